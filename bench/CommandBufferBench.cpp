@@ -0,0 +1,104 @@
+// Command buffers: recording time for the sorted scene draws with 1 to 4
+// recording threads, the size of the recorded stream, its command mix, and a
+// save/load round trip checked for an identical stream.
+#include "core/CommandBuffer.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Timing.hpp"
+#include "scene/CommandRecorder.hpp"
+#include "scene/RenderQueue.hpp"
+#include "scene/SceneGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+    const char* commandName(CommandType type) {
+        switch (type) {
+        case CommandType::BIND_MESH: return "bind mesh";
+        case CommandType::BIND_TEXTURE: return "bind texture";
+        case CommandType::SET_BLEND: return "set blend";
+        case CommandType::SET_SCISSOR: return "set scissor";
+        case CommandType::DISABLE_SCISSOR: return "no scissor";
+        case CommandType::SET_MATRIX: return "set matrix";
+        case CommandType::SET_VECTOR: return "set vector";
+        case CommandType::DRAW: return "draw";
+        default: return "?";
+        }
+    }
+}
+
+int main() {
+    const int copiesPerShape = 10000;
+    const int viewportHeight = 1080;
+    const int textureCount = 4;
+    Camera camera = Camera::canvasDefault();
+
+    Scene scene;
+    SceneGenerator::populateBenchmark(scene, copiesPerShape);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> texture(-2 * textureCount, textureCount - 1);
+    for (ObjectMaterial& material : scene.materials) {
+        material.texture = std::max(-1, texture(rng));
+    }
+    scene.updateWorldMatrices();
+    std::vector<uint32_t> objects(scene.size());
+    std::iota(objects.begin(), objects.end(), 0u);
+
+    RenderQueue queue;
+    std::vector<int8_t> lodLevels(scene.size(), -1);
+    queue.build(scene, objects, camera, viewportHeight, lodLevels);
+
+    std::printf("%zu draws\n\n%10s %10s %10s\n", queue.size(), "threads", "record ms", "buffers");
+    std::vector<CommandBuffer> reference;
+    for (unsigned workers = 0; workers < 4; ++workers) {
+        ThreadPool pool(workers);
+        std::vector<CommandBuffer> buffers;
+        CommandRecorder::record(scene, queue, camera, pool, buffers); // Warm up allocations
+
+        const int passes = 10;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            CommandRecorder::record(scene, queue, camera, pool, buffers);
+        }
+        double recordMs = Timing::millisecondsSince(start) / passes;
+        std::printf("%10u %10.2f %10zu%s\n", pool.threadCount(), recordMs, buffers.size(),
+                    workers == 0 || buffers == reference ? "" : "  MISMATCH");
+        if (workers == 0) {
+            reference = buffers;
+        }
+    }
+
+    CommandBuffer::Stats total;
+    size_t commands = 0;
+    for (const CommandBuffer& buffer : reference) {
+        CommandBuffer::Stats stats = buffer.analyze();
+        for (int type = 0; type < (int)CommandType::COUNT; ++type) {
+            total.counts[type] += stats.counts[type];
+        }
+        total.bytes += stats.bytes;
+        commands += buffer.size();
+    }
+    std::printf("\n%zu commands, %.1f MB, %.1f bytes per draw\n", commands, total.bytes / (1024.0 * 1024.0),
+                (double)total.bytes / std::max((size_t)1, queue.size()));
+    for (int type = 0; type < (int)CommandType::COUNT; ++type) {
+        if (total.counts[type] > 0) {
+            std::printf("%14s %10u\n", commandName((CommandType)type), total.counts[type]);
+        }
+    }
+
+    const char* path = "command_bench.blcb";
+    auto start = std::chrono::steady_clock::now();
+    bool saved = CommandBuffer::save(path, reference);
+    double saveMs = Timing::millisecondsSince(start);
+    std::vector<CommandBuffer> loaded;
+    start = std::chrono::steady_clock::now();
+    bool restored = CommandBuffer::load(path, loaded);
+    double loadMs = Timing::millisecondsSince(start);
+    std::remove(path);
+    std::printf("\nsave %.2f ms, load %.2f ms, round trip %s\n", saveMs, loadMs,
+                saved && restored && loaded == reference ? "ok" : "FAILED");
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Frustum culling through the scene BVH: build time, cull time against a
+// brute-force test of every object, and the cost of refitting after 1% or
+// all of the objects move, for scenes where most objects are off-screen.
+#include "core/Timing.hpp"
+#include "scene/SceneBvh.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "math/Camera.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main() {
+    const int objectCounts[] = {100000, 1000000};
+    Frustum frustum = Frustum::fromMatrix(Camera::canvasDefault().viewProjection());
+
+    std::printf("%10s %9s %10s %10s %10s %10s %11s %11s %6s %9s\n", "objects", "visible", "build ms", "cull ms",
+                "brute ms", "nodes", "refit1% ms", "refit all", "match", "rebuilds");
+
+    for (int count : objectCounts) {
+        Scene scene;
+        SceneGenerator::populateScattered(scene, count, 100.0f);
+        scene.updateWorldMatrices();
+
+        SceneBvh bvh;
+        auto start = std::chrono::steady_clock::now();
+        bvh.update(scene);
+        double buildMs = Timing::millisecondsSince(start);
+
+        const int passes = 20;
+        std::vector<uint32_t> visible;
+        SceneBvh::CullStats stats;
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            visible.clear();
+            bvh.cull(scene, frustum, visible, &stats);
+        }
+        double cullMs = Timing::millisecondsSince(start) / passes;
+
+        std::vector<uint32_t> bruteVisible;
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            bruteVisible.clear();
+            for (uint32_t i = 0; i < scene.size(); ++i) {
+                glm::vec3 boundsMin, boundsMax;
+                SceneBvh::worldBounds(scene, i, boundsMin, boundsMax);
+                if (frustum.intersectsAabb(boundsMin, boundsMax)) {
+                    bruteVisible.push_back(i);
+                }
+            }
+        }
+        double bruteMs = Timing::millisecondsSince(start) / passes;
+
+        std::sort(visible.begin(), visible.end());
+        bool match = visible == bruteVisible;
+
+        // Nudge 1% of the objects, then everything
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<uint32_t> pick(0, (uint32_t)scene.size() - 1);
+        std::uniform_real_distribution<float> nudge(-0.5f, 0.5f);
+        for (int i = 0; i < count / 100; ++i) {
+            uint32_t index = pick(rng);
+            scene.positions[index] += glm::vec3(nudge(rng), nudge(rng), nudge(rng));
+            scene.markDirty(index);
+        }
+        scene.updateWorldMatrices();
+        start = std::chrono::steady_clock::now();
+        bvh.update(scene);
+        double refitSomeMs = Timing::millisecondsSince(start);
+
+        for (uint32_t index = 0; index < scene.size(); ++index) {
+            scene.positions[index] += glm::vec3(nudge(rng), nudge(rng), nudge(rng));
+        }
+        scene.updateAllWorldMatrices();
+        start = std::chrono::steady_clock::now();
+        bvh.update(scene);
+        double refitAllMs = Timing::millisecondsSince(start);
+
+        visible.clear();
+        bvh.cull(scene, frustum, visible);
+        bruteVisible.clear();
+        for (uint32_t i = 0; i < scene.size(); ++i) {
+            glm::vec3 boundsMin, boundsMax;
+            SceneBvh::worldBounds(scene, i, boundsMin, boundsMax);
+            if (frustum.intersectsAabb(boundsMin, boundsMax)) {
+                bruteVisible.push_back(i);
+            }
+        }
+        std::sort(visible.begin(), visible.end());
+        match = match && visible == bruteVisible;
+
+        std::printf("%10zu %9u %10.2f %10.3f %10.2f %10u %11.3f %11.2f %6s %9u\n", scene.size(), stats.visible, buildMs,
+                    cullMs, bruteMs, stats.nodesVisited, refitSomeMs, refitAllMs, match ? "yes" : "NO", bvh.getRebuildCount());
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Half-edge topology on large spheres: build time and adjacency query cost,
+// which must stay flat as the face count grows.
+#include "geometry/PrimitiveGenerator.hpp"
+#include "core/Timing.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main() {
+    const int sliceCounts[] = {64, 256, 512, 1024, 1448};
+    const int queries = 1000000;
+
+    std::printf("%8s %10s %10s %10s %16s %16s\n", "slices", "faces", "build ms", "MB", "neighbors ns/q", "one-ring ns/q");
+
+    for (int slices : sliceCounts) {
+        MeshData mesh = PrimitiveGenerator::generateSphere(0.5f, slices, slices / 2);
+
+        auto start = std::chrono::steady_clock::now();
+        HalfEdgeMesh topology = HalfEdgeMesh::fromMesh(mesh);
+        double buildMs = Timing::millisecondsSince(start);
+
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<int32_t> pickFace(0, (int32_t)topology.faceCount() - 1);
+        std::uniform_int_distribution<uint32_t> pickVertex(0, (uint32_t)topology.vertexCount() - 1);
+        std::vector<int32_t> faces(queries);
+        std::vector<uint32_t> vertices(queries);
+        for (int i = 0; i < queries; ++i) {
+            faces[i] = pickFace(rng);
+            vertices[i] = pickVertex(rng);
+        }
+
+        long long checksum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int32_t f : faces) {
+            int32_t neighbors[3];
+            topology.faceNeighbors(f, neighbors);
+            checksum += neighbors[0] + neighbors[1] + neighbors[2];
+        }
+        double neighborNs = Timing::millisecondsSince(start) * 1e6 / queries;
+
+        start = std::chrono::steady_clock::now();
+        for (uint32_t v : vertices) {
+            topology.forEachOneRing(v, [&checksum](uint32_t n) { checksum += n; });
+        }
+        double ringNs = Timing::millisecondsSince(start) * 1e6 / queries;
+
+        std::printf("%8d %10zu %10.1f %10.1f %16.1f %16.1f\n", slices, topology.faceCount(), buildMs,
+                    topology.byteSize() / (1024.0 * 1024.0), neighborNs, ringNs);
+        if (checksum == 42) std::printf(" ");
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Vertex cache efficiency before and after MeshOptimizer, for every generated
+// primitive and for unindexed triangle soups like those exported by STL tools.
+#include "geometry/MeshOptimizer.hpp"
+#include "geometry/PrimitiveGenerator.hpp"
+#include "core/Timing.hpp"
+#include <chrono>
+#include <cstdio>
+
+namespace {
+    // One vertex per triangle corner, the way an unindexed importer delivers meshes
+    MeshData toTriangleSoup(const MeshData& mesh) {
+        MeshData soup;
+        soup.vertices.reserve(mesh.indices.size());
+        soup.indices.reserve(mesh.indices.size());
+        for (uint32_t index : mesh.indices) {
+            soup.indices.push_back((uint32_t)soup.vertices.size());
+            soup.vertices.push_back(mesh.vertices[index]);
+        }
+        return soup;
+    }
+
+    void report(const char* name, MeshData mesh) {
+        MeshOptimizer::Options options;
+        options.overdraw = true;
+        auto start = std::chrono::steady_clock::now();
+        MeshOptimizer::Report result = MeshOptimizer::optimize(mesh, options);
+        double ms = Timing::millisecondsSince(start);
+
+        std::printf("%-18s %9zu %9zu %9zu %6.3f %6.3f %6.3f %6.3f %9s %8.2f\n", name, mesh.triangleCount(),
+                    result.verticesBefore, result.verticesAfter, result.before.acmr, result.after.acmr,
+                    result.before.atvr, result.after.atvr, result.overdrawApplied ? "yes" : "no", ms);
+    }
+}
+
+int main() {
+    const struct { const char* name; ShapeType shape; } shapes[] = {
+        {"cube", ShapeType::CUBE}, {"sphere", ShapeType::SPHERE}, {"cone", ShapeType::CONE},
+        {"cylinder", ShapeType::CYLINDER}, {"torus", ShapeType::TORUS}, {"pyramid", ShapeType::PYRAMID},
+    };
+
+    std::printf("%-18s %9s %9s %9s %6s %6s %6s %6s %9s %8s\n", "mesh", "triangles", "verts in", "verts out",
+                "ACMR", "->", "ATVR", "->", "overdraw", "ms");
+
+    for (const auto& entry : shapes) {
+        report(entry.name, PrimitiveGenerator::generate(PrimitiveParams::defaultsFor(entry.shape)));
+    }
+
+    MeshData sphere = PrimitiveGenerator::generateSphere(0.5f, 512, 256);
+    MeshData torus = PrimitiveGenerator::generateTorus(0.5f, 0.2f, 512, 256);
+    report("sphere 512", sphere);
+    report("torus 512", torus);
+    report("sphere 512 soup", toTriangleSoup(sphere));
+    report("torus 512 soup", toTriangleSoup(torus));
+    return 0;
+}
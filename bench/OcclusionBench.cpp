@@ -0,0 +1,74 @@
+// CPU occlusion culling behind a wall of large panels: how many of the
+// frustum-visible objects are culled, rasterization and test times, and how
+// both scale with the number of threads. Culled objects are checked against a
+// ray through their center, which must hit something nearer.
+#include "core/ThreadPool.hpp"
+#include "scene/OcclusionCuller.hpp"
+#include "scene/SceneBvh.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "scene/ScenePicker.hpp"
+#include "math/Camera.hpp"
+#include "math/Frustum.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <vector>
+
+int main() {
+    const int objectCounts[] = {20000, 100000};
+    const unsigned workerCounts[] = {0, 1, 3};
+    Camera camera = Camera::canvasDefault();
+    Frustum frustum = Frustum::fromMatrix(camera.viewProjection());
+
+    std::printf("%10s %8s %9s %10s %10s %9s %10s %9s %8s\n", "objects", "threads", "visible", "occluders",
+                "triangles", "culled", "raster ms", "test ms", "check");
+
+    for (int count : objectCounts) {
+        Scene scene;
+        SceneGenerator::populateOccluded(scene, count);
+        scene.updateWorldMatrices();
+        SceneBvh bvh;
+        bvh.update(scene);
+        std::vector<int8_t> lodLevels(scene.size(), -1);
+
+        std::vector<uint32_t> frustumVisible;
+        bvh.cull(scene, frustum, frustumVisible);
+        std::sort(frustumVisible.begin(), frustumVisible.end());
+
+        for (unsigned workers : workerCounts) {
+            ThreadPool pool(workers);
+            OcclusionCuller culler;
+            std::vector<uint32_t> visible;
+
+            const int passes = 20;
+            double rasterMs = 0.0;
+            double testMs = 0.0;
+            for (int pass = 0; pass < passes; ++pass) {
+                visible = frustumVisible;
+                culler.cull(scene, camera, lodLevels, visible, pool);
+                rasterMs += culler.getStats().rasterMs;
+                testMs += culler.getStats().testMs;
+            }
+
+            // A culled object's center must be behind some other surface
+            std::vector<uint32_t> culled;
+            std::set_difference(frustumVisible.begin(), frustumVisible.end(), visible.begin(), visible.end(),
+                                std::back_inserter(culled));
+            size_t failures = 0;
+            for (uint32_t object : culled) {
+                glm::vec3 center(scene.worldMatrices[object][3]);
+                Ray ray{camera.eye, glm::normalize(center - camera.eye)};
+                PickResult hit = ScenePicker::pick(scene, bvh, ray, lodLevels);
+                if (!hit.hit() || scene.indexOf(hit.object) == (int64_t)object) {
+                    failures++;
+                }
+            }
+
+            const OcclusionCuller::Stats& stats = culler.getStats();
+            std::printf("%10zu %8u %9zu %10u %10u %9u %10.3f %9.3f %8s\n", scene.size(), pool.threadCount(),
+                        frustumVisible.size(), stats.occluders, stats.triangles, stats.culled, rasterMs / passes,
+                        testMs / passes, failures == 0 ? "ok" : "FAIL");
+        }
+    }
+    return 0;
+}
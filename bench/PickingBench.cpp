@@ -0,0 +1,112 @@
+// Ray-cast picking cost: random rays through the canvas camera into scenes of
+// about 5M triangles, once with few dense meshes and once with many coarse
+// ones, checked against a brute-force test of every triangle of every object.
+#include "core/Timing.hpp"
+#include "scene/ScenePicker.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "scene/LodSelector.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    // Reference: every visible object, every triangle, scalar Moller-Trumbore in world space
+    float bruteForce(const Scene& scene, const std::vector<int8_t>& lodLevels, const Ray& ray, uint32_t& hitObject) {
+        float best = std::numeric_limits<float>::max();
+        hitObject = ObjectHandle::INVALID_INDEX;
+        for (uint32_t object = 0; object < scene.size(); ++object) {
+            const MeshBvh& mesh = ScenePicker::meshFor(ScenePicker::paramsFor(scene, object, lodLevels));
+            const glm::mat4& world = scene.worldMatrices[object];
+            for (uint32_t face = 0; face < mesh.triangleCount(); ++face) {
+                glm::vec3 a, b, c;
+                mesh.triangle(face, a, b, c);
+                a = glm::vec3(world * glm::vec4(a, 1.0f));
+                b = glm::vec3(world * glm::vec4(b, 1.0f));
+                c = glm::vec3(world * glm::vec4(c, 1.0f));
+                glm::vec3 e1 = b - a, e2 = c - a;
+                glm::vec3 p = glm::cross(ray.direction, e2);
+                float det = glm::dot(e1, p);
+                if (std::fabs(det) < 1e-12f) continue;
+                glm::vec3 s = ray.origin - a;
+                float u = glm::dot(s, p) / det;
+                glm::vec3 q = glm::cross(s, e1);
+                float v = glm::dot(ray.direction, q) / det;
+                float t = glm::dot(e2, q) / det;
+                if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < best) {
+                    best = t;
+                    hitObject = object;
+                }
+            }
+        }
+        return best;
+    }
+
+    size_t triangleCount(const Scene& scene, const std::vector<int8_t>& lodLevels) {
+        size_t total = 0;
+        for (size_t i = 0; i < scene.size(); ++i) {
+            total += ScenePicker::meshFor(ScenePicker::paramsFor(scene, i, lodLevels)).triangleCount();
+        }
+        return total;
+    }
+}
+
+int main() {
+    struct Config {
+        const char* name;
+        int copiesPerShape;
+        int level;
+    };
+    // Densest LOD on a few hundred objects, then a coarse LOD on many more
+    const Config configs[] = {{"dense", 160, LodSelector::LEVEL_COUNT - 1}, {"coarse", 4000, 4}};
+    Camera camera = Camera::canvasDefault();
+
+    std::printf("%8s %9s %10s %10s %10s %10s %8s\n", "scene", "objects", "triangles", "hit rate", "us/pick",
+                "brute ms", "match");
+
+    for (const Config& config : configs) {
+        Scene scene;
+        SceneGenerator::populateBenchmark(scene, config.copiesPerShape);
+        std::vector<int8_t> lodLevels(scene.size(), (int8_t)config.level);
+        scene.updateWorldMatrices();
+        SceneBvh bvh;
+        bvh.update(scene);
+        size_t triangles = triangleCount(scene, lodLevels); // Also builds every mesh BVH up front
+
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> ndc(-0.9f, 0.9f);
+        const int rays = 2000;
+        std::vector<Ray> samples(rays);
+        for (Ray& ray : samples) {
+            ray = camera.rayThroughNdc(ndc(rng), ndc(rng));
+        }
+
+        int hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const Ray& ray : samples) {
+            hits += ScenePicker::pick(scene, bvh, ray, lodLevels).hit() ? 1 : 0;
+        }
+        double pickUs = Timing::millisecondsSince(start) * 1000.0 / rays;
+
+        // Brute force is slow; compare on a handful of rays
+        const int checked = 8;
+        int matches = 0;
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < checked; ++r) {
+            uint32_t bruteObject;
+            float bruteDistance = bruteForce(scene, lodLevels, samples[r], bruteObject);
+            PickResult pick = ScenePicker::pick(scene, bvh, samples[r], lodLevels);
+            bool same = pick.hit() ? (scene.indexOf(pick.object) == (int64_t)bruteObject &&
+                                      std::fabs(pick.distance - bruteDistance) < 1e-4f * (1.0f + bruteDistance))
+                                   : bruteObject == ObjectHandle::INVALID_INDEX;
+            matches += same ? 1 : 0;
+        }
+        double bruteMs = Timing::millisecondsSince(start) / checked;
+
+        std::printf("%8s %9zu %10zu %9.0f%% %10.2f %10.1f %5d/%d\n", config.name, scene.size(), triangles,
+                    100.0 * hits / rays, pickUs, bruteMs, matches, checked);
+    }
+    return 0;
+}
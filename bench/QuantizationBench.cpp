@@ -0,0 +1,48 @@
+// Error and footprint of the packed 16-bit vertex format for every primitive
+// at its default and highest tessellation level.
+#include "geometry/MeshOptimizer.hpp"
+#include "geometry/PrimitiveGenerator.hpp"
+#include "geometry/VertexQuantizer.hpp"
+#include "scene/LodSelector.hpp"
+#include <cstdio>
+
+namespace {
+    void report(const char* name, const PrimitiveParams& params) {
+        MeshData mesh = PrimitiveGenerator::generate(params);
+        MeshOptimizer::optimize(mesh);
+        QuantizedMesh packed = VertexQuantizer::quantize(mesh);
+        QuantizationReport result = VertexQuantizer::measure(mesh, packed);
+
+        std::printf("%-16s %9zu %10.1f %10.1f %6.2fx %10.2e %10.2e %10.4f %10.2e\n", name, mesh.vertices.size(),
+                    result.floatBytes / 1024.0, result.packedBytes / 1024.0,
+                    (double)result.floatBytes / result.packedBytes, result.maxPositionError,
+                    result.positionErrorBound, result.maxNormalErrorDegrees, result.maxUvError);
+    }
+}
+
+int main() {
+    const struct { const char* name; ShapeType shape; } shapes[] = {
+        {"cube", ShapeType::CUBE}, {"sphere", ShapeType::SPHERE}, {"cone", ShapeType::CONE},
+        {"cylinder", ShapeType::CYLINDER}, {"torus", ShapeType::TORUS}, {"pyramid", ShapeType::PYRAMID},
+    };
+
+    std::printf("%-16s %9s %10s %10s %7s %10s %10s %10s %10s\n", "mesh", "vertices", "float KB", "packed KB",
+                "ratio", "pos err", "pos bound", "normal deg", "uv err");
+
+    for (const auto& entry : shapes) {
+        PrimitiveParams params = PrimitiveParams::defaultsFor(entry.shape);
+        report(entry.name, params);
+        if (LodSelector::usesLod(entry.shape)) {
+            char name[32];
+            std::snprintf(name, sizeof(name), "%s lod %d", entry.name, LodSelector::LEVEL_COUNT - 1);
+            report(name, LodSelector::paramsForLevel(params, LodSelector::LEVEL_COUNT - 1));
+        }
+    }
+
+    // Past 65536 vertices the indices stay 32-bit and only the vertices shrink
+    PrimitiveParams dense = PrimitiveParams::defaultsFor(ShapeType::SPHERE);
+    dense.slices = 1024;
+    dense.stacks = 512;
+    report("sphere 1024", dense);
+    return 0;
+}
@@ -0,0 +1,83 @@
+// Software rasterizer: triangle throughput at 1 to N threads for a benchmark
+// scene of few large objects (fill bound) and one of many small ones
+// (triangle bound), split into setup (transform, clipping, binning) and tile
+// rasterization, with the speedup over one thread.
+#include "core/Image.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Timing.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "scene/SoftwareRenderer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+int main() {
+    const int copiesPerShape[] = {100, 5000};
+    const int width = 1920;
+    const int height = 1080;
+    const int textureCount = 6;
+
+    std::vector<Image> textures;
+    for (int i = 0; i < textureCount; ++i) {
+        textures.push_back(Image::fallbackTexture(i));
+    }
+
+    // Powers of two, then every hardware thread
+    unsigned maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+    std::printf("%dx%d, %u hardware threads\n", width, height, std::thread::hardware_concurrency());
+
+    for (int copies : copiesPerShape) {
+        Scene scene;
+        SceneGenerator::populateBenchmark(scene, copies);
+        // A third of the objects textured with the placeholder textures
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> texture(-2 * textureCount, textureCount - 1);
+        for (ObjectMaterial& material : scene.materials) {
+            material.texture = std::max(-1, texture(rng));
+        }
+        scene.updateWorldMatrices();
+        std::vector<uint32_t> objects(scene.size());
+        std::iota(objects.begin(), objects.end(), 0u);
+
+        std::printf("\n%zu objects\n%8s %10s %10s %10s %10s %10s %8s\n", scene.size(), "threads", "triangles",
+                    "raster", "setup ms", "raster ms", "Mtris/s", "speedup");
+        double singleMs = 0.0;
+        for (unsigned threads : threadCounts) {
+            ThreadPool pool(threads - 1);
+            SoftwareRenderer renderer;
+            renderer.resize(width, height);
+            renderer.setTextures(textures);
+            std::vector<int8_t> lodLevels(scene.size(), -1);
+            renderer.render(scene, objects, Camera::canvasDefault(), lodLevels, pool); // Warm up meshes and bins
+
+            const int passes = 5;
+            double setupMs = 0.0;
+            double rasterMs = 0.0;
+            auto start = std::chrono::steady_clock::now();
+            for (int pass = 0; pass < passes; ++pass) {
+                renderer.clear(glm::vec4(0.12f, 0.12f, 0.15f, 1.0f));
+                renderer.render(scene, objects, Camera::canvasDefault(), lodLevels, pool);
+                setupMs += renderer.getStats().setupMs;
+                rasterMs += renderer.getStats().rasterMs;
+            }
+            double frameMs = Timing::millisecondsSince(start) / passes;
+            if (threads == 1) {
+                singleMs = frameMs;
+            }
+            const SoftwareRenderer::Stats& stats = renderer.getStats();
+            std::printf("%8u %10llu %10llu %10.2f %10.2f %10.2f %7.2fx\n", threads,
+                        (unsigned long long)stats.triangles, (unsigned long long)stats.rasterTriangles,
+                        setupMs / passes, rasterMs / passes, stats.triangles / (frameMs * 1000.0), singleMs / frameMs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Render queue sorting: state changes per frame for the same draws in scene
+// order, in sorted key order, and as the old per-object loop issued them
+// (mesh and material set for every draw, plus blending for textured ones),
+// along with the queue build time and radix against comparison sorting.
+#include "core/RadixSort.hpp"
+#include "core/Timing.hpp"
+#include "scene/RenderQueue.hpp"
+#include "scene/SceneGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+int main() {
+    const int copiesPerShape[] = {100, 1000, 10000, 100000};
+    const int viewportHeight = 1080;
+    const int textureCount = 4;
+    Camera camera = Camera::canvasDefault();
+
+    std::printf("%10s %10s %10s %10s %10s %10s %10s\n", "objects", "per-draw", "scene ord", "sorted", "build ms",
+                "radix ms", "std ms");
+
+    for (int copies : copiesPerShape) {
+        Scene scene;
+        SceneGenerator::populateBenchmark(scene, copies);
+        // A third of the objects textured, as if picked from the texture panel
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> texture(-2 * textureCount, textureCount - 1);
+        uint32_t textured = 0;
+        for (ObjectMaterial& material : scene.materials) {
+            material.texture = std::max(-1, texture(rng));
+            textured += material.texture != -1;
+        }
+        scene.updateWorldMatrices();
+        std::vector<uint32_t> objects(scene.size());
+        std::iota(objects.begin(), objects.end(), 0u);
+
+        RenderQueue queue;
+        std::vector<int8_t> lodLevels(scene.size(), -1);
+        queue.build(scene, objects, camera, viewportHeight, lodLevels); // Warm up allocations
+
+        const int passes = 10;
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            queue.build(scene, objects, camera, viewportHeight, lodLevels);
+        }
+        double buildMs = Timing::millisecondsSince(start) / passes;
+
+        // Sorting alone, from the unsorted keys
+        std::vector<uint64_t> unsortedKeys(queue.getKeys());
+        std::shuffle(unsortedKeys.begin(), unsortedKeys.end(), rng);
+        RadixSort sorter;
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> values;
+        double radixMs = 0.0;
+        double stdMs = 0.0;
+        for (int pass = 0; pass < passes; ++pass) {
+            keys = unsortedKeys;
+            values = objects;
+            start = std::chrono::steady_clock::now();
+            sorter.sort(keys, values);
+            radixMs += Timing::millisecondsSince(start);
+
+            keys = unsortedKeys;
+            start = std::chrono::steady_clock::now();
+            std::sort(keys.begin(), keys.end());
+            stdMs += Timing::millisecondsSince(start);
+        }
+
+        uint32_t perDraw = (uint32_t)queue.size() * 2 + textured;
+        std::printf("%10zu %10u %10u %10u %10.2f %10.2f %10.2f\n", scene.size(), perDraw,
+                    queue.getUnsortedChanges().total(), queue.getSortedChanges().total(), buildMs, radixMs / passes,
+                    stdMs / passes);
+    }
+    return 0;
+}
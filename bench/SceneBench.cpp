@@ -0,0 +1,91 @@
+// Scene container throughput: bulk add, random remove/re-add through the free
+// list and the linear world-matrix pass at 100k and 1M objects, then the cost
+// of moving one node in a 50k-node hierarchy.
+#include "core/Timing.hpp"
+#include "scene/Scene.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main() {
+    const size_t objectCounts[] = {100000, 1000000};
+
+    std::printf("%10s %10s %12s %12s %12s %10s\n", "objects", "add ms", "churn ns/op", "update ms", "ns/object", "stale ok");
+
+    for (size_t count : objectCounts) {
+        Scene scene;
+        std::vector<ObjectHandle> handles;
+        handles.reserve(count);
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+
+        auto start = std::chrono::steady_clock::now();
+        scene.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            ObjectHandle handle = scene.add((ShapeType)(1 + i % 6));
+            handles.push_back(handle);
+            size_t index = (size_t)scene.indexOf(handle);
+            scene.positions[index] = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+            scene.rotations[index] = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+        double addMs = Timing::millisecondsSince(start);
+
+        // Remove a random object and add a replacement, reusing its slot
+        const size_t churn = count / 2;
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        size_t staleRejected = 0;
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < churn; ++i) {
+            size_t victim = pick(rng);
+            ObjectHandle old = handles[victim];
+            scene.remove(old);
+            handles[victim] = scene.add(ShapeType::SPHERE);
+            staleRejected += scene.isValid(old) ? 0 : 1;
+        }
+        double churnNs = Timing::millisecondsSince(start) * 1e6 / churn;
+
+        const int passes = 10;
+        start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            scene.updateAllWorldMatrices();
+        }
+        double updateMs = Timing::millisecondsSince(start) / passes;
+
+        std::printf("%10zu %10.1f %12.1f %12.2f %12.2f %10s\n", scene.size(), addMs, churnNs, updateMs,
+                    updateMs * 1e6 / scene.size(), staleRejected == churn ? "yes" : "no");
+    }
+
+    // 500 trees of 100 nodes: each root has 9 children with 10 leaves each
+    Scene hierarchy;
+    std::vector<ObjectHandle> roots, leaves;
+    for (int tree = 0; tree < 500; ++tree) {
+        ObjectHandle root = hierarchy.add(ShapeType::CUBE);
+        roots.push_back(root);
+        for (int branch = 0; branch < 9; ++branch) {
+            ObjectHandle child = hierarchy.add(ShapeType::SPHERE, root);
+            for (int leaf = 0; leaf < 10; ++leaf) {
+                leaves.push_back(hierarchy.add(ShapeType::CONE, child));
+            }
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    hierarchy.updateAllWorldMatrices();
+    double fullUs = Timing::millisecondsSince(start) * 1000.0;
+
+    auto moveAndUpdate = [&hierarchy](ObjectHandle handle, int iterations) {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            size_t index = (size_t)hierarchy.indexOf(handle);
+            hierarchy.setLocalTransform(index, glm::vec3((float)i, 0.0f, 0.0f), hierarchy.scales[index],
+                                        hierarchy.rotations[index]);
+            hierarchy.updateWorldMatrices();
+        }
+        return Timing::millisecondsSince(begin) * 1000.0 / iterations;
+    };
+
+    std::printf("\n%10s %14s %14s %14s\n", "nodes", "full pass us", "move leaf us", "move root us");
+    std::printf("%10zu %14.1f %14.2f %14.2f\n", hierarchy.size(), fullUs, moveAndUpdate(leaves[leaves.size() / 2], 1000),
+                moveAndUpdate(roots[roots.size() / 2], 1000));
+    return 0;
+}
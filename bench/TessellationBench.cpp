@@ -0,0 +1,66 @@
+// Sphere tessellation throughput: table-driven SIMD generator versus the
+// per-vertex trigonometry the immediate-mode drawSphere used to do.
+#include "geometry/PrimitiveGenerator.hpp"
+#include "core/Constants.hpp"
+#include "core/Timing.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    // Same math as the old drawSphere, written into a buffer instead of glVertex3f
+    size_t referenceSphere(float radius, int slices, int stacks) {
+        std::vector<Vertex> out;
+        for (int i = 0; i <= stacks; ++i) {
+            float phi = Constants::PI * i / stacks;
+            for (int j = 0; j <= slices; ++j) {
+                float theta = 2.0f * Constants::PI * j / slices;
+                float s = (float)j / slices;
+                out.push_back({{radius * sinf(phi) * cosf(theta), radius * cosf(phi), radius * sinf(phi) * sinf(theta)},
+                               {sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta)},
+                               {s, (float)i / stacks}});
+                float phi2 = phi + Constants::PI / stacks;
+                out.push_back({{radius * sinf(phi2) * cosf(theta), radius * cosf(phi2), radius * sinf(phi2) * sinf(theta)},
+                               {sinf(phi2) * cosf(theta), cosf(phi2), sinf(phi2) * sinf(theta)},
+                               {s, (float)(i + 1) / stacks}});
+            }
+        }
+        return out.size();
+    }
+}
+
+int main() {
+    const int sliceCounts[] = {20, 32, 64, 128, 256, 512, 1024};
+    const double budgetMs = 250.0; // Per measurement
+
+    std::printf("%8s %12s %16s %16s %8s\n", "slices", "vertices", "table Mvert/s", "reference Mvert/s", "speedup");
+
+    for (int slices : sliceCounts) {
+        int stacks = slices;
+
+        // Warm the ring tables so the steady state is measured
+        PrimitiveGenerator::generateSphere(0.5f, slices, stacks);
+
+        size_t vertices = 0;
+        int runs = 0;
+        auto start = std::chrono::steady_clock::now();
+        do {
+            vertices += PrimitiveGenerator::generateSphere(0.5f, slices, stacks).vertices.size();
+            runs++;
+        } while (Timing::millisecondsSince(start) < budgetMs);
+        double tableRate = vertices / Timing::millisecondsSince(start) / 1e3;
+        size_t perMesh = vertices / runs;
+
+        vertices = 0;
+        start = std::chrono::steady_clock::now();
+        do {
+            vertices += referenceSphere(0.5f, slices, stacks);
+        } while (Timing::millisecondsSince(start) < budgetMs);
+        double referenceRate = vertices / Timing::millisecondsSince(start) / 1e3;
+
+        std::printf("%8d %12zu %16.1f %16.1f %7.2fx\n", slices, perMesh, tableRate, referenceRate,
+                    tableRate / referenceRate);
+    }
+    return 0;
+}
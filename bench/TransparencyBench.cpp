@@ -0,0 +1,130 @@
+// Transparent pass: 100k blended objects split from the visible set and
+// sorted back to front, per thread count, against std::stable_sort on the
+// same depths; then per-triangle sorting of one large transparent sphere.
+// Every order is checked to be back to front and the same for every pool.
+#include "core/RadixSort.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Timing.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "scene/TransparentPass.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace {
+    float viewDepth(const Scene& scene, uint32_t object, const glm::mat4& view) {
+        return -(view * scene.worldMatrices[object][3]).z;
+    }
+
+    // Quantized depths may tie, so only a strictly nearer-first pair is wrong
+    bool backToFront(const Scene& scene, const std::vector<uint32_t>& order, const Camera& camera) {
+        glm::mat4 view = camera.view();
+        for (size_t k = 1; k < order.size(); ++k) {
+            uint32_t previous = TransparentPass::quantizeDepth(viewDepth(scene, order[k - 1], view),
+                                                               camera.nearPlane, camera.farPlane);
+            uint32_t current = TransparentPass::quantizeDepth(viewDepth(scene, order[k], view), camera.nearPlane,
+                                                              camera.farPlane);
+            if (current > previous) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    const int objectCount = 100000;
+    const int viewportHeight = 1080;
+    const int passes = 10;
+    Camera camera = Camera::canvasDefault();
+
+    Scene scene;
+    SceneGenerator::populateScattered(scene, objectCount, 20.0f);
+    for (size_t i = 0; i < scene.size(); ++i) {
+        scene.materials[i].texture = (int)(i % 4);
+    }
+    scene.updateWorldMatrices();
+    std::vector<uint32_t> objects(scene.size());
+    std::iota(objects.begin(), objects.end(), 0u);
+    std::vector<int8_t> lodLevels(scene.size(), -1);
+
+    std::printf("%zu transparent objects\n\n%10s %10s %10s %10s\n", scene.size(), "threads", "pass ms", "radix ms",
+                "std ms");
+    std::vector<uint32_t> reference;
+    for (unsigned workers = 0; workers < 4; ++workers) {
+        ThreadPool pool(workers);
+        TransparentPass pass;
+        pass.build(scene, objects, camera, viewportHeight, lodLevels, pool); // Warm up allocations
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < passes; ++i) {
+            pass.build(scene, objects, camera, viewportHeight, lodLevels, pool);
+        }
+        double passMs = Timing::millisecondsSince(start) / passes;
+
+        // The sort alone, from keys in scene order, against a comparison sort
+        glm::mat4 view = camera.view();
+        std::vector<uint64_t> unsortedKeys(scene.size());
+        for (size_t i = 0; i < scene.size(); ++i) {
+            unsortedKeys[i] = 0xffffffffull - TransparentPass::quantizeDepth(viewDepth(scene, (uint32_t)i, view),
+                                                                             camera.nearPlane, camera.farPlane);
+        }
+        RadixSort sorter;
+        std::vector<uint64_t> keys;
+        std::vector<uint32_t> values;
+        std::vector<std::pair<uint64_t, uint32_t>> pairs;
+        double radixMs = 0.0;
+        double stdMs = 0.0;
+        for (int i = 0; i < passes; ++i) {
+            keys = unsortedKeys;
+            values = objects;
+            start = std::chrono::steady_clock::now();
+            sorter.sort(keys, values, pool);
+            radixMs += Timing::millisecondsSince(start);
+
+            pairs.resize(keys.size());
+            for (size_t k = 0; k < pairs.size(); ++k) {
+                pairs[k] = std::make_pair(unsortedKeys[k], (uint32_t)k);
+            }
+            start = std::chrono::steady_clock::now();
+            std::stable_sort(pairs.begin(), pairs.end(),
+                             [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) {
+                                 return a.first < b.first;
+                             });
+            stdMs += Timing::millisecondsSince(start);
+        }
+        bool sameAsStd = true;
+        for (size_t k = 0; k < pairs.size(); ++k) {
+            sameAsStd = sameAsStd && pairs[k].second == values[k];
+        }
+
+        const std::vector<uint32_t>& order = pass.getObjects();
+        bool ok = order.size() == scene.size() && backToFront(scene, order, camera) && sameAsStd &&
+                  (workers == 0 || order == reference);
+        std::printf("%10u %10.2f %10.2f %10.2f%s\n", pool.threadCount(), passMs, radixMs / passes, stdMs / passes,
+                    ok ? "" : "  WRONG ORDER");
+        if (workers == 0) {
+            reference = order;
+        }
+    }
+
+    // One sphere filling most of the view gets the finest LOD and its triangles sorted
+    Scene single;
+    single.add(ShapeType::SPHERE);
+    single.setLocalTransform(0, glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(1.0f), glm::vec3(0.0f));
+    single.materials[0].texture = 0;
+    single.updateWorldMatrices();
+    std::vector<uint32_t> lone(1, 0u);
+    std::vector<int8_t> loneLevels(1, -1);
+    TransparentPass pass;
+    pass.build(single, lone, camera, viewportHeight, loneLevels, ThreadPool::shared());
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; ++i) {
+        pass.build(single, lone, camera, viewportHeight, loneLevels, ThreadPool::shared());
+    }
+    std::printf("\nlone sphere: %u triangles sorted in %.3f ms\n", pass.getStats().sortedTriangles,
+                Timing::millisecondsSince(start) / passes);
+    return 0;
+}
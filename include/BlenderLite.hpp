@@ -6,7 +6,32 @@
 #include <GL/glut.h>
 #include "core/Constants.hpp"
 #include "core/ApplicationState.hpp"
+#include "core/Image.hpp"
+#include "math/Camera.hpp"
+#include "math/Frustum.hpp"
+#include "rendering/CommandExecutor.hpp"
+#include "rendering/GlState.hpp"
+#include "rendering/IconAtlas.hpp"
 #include "rendering/PrimitiveRenderer.hpp"
+#include "rendering/InstancedRenderer.hpp"
+#include "rendering/MeshCache.hpp"
+#include "rendering/OcclusionDebugView.hpp"
+#include "rendering/ShaderRenderer.hpp"
+#include "rendering/TextRenderer.hpp"
+#include "rendering/TransparentRenderer.hpp"
+#include "rendering/UiLayer.hpp"
+#include "rendering/UiRenderer.hpp"
+#include "rendering/ViewFramebuffers.hpp"
+#include "scene/CommandRecorder.hpp"
+#include "scene/LodSelector.hpp"
+#include "scene/SceneBvh.hpp"
+#include "scene/SceneEditor.hpp"
+#include "scene/SceneGenerator.hpp"
+#include "scene/ScenePicker.hpp"
+#include "scene/SceneView.hpp"
+#include "scene/ShapeMaterial.hpp"
+#include "scene/SoftwareRenderer.hpp"
 #include "ui/Panels.hpp"
+#include "ui/UiLayout.hpp"
 
 #endif
\ No newline at end of file
@@ -2,18 +2,16 @@
 #define APPLICATION_STATE_HPP
 
 #include "Constants.hpp"
+#include "CommandBuffer.hpp"
+#include "FrameStats.hpp"
+#include "ShapeType.hpp"
+#include "scene/Scene.hpp"
+#include "scene/OcclusionCuller.hpp"
+#include "scene/SceneBvh.hpp"
+#include "scene/ScenePicker.hpp"
+#include "scene/SceneView.hpp"
 #include <string>
 
-enum class ShapeType {
-    NONE,
-    CUBE,
-    SPHERE,
-    CONE,
-    CYLINDER,
-    TORUS,
-    PYRAMID
-};
-
 // New struct to track active text input field
 struct ActiveInputField {
     int panelType; // 0: Rotation, 1: Scaling, 2: Translation
@@ -37,17 +35,19 @@ struct ApplicationState {
     float leftPanelTexturesScroll = 0.0f;
 
     // Updated fields for axis button selection and dragging
-    bool axisHovered[3] = {false, false, false}; // X, Y, Z button hover states
     bool axisSelected[3] = {false, false, false}; // X, Y, Z selection states (can have multiple)
     bool draggingAxis = false; // True when dragging selected axes
     double dragStartX = 0.0, dragStartY = 0.0; // Drag start position
 
-    // New field to track mouse clicks for UI interactions
-    bool mouseClicked = false;
-
     // New field for text input
     ActiveInputField activeInputField;
 
+    // Every object on the canvas; the selected one is edited through the
+    // transform fields above and currentShape below
+    Scene scene;
+    ObjectHandle selectedObject;
+    ObjectHandle previousSelectedObject; // Parent target for the P shortcut
+
     // Shape selection
     ShapeType currentShape = ShapeType::NONE;
 
@@ -70,6 +70,63 @@ struct ApplicationState {
         {0.8f, 0.8f, 0.8f}, // Torus - light gray
         {0.8f, 0.8f, 0.8f}  // Pyramid - light gray
     };
+
+    // Tessellation level picked for the selected object (-1 until first drawn)
+    int lodLevel = -1;
+    float lodScreenRadius = 0.0f;
+
+    // Renderer statistics overlay (toggled with F3)
+    bool showStats = false;
+
+    // The main loop sleeps in glfwWaitEvents until input or a state change
+    // sets needsRedraw; continuousRedraw draws every frame for animation
+    // (toggled with F1). Either way it redraws at most
+    // Constants::UNFOCUSED_FRAME_RATE times a second while unfocused.
+    bool needsRedraw = true;
+    bool continuousRedraw = false;
+    bool windowFocused = true;
+
+    // Resident meshes use the packed 16-bit vertex format (toggled with F4)
+    bool compactVertices = false;
+
+    // Draw repeated primitives with one instanced call per batch (toggled with F6)
+    bool useInstancing = true;
+    FrameStats frameStats;
+
+    // Canvas views, each with its own culling output, sorted draws and the
+    // command buffers they were last recorded into (views[0]'s are saved to a
+    // file with F11). views[0] is the front view shown alone; quad view
+    // (toggled with F2) shows all four, redrawing only views whose inputs
+    // changed.
+    static constexpr int VIEW_COUNT = 4;
+    SceneView views[VIEW_COUNT];
+    bool quadView = false;
+    int hoverView = 0; // View the cursor pick ray was cast through
+
+    // Draw the scene with the core-profile shader renderer instead of the
+    // legacy fixed-function paths (toggled with F10)
+    bool useCoreRenderer = false;
+
+    // Benchmark scene size, cycled with F5
+    int benchmarkLevel = 0;
+
+    // View frustum culling through the scene BVH (toggled with F7)
+    bool frustumCulling = true;
+    SceneBvh sceneBvh;
+
+    // CPU occlusion culling after the frustum cull (toggled with F8), with
+    // its depth buffer shown as an inset on the canvas (F9)
+    bool occlusionCulling = true;
+    bool showOcclusionBuffer = false;
+    OcclusionCuller occlusionCuller;
+
+    // Save the next frame's scene from GL and from the software rasterizer
+    // side by side, for comparing the two (F12)
+    bool captureScene = false;
+
+    // Object and face under the cursor, ray-cast every frame
+    PickResult hoverPick;
+    double pickMicros = 0.0;
 };
 
 #endif
\ No newline at end of file
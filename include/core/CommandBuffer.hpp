@@ -0,0 +1,91 @@
+#ifndef COMMAND_BUFFER_HPP
+#define COMMAND_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+enum class CommandType : uint8_t {
+    BIND_MESH,       // Mesh key: shape (4 bits) | LOD level + 1 (4 bits), as in RenderQueue
+    BIND_TEXTURE,    // Texture index, -1 for untextured
+    SET_BLEND,       // Alpha blending on or off
+    SET_SCISSOR,     // Window pixels, origin at the bottom left
+    DISABLE_SCISSOR,
+    SET_MATRIX,      // UniformSlot and a 4x4 matrix
+    SET_VECTOR,      // UniformSlot and a 4-vector
+    DRAW,            // The bound mesh with the current uniforms
+    COUNT
+};
+
+enum class UniformSlot : uint8_t {
+    PROJECTION,
+    VIEW,
+    MODEL,
+    COLOR
+};
+
+// Backend-agnostic stream of rendering commands. Commands are packed into a
+// byte array, each a small header followed by its payload, and name
+// resources by key (mesh key, texture index) rather than by GL object, so a
+// buffer can be recorded on any thread, saved, and replayed or analyzed
+// offline. An executor for a specific API turns them into calls.
+class CommandBuffer {
+public:
+    struct Header {
+        CommandType type;
+        uint8_t slot;     // UniformSlot for SET_MATRIX and SET_VECTOR
+        uint16_t size;    // Payload bytes after the header
+    };
+
+    // Decoded view of one command; only the fields of its type are meaningful
+    struct Command {
+        CommandType type;
+        UniformSlot slot;
+        int32_t value[4];      // Mesh key, texture, blend flag, or scissor box
+        const float* floats;   // 16 matrix or 4 vector components, inside the buffer
+    };
+
+    struct Stats {
+        uint32_t counts[(int)CommandType::COUNT] = {};
+        size_t bytes = 0;
+    };
+
+    void clear() { bytes.clear(); commandCount = 0; }
+    bool empty() const { return commandCount == 0; }
+    size_t size() const { return commandCount; }
+    size_t byteSize() const { return bytes.size(); }
+
+    void bindMesh(uint32_t meshKey);
+    void bindTexture(int texture);
+    void setBlend(bool enabled);
+    void setScissor(int x, int y, int width, int height);
+    void disableScissor();
+    void setMatrix(UniformSlot slot, const glm::mat4& matrix);
+    void setVector(UniformSlot slot, const glm::vec4& vector);
+    void draw();
+
+    // Decodes the command at offset and advances offset past it; false at the
+    // end, or at a command whose payload runs past it
+    bool next(size_t& offset, Command& command) const;
+
+    Stats analyze() const;
+
+    // Host byte order; files are for replay on the same kind of machine.
+    // load checks every command's type and payload size before returning true.
+    static bool save(const std::string& path, const std::vector<CommandBuffer>& buffers);
+    static bool load(const std::string& path, std::vector<CommandBuffer>& buffers);
+
+    bool operator==(const CommandBuffer& other) const { return bytes == other.bytes; }
+
+private:
+    void push(CommandType type, uint8_t slot, const void* payload, uint16_t size);
+    // True when the bytes hold exactly commandCount well-formed commands
+    bool isWellFormed() const;
+
+    std::vector<unsigned char> bytes;
+    size_t commandCount = 0;
+};
+
+#endif
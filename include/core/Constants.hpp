@@ -8,9 +8,40 @@ namespace Constants {
     constexpr float RIGHT_BAR_WIDTH = 280.0f; // Changed from MIN_RIGHT_BAR_WIDTH to fixed width
     constexpr float MIN_WINDOW_WIDTH = 650.0f;
     constexpr float TOP_BAR_HEIGHT = 110.0f;
+    constexpr double UNFOCUSED_FRAME_RATE = 10.0; // Redraws per second at most while another window has focus
     constexpr double PI_DOUBLE = 3.14159265358979323846;
     constexpr float PI = static_cast<float>(PI_DOUBLE);
 
+    // Canvas camera
+    constexpr float CAMERA_FOV_DEGREES = 45.0f;
+    constexpr float CAMERA_NEAR = 0.1f;
+    constexpr float CAMERA_FAR = 100.0f;
+    constexpr float CAMERA_EYE[3] = {0.0f, 0.0f, 3.0f};
+
+    // Scene textures, indexed by ObjectMaterial::texture
+    constexpr const char* TEXTURE_FILES[] = {
+        "textures/texture1.png",
+        "textures/texture2.png",
+        "textures/texture3.png",
+        "textures/texture4.png",
+        "textures/texture5.png",
+        "textures/texture6.png"
+    };
+
+    // UI font, the first of these that loads; the bundled copy is copied next
+    // to the binary, system fonts are a fallback, GLUT bitmap text when none load
+    constexpr const char* FONT_FILES[] = {
+        "fonts/DejaVuSans.ttf",
+        "C:/Windows/Fonts/segoeui.ttf",
+        "C:/Windows/Fonts/arial.ttf",
+        "/System/Library/Fonts/Supplemental/Arial.ttf",
+        "/Library/Fonts/Arial.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",
+        "/usr/share/fonts/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf"
+    };
+
     // Color constants for the color buttons
     constexpr float COLOR_BLACK[3] = {0.0f, 0.0f, 0.0f};
     constexpr float COLOR_WHITE[3] = {1.0f, 1.0f, 1.0f};
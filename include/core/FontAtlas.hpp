@@ -0,0 +1,88 @@
+#ifndef FONT_ATLAS_HPP
+#define FONT_ATLAS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Printable ASCII glyphs of a TrueType font baked at a few pixel sizes into
+// one 8-bit coverage atlas with stb_truetype's rect packer, and strings laid
+// out as runs of glyph quads. Layouts are cached per size and string, so text
+// that does not change between frames costs one hash lookup.
+class FontAtlas {
+public:
+    static constexpr int FIRST_CHAR = 32;
+    static constexpr int CHAR_COUNT = 95;
+    // Cached layouts per size before that size's cache is dropped
+    static constexpr size_t LAYOUT_CACHE_MAX = 4096;
+
+    // Pixels from the pen's start on the baseline, y up; texture coordinates
+    // with v = 0 at the atlas's first row
+    struct GlyphQuad {
+        float x0, y0, x1, y1;
+        float u0, v0, u1, v1;
+    };
+
+    struct Layout {
+        std::vector<GlyphQuad> quads;
+        float width = 0.0f; // Advance of the whole string
+    };
+
+    struct Stats {
+        uint32_t layoutHits = 0;
+        uint32_t layoutMisses = 0;
+    };
+
+    static bool loadFile(const std::string& path, std::vector<uint8_t>& data);
+
+    // Bakes the glyphs with an em of pixelSizes[i] pixels for size i; false
+    // when the data is not a font stb_truetype reads
+    bool build(const std::vector<uint8_t>& fontData, const std::vector<float>& pixelSizes);
+    bool empty() const { return pixels.empty(); }
+
+    int sizeCount() const { return (int)sizes.size(); }
+    float pixelSize(int size) const { return sizes[size]; }
+    // Baked size with the nearest em
+    int sizeIndexFor(float pixelSize) const;
+    float ascent(int size) const { return ascents[size]; }
+    float descent(int size) const { return descents[size]; } // Negative, below the baseline
+
+    // Characters outside printable ASCII advance like a space
+    const Layout& layout(int size, const std::string& text);
+    float measure(int size, const std::string& text) { return layout(size, text).width; }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // Coverage, one byte per texel, first row first
+    const std::vector<uint8_t>& getPixels() const { return pixels; }
+
+    const Stats& getStats() const { return stats; }
+    void resetStats() { stats = Stats(); }
+    size_t cachedLayouts() const;
+
+private:
+    // Atlas rect in texels and its top-left offset from the pen, stb_truetype's y down
+    struct Glyph {
+        uint16_t x0, y0, x1, y1;
+        float xOffset, yOffset;
+        float advance;
+    };
+
+    const Glyph& glyph(int size, int character) const { return glyphs[size * CHAR_COUNT + character]; }
+
+    std::vector<uint8_t> pixels;
+    int width = 0;
+    int height = 0;
+    std::vector<float> sizes;
+    std::vector<float> ascents;
+    std::vector<float> descents;
+    std::vector<Glyph> glyphs;       // CHAR_COUNT per size
+    std::vector<int16_t> kerning;    // Font units per character pair, CHAR_COUNT * CHAR_COUNT
+    std::vector<float> scales;       // Font units to pixels per size
+    std::vector<std::unordered_map<std::string, Layout>> layouts; // Per size
+    Stats stats;
+};
+
+#endif
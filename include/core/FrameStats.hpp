@@ -0,0 +1,81 @@
+#ifndef FRAME_STATS_HPP
+#define FRAME_STATS_HPP
+
+#include <cstdint>
+
+// Per-frame renderer counters plus smoothed frame timings for the stats overlay
+struct FrameStats {
+    uint32_t drawCalls = 0;
+    uint32_t batches = 0;
+    uint32_t instances = 0;
+    uint32_t stateChanges = 0;          // Mesh, texture and blend changes issued
+    uint32_t unsortedStateChanges = 0;  // The same draws in scene order (render queue path only)
+
+    // Blended objects drawn back to front after the opaque ones
+    uint32_t transparentObjects = 0;
+    uint32_t sortedTriangles = 0;       // Triangles re-sorted for a lone transparent mesh
+    double transparentSortMs = 0.0;
+    uint32_t viewsDrawn = 0;            // Canvas views redrawn rather than shown from their last frame
+
+    // Last complete frame's state changes that reached GL and that the state cache dropped
+    uint32_t glCallsIssued = 0;
+    uint32_t glCallsElided = 0;
+
+    // Last complete frame's batched UI: geometry draws, GLUT bitmap strings
+    // (no font), atlas glyphs, text layouts not found in the cache, recorded
+    // primitives and the CPU time spent recording and flushing them
+    uint32_t uiDrawCalls = 0;
+    uint32_t uiTextStrings = 0;
+    uint32_t uiGlyphs = 0;
+    uint32_t uiLayoutsBuilt = 0;
+    uint32_t uiPrimitives = 0;
+    double uiMs = 0.0;
+    // UI layer regions redrawn and shown from their last drawing
+    uint32_t uiRegionsDrawn = 0;
+    uint32_t uiRegionsCached = 0;
+    // UI layout passes, and cursor hit tests with the widget rects they tested
+    uint32_t uiLayoutBuilds = 0;
+    uint32_t uiHitTests = 0;
+    uint32_t uiHitRectsTested = 0;
+
+    double frameMs = 0.0; // Time between frame starts
+    double cpuMs = 0.0;   // Frame start to buffer swap
+
+    // Frames actually drawn per second, over the last second or more; the
+    // main loop only redraws when something changed unless it runs continuously
+    double redrawsPerSecond = 0.0;
+    uint32_t redrawsCounted = 0;
+    double redrawCountStart = 0.0;
+
+    void resetCounters() {
+        drawCalls = 0;
+        batches = 0;
+        instances = 0;
+        stateChanges = 0;
+        unsortedStateChanges = 0;
+        transparentObjects = 0;
+        sortedTriangles = 0;
+        transparentSortMs = 0.0;
+        viewsDrawn = 0;
+    }
+
+    // Exponential moving average so the overlay stays readable
+    void recordFrame(double frameTimeMs, double cpuTimeMs) {
+        const double smoothing = 0.9;
+        frameMs = frameMs == 0.0 ? frameTimeMs : frameMs * smoothing + frameTimeMs * (1.0 - smoothing);
+        cpuMs = cpuMs == 0.0 ? cpuTimeMs : cpuMs * smoothing + cpuTimeMs * (1.0 - smoothing);
+    }
+
+    // Call once per frame drawn, with the time in seconds
+    void countRedraw(double now) {
+        redrawsCounted++;
+        double elapsed = now - redrawCountStart;
+        if (elapsed >= 1.0) {
+            redrawsPerSecond = redrawsCounted / elapsed;
+            redrawsCounted = 0;
+            redrawCountStart = now;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// RGBA8 pixels in memory order, rows as stored in the file (the first row is
+// the top of a PNG). Used for the scene textures outside of GL and for
+// images rendered headless.
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+
+    bool empty() const { return pixels.empty(); }
+
+    // Any format stb_image reads, expanded to four channels
+    static bool load(const std::string& path, Image& image);
+
+    // The patterned placeholder shown for a texture slot whose file failed to load
+    static Image fallbackTexture(int slot);
+
+    // flipRows writes the last row first, for images with row 0 at the bottom
+    bool savePng(const std::string& path, bool flipRows) const;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/ThreadPool.hpp"
+
+// Stable least-significant-digit radix sort of 64-bit keys, one byte per
+// pass. Bytes that are the same in every key are skipped, so keys with few
+// distinct high bits cost only the passes they need. Scratch buffers are kept
+// between calls to avoid per-frame allocation.
+class RadixSort {
+public:
+    // Sorts keys ascending
+    void sort(std::vector<uint64_t>& keys);
+
+    // Sorts keys ascending and applies the same permutation to values
+    void sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values);
+
+    // The same sort with the histograms and scatters of every pass split
+    // into contiguous chunks across the pool; each chunk scatters to offsets
+    // computed from all chunks' histograms, so the result is identical and
+    // still stable. Inputs below PARALLEL_MIN_KEYS sort on the calling thread.
+    void sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, ThreadPool& pool);
+
+    static constexpr size_t PARALLEL_MIN_KEYS = 32768;
+
+private:
+    static constexpr int RADIX = 256;
+    static constexpr int PASSES = 8;
+
+    // Histograms of every byte, from one read of the keys
+    void countDigits(const std::vector<uint64_t>& keys);
+
+    size_t counts[PASSES][RADIX];
+    std::vector<uint64_t> keyScratch;
+    std::vector<uint32_t> valueScratch;
+    std::vector<size_t> chunkCounts; // Parallel sort: per chunk, per pass, per digit
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef SHAPE_TYPE_HPP
+#define SHAPE_TYPE_HPP
+
+enum class ShapeType {
+    NONE,
+    CUBE,
+    SPHERE,
+    CONE,
+    CYLINDER,
+    TORUS,
+    PYRAMID
+};
+
+#endif
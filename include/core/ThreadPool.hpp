@@ -0,0 +1,51 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel passes. parallelFor hands out
+// indices from a shared atomic counter, so fast threads keep taking work from
+// slow ones, and the calling thread works too. Calls must not be nested.
+class ThreadPool {
+public:
+    // workerCount threads in addition to the caller; 0 runs everything inline
+    explicit ThreadPool(unsigned workerCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned threadCount() const { return (unsigned)workers.size() + 1; }
+
+    // Runs fn(index, thread) for every index in [0, count) and returns when all
+    // are done; thread is in [0, threadCount()) for per-thread scratch data
+    void parallelFor(size_t count, const std::function<void(size_t index, unsigned thread)>& fn);
+
+    // One worker per hardware thread beyond the caller's
+    static ThreadPool& shared();
+
+private:
+    void workerLoop(unsigned thread);
+    void runJob(unsigned thread);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+
+    const std::function<void(size_t, unsigned)>* job = nullptr;
+    size_t jobCount = 0;
+    std::atomic<size_t> nextIndex{0};
+    uint64_t generation = 0;
+    unsigned pendingWorkers = 0;
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef TIMING_HPP
+#define TIMING_HPP
+
+#include <chrono>
+
+namespace Timing {
+    // Milliseconds from start to now on the steady clock
+    inline double millisecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef HALF_EDGE_MESH_HPP
+#define HALF_EDGE_MESH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "geometry/MeshData.hpp"
+
+// Index-based half-edge structure for triangle meshes (a corner table).
+// Half-edge h belongs to face h / 3 and runs from corner h to corner next(h),
+// so next, prev and face are implicit; only origins and twins are stored.
+// Render vertices that share a position are welded into one topological
+// vertex, which closes the texture seams and poles of the generated primitives.
+// Face f is always triangle f of the source index buffer.
+class HalfEdgeMesh {
+public:
+    static constexpr int32_t INVALID = -1;
+
+    static HalfEdgeMesh fromMesh(const MeshData& mesh);
+
+    size_t vertexCount() const { return positions.size(); }
+    size_t faceCount() const { return halfEdgeOrigin.size() / 3; }
+    size_t halfEdgeCount() const { return halfEdgeOrigin.size(); }
+
+    // Half-edge navigation, all O(1)
+    static int32_t next(int32_t h) { return (h % 3 == 2) ? h - 2 : h + 1; }
+    static int32_t prev(int32_t h) { return (h % 3 == 0) ? h + 2 : h - 1; }
+    static int32_t face(int32_t h) { return h / 3; }
+    static int32_t faceHalfEdge(int32_t f) { return f * 3; }
+    int32_t twin(int32_t h) const { return halfEdgeTwin[h]; }
+    uint32_t origin(int32_t h) const { return halfEdgeOrigin[h]; }
+    uint32_t target(int32_t h) const { return halfEdgeOrigin[next(h)]; }
+    bool isBoundary(int32_t h) const { return halfEdgeTwin[h] == INVALID; }
+
+    // One outgoing half-edge; on the boundary it is the one without a twin
+    int32_t vertexHalfEdge(uint32_t v) const { return vertexOutgoing[v]; }
+    bool isBoundaryVertex(uint32_t v) const;
+
+    // Faces across the three edges of f (INVALID across boundary edges)
+    void faceNeighbors(int32_t f, int32_t out[3]) const;
+
+    // Visits every outgoing half-edge of v in fan order. O(valence).
+    template <typename Fn>
+    void forEachOutgoing(uint32_t v, Fn fn) const {
+        int32_t start = vertexOutgoing[v];
+        if (start == INVALID) return;
+        int32_t h = start;
+        do {
+            fn(h);
+            int32_t incoming = halfEdgeTwin[prev(h)];
+            if (incoming == INVALID) return;
+            h = incoming;
+        } while (h != start);
+    }
+
+    // Neighboring vertices of v, including the last one on an open fan
+    template <typename Fn>
+    void forEachOneRing(uint32_t v, Fn fn) const {
+        int32_t last = INVALID;
+        forEachOutgoing(v, [&](int32_t h) {
+            fn(target(h));
+            last = h;
+        });
+        if (last != INVALID && halfEdgeTwin[prev(last)] == INVALID) {
+            fn(origin(prev(last)));
+        }
+    }
+
+    void oneRing(uint32_t v, std::vector<uint32_t>& out) const;
+
+    const std::vector<int32_t>& boundaryHalfEdges() const { return boundary; }
+
+    const glm::vec3& position(uint32_t v) const { return positions[v]; }
+    uint32_t renderVertex(int32_t h) const { return renderCorners[h]; }
+    glm::vec3 faceNormal(int32_t f) const;
+    glm::vec3 faceCentroid(int32_t f) const;
+
+    size_t byteSize() const;
+
+private:
+    std::vector<glm::vec3> positions;     // Welded vertex positions
+    std::vector<uint32_t> halfEdgeOrigin; // Welded vertex per corner
+    std::vector<int32_t> halfEdgeTwin;
+    std::vector<int32_t> vertexOutgoing;
+    std::vector<uint32_t> renderCorners;  // Source index buffer, for attribute lookups
+    std::vector<int32_t> boundary;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef MESH_BVH_HPP
+#define MESH_BVH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "geometry/MeshData.hpp"
+#include "math/Camera.hpp"
+
+// Nearest ray hit on a triangle: the hit point is
+// (1 - u - v) * corner0 + u * corner1 + v * corner2
+struct TriangleHit {
+    float distance = 0.0f; // In units of the ray direction
+    uint32_t face = 0;     // Triangle index into the source mesh's index list
+    float u = 0.0f;
+    float v = 0.0f;
+};
+
+// Eight-wide BVH over the triangles of one mesh, for ray casts. Leaves are
+// packets of up to eight triangles stored as structure-of-arrays lanes
+// (first corner plus both edges) so the ray/triangle test runs on all eight
+// at once.
+class MeshBvh {
+public:
+    static constexpr int WIDTH = 8;
+
+    static MeshBvh build(const MeshData& mesh);
+
+    // Closest hit with distance in [0, maxDistance), double-sided
+    bool intersect(const Ray& ray, float maxDistance, TriangleHit& hit) const;
+
+    void triangle(uint32_t face, glm::vec3& a, glm::vec3& b, glm::vec3& c) const;
+    const std::vector<glm::vec3>& getPositions() const { return positions; }
+    const std::vector<uint32_t>& getIndices() const { return indices; }
+    size_t triangleCount() const { return indices.size() / 3; }
+    size_t nodeCount() const { return nodes.size(); }
+    size_t byteSize() const;
+
+private:
+    static constexpr uint32_t EMPTY = 0xffffffffu;
+    static constexpr uint32_t LEAF_BIT = 0x80000000u; // Lane holds a packet, not a node
+
+    struct alignas(32) Node {
+        float minX[WIDTH], minY[WIDTH], minZ[WIDTH];
+        float maxX[WIDTH], maxY[WIDTH], maxZ[WIDTH];
+        uint32_t child[WIDTH];
+    };
+
+    struct alignas(32) Packet {
+        float v0x[WIDTH], v0y[WIDTH], v0z[WIDTH];
+        float e1x[WIDTH], e1y[WIDTH], e1z[WIDTH];
+        float e2x[WIDTH], e2y[WIDTH], e2z[WIDTH];
+        uint32_t face[WIDTH];
+    };
+
+    struct BuildItem {
+        glm::vec3 centroid;
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        uint32_t face;
+    };
+
+    uint32_t buildNode(std::vector<BuildItem>& items, uint32_t begin, uint32_t end);
+    uint32_t buildPacket(const std::vector<BuildItem>& items, uint32_t begin, uint32_t end);
+    bool intersectPacket(const Packet& packet, const Ray& ray, float maxDistance, TriangleHit& hit) const;
+
+    std::vector<Node> nodes;
+    std::vector<Packet> packets;
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef MESH_DATA_HPP
+#define MESH_DATA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Interleaved vertex layout shared by every generated primitive
+struct Vertex {
+    float position[3];
+    float normal[3];
+    float texCoord[2];
+};
+
+// CPU-side triangle list with 32-bit indices
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+
+    size_t triangleCount() const { return indices.size() / 3; }
+    size_t byteSize() const {
+        return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t);
+    }
+};
+
+#endif
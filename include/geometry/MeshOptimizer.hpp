@@ -0,0 +1,53 @@
+#ifndef MESH_OPTIMIZER_HPP
+#define MESH_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "geometry/MeshData.hpp"
+
+// Post-process for any indexed triangle mesh, generated or imported:
+// welds duplicate vertices, reorders triangles for the post-transform vertex
+// cache (Forsyth), optionally sorts triangle clusters to reduce overdraw, and
+// finally lays vertices out in first-use order for fetch locality.
+class MeshOptimizer {
+public:
+    static constexpr int ANALYSIS_CACHE_SIZE = 16; // FIFO used for ACMR/ATVR
+    static constexpr int FORSYTH_CACHE_SIZE = 32;  // LRU modelled while reordering
+
+    struct Options {
+        bool weld = true;
+        bool vertexCache = true;
+        bool overdraw = false;
+        float overdrawThreshold = 1.05f; // Max ACMR growth accepted for overdraw ordering
+    };
+
+    struct CacheStats {
+        float acmr = 0.0f; // Transformed vertices per triangle (0.5 ideal, 3 worst)
+        float atvr = 0.0f; // Transformed vertices per referenced vertex (1 ideal)
+    };
+
+    struct Report {
+        size_t verticesBefore = 0;
+        size_t verticesAfter = 0;
+        CacheStats before;
+        CacheStats after;
+        bool overdrawApplied = false;
+    };
+
+    static Report optimize(MeshData& mesh);
+    static Report optimize(MeshData& mesh, const Options& options);
+
+    static CacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                         int cacheSize = ANALYSIS_CACHE_SIZE);
+
+    // Merges vertices whose attributes are bit-identical and remaps the indices
+    static void weldVertices(MeshData& mesh);
+    static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+    // Returns false (leaving indices untouched) if the cache cost exceeds the threshold
+    static bool optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+                                 float threshold);
+    static void optimizeVertexFetch(MeshData& mesh);
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef PRIMITIVE_GENERATOR_HPP
+#define PRIMITIVE_GENERATOR_HPP
+
+#include <cstddef>
+#include "core/ShapeType.hpp"
+#include "geometry/HalfEdgeMesh.hpp"
+#include "geometry/MeshData.hpp"
+
+// Everything needed to regenerate a primitive. Two equal parameter sets always
+// produce identical meshes, so this doubles as the mesh cache key.
+struct PrimitiveParams {
+    ShapeType shape = ShapeType::NONE;
+    float radius = 0.0f; // Cube edge, sphere/cone/cylinder radius, torus major radius, pyramid base
+    float height = 0.0f; // Cone/cylinder/pyramid height, torus minor radius
+    int slices = 0;
+    int stacks = 0;      // Sphere stacks, torus minor slices
+
+    bool operator==(const PrimitiveParams& other) const {
+        return shape == other.shape && radius == other.radius && height == other.height &&
+               slices == other.slices && stacks == other.stacks;
+    }
+    bool operator!=(const PrimitiveParams& other) const { return !(*this == other); }
+
+    // Parameters the canvas has always drawn each shape with
+    static PrimitiveParams defaultsFor(ShapeType shape);
+};
+
+struct PrimitiveParamsHash {
+    size_t operator()(const PrimitiveParams& params) const;
+};
+
+// Builds indexed triangle meshes (CCW, outward facing) for every ShapeType
+class PrimitiveGenerator {
+public:
+    static MeshData generate(const PrimitiveParams& params);
+    // Welded half-edge topology; face i is triangle i of generate(params)
+    static HalfEdgeMesh generateTopology(const PrimitiveParams& params);
+
+    static MeshData generateCube(float size);
+    static MeshData generateSphere(float radius, int slices, int stacks);
+    static MeshData generateCone(float base, float height, int slices);
+    static MeshData generateCylinder(float radius, float height, int slices);
+    static MeshData generateTorus(float majorRadius, float minorRadius, int majorSlices, int minorSlices);
+    static MeshData generatePyramid(float base, float height);
+};
+
+#endif
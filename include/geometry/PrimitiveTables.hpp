@@ -0,0 +1,89 @@
+#ifndef PRIMITIVE_TABLES_HPP
+#define PRIMITIVE_TABLES_HPP
+
+#include <cstdint>
+#include "geometry/MeshData.hpp"
+
+// Fixed unit-size data for the flat-sided primitives. Corner order and texture
+// coordinates match the original immediate-mode drawing code.
+namespace PrimitiveTables {
+    constexpr Vertex CUBE_VERTICES[24] = {
+        // Front
+        {{-0.5f, -0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 1.0f}},
+        {{-0.5f,  0.5f,  0.5f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 1.0f}},
+        // Back
+        {{-0.5f, -0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 0.0f}},
+        {{-0.5f,  0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, { 0.0f,  0.0f, -1.0f}, {0.0f, 0.0f}},
+        // Top
+        {{-0.5f,  0.5f, -0.5f}, { 0.0f,  1.0f,  0.0f}, {0.0f, 1.0f}},
+        {{-0.5f,  0.5f,  0.5f}, { 0.0f,  1.0f,  0.0f}, {0.0f, 0.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, { 0.0f,  1.0f,  0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, { 0.0f,  1.0f,  0.0f}, {1.0f, 1.0f}},
+        // Bottom
+        {{-0.5f, -0.5f, -0.5f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, { 0.0f, -1.0f,  0.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, { 0.0f, -1.0f,  0.0f}, {0.0f, 0.0f}},
+        {{-0.5f, -0.5f,  0.5f}, { 0.0f, -1.0f,  0.0f}, {1.0f, 0.0f}},
+        // Right
+        {{ 0.5f, -0.5f, -0.5f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f,  0.5f, -0.5f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 1.0f}},
+        {{ 0.5f,  0.5f,  0.5f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 1.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 0.0f}},
+        // Left
+        {{-0.5f, -0.5f, -0.5f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 0.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 0.0f}},
+        {{-0.5f,  0.5f,  0.5f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 1.0f}},
+        {{-0.5f,  0.5f, -0.5f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 1.0f}}
+    };
+
+    constexpr uint32_t CUBE_INDICES[36] = {
+         0,  1,  2,  0,  2,  3,
+         4,  5,  6,  4,  6,  7,
+         8,  9, 10,  8, 10, 11,
+        12, 13, 14, 12, 14, 15,
+        16, 17, 18, 16, 18, 19,
+        20, 21, 22, 20, 22, 23
+    };
+
+    // Side normals of a pyramid with unit base and unit height: (0, 1, 2) / sqrt(5)
+    constexpr float PYRAMID_NY = 0.4472136f;
+    constexpr float PYRAMID_NH = 0.8944272f;
+
+    constexpr Vertex PYRAMID_VERTICES[16] = {
+        // Base
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {1.0f, 1.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f}},
+        // Front
+        {{ 0.0f,  0.5f,  0.0f}, {0.0f, PYRAMID_NY, PYRAMID_NH}, {0.5f, 1.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {0.0f, PYRAMID_NY, PYRAMID_NH}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {0.0f, PYRAMID_NY, PYRAMID_NH}, {1.0f, 0.0f}},
+        // Right
+        {{ 0.0f,  0.5f,  0.0f}, {PYRAMID_NH, PYRAMID_NY, 0.0f}, {0.5f, 1.0f}},
+        {{ 0.5f, -0.5f,  0.5f}, {PYRAMID_NH, PYRAMID_NY, 0.0f}, {0.0f, 0.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {PYRAMID_NH, PYRAMID_NY, 0.0f}, {1.0f, 0.0f}},
+        // Back
+        {{ 0.0f,  0.5f,  0.0f}, {0.0f, PYRAMID_NY, -PYRAMID_NH}, {0.5f, 1.0f}},
+        {{ 0.5f, -0.5f, -0.5f}, {0.0f, PYRAMID_NY, -PYRAMID_NH}, {0.0f, 0.0f}},
+        {{-0.5f, -0.5f, -0.5f}, {0.0f, PYRAMID_NY, -PYRAMID_NH}, {1.0f, 0.0f}},
+        // Left
+        {{ 0.0f,  0.5f,  0.0f}, {-PYRAMID_NH, PYRAMID_NY, 0.0f}, {0.5f, 1.0f}},
+        {{-0.5f, -0.5f, -0.5f}, {-PYRAMID_NH, PYRAMID_NY, 0.0f}, {0.0f, 0.0f}},
+        {{-0.5f, -0.5f,  0.5f}, {-PYRAMID_NH, PYRAMID_NY, 0.0f}, {1.0f, 0.0f}}
+    };
+
+    constexpr uint32_t PYRAMID_INDICES[18] = {
+        0, 1, 2, 0, 2, 3,
+        4, 5, 6,
+        7, 8, 9,
+        10, 11, 12,
+        13, 14, 15
+    };
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef TESSELLATOR_HPP
+#define TESSELLATOR_HPP
+
+#include <cstdint>
+#include <vector>
+#include "geometry/MeshData.hpp"
+
+// Precomputed cos/sin for segments + 1 evenly spaced angles. The last entry
+// repeats the first angle so seams can carry their own texture coordinate.
+struct RingTable {
+    int segments = 0;
+    bool halfTurn = false; // Angles span [0, PI] instead of [0, 2 PI]
+    std::vector<float> cos;
+    std::vector<float> sin;
+    std::vector<float> u;  // i / segments
+};
+
+// Shared tessellation kernels for the curved primitives. Ring tables are built
+// once per segment count; vertices are emitted eight floats at a time, one
+// Vertex per SIMD multiply-add: out = lane * scale + offset.
+class Tessellator {
+public:
+    static const RingTable& ring(int segments, bool halfTurn = false);
+
+    static void emitRow(Vertex* out, const Vertex* lanes, const Vertex& scale, const Vertex& offset, int count);
+
+    // Two triangles per cell of a rows x cols vertex grid laid out row-major.
+    // The first row's upper triangles and the last row's lower triangles can be
+    // skipped where a row collapses into a pole.
+    static void appendGridIndices(std::vector<uint32_t>& indices, uint32_t base, int rows, int cols,
+                                  bool skipFirstRowTop = false, bool skipLastRowBottom = false);
+
+    // Triangle fan from center over ring[0..count), wound towards +y or -y
+    static void appendFanIndices(std::vector<uint32_t>& indices, uint32_t center, uint32_t ring, int count,
+                                 bool facingUp);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef VERTEX_QUANTIZER_HPP
+#define VERTEX_QUANTIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "geometry/MeshData.hpp"
+
+// 16-byte vertex: positions as signed 16-bit fractions of the mesh AABB,
+// octahedral normals in two signed 16-bit components, UVs as unsigned 16-bit
+// fractions of the UV bounds. All fields are normalized integers so the GPU
+// can fetch them directly and decode in the vertex shader.
+struct PackedVertex {
+    int16_t position[4]; // xyz, w unused (keeps the normal 4-byte aligned)
+    int16_t normal[2];
+    uint16_t texCoord[2];
+};
+
+// Packed mesh plus the constants needed to decode it. Indices drop to 16 bits
+// whenever the vertex count allows.
+struct QuantizedMesh {
+    std::vector<PackedVertex> vertices;
+    std::vector<uint16_t> shortIndices;
+    std::vector<uint32_t> indices;
+
+    glm::vec3 center = glm::vec3(0.0f);
+    glm::vec3 halfExtent = glm::vec3(1.0f);
+    glm::vec2 uvMin = glm::vec2(0.0f);
+    glm::vec2 uvExtent = glm::vec2(1.0f);
+
+    bool usesShortIndices() const { return !shortIndices.empty(); }
+    size_t indexCount() const { return usesShortIndices() ? shortIndices.size() : indices.size(); }
+    size_t byteSize() const {
+        return vertices.size() * sizeof(PackedVertex) + shortIndices.size() * sizeof(uint16_t) +
+               indices.size() * sizeof(uint32_t);
+    }
+};
+
+// Worst-case error of a quantized mesh: the analytic bound of the format and
+// the maximum actually measured against the float source
+struct QuantizationReport {
+    float positionErrorBound = 0.0f;   // World units
+    float maxPositionError = 0.0f;
+    float maxNormalErrorDegrees = 0.0f;
+    float uvErrorBound = 0.0f;
+    float maxUvError = 0.0f;
+    size_t floatBytes = 0;
+    size_t packedBytes = 0;
+};
+
+class VertexQuantizer {
+public:
+    static QuantizedMesh quantize(const MeshData& mesh);
+    static QuantizationReport measure(const MeshData& source, const QuantizedMesh& packed);
+
+    // CPU mirrors of the shader decode, used for measuring and for CPU-side consumers
+    static glm::vec3 decodePosition(const QuantizedMesh& mesh, const PackedVertex& vertex);
+    static glm::vec3 decodeNormal(const PackedVertex& vertex);
+    static glm::vec2 decodeTexCoord(const QuantizedMesh& mesh, const PackedVertex& vertex);
+
+    static void encodeOctahedral(const glm::vec3& normal, int16_t out[2]);
+    static glm::vec3 decodeOctahedral(const int16_t encoded[2]);
+};
+
+#endif
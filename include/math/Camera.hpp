@@ -0,0 +1,44 @@
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+#include <glm/glm.hpp>
+
+// Half-line origin + t * direction; direction need not be normalized
+struct Ray {
+    glm::vec3 origin = glm::vec3(0.0f);
+    glm::vec3 direction = glm::vec3(0.0f, 0.0f, -1.0f);
+};
+
+// Perspective camera described the same way the canvas always set it up by hand
+struct Camera {
+    glm::vec3 eye = glm::vec3(0.0f, 0.0f, 3.0f);
+    glm::vec3 center = glm::vec3(0.0f);
+    glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);
+    float fovY = glm::radians(45.0f);
+    float aspect = 1.0f;
+    float nearPlane = 0.1f;
+    float farPlane = 100.0f;
+
+    glm::mat4 projection() const;
+    glm::mat4 view() const;
+    glm::mat4 viewProjection() const { return projection() * view(); }
+
+    // World-space ray from the near plane through a point in normalized device
+    // coordinates, with a unit direction so hit distances are in world units
+    Ray rayThroughNdc(float ndcX, float ndcY) const;
+
+    // Eye at CAMERA_EYE looking at the origin, as drawn on the 3D canvas
+    static Camera canvasDefault();
+};
+
+namespace TransformMath {
+    // translate * scale * rotateX * rotateY * rotateZ, matching the order of the
+    // glTranslatef / glScalef / glRotatef calls the canvas used to issue
+    glm::mat4 modelMatrix(const float translate[3], const float scale[3], const float rotateDegrees[3]);
+    // Same matrix in closed form, for passes over many objects
+    glm::mat4 modelMatrix(const glm::vec3& translate, const glm::vec3& scale, const glm::vec3& rotateDegrees);
+
+    float maxAxisScale(const float scale[3]);
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef FLOAT8_HPP
+#define FLOAT8_HPP
+
+#include <glm/simd/platform.h>
+#include <cstdint>
+
+// Eight float lanes for the BVH and ray kernels: one AVX register, two SSE
+// registers, or a plain array on other targets. Loads and stores expect
+// 32-byte aligned data. Comparisons return all-ones lanes for true, which is
+// what select(mask, a, b) expects.
+struct Float8 {
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+    __m256 v;
+
+    static Float8 load(const float* p) { return {_mm256_load_ps(p)}; }
+    static Float8 broadcast(float x) { return {_mm256_set1_ps(x)}; }
+    void store(float* p) const { _mm256_store_ps(p, v); }
+    uint32_t mask() const { return (uint32_t)_mm256_movemask_ps(v); }
+
+    friend Float8 operator+(Float8 a, Float8 b) { return {_mm256_add_ps(a.v, b.v)}; }
+    friend Float8 operator-(Float8 a, Float8 b) { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend Float8 operator*(Float8 a, Float8 b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend Float8 operator/(Float8 a, Float8 b) { return {_mm256_div_ps(a.v, b.v)}; }
+    friend Float8 operator&(Float8 a, Float8 b) { return {_mm256_and_ps(a.v, b.v)}; }
+    friend Float8 operator|(Float8 a, Float8 b) { return {_mm256_or_ps(a.v, b.v)}; }
+    friend Float8 operator<(Float8 a, Float8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+    friend Float8 operator<=(Float8 a, Float8 b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+    friend Float8 min(Float8 a, Float8 b) { return {_mm256_min_ps(a.v, b.v)}; }
+    friend Float8 max(Float8 a, Float8 b) { return {_mm256_max_ps(a.v, b.v)}; }
+    friend Float8 select(Float8 mask, Float8 a, Float8 b) { return {_mm256_blendv_ps(b.v, a.v, mask.v)}; }
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+    __m128 lo, hi;
+
+    static Float8 load(const float* p) { return {_mm_load_ps(p), _mm_load_ps(p + 4)}; }
+    static Float8 broadcast(float x) { return {_mm_set1_ps(x), _mm_set1_ps(x)}; }
+    void store(float* p) const { _mm_store_ps(p, lo); _mm_store_ps(p + 4, hi); }
+    uint32_t mask() const { return (uint32_t)_mm_movemask_ps(lo) | ((uint32_t)_mm_movemask_ps(hi) << 4); }
+
+    friend Float8 operator+(Float8 a, Float8 b) { return {_mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi)}; }
+    friend Float8 operator-(Float8 a, Float8 b) { return {_mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi)}; }
+    friend Float8 operator*(Float8 a, Float8 b) { return {_mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi)}; }
+    friend Float8 operator/(Float8 a, Float8 b) { return {_mm_div_ps(a.lo, b.lo), _mm_div_ps(a.hi, b.hi)}; }
+    friend Float8 operator&(Float8 a, Float8 b) { return {_mm_and_ps(a.lo, b.lo), _mm_and_ps(a.hi, b.hi)}; }
+    friend Float8 operator|(Float8 a, Float8 b) { return {_mm_or_ps(a.lo, b.lo), _mm_or_ps(a.hi, b.hi)}; }
+    friend Float8 operator<(Float8 a, Float8 b) { return {_mm_cmplt_ps(a.lo, b.lo), _mm_cmplt_ps(a.hi, b.hi)}; }
+    friend Float8 operator<=(Float8 a, Float8 b) { return {_mm_cmple_ps(a.lo, b.lo), _mm_cmple_ps(a.hi, b.hi)}; }
+    friend Float8 min(Float8 a, Float8 b) { return {_mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi)}; }
+    friend Float8 max(Float8 a, Float8 b) { return {_mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi)}; }
+    friend Float8 select(Float8 mask, Float8 a, Float8 b) {
+        return {_mm_or_ps(_mm_and_ps(mask.lo, a.lo), _mm_andnot_ps(mask.lo, b.lo)),
+                _mm_or_ps(_mm_and_ps(mask.hi, a.hi), _mm_andnot_ps(mask.hi, b.hi))};
+    }
+#else
+    float v[8];
+
+    template <typename Fn>
+    static Float8 apply(Float8 a, Float8 b, Fn fn) {
+        Float8 r;
+        for (int i = 0; i < 8; ++i) r.v[i] = fn(a.v[i], b.v[i]);
+        return r;
+    }
+    // Comparison lanes hold 1.0f for true; mask() and & only look at nonzero
+    static float truth(bool b) { return b ? 1.0f : 0.0f; }
+
+    static Float8 load(const float* p) { Float8 r; for (int i = 0; i < 8; ++i) r.v[i] = p[i]; return r; }
+    static Float8 broadcast(float x) { Float8 r; for (int i = 0; i < 8; ++i) r.v[i] = x; return r; }
+    void store(float* p) const { for (int i = 0; i < 8; ++i) p[i] = v[i]; }
+    uint32_t mask() const { uint32_t m = 0; for (int i = 0; i < 8; ++i) m |= (uint32_t)(v[i] != 0.0f) << i; return m; }
+
+    friend Float8 operator+(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return x + y; }); }
+    friend Float8 operator-(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return x - y; }); }
+    friend Float8 operator*(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return x * y; }); }
+    friend Float8 operator/(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return x / y; }); }
+    friend Float8 operator&(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return truth(x != 0.0f && y != 0.0f); }); }
+    friend Float8 operator|(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return truth(x != 0.0f || y != 0.0f); }); }
+    friend Float8 operator<(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return truth(x < y); }); }
+    friend Float8 operator<=(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return truth(x <= y); }); }
+    friend Float8 min(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return x < y ? x : y; }); }
+    friend Float8 max(Float8 a, Float8 b) { return apply(a, b, [](float x, float y) { return x > y ? x : y; }); }
+    friend Float8 select(Float8 mask, Float8 a, Float8 b) {
+        Float8 r;
+        for (int i = 0; i < 8; ++i) r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+        return r;
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef FRUSTUM_HPP
+#define FRUSTUM_HPP
+
+#include <glm/glm.hpp>
+
+// Six clip planes (left, right, bottom, top, near, far) with inward-facing
+// unit normals: a point p is inside plane i when dot(xyz, p) + w >= 0.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    // Planes of a combined projection * view matrix, in world space
+    static Frustum fromMatrix(const glm::mat4& viewProjection);
+
+    // Conservative: boxes straddling a plane corner may be reported as visible
+    bool intersectsAabb(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+};
+
+#endif
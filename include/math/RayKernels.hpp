@@ -0,0 +1,47 @@
+#ifndef RAY_KERNELS_HPP
+#define RAY_KERNELS_HPP
+
+#include <cmath>
+#include <cstdint>
+#include "math/Camera.hpp"
+#include "math/Float8.hpp"
+
+// A ray broadcast across eight lanes, with a reciprocal direction that stays
+// finite for axis-parallel rays so slab tests never compute 0 * inf
+struct RayLanes {
+    Float8 origin[3];
+    Float8 inverseDirection[3];
+
+    explicit RayLanes(const Ray& ray) {
+        const float tiny = 1e-20f;
+        for (int axis = 0; axis < 3; ++axis) {
+            float direction = ray.direction[axis];
+            if (std::fabs(direction) < tiny) {
+                direction = direction < 0.0f ? -tiny : tiny;
+            }
+            origin[axis] = Float8::broadcast(ray.origin[axis]);
+            inverseDirection[axis] = Float8::broadcast(1.0f / direction);
+        }
+    }
+};
+
+// Slab test of one ray against eight boxes stored as lanes. Returns the lanes
+// hit within [0, maxDistance] and writes each lane's entry distance to the
+// 32-byte aligned entry array.
+inline uint32_t intersectRayBoxes(const float* minX, const float* minY, const float* minZ,
+                                  const float* maxX, const float* maxY, const float* maxZ,
+                                  const RayLanes& ray, float maxDistance, float* entry) {
+    Float8 x1 = (Float8::load(minX) - ray.origin[0]) * ray.inverseDirection[0];
+    Float8 x2 = (Float8::load(maxX) - ray.origin[0]) * ray.inverseDirection[0];
+    Float8 y1 = (Float8::load(minY) - ray.origin[1]) * ray.inverseDirection[1];
+    Float8 y2 = (Float8::load(maxY) - ray.origin[1]) * ray.inverseDirection[1];
+    Float8 z1 = (Float8::load(minZ) - ray.origin[2]) * ray.inverseDirection[2];
+    Float8 z2 = (Float8::load(maxZ) - ray.origin[2]) * ray.inverseDirection[2];
+
+    Float8 near = max(max(min(x1, x2), min(y1, y2)), max(min(z1, z2), Float8::broadcast(0.0f)));
+    Float8 far = min(min(max(x1, x2), max(y1, y2)), min(max(z1, z2), Float8::broadcast(maxDistance)));
+    near.store(entry);
+    return (near <= far).mask();
+}
+
+#endif
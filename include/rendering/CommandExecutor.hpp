@@ -0,0 +1,39 @@
+#ifndef COMMAND_EXECUTOR_HPP
+#define COMMAND_EXECUTOR_HPP
+
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "core/CommandBuffer.hpp"
+#include "core/FrameStats.hpp"
+
+struct GpuMesh;
+
+// Replays command buffers through the fixed-function path, in order. The
+// MODEL matrix is combined with the last VIEW into the modelview matrix,
+// COLOR is the material color (drawn white while a texture is bound), and
+// mesh, texture and blend commands only count as state changes when they
+// change what is bound. GL state is left as it was found apart from the
+// modelview and projection matrices, which the caller saves.
+class CommandExecutor {
+public:
+    static void execute(const std::vector<CommandBuffer>& buffers, FrameStats& stats);
+
+private:
+    struct State {
+        glm::mat4 view = glm::mat4(1.0f);
+        glm::vec4 color = glm::vec4(1.0f);
+        const GpuMesh* mesh = nullptr;
+        uint32_t meshKey = 0;
+        int texture = -1;
+        bool textureSet = false;
+        bool textured = false;
+        bool blending = false;
+        bool blendSet = false;
+        bool started = false;   // Any state touched that must be reset afterwards
+    };
+
+    static void execute(const CommandBuffer::Command& command, State& state, FrameStats& stats);
+};
+
+#endif
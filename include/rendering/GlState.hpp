@@ -0,0 +1,82 @@
+#ifndef GL_STATE_HPP
+#define GL_STATE_HPP
+
+#include <glad/glad.h>
+#include <cstdint>
+
+// Shadow of the GL state the renderer changes most often. Rendering code sets
+// state through here instead of calling GL directly; a change that matches
+// the shadowed value is dropped. State starts unknown, so the first change of
+// each kind always reaches GL, and invalidate() forgets everything after code
+// that may have changed state behind the cache's back (e.g. object deletion).
+class GlState {
+public:
+    struct Counters {
+        uint32_t issued = 0;
+        uint32_t elided = 0;
+    };
+
+    static void enable(GLenum capability);
+    static void disable(GLenum capability);
+    static void setEnabled(GLenum capability, bool enabled);
+    // Answers from the shadow when known, so callers avoid a glIsEnabled round trip
+    static bool isEnabled(GLenum capability);
+
+    static void bindTexture(GLuint texture); // GL_TEXTURE_2D on the active unit
+    static void blendFunc(GLenum source, GLenum destination);
+    static void blendFuncSeparate(GLenum source, GLenum destination, GLenum sourceAlpha, GLenum destinationAlpha);
+    static void scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+    static void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    static void useProgram(GLuint program);
+    static void bindVertexArray(GLuint vao);
+    static void matrixMode(GLenum mode);
+
+    static void invalidate();
+
+    // Calls issued and elided since the last reset, reset once per frame
+    static const Counters& getCounters() { return counters; }
+    static void resetCounters() { counters = Counters(); }
+
+private:
+    enum Capability {
+        CAP_TEXTURE_2D,
+        CAP_BLEND,
+        CAP_DEPTH_TEST,
+        CAP_SCISSOR_TEST,
+        CAP_CULL_FACE,
+        CAP_COUNT
+    };
+
+    // Shadowed values other than the enables, each valid or unknown on its own
+    enum Value {
+        VAL_TEXTURE,
+        VAL_BLEND_FUNC,
+        VAL_SCISSOR,
+        VAL_VIEWPORT,
+        VAL_PROGRAM,
+        VAL_VERTEX_ARRAY,
+        VAL_MATRIX_MODE,
+        VAL_COUNT
+    };
+
+    // Slot of a shadowed capability, -1 for the rest (always issued)
+    static int capabilitySlot(GLenum capability);
+    // Counts the call and returns whether it must reach GL, marking the value known
+    static bool changed(Value value, bool differs);
+
+    static Counters counters;
+    static int8_t enabled[CAP_COUNT]; // 1, 0, or -1 when unknown
+    static bool known[VAL_COUNT];
+    static GLuint texture;
+    static GLenum blendSource;
+    static GLenum blendDestination;
+    static GLenum blendSourceAlpha;
+    static GLenum blendDestinationAlpha;
+    static GLint scissorBox[4];
+    static GLint viewportBox[4];
+    static GLuint program;
+    static GLuint vertexArray;
+    static GLenum matrix;
+};
+
+#endif
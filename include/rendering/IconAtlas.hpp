@@ -0,0 +1,35 @@
+#ifndef ICON_ATLAS_HPP
+#define ICON_ATLAS_HPP
+
+#include <glad/glad.h>
+#include "core/ShapeType.hpp"
+
+// The shape buttons' icons, flat projections of small 3D shapes, drawn once
+// into a texture at the window's scale and shown as textured quads from
+// then on. Without framebuffer objects, or before prepare has run for the
+// window size, each icon is drawn from its triangles instead.
+class IconAtlas {
+public:
+    // NDC from an icon's center to its edge
+    static constexpr float ICON_SIZE = 0.03f;
+
+    // Redraws the atlas when the window size changed; call outside
+    // UiRenderer::begin/end with the window's framebuffer bound
+    static void prepare(int width, int height);
+    // Icon for shape centered on (x, y) in window NDC
+    static void draw(ShapeType shape, float x, float y, int width, int height);
+    static GLuint getTexture() { return texture; }
+    static void shutdown();
+
+private:
+    static constexpr int ICON_COUNT = 6; // ShapeType::CUBE to PYRAMID
+
+    static GLuint texture;
+    static int builtWidth;   // Window size the atlas was drawn for
+    static int builtHeight;
+    static int cellWidth;    // Pixels per icon, the icon centered in its cell
+    static int cellHeight;
+    static bool failed;
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef INSTANCED_RENDERER_HPP
+#define INSTANCED_RENDERER_HPP
+
+#include <glad/glad.h>
+#include <cstddef>
+#include "core/FrameStats.hpp"
+#include "rendering/MeshCache.hpp"
+#include "scene/InstanceBatcher.hpp"
+
+// Draws a scene with one glDrawElementsInstanced per (mesh, texture) batch.
+// Per-instance world matrices and colors are streamed each frame into a
+// single orphaned buffer; each batch points the instance attributes at its
+// slice of it.
+class InstancedRenderer {
+public:
+    // Returns false, drawing nothing, if the instancing shaders are unavailable
+    static bool drawScene(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera,
+                          int viewportHeightPx, std::vector<int8_t>& lodLevels, FrameStats& stats);
+    static void shutdown();
+
+private:
+    static GLuint programFor(VertexFormat format);
+    static void bindInstanceAttributes(size_t firstInstance);
+    static void unbindInstanceAttributes();
+
+    static InstanceBatcher batcher;
+    static GLuint instanceBuffer;
+    static GLuint floatProgram;
+    static GLuint packedProgram;
+    static bool shadersFailed;
+};
+
+#endif
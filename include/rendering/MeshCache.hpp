@@ -0,0 +1,92 @@
+#ifndef MESH_CACHE_HPP
+#define MESH_CACHE_HPP
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "geometry/MeshOptimizer.hpp"
+#include "geometry/PrimitiveGenerator.hpp"
+#include "geometry/VertexQuantizer.hpp"
+
+// Resident vertex layout: 32-byte float vertices, or 16-byte PackedVertex
+// decoded in a vertex shader
+enum class VertexFormat {
+    FLOAT32,
+    PACKED16
+};
+
+// Primitive uploaded once into a VAO with interleaved VBO and index buffer
+struct GpuMesh {
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ibo = 0;
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_INT;
+    size_t bytes = 0;
+    MeshOptimizer::Report optimization;
+
+    // Packed meshes only: decode constants and the error/footprint report
+    VertexFormat format = VertexFormat::FLOAT32;
+    glm::vec3 center = glm::vec3(0.0f);
+    glm::vec3 halfExtent = glm::vec3(1.0f);
+    glm::vec2 uvMin = glm::vec2(0.0f);
+    glm::vec2 uvExtent = glm::vec2(1.0f);
+    QuantizationReport quantization;
+};
+
+// Retained GPU meshes keyed by primitive parameters. A mesh is generated and
+// uploaded on first use and reused every frame until its parameters change.
+// Meshes pass through MeshOptimizer before upload.
+class MeshCache {
+public:
+    // Generic attributes float meshes also expose for core-profile shaders.
+    // They hold the same data as the fixed-function vertex and texcoord0
+    // arrays, which some drivers alias onto these slots.
+    static constexpr GLuint FLOAT_POSITION_ATTRIBUTE = 0;
+    static constexpr GLuint FLOAT_TEXCOORD_ATTRIBUTE = 8;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t bytesResident = 0;
+        size_t meshCount = 0;
+    };
+
+    static const GpuMesh& acquire(const PrimitiveParams& params);
+    static const GpuMesh* find(const PrimitiveParams& params);
+    static void draw(const PrimitiveParams& params);
+    static void drawMesh(const GpuMesh& mesh);
+    // drawMesh split for callers drawing one mesh several times: bind once,
+    // then drawBound per draw, then unbindMesh
+    static void bindMesh(const GpuMesh& mesh);
+    static void drawBound(const GpuMesh& mesh);
+    // Draws the bound mesh with indices streamed from the CPU instead of its
+    // own index buffer, e.g. triangles re-sorted for blending
+    static void drawBoundIndices(const GpuMesh& mesh, const std::vector<uint32_t>& indices);
+    static void unbindMesh();
+    static void release(const PrimitiveParams& params);
+    static void clear();
+
+    static const Stats& getStats();
+
+    // Switching formats drops every resident mesh; they re-upload on next use
+    static void setVertexFormat(VertexFormat format);
+    static VertexFormat getVertexFormat();
+
+private:
+    static GpuMesh upload(const MeshData& data);
+    static GpuMesh uploadPacked(const QuantizedMesh& data);
+    static GLuint packedProgram();
+    static void destroy(GpuMesh& mesh);
+
+    static std::unordered_map<PrimitiveParams, GpuMesh, PrimitiveParamsHash> meshes;
+    static Stats stats;
+    static VertexFormat vertexFormat;
+    static GLuint packedShader;
+    static GLuint streamIndexBuffer;
+    static bool packedShaderFailed;
+};
+
+#endif
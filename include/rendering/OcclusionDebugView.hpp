@@ -0,0 +1,23 @@
+#ifndef OCCLUSION_DEBUG_VIEW_HPP
+#define OCCLUSION_DEBUG_VIEW_HPP
+
+#include <glad/glad.h>
+#include <vector>
+#include "math/Camera.hpp"
+#include "scene/OcclusionCuller.hpp"
+
+// Shows the occlusion culler's depth buffer as a grayscale inset: near
+// occluders are bright, empty pixels black. Depth is linearized with the
+// camera's clip planes so distant occluders stay distinguishable.
+class OcclusionDebugView {
+public:
+    // Draws the buffer stretched over the NDC rectangle (x1, y1)-(x2, y2)
+    static void draw(const OcclusionCuller& culler, const Camera& camera, float x1, float y1, float x2, float y2);
+    static void shutdown();
+
+private:
+    static GLuint texture;
+    static std::vector<unsigned char> pixels;
+};
+
+#endif
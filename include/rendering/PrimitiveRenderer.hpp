@@ -1,7 +1,9 @@
 #ifndef PRIMITIVE_RENDERER_HPP
 #define PRIMITIVE_RENDERER_HPP
 
+#include <glad/glad.h>
 #include <GL/glut.h>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "core/ApplicationState.hpp"
@@ -11,12 +13,18 @@ public:
     static void drawRect(float x1, float y1, float x2, float y2, float r, float g, float b);
     static void drawOutlineRect(float x1, float y1, float x2, float y2, float lineR, float lineG, float lineB, float lineWidth = 2.0f);
     static void drawCircle(float cx, float cy, float radius, int segments, float r, float g, float b);
+    static void drawLine(float x1, float y1, float x2, float y2, float r, float g, float b, float lineWidth = 1.0f);
+    static void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, float r, float g, float b);
+    // Text is drawn in the color last set here, like glColor before glRasterPos
+    static void setTextColor(float r, float g, float b);
     static void drawText(const std::string &text, float x, float y, void* font = GLUT_BITMAP_HELVETICA_12);
     static float pxToNDCx(int px, int width);
     static float pxToNDCy(int px, int height);
     static void mouseToNDC(double mx, double my, int width, int height, float &ndcX, float &ndcY);
     static bool isInsideNDC(double mx, double my, int width, int height, float x1, float y1, float x2, float y2);
+    // Clips the UI drawn after it to a top-left-origin pixel rect until clearScissor
     static void setScissor(int x, int y, int width, int height, int screenHeight);
+    static void clearScissor();
 
     // New texture-related functions
     static bool loadTexture(const std::string& filename, GLuint& textureID);
@@ -24,15 +32,16 @@ public:
     static void initTextures();
     static void cleanupTextures();
 
-    // NEW: Texture application functions
-    static void applyTextureToShape(ShapeType shapeType, int textureID, ApplicationState& appState);
-    static void applyColorToShape(ShapeType shapeType, ApplicationState& appState);
-    static int getShapeTexture(ShapeType shapeType, ApplicationState& appState);
-    static bool shapeHasTexture(ShapeType shapeType, ApplicationState& appState);
     static void drawTexturedShape(ShapeType shapeType, ApplicationState& appState);
 
+    // Binds a scene object's texture, or falls back to its flat color
+    static void applyMaterial(const ObjectMaterial& material);
+
     // Texture storage
     static std::vector<GLuint> textureIDs;
+
+private:
+    static uint32_t textColor;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef SHADER_PROGRAM_HPP
+#define SHADER_PROGRAM_HPP
+
+#include <glad/glad.h>
+#include <utility>
+#include <vector>
+
+// Compiles and links GLSL programs. Failures are logged and return 0, and
+// callers fall back to the fixed-function path.
+class ShaderProgram {
+public:
+    // Attribute names are bound to their index in the list before linking
+    static GLuint build(const char* name, const char* vertexSource, const char* fragmentSource,
+                        const std::vector<std::pair<GLuint, const char*>>& attributes = {});
+    static void destroy(GLuint& program);
+
+private:
+    static GLuint compile(const char* name, GLenum type, const char* source);
+};
+
+#endif
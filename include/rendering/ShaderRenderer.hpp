@@ -0,0 +1,68 @@
+#ifndef SHADER_RENDERER_HPP
+#define SHADER_RENDERER_HPP
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/FrameStats.hpp"
+#include "math/Camera.hpp"
+#include "rendering/MeshCache.hpp"
+#include "scene/RenderQueue.hpp"
+
+// Scene renderer using only core-profile GL: GLSL 330 shaders, VAOs and
+// uniform buffers, no matrix stack, glBegin or glColor. Camera matrices live
+// in a uniform buffer updated once per drawn view. Per-object data is written
+// into a ring of FRAMES_IN_FLIGHT segments of one persistently mapped buffer,
+// one segment per frame with every view drawn that frame given its own slice
+// of it, fenced so the CPU never overwrites a segment the GPU may still read;
+// each draw binds its object's block. Without glBufferStorage the ring is
+// replaced by an orphaned buffer refilled for every view.
+class ShaderRenderer {
+public:
+    // Bracket every frame's drawScene calls: beginFrame moves to the next
+    // segment, waiting for the GPU to finish the frame that last used it,
+    // and endFrame fences the segment
+    static void beginFrame();
+    static void endFrame();
+
+    // Draws the sorted queue; returns false, drawing nothing, if the shaders
+    // are unavailable
+    static bool drawScene(const Scene& scene, const RenderQueue& queue, const Camera& camera, FrameStats& stats);
+    static void shutdown();
+
+    static bool isPersistentlyMapped() { return mapped != nullptr; }
+
+private:
+    static constexpr int FRAMES_IN_FLIGHT = 3;
+
+    // std140 layout of the ObjectData uniform block
+    struct ObjectData {
+        float model[16];
+        float color[4];
+        float decodeCenter[4];     // w = 1 when textured
+        float decodeHalfExtent[4];
+        float decodeUv[4];         // xy = UV minimum, zw = UV extent
+    };
+
+    static bool ensurePrograms();
+    static bool ensureObjectCapacity(size_t objectCount);
+    static void releaseObjectBuffer();
+    static unsigned char* beginObjectWrites(size_t objectCount);
+    static void endObjectWrites(size_t objectCount);
+
+    static GLuint floatProgram;
+    static GLuint packedProgram;
+    static bool shadersFailed;
+    static GLuint cameraBuffer;
+    static GLuint objectBuffer;
+    static size_t objectStride;   // sizeof(ObjectData) rounded up to the UBO offset alignment
+    static size_t objectCapacity; // Objects per ring segment
+    static unsigned char* mapped; // Persistent mapping of the whole ring, null when orphaning
+    static int segment;
+    static size_t segmentUsed;    // Objects written into this frame's segment so far
+    static GLsync fences[FRAMES_IN_FLIGHT];
+    static std::vector<unsigned char> staging;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef TEXT_RENDERER_HPP
+#define TEXT_RENDERER_HPP
+
+#include <glad/glad.h>
+#include <string>
+#include "core/FontAtlas.hpp"
+
+// The UI font on the GL side. Loads the first of Constants::FONT_FILES, bakes
+// it at the sizes of the GLUT bitmap fonts the UI asks for and keeps the
+// atlas in an alpha texture; UiRenderer lays text out through it and draws
+// the glyph quads in its batches. Without a font, text stays GLUT bitmaps.
+class TextRenderer {
+public:
+    // False when no font loads
+    static bool init();
+    static void shutdown();
+
+    static bool isReady() { return texture != 0; }
+    static GLuint getTexture() { return texture; }
+    static FontAtlas& getAtlas() { return atlas; }
+    static const std::string& getFontPath() { return fontPath; }
+
+    // Em size in pixels of a GLUT bitmap font, e.g. 12 for GLUT_BITMAP_HELVETICA_12
+    static float pixelSizeOf(void* glutFont);
+    // Baked size standing in for a GLUT bitmap font
+    static int sizeFor(void* glutFont);
+
+private:
+    static FontAtlas atlas;
+    static GLuint texture;
+    static std::string fontPath;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef TRANSPARENT_RENDERER_HPP
+#define TRANSPARENT_RENDERER_HPP
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "core/FrameStats.hpp"
+#include "scene/Scene.hpp"
+#include "scene/TransparentPass.hpp"
+
+// Draws a TransparentPass back to front through the fixed-function path,
+// after the opaque objects. Blending is over with depth testing and writes
+// left on, as the software rasterizer does. A lone object whose triangles
+// were sorted is drawn with the sorted indices. The caller has loaded the
+// projection matrix and saves the modelview matrix.
+class TransparentRenderer {
+public:
+    static void draw(const Scene& scene, const TransparentPass& pass, const glm::mat4& view, FrameStats& stats);
+};
+
+#endif
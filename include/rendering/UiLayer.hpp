@@ -0,0 +1,75 @@
+#ifndef UI_LAYER_HPP
+#define UI_LAYER_HPP
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+// The top bar, side panels and axis buttons kept in a window-sized texture
+// between frames. A region is redrawn into the texture only when its key, a
+// hash of the state it shows including which of its widgets is hovered,
+// changed; every frame the texture is composited over the canvas with one
+// textured quad.
+//
+// The texture starts transparent and UiRenderer accumulates coverage in its
+// alpha, so it holds premultiplied color and is blended as such. Without
+// framebuffer objects every region is drawn into the window each frame.
+class UiLayer {
+public:
+    enum Region {
+        TOP_BAR,
+        LEFT_BAR,
+        RIGHT_BAR,
+        AXIS_BUTTONS,
+        REGION_COUNT
+    };
+
+    struct Stats {
+        uint32_t regionsDrawn = 0;
+        uint32_t regionsCached = 0;
+    };
+
+    // Starts a frame
+    static void begin(int width, int height);
+    // True when the region has to be drawn, in which case its draws up to
+    // endRegion go to the layer, clipped to x1, y1, x2, y2 in window NDC
+    static bool beginRegion(Region region, float x1, float y1, float x2, float y2, uint64_t key);
+    static void endRegion();
+    // Draws the layer over the window
+    static void composite();
+
+    // Redraws every region next frame
+    static void invalidate();
+    static bool isCaching() { return framebuffer != 0; }
+
+    // Folding the state a region shows into its key
+    static uint64_t mix(uint64_t key, uint64_t value);
+    static uint64_t mixFloat(uint64_t key, float value);
+    static uint64_t mixString(uint64_t key, const std::string& value);
+
+    static const Stats& getStats() { return stats; }
+    static void resetStats() { stats = Stats(); }
+    static void shutdown();
+
+private:
+    struct RegionState {
+        bool valid = false;
+        uint64_t key = 0;
+    };
+
+    static bool allocate(int width, int height);
+
+    static GLuint framebuffer;
+    static GLuint texture;
+    static int layerWidth;
+    static int layerHeight;
+    static int windowWidth;  // From begin
+    static int windowHeight;
+    static GLint windowFramebuffer; // Bound when beginRegion switched to the layer
+    static bool failed;
+    static int drawing;   // Region between beginRegion and endRegion, -1 for none
+    static RegionState regions[REGION_COUNT];
+    static Stats stats;
+};
+
+#endif
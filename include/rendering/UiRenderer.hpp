@@ -0,0 +1,140 @@
+#ifndef UI_RENDERER_HPP
+#define UI_RENDERER_HPP
+
+#include <glad/glad.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Batched 2D renderer for the UI. Between begin and end, rects, outlines,
+// circles, triangles, textured quads and text glyphs are only recorded; end groups
+// them into batches by texture and clip rect, streams all vertices into one
+// buffer and issues one draw per batch.
+//
+// Batching keeps the painter's order where it matters: a primitive joins the
+// latest earlier batch with the same state only if it overlaps nothing drawn
+// after that batch, so the result matches drawing in call order. Outside
+// begin/end each primitive is drawn as it is recorded.
+//
+// Coordinates are window NDC drawn through the current matrices (identity
+// for the UI pass); clip rects are window pixels with the origin at the
+// bottom left. Colors are RGBA8 with R in the lowest byte. Alpha is
+// accumulated as coverage, so a target cleared to transparent ends up
+// holding the UI with premultiplied alpha (see UiLayer).
+class UiRenderer {
+public:
+    struct Vertex {
+        float x, y;
+        float u, v;
+        uint32_t color;
+    };
+
+    struct Stats {
+        uint32_t drawCalls = 0;   // Geometry draws, glyphs included
+        uint32_t textStrings = 0; // GLUT bitmap strings, drawn one at a time when there is no font
+        uint32_t glyphs = 0;      // Glyph quads from the font atlas
+        uint32_t primitives = 0;  // Recorded, after dropping fully clipped ones
+        uint32_t vertices = 0;
+        double cpuMs = 0.0;       // Recording and flushing, begin to end
+    };
+
+    static uint32_t packColor(float r, float g, float b, float a = 1.0f);
+
+    // Window size in pixels, for line widths and text extents
+    static void begin(int width, int height);
+    static void end();
+    static bool isRecording() { return recording; }
+
+    static void rect(float x1, float y1, float x2, float y2, uint32_t color);
+    // Edges lineWidthPx wide, centered on the rectangle like GL wide lines
+    static void outline(float x1, float y1, float x2, float y2, uint32_t color, float lineWidthPx);
+    static void line(float x1, float y1, float x2, float y2, uint32_t color, float lineWidthPx);
+    static void circle(float cx, float cy, float radius, int segments, uint32_t color);
+    static void triangle(const Vertex& a, const Vertex& b, const Vertex& c);
+    // A triangle list recorded as one primitive, e.g. an icon
+    static void triangles(const Vertex* vertices, size_t count);
+    // Texture coordinates u0, v0 at (x1, y1) and u1, v1 at (x2, y2)
+    static void texturedRect(float x1, float y1, float x2, float y2, GLuint texture, float u0, float v0, float u1,
+                             float v1);
+    // Text with its baseline starting at (x, y), in the TextRenderer font at
+    // the size of the GLUT bitmap font given, or as GLUT bitmaps without one
+    static void text(const std::string& text, float x, float y, void* font, uint32_t color);
+
+    static void setClip(int x, int y, int width, int height);
+    static void clearClip();
+    // Rect every clip is narrowed to, kept across setClip and clearClip
+    static void setBounds(int x, int y, int width, int height);
+    static void clearBounds();
+
+    // Counters since the last reset, for the stats overlay
+    static const Stats& getStats() { return stats; }
+    static void resetStats() { stats = Stats(); }
+    static void shutdown();
+
+private:
+    struct Clip {
+        int x, y, width, height;
+    };
+
+    struct Command {
+        GLuint texture;     // 0 for flat color
+        int clip;           // Index into clips, -1 for none
+        bool isText;
+        float bounds[4];    // x1, y1, x2, y2 in NDC
+        uint32_t first;     // Into staged vertices, or texts
+        uint32_t count;
+    };
+
+    struct Text {
+        std::string text;
+        float x, y;
+        void* font;
+        uint32_t color;
+    };
+
+    struct Batch {
+        GLuint texture;
+        int clip;
+        bool isText;
+        float bounds[4];
+        uint32_t firstCommand; // Into the commands sorted by batch
+        uint32_t commandCount;
+        uint32_t firstVertex;  // Into the vertices sorted by batch
+        uint32_t vertexCount;
+    };
+
+    static void addCommand(GLuint texture, bool isText, uint32_t first, uint32_t count, const float* bounds);
+    // Records staged vertices from first on as one primitive
+    static void addVertices(GLuint texture, uint32_t first);
+    static void requireViewport();
+    static void quad(float x1, float y1, float x2, float y2, uint32_t color);
+    static bool sameClip(int a, int b);
+    // Active clip narrowed to the bounds; false when neither is set
+    static bool currentClip(Clip& clip);
+    static void flush();
+    static void applyClip(int clip);
+
+    static bool recording;
+    static int viewportWidth;
+    static int viewportHeight;
+    static bool clipActive;
+    static Clip activeClip;
+    static bool boundsActive;
+    static Clip bounds;
+    static std::chrono::steady_clock::time_point beginTime;
+    static std::vector<Vertex> staged;
+    static std::vector<Vertex> ordered;
+    static std::vector<Command> commands;
+    static std::vector<Text> texts;
+    static std::vector<Clip> clips;
+    static std::vector<Batch> batches;
+    static std::vector<uint32_t> batchOf;
+    static std::vector<uint32_t> sortedCommands;
+    static GLuint vao;
+    static GLuint vbo;
+    static Stats stats;
+};
+
+#endif
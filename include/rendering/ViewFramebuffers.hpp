@@ -0,0 +1,37 @@
+#ifndef VIEW_FRAMEBUFFERS_HPP
+#define VIEW_FRAMEBUFFERS_HPP
+
+#include <glad/glad.h>
+
+// Offscreen color and depth targets, one per canvas view. A view is drawn
+// into its target only when something it shows changed; every frame the
+// targets are copied onto the window with a blit.
+class ViewFramebuffers {
+public:
+    static constexpr int MAX_VIEWS = 4;
+
+    // Binds view's target for drawing, reallocating it when the size
+    // changed; false if framebuffer objects are unavailable
+    static bool bind(int view, int width, int height);
+    static void unbind();
+
+    // Copies view's color onto the window at (x, y), origin at the bottom left
+    static void present(int view, int x, int y);
+    static void shutdown();
+
+private:
+    struct Target {
+        GLuint framebuffer = 0;
+        GLuint color = 0;
+        GLuint depth = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    static void destroy(Target& target);
+
+    static Target targets[MAX_VIEWS];
+    static bool failed;
+};
+
+#endif
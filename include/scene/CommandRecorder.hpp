@@ -0,0 +1,30 @@
+#ifndef COMMAND_RECORDER_HPP
+#define COMMAND_RECORDER_HPP
+
+#include <cstddef>
+#include <vector>
+#include "core/CommandBuffer.hpp"
+#include "core/ThreadPool.hpp"
+#include "math/Camera.hpp"
+#include "scene/RenderQueue.hpp"
+
+// Records a sorted RenderQueue into command buffers, one per run of draws,
+// with the runs recorded in parallel. Every buffer starts by setting the
+// mesh, texture and blend state of its first draw, so buffers do not depend
+// on one another and an executor can replay them in order; later state is
+// only emitted when the queue key changes. The first buffer also carries the
+// camera matrices.
+class CommandRecorder {
+public:
+    static constexpr size_t DRAWS_PER_BUFFER = 4096;
+
+    // Resizes buffers to the number of runs and records into them
+    static void record(const Scene& scene, const RenderQueue& queue, const Camera& camera, ThreadPool& pool,
+                       std::vector<CommandBuffer>& buffers, size_t drawsPerBuffer = DRAWS_PER_BUFFER);
+
+private:
+    static void recordRun(const Scene& scene, const RenderQueue& queue, size_t begin, size_t end,
+                          CommandBuffer& buffer);
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef INSTANCE_BATCHER_HPP
+#define INSTANCE_BATCHER_HPP
+
+#include <cstdint>
+#include <vector>
+#include "core/RadixSort.hpp"
+#include "geometry/PrimitiveGenerator.hpp"
+#include "math/Camera.hpp"
+#include "scene/Scene.hpp"
+
+// Per-instance vertex data streamed to the GPU: world matrix columns and color
+struct InstanceData {
+    float model[16];
+    float color[4];
+};
+
+// Run of instances sharing one mesh (shape + LOD level) and one texture
+struct InstanceBatch {
+    PrimitiveParams params;
+    int texture = -1;
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+// Groups the visible objects of a scene into batches that can each be drawn
+// with one instanced call. Instances are laid out batch by batch in a single
+// array so the whole frame streams as one buffer upload.
+class InstanceBatcher {
+public:
+    // Picks LOD levels into the view's lodLevels and rebuilds the batches from
+    // the given objects (dense indices, e.g. the frustum culling output);
+    // world matrices must be up to date
+    void build(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera, int viewportHeightPx,
+               std::vector<int8_t>& lodLevels);
+
+    const std::vector<InstanceBatch>& getBatches() const { return batches; }
+    const std::vector<InstanceData>& getInstances() const { return instances; }
+
+private:
+    RadixSort sorter;
+    std::vector<uint64_t> keys;  // Batch key in the high 32 bits, object index in the low 32
+    std::vector<InstanceBatch> batches;
+    std::vector<InstanceData> instances;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef LOD_SELECTOR_HPP
+#define LOD_SELECTOR_HPP
+
+#include <cstdint>
+#include <vector>
+#include "geometry/PrimitiveGenerator.hpp"
+#include "math/Camera.hpp"
+#include "scene/Scene.hpp"
+
+// Picks tessellation density for curved primitives from their projected size.
+// Levels are discrete so every level maps to one cached mesh, and switching
+// uses hysteresis so a zoom hovering at a boundary does not regenerate.
+class LodSelector {
+public:
+    static constexpr int LEVEL_COUNT = 10;
+    static constexpr int LEVEL_SLICES[LEVEL_COUNT] = {6, 8, 12, 16, 24, 32, 48, 64, 96, 128};
+    static constexpr float MAX_ERROR_PX = 0.5f;  // Allowed chord-to-arc distance on screen
+    static constexpr float HYSTERESIS = 0.15f;   // Fraction a level boundary must be crossed by
+
+    static float boundingRadius(const PrimitiveParams& params);
+
+    // Radius in pixels of a world-space sphere at the given distance from the eye
+    static float projectedRadius(float worldRadius, float distance, float fovYRadians, int viewportHeightPx);
+
+    // Segments needed for a circle of radiusPx to stay within MAX_ERROR_PX
+    static float requiredSlices(float radiusPx);
+
+    // currentLevel < 0 selects without hysteresis
+    static int selectLevel(float radiusPx, int currentLevel);
+
+    // Base params with slice/stack counts replaced by the level's density
+    static PrimitiveParams paramsForLevel(const PrimitiveParams& base, int level);
+
+    static bool usesLod(ShapeType shape);
+
+    // Params for scene object `index` seen through camera. lodLevels holds the
+    // level each object was last drawn with in that view, indexed like the
+    // scene, and gets this one's new level. Reads the object's world matrix,
+    // so update the scene's world matrices first.
+    static PrimitiveParams selectForObject(const Scene& scene, size_t index, const Camera& camera,
+                                           int viewportHeightPx, std::vector<int8_t>& lodLevels,
+                                           float* screenRadiusPx = nullptr);
+};
+
+#endif
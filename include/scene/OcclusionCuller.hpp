@@ -0,0 +1,110 @@
+#ifndef OCCLUSION_CULLER_HPP
+#define OCCLUSION_CULLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/ThreadPool.hpp"
+#include "geometry/MeshBvh.hpp"
+#include "math/Camera.hpp"
+#include "math/Float8.hpp"
+#include "scene/Scene.hpp"
+
+// CPU occlusion culling. The largest opaque objects on screen are rasterized
+// as occluders into a low-resolution depth buffer, then every candidate's
+// bounding box is tested against it and hidden objects are dropped before
+// draw submission.
+//
+// Occluder triangles are binned into screen tiles and the tiles rasterized in
+// parallel, eight pixels per SIMD step. Each tile also keeps its farthest
+// depth so most occludee tests resolve without touching pixels. Coverage is
+// sampled at pixel centers, so occluders may overreach by up to half a pixel
+// at their silhouettes.
+class OcclusionCuller {
+public:
+    static constexpr int TILE_WIDTH = 32;
+    static constexpr int TILE_HEIGHT = 16;
+
+    struct Settings {
+        int width = 320;                // Multiple of TILE_WIDTH
+        int height = 192;               // Multiple of TILE_HEIGHT
+        int maxOccluders = 64;
+        float minOccluderArea = 0.01f;  // Fraction of the screen an occluder's box must cover
+    };
+
+    struct Stats {
+        uint32_t occluders = 0;
+        uint32_t triangles = 0;   // Occluder triangles rasterized (after back-face culling)
+        uint32_t tested = 0;
+        uint32_t culled = 0;
+        double rasterMs = 0.0;    // Occluder selection, setup, binning and rasterization
+        double testMs = 0.0;
+    };
+
+    OcclusionCuller();
+    explicit OcclusionCuller(const Settings& settings);
+
+    // Removes the objects hidden behind occluders from objects (dense indices,
+    // e.g. the frustum culling output), keeping the order of the rest.
+    // Occluders are rasterized with the LOD levels the view last drew them
+    // with. World matrices must be up to date.
+    void cull(const Scene& scene, const Camera& camera, const std::vector<int8_t>& lodLevels,
+              std::vector<uint32_t>& objects, ThreadPool& pool);
+
+    const Settings& getSettings() const { return settings; }
+    const Stats& getStats() const { return stats; }
+
+    // Row-major depth, row 0 at the bottom, NDC depth mapped to [0, 1] (1 = empty)
+    const float* getDepth() const { return depth.empty() ? nullptr : depth.data()->v; }
+
+private:
+    struct alignas(32) DepthBlock {
+        float v[8];
+    };
+
+    // Screen-space triangle in buffer pixels, counter-clockwise
+    struct ScreenTriangle {
+        float x[3];
+        float y[3];
+        float z[3];
+    };
+
+    // Projected bounding box of a candidate; inFront is false when it reaches the eye plane
+    struct ScreenBox {
+        glm::vec3 ndcMin;
+        glm::vec3 ndcMax;
+        bool inFront;
+    };
+
+    struct ThreadScratch {
+        std::vector<ScreenTriangle> triangles;
+        std::vector<std::vector<uint32_t>> bins; // Per tile: indices into triangles
+        std::vector<glm::vec4> clip;
+    };
+
+    void projectCandidates(const Scene& scene, const glm::mat4& viewProjection, const std::vector<uint32_t>& objects,
+                           ThreadPool& pool);
+    void selectOccluders(const Scene& scene, const std::vector<int8_t>& lodLevels,
+                         const std::vector<uint32_t>& objects);
+    void setupOccluder(const Scene& scene, uint32_t object, const MeshBvh& mesh, const glm::mat4& viewProjection,
+                       ThreadScratch& scratch);
+    void rasterizeTile(int tile);
+    void rasterizeTriangle(const ScreenTriangle& triangle, int x0, int y0, int x1, int y1);
+    bool isOccluded(const ScreenBox& box) const;
+
+    Settings settings;
+    Stats stats;
+    int tilesX = 0;
+    int tilesY = 0;
+    std::vector<DepthBlock> depth;
+    std::vector<float> tileMaxDepth;
+    std::vector<uint32_t> occluders;
+    std::vector<const MeshBvh*> occluderMeshes; // Fetched up front: the mesh cache is not thread-safe
+    std::vector<ScreenBox> screenBoxes;                 // Parallel to the objects being culled
+    std::vector<std::pair<float, uint32_t>> candidates; // (screen area, object)
+    std::vector<ThreadScratch> scratch;
+    std::vector<uint8_t> hidden;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/RadixSort.hpp"
+#include "geometry/PrimitiveGenerator.hpp"
+#include "math/Camera.hpp"
+#include "scene/Scene.hpp"
+
+// Per-frame list of draws, each with a 64-bit sort key packing the GL state
+// it needs. Radix-sorting the keys groups draws by state, so submission only
+// changes the state whose key bits differ from the previous draw.
+//
+// Key layout, most significant first:
+//   pass (2) | blended (1) | opaque:  texture + 1 (12) | mesh (8) | depth (24)
+//                            blended: far-to-near depth (24) | texture + 1 (12) | mesh (8)
+// Opaque draws are grouped by state and front to back within a state; blended
+// (textured) draws go back to front after them. Mesh is shape (4) | LOD level + 1 (4).
+class RenderQueue {
+public:
+    enum Pass : uint32_t {
+        PASS_SCENE = 0
+    };
+
+    // Transitions a submission in key order makes; a draw never re-issues
+    // state its predecessor already set
+    struct StateChanges {
+        uint32_t meshes = 0;
+        uint32_t textures = 0;
+        uint32_t blends = 0;
+
+        uint32_t total() const { return meshes + textures + blends; }
+    };
+
+    // Picks LOD levels into the view's lodLevels and rebuilds the sorted draws
+    // from the given objects (dense indices, e.g. the culling output); world
+    // matrices must be up to date
+    void build(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera, int viewportHeightPx,
+               std::vector<int8_t>& lodLevels);
+
+    size_t size() const { return keys.size(); }
+    const std::vector<uint64_t>& getKeys() const { return keys; }
+    const std::vector<uint32_t>& getObjects() const { return objects; }
+
+    // State the last build needed in sorted order, and would have needed had
+    // the draws been submitted in the order they were given
+    const StateChanges& getSortedChanges() const { return sortedChanges; }
+    const StateChanges& getUnsortedChanges() const { return unsortedChanges; }
+
+    static uint64_t makeKey(Pass pass, bool blended, int texture, ShapeType shape, int level, float depth);
+    static bool isBlended(uint64_t key);
+    static int textureOf(uint64_t key);
+    static uint32_t meshOf(uint64_t key);
+    static PrimitiveParams paramsOf(uint64_t key);
+    static PrimitiveParams paramsForMesh(uint32_t mesh);
+
+    static StateChanges countStateChanges(const std::vector<uint64_t>& keys);
+
+private:
+    RadixSort sorter;
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> objects;
+    StateChanges sortedChanges;
+    StateChanges unsortedChanges;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/ShapeType.hpp"
+
+// Stable reference to a scene object. The generation changes every time a
+// slot is reused, so handles to removed objects stop resolving.
+struct ObjectHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xffffffffu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == INVALID_INDEX; }
+    bool operator==(const ObjectHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const ObjectHandle& other) const { return !(*this == other); }
+};
+
+struct ObjectMaterial {
+    glm::vec3 color = glm::vec3(0.8f);
+    int texture = -1; // Index into PrimitiveRenderer::textureIDs, -1 draws the color
+};
+
+namespace ObjectFlags {
+    constexpr uint32_t VISIBLE = 1u << 0;
+    constexpr uint32_t SELECTED = 1u << 1;
+    constexpr uint32_t DIRTY = 1u << 2;  // Local transform changed since the last update
+}
+
+// Objects stored as parallel dense arrays (structure of arrays) so per-frame
+// passes walk contiguous memory. Handles go through a slot table with a free
+// list, so lookups are O(1) and survive reordering.
+//
+// Objects form a transform hierarchy kept in depth-first preorder: parents
+// precede their children and every subtree is the contiguous range
+// [i, i + subtreeSizes[i]). World matrices are cached and only dirty
+// subtrees are recomputed. Root-level childless objects (the flat case) add
+// and remove in O(1) by swapping with the last object; reparenting and
+// removals that would break the preorder reorder the arrays in O(n).
+class Scene {
+public:
+    static constexpr uint32_t NO_PARENT = ObjectHandle::INVALID_INDEX;
+
+    // Dense index range [begin, end)
+    struct IndexRange {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    ObjectHandle add(ShapeType shape);
+    ObjectHandle add(ShapeType shape, ObjectHandle parent);
+    // Removes the object together with its descendants
+    bool remove(ObjectHandle handle);
+    void clear();
+    void reserve(size_t count);
+
+    // Moves handle's subtree under parent (a null handle makes it a root).
+    // Local transforms are kept, so the subtree moves with its new parent.
+    // Fails if parent is inside the subtree.
+    bool setParent(ObjectHandle handle, ObjectHandle parent);
+    ObjectHandle parentOf(ObjectHandle handle) const;
+
+    bool isValid(ObjectHandle handle) const;
+    size_t size() const { return shapes.size(); }
+
+    // Dense index of a live handle, or -1; only valid until the next add/remove/reparent
+    int64_t indexOf(ObjectHandle handle) const;
+    ObjectHandle handleAt(size_t index) const;
+
+    // Writes a local transform, marking the subtree dirty only if it changed
+    void setLocalTransform(size_t index, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation);
+    // Call after writing positions/scales/rotations directly
+    void markDirty(size_t index);
+
+    // Recomputes world matrices of dirty subtrees only: O(total dirty subtree size)
+    void updateWorldMatrices();
+    // Recomputes every world matrix in one linear pass
+    void updateAllWorldMatrices();
+
+    // Bumped whenever objects are added, removed or reordered, which
+    // invalidates dense indices held elsewhere (e.g. by acceleration structures)
+    uint64_t getStructureRevision() const { return structureRevision; }
+
+    // Bumped by any change to what the scene draws: structure, transforms,
+    // and materials or flags written through markChanged
+    uint64_t getRevision() const { return revision; }
+    // Call after writing materials or flags directly
+    void markChanged() { revision++; }
+
+    // Hands over the ranges whose world matrices were recomputed since the
+    // last call. Only meaningful while the structure revision is unchanged.
+    void takeMovedRanges(std::vector<IndexRange>& out);
+
+    // Dense arrays, all size() long and indexed alike. Transforms are local to the parent.
+    std::vector<ShapeType> shapes;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> scales;
+    std::vector<glm::vec3> rotations;  // Euler angles in degrees
+    std::vector<ObjectMaterial> materials;
+    std::vector<uint32_t> flags;
+    std::vector<glm::mat4> worldMatrices;
+    std::vector<uint32_t> parents;     // Dense index of the parent, NO_PARENT for roots
+    std::vector<uint32_t> subtreeSizes;
+
+private:
+    struct Slot {
+        uint32_t denseIndex = ObjectHandle::INVALID_INDEX;
+        uint32_t generation = 0;
+        uint32_t nextFree = ObjectHandle::INVALID_INDEX;
+    };
+
+    // Calls fn on every dense array, for operations that move whole objects
+    template <typename Fn>
+    void forEachArray(Fn fn) {
+        fn(shapes);
+        fn(positions);
+        fn(scales);
+        fn(rotations);
+        fn(materials);
+        fn(flags);
+        fn(worldMatrices);
+        fn(parents);
+        fn(subtreeSizes);
+        fn(denseToSlot);
+    }
+
+    uint32_t allocateSlot();
+    void releaseSlot(uint32_t slotIndex);
+    void appendObject(ShapeType shape, uint32_t slotIndex, uint32_t parent);
+    // Reorders objects so new index k holds old index order[k]; order may drop objects
+    void applyOrder(const std::vector<uint32_t>& order);
+    void rebuildSubtreeSizes();
+    void recordMoved(uint32_t begin, uint32_t end);
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> denseToSlot;
+    std::vector<uint32_t> dirtySlots;  // Slots whose subtree needs a world update
+    uint32_t freeHead = ObjectHandle::INVALID_INDEX;
+    uint64_t structureRevision = 0;
+    uint64_t revision = 0;
+    std::vector<IndexRange> movedRanges;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef SCENE_BVH_HPP
+#define SCENE_BVH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <glm/glm.hpp>
+#include "math/Camera.hpp"
+#include "math/Frustum.hpp"
+#include "scene/Scene.hpp"
+
+// Eight-wide bounding volume hierarchy over the world-space AABBs of scene
+// objects, used to cull everything outside the view frustum. Each node holds
+// its children's bounds as structure-of-arrays lanes so one node visit tests
+// all eight children against a plane with a single SIMD pass.
+//
+// Moving objects only refits the affected leaves and their ancestors; the tree
+// is rebuilt when the scene structure changes or refitting has loosened the
+// boxes enough to make traversal noticeably worse.
+class SceneBvh {
+public:
+    static constexpr int WIDTH = 8;
+
+    struct CullStats {
+        uint32_t visible = 0;
+        uint32_t culled = 0;
+        uint32_t nodesVisited = 0;
+    };
+
+    // Brings the tree in sync with the scene; world matrices must be up to date
+    void update(Scene& scene);
+    void build(const Scene& scene);
+
+    // Appends the dense indices of VISIBLE objects whose bounds touch the frustum
+    void cull(const Scene& scene, const Frustum& frustum, std::vector<uint32_t>& visible,
+              CullStats* stats = nullptr) const;
+
+    // Visits VISIBLE objects whose bounds the ray enters before the closest hit
+    // so far, nearest box first. intersectObject(object, closest) returns the
+    // object's hit distance, or closest if it misses. Returns the closest hit,
+    // or maxDistance if nothing was hit.
+    float raycast(const Scene& scene, const Ray& ray, float maxDistance,
+                  const std::function<float(uint32_t object, float closest)>& intersectObject) const;
+
+    // World-space bounds of the object's default-size primitive
+    static void worldBounds(const Scene& scene, size_t index, glm::vec3& boundsMin, glm::vec3& boundsMax);
+
+    size_t nodeCount() const { return nodes.size(); }
+    uint32_t getRebuildCount() const { return rebuildCount; }
+
+private:
+    static constexpr uint32_t EMPTY = 0xffffffffu;
+    static constexpr uint32_t LEAF_BIT = 0x80000000u; // Lane holds an object index, not a node
+
+    struct alignas(32) Node {
+        float minX[WIDTH], minY[WIDTH], minZ[WIDTH];
+        float maxX[WIDTH], maxY[WIDTH], maxZ[WIDTH];
+        uint32_t child[WIDTH];
+        uint32_t parentLane; // parent node * WIDTH + lane, EMPTY for the root
+    };
+
+    // Object being partitioned during a build, with its centroid kept inline for the median splits
+    struct BuildItem {
+        glm::vec3 centroid;
+        uint32_t object;
+    };
+
+    uint32_t buildNode(uint32_t begin, uint32_t end, uint32_t parentLane);
+    void refit(const Scene& scene, const std::vector<Scene::IndexRange>& ranges);
+    void setLane(uint32_t node, int lane, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    void nodeBounds(uint32_t node, glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+    void appendSubtree(const Scene& scene, uint32_t node, std::vector<uint32_t>& visible) const;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> objectLanes; // Per object: leaf node * WIDTH + lane
+    std::vector<float> nodeAreas;      // Surface area of each node's bounds, for the rebuild heuristic
+    std::vector<glm::vec3> buildMin, buildMax;
+    std::vector<BuildItem> buildItems;
+    std::vector<uint8_t> nodeQueued;
+    std::vector<uint32_t> refitQueue;
+    std::vector<Scene::IndexRange> movedRanges;
+    double totalArea = 0.0;
+    double builtArea = 0.0;
+    uint64_t builtRevision = ~0ull;
+    uint32_t rebuildCount = 0;
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SCENE_EDITOR_HPP
+#define SCENE_EDITOR_HPP
+
+#include "core/ApplicationState.hpp"
+
+// Ties the single-object editing UI to the scene. The transform fields and
+// currentShape on ApplicationState act as the edit buffer of the selected
+// object: select() loads them and syncSelected() writes them back.
+class SceneEditor {
+public:
+    // Adds an object at the origin with the shape's current material and selects it
+    static ObjectHandle addShape(ApplicationState& appState, ShapeType shape);
+
+    static void select(ApplicationState& appState, ObjectHandle handle);
+    static void selectNext(ApplicationState& appState);
+    // Removes the selected object and its children
+    static bool removeSelected(ApplicationState& appState);
+
+    // Parents the selected object to the one selected before it, or makes it a root again
+    static bool parentToPreviousSelection(ApplicationState& appState);
+    static bool clearParent(ApplicationState& appState);
+
+    static void syncSelected(ApplicationState& appState);
+};
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef SCENE_GENERATOR_HPP
+#define SCENE_GENERATOR_HPP
+
+#include "scene/Scene.hpp"
+
+// Synthetic scenes for measuring the renderer
+class SceneGenerator {
+public:
+    // Replaces the scene with copiesPerShape objects of every ShapeType, laid
+    // out on a 3D grid that fits the default canvas camera
+    static void populateBenchmark(Scene& scene, int copiesPerShape);
+
+    // Replaces the scene with count objects of random shape scattered through
+    // a cube of the given half-size centered on the origin, so that at large
+    // extents most of them are outside the canvas view
+    static void populateScattered(Scene& scene, int count, float extent);
+
+    // Replaces the scene with a wall of four large panels in front of the
+    // default canvas camera and count small objects behind it, most of them
+    // hidden except through the gaps between the panels
+    static void populateOccluded(Scene& scene, int count);
+};
+
+#endif
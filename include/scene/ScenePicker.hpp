@@ -0,0 +1,47 @@
+#ifndef SCENE_PICKER_HPP
+#define SCENE_PICKER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "geometry/MeshBvh.hpp"
+#include "geometry/PrimitiveGenerator.hpp"
+#include "math/Camera.hpp"
+#include "scene/Scene.hpp"
+#include "scene/SceneBvh.hpp"
+
+struct PickResult {
+    ObjectHandle object;              // Null if nothing was hit
+    uint32_t face = 0;                // Triangle index in PrimitiveGenerator::generate(params)
+    glm::vec3 barycentric = glm::vec3(0.0f); // Weights of the face's three corners
+    float distance = 0.0f;            // World units along the ray
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 corners[3];             // World-space corners of the hit face
+
+    bool hit() const { return !object.isNull(); }
+};
+
+// Ray-cast picking: the scene BVH finds candidate objects nearest first, then
+// each candidate's triangle BVH is traversed in object space. Triangle BVHs
+// are built on first use per mesh (shape + LOD level) and shared by every
+// object drawn with that mesh.
+class ScenePicker {
+public:
+    // The BVH must be up to date with the scene's world matrices. lodLevels
+    // are those of the view the ray goes through, so each object is tested
+    // with the mesh that view shows.
+    static PickResult pick(const Scene& scene, const SceneBvh& bvh, const Ray& ray,
+                           const std::vector<int8_t>& lodLevels);
+
+    // Mesh an object is currently drawn with in the view lodLevels belong to,
+    // so the picked face matches the screen
+    static PrimitiveParams paramsFor(const Scene& scene, size_t index, const std::vector<int8_t>& lodLevels);
+    static const MeshBvh& meshFor(const PrimitiveParams& params);
+    static void clear();
+
+private:
+    static std::unordered_map<PrimitiveParams, MeshBvh, PrimitiveParamsHash> meshes;
+};
+
+#endif
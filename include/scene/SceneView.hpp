@@ -0,0 +1,68 @@
+#ifndef SCENE_VIEW_HPP
+#define SCENE_VIEW_HPP
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/CommandBuffer.hpp"
+#include "math/Camera.hpp"
+#include "scene/RenderQueue.hpp"
+#include "scene/Scene.hpp"
+#include "scene/SceneBvh.hpp"
+#include "scene/TransparentPass.hpp"
+
+// One camera's view of the canvas scene with its own culling output, draw
+// order and recorded commands. The scene, its world matrices and BVH, and the
+// GPU meshes are shared by all views, so each extra view costs only its own
+// culling and submission.
+struct SceneView {
+    enum Kind {
+        FRONT,       // The canvas camera
+        TOP,
+        SIDE,
+        PERSPECTIVE, // Above and to the right of the front view
+        KIND_COUNT
+    };
+
+    Kind kind = FRONT;
+    Camera camera = Camera::canvasDefault();
+    // Window pixels the view is shown in, origin at the bottom left
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    std::vector<uint32_t> visibleObjects;
+    SceneBvh::CullStats cullStats;
+    RenderQueue renderQueue;
+    TransparentPass transparentPass;
+    std::vector<CommandBuffer> commands;
+
+    // LOD level each object was last drawn with in this view, indexed like
+    // the scene, so every view keeps its own hysteresis and picking tests the
+    // meshes this view shows
+    std::vector<int8_t> lodLevels;
+    uint64_t lodStructureRevision = 0;
+
+    // Inputs of the last redraw, so an unchanged view can be shown again as is
+    bool drawn = false;
+    uint64_t drawnSceneRevision = 0;
+    uint64_t drawnSettings = 0;
+    glm::mat4 drawnViewProjection = glm::mat4(1.0f);
+    int drawnWidth = 0;
+    int drawnHeight = 0;
+
+    // lodLevels for scene, reset to -1 (picked afresh) when objects were
+    // added, removed or reordered since the last call
+    std::vector<int8_t>& lodLevelsFor(const Scene& scene);
+
+    // True when the scene, camera, size or render settings changed since markDrawn
+    bool needsRedraw(uint64_t sceneRevision, uint64_t settings) const;
+    void markDrawn(uint64_t sceneRevision, uint64_t settings);
+
+    // The canvas camera seen from kind's direction, at the same distance from the origin
+    static Camera cameraFor(Kind kind, float aspect);
+    static const char* nameOf(Kind kind);
+};
+
+#endif
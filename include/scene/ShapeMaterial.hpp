@@ -0,0 +1,16 @@
+#ifndef SHAPE_MATERIAL_HPP
+#define SHAPE_MATERIAL_HPP
+
+#include "core/ApplicationState.hpp"
+
+// Per-shape texture/color bookkeeping on ApplicationState; applying a
+// material also sets it on the selected scene object
+class ShapeMaterial {
+public:
+    static void applyTextureToShape(ShapeType shapeType, int textureID, ApplicationState& appState);
+    static void applyColorToShape(ShapeType shapeType, ApplicationState& appState);
+    static int getShapeTexture(ShapeType shapeType, const ApplicationState& appState);
+    static bool shapeHasTexture(ShapeType shapeType, const ApplicationState& appState);
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef SOFTWARE_RENDERER_HPP
+#define SOFTWARE_RENDERER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/Image.hpp"
+#include "core/ThreadPool.hpp"
+#include "geometry/MeshData.hpp"
+#include "math/Camera.hpp"
+#include "math/Float8.hpp"
+#include "scene/RenderQueue.hpp"
+#include "scene/Scene.hpp"
+
+// CPU rasterizer producing the same picture as the GL scene view, for
+// rendering on machines without a GPU. Draws go through a RenderQueue, so LOD
+// selection and draw order (opaque front to back, then textured back to front
+// with alpha blending) match the GL path.
+//
+// Runs in two parallel passes. Runs of draws are transformed, clipped and set
+// up on whichever thread picks them up, each copying its triangles into the
+// screen tiles they touch; then every tile is rasterized by one thread,
+// walking the runs' bins in draw order. Edge functions, depth and the
+// perspective-correct texture coordinates are evaluated eight pixels per SIMD
+// step. Like GL without face culling, both sides of every triangle are drawn;
+// depth testing is GL_LESS and textures are sampled bilinearly with repeat.
+class SoftwareRenderer {
+public:
+    static constexpr int TILE_SIZE = 64;
+
+    struct Stats {
+        uint32_t draws = 0;
+        uint64_t triangles = 0;       // Mesh triangles submitted
+        uint64_t rasterTriangles = 0; // After clipping and trivial rejection
+        double setupMs = 0.0;         // Meshes, transform, clipping, setup and binning
+        double rasterMs = 0.0;
+    };
+
+    // Color and depth as GL leaves them after glClear
+    void resize(int width, int height);
+    void clear(const glm::vec4& color);
+
+    // Indexed like ObjectMaterial::texture; empty images draw untextured
+    void setTextures(const std::vector<Image>& images) { textures = images; }
+
+    // Builds the draw order for objects (dense indices, e.g. the culling
+    // output), picking LOD levels into the view's lodLevels, and draws them;
+    // world matrices must be up to date
+    void render(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera,
+                std::vector<int8_t>& lodLevels, ThreadPool& pool);
+    void draw(const Scene& scene, const RenderQueue& queue, const Camera& camera, ThreadPool& pool);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const Stats& getStats() const { return stats; }
+
+    // Color with row 0 at the bottom, as glReadPixels returns it
+    Image getImage() const;
+    // Window depth in [0, 1]
+    float depthAt(int x, int y) const;
+
+private:
+    struct alignas(32) DepthBlock {
+        float v[8];
+    };
+
+    // Plane equations in pixels relative to (originX, originY): p(x, y) = a * x + b * y + c
+    struct Plane {
+        float a, b, c;
+    };
+
+    struct RasterTriangle {
+        Plane edges[3];        // >= threshold inside
+        float thresholds[3];   // 0 for top-left edges, the smallest positive float otherwise
+        Plane depth;
+        Plane inverseW;
+        Plane uOverW;
+        Plane vOverW;
+        int originX, originY;
+        int minX, minY, maxX, maxY; // Pixel bounds, max exclusive
+        uint32_t color;
+        int texture;                // -1 for flat color
+    };
+
+    struct ClipVertex {
+        glm::vec4 position;
+        glm::vec2 texCoord;
+    };
+
+    // Per tile, copies of the triangles of one run of draws touching it, so
+    // tiles read their triangles sequentially
+    struct RunScratch {
+        std::vector<std::vector<RasterTriangle>> bins;
+        std::vector<ClipVertex> clip;
+        uint64_t submitted = 0;
+        uint64_t rasterized = 0;
+    };
+
+    void setupRun(const Scene& scene, const RenderQueue& queue, size_t begin, size_t end,
+                  const glm::mat4& viewProjection, RunScratch& run);
+    void setupTriangle(const ClipVertex* vertices, uint32_t color, int texture, RunScratch& run);
+    void binTriangle(const RasterTriangle& triangle, RunScratch& run);
+    void rasterizeTile(int tile);
+    void rasterizeTriangle(const RasterTriangle& triangle, int x0, int y0, int x1, int y1);
+    uint32_t sampleTexture(const Image& image, float u, float v) const;
+
+    int width = 0;
+    int height = 0;
+    int stride = 0;     // Pixels per row, a multiple of TILE_SIZE
+    int tilesX = 0;
+    int tilesY = 0;
+    std::vector<uint32_t> color;    // RGBA8, R in the lowest byte
+    std::vector<DepthBlock> depth;
+    std::vector<Image> textures;
+    Stats stats;
+
+    std::unordered_map<uint32_t, MeshData> meshes; // By RenderQueue mesh key
+    std::vector<const MeshData*> drawMeshes;       // Parallel to the queue
+    std::vector<RunScratch> runs;
+    RenderQueue queue;
+};
+
+#endif
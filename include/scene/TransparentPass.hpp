@@ -0,0 +1,73 @@
+#ifndef TRANSPARENT_PASS_HPP
+#define TRANSPARENT_PASS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+#include "core/RadixSort.hpp"
+#include "core/ThreadPool.hpp"
+#include "geometry/MeshData.hpp"
+#include "geometry/PrimitiveGenerator.hpp"
+#include "math/Camera.hpp"
+#include "scene/Scene.hpp"
+
+// Splits the visible objects into opaque ones and blended (textured) ones,
+// and orders the blended ones back to front so alpha composites correctly
+// after the opaque pass. Sort keys are view depths quantized to 32 bits and
+// sorted with the parallel radix sort, so 100k transparent objects sort in
+// a few milliseconds.
+//
+// When the pass holds a single object with many triangles, its triangles are
+// sorted back to front too, since one large blended mesh would otherwise show
+// its far side through the near one in index order.
+class TransparentPass {
+public:
+    // Triangles a lone transparent object needs before its triangles are sorted
+    static constexpr size_t TRIANGLE_SORT_MIN = 256;
+
+    struct Stats {
+        uint32_t objects = 0;
+        uint32_t sortedTriangles = 0;
+        double sortMs = 0.0; // Split, LOD selection, keys and sorting
+    };
+
+    static bool isTransparent(const Scene& scene, uint32_t object) { return scene.materials[object].texture != -1; }
+
+    // Maps view depth in [near, far] to 0..2^32-1 so nearer is smaller
+    static uint32_t quantizeDepth(float viewDepth, float nearPlane, float farPlane);
+
+    // Picks LOD levels into the view's lodLevels for the transparent objects
+    // among `objects` (dense indices, e.g. the culling output) and sorts them;
+    // the rest keep their order in getOpaque(). World matrices must be up to date.
+    void build(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera, int viewportHeightPx,
+               std::vector<int8_t>& lodLevels, ThreadPool& pool);
+
+    const std::vector<uint32_t>& getOpaque() const { return opaque; }
+    // Back to front
+    const std::vector<uint32_t>& getObjects() const { return transparent; }
+    // Mesh per sorted object, encoded like RenderQueue::meshOf
+    const std::vector<uint32_t>& getMeshes() const { return meshes; }
+
+    // Indices of the lone object's mesh (as generated and optimized for
+    // MeshCache) with its triangles back to front; empty when not sorted
+    const std::vector<uint32_t>& getSortedIndices() const { return sortedIndices; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    void sortTriangles(const Scene& scene, uint32_t object, uint32_t mesh, const Camera& camera, ThreadPool& pool);
+    const MeshData& meshFor(uint32_t mesh);
+
+    RadixSort sorter;
+    std::vector<uint32_t> opaque;
+    std::vector<uint32_t> transparent;
+    std::vector<uint32_t> meshes;
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> triangleOrder;
+    std::vector<uint32_t> sortedIndices;
+    std::unordered_map<uint32_t, MeshData> meshData; // By mesh key, for triangle sorting
+    Stats stats;
+};
+
+#endif
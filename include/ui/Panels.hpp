@@ -4,16 +4,18 @@
 #include <string>
 #include "core/ApplicationState.hpp"
 
+// Draws the top bar and side panels from the rects UiLayout laid out, and
+// acts on clicks that land on them
 class Panels {
 public:
-    static void drawTransformPanel(float panelX1, float panelY1, float panelWidth, float panelHeight,
-                                  const std::string& title, float values[3],
-                                  ApplicationState& state, int width, int height);
-    static void drawShapesPanel(float panelX1, float panelY1, float panelWidth, float panelHeight,
-                               ApplicationState& state, int width, int height);
-    static void drawTexturesPanel(float panelX1, float panelY1, float panelWidth, float panelHeight,
-                                 ApplicationState& state, int width, int height);
-    static void drawTopBarUI(int width, int height, ApplicationState& appState);
+    // panel is ActiveInputField::panelType: rotation, scaling or translation
+    static void drawTransformPanel(int panel, ApplicationState& state, int width, int height);
+    static void drawShapesPanel(ApplicationState& state, int width, int height);
+    static void drawTexturesPanel(ApplicationState& state, int width, int height);
+    static void drawTopBarUI(int width, int height);
+    static void drawStatsOverlay(float canvasX1, float canvasY2, int width, int height, ApplicationState& appState);
+    // Acts on a click on a UiLayout widget; false for -1, a click off the UI
+    static bool handleClick(int widget, ApplicationState& state);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+#ifndef UI_LAYOUT_HPP
+#define UI_LAYOUT_HPP
+
+#include <cstdint>
+#include <vector>
+#include "core/ApplicationState.hpp"
+#include "rendering/UiLayer.hpp"
+
+// Where every widget of the top bar, side panels and axis buttons sits, laid
+// out once per window size or panel scroll into a flat array: each widget
+// after its parent, siblings in the order they are drawn. Panels draw from
+// these rects and the input callbacks hit-test them, so the two can't drift.
+//
+// Hit testing goes through a grid of CELL_SIZE pixel cells over the window,
+// each listing the interactive widgets that overlap it, so finding the widget
+// under the cursor tests a few rects however many widgets there are.
+class UiLayout {
+public:
+    enum WidgetType {
+        TOP_BAR,
+        LOGO,
+        SAVE_BUTTON,
+        SAVE_AS_BUTTON,
+        UNDO_BUTTON,
+        REDO_BUTTON,
+        PROJECT_NAME,
+        NEW_PROJECT_BUTTON,
+        CAMERA_BUTTON,
+        COLORS_PANEL,
+        COLOR_SWATCH,       // index: color, see Panels::handleClick
+        SHADES_TOGGLE,
+        SHADES_LABEL,
+        LEFT_BAR,
+        TEXTURES_PANEL,
+        TEXTURE_BUTTON,     // index: texture
+        SHAPES_PANEL,
+        SHAPE_BUTTON,       // index: ShapeType minus ShapeType::CUBE
+        RIGHT_BAR,
+        TRANSFORM_PANEL,    // index: ActiveInputField::panelType
+        TRANSFORM_FIELD,    // index: panel * 3 + axis
+        RESET_BUTTON,       // index: panel
+        SCROLL_TRACK,       // index: textures panel, shapes panel, right bar
+        SCROLL_THUMB,
+        AXIS_GROUP,
+        AXIS_BUTTON,        // index: axis
+        WIDGET_TYPE_COUNT
+    };
+
+    struct Rect {
+        float x1, y1, x2, y2;
+
+        bool contains(float x, float y) const { return x >= x1 && x <= x2 && y >= y1 && y <= y2; }
+        bool isEmpty() const { return x1 > x2 || y1 > y2; }
+    };
+
+    struct Widget {
+        WidgetType type;
+        int index;
+        int parent;              // -1 for a bar
+        UiLayer::Region region;  // The UI layer region of its bar
+        bool interactive;
+        Rect rect;               // Window NDC
+        float width, height;     // Size it was laid out with; x2 - x1 can be a bit off it
+        Rect hit;                // rect clipped to the parents that clip it, empty when scrolled out of them
+        Rect clip;               // Where its children can be hit
+    };
+
+    struct Stats {
+        uint32_t builds = 0;
+        uint32_t hitTests = 0;
+        uint32_t rectsTested = 0;
+    };
+
+    static constexpr int CELL_SIZE = 32;
+
+    // Lays the UI out again when the window size or a panel scroll changed,
+    // then hit-tests the cursor against the new rects; true when it did
+    static bool update(int width, int height, const ApplicationState& state);
+
+    // Widget under the cursor, in window pixels from the top left as GLFW
+    // reports it, or -1; the topmost one where interactive widgets overlap
+    static int hitTest(double mouseX, double mouseY);
+    // Remembers the widget under the cursor for isHovered and hoveredIn; true
+    // when it is another widget than before
+    static bool setCursor(double mouseX, double mouseY);
+    // Whether the cursor is over the canvas the bars leave, where it can hover objects
+    static bool isOverCanvas(double mouseX, double mouseY);
+    static bool isHovered(WidgetType type, int index = 0);
+    // The hovered widget when it is in region, otherwise -1
+    static int hoveredIn(UiLayer::Region region);
+    // Scroll under the cursor, as SCROLL_TRACK indexes them, or -1: the
+    // textures panel, shapes panel or right bar containing the hit widget,
+    // or the panel itself over its background
+    static int scrollAt(double mouseX, double mouseY);
+    // How far that scroll goes below zero, the content height past what is
+    // visible; 0 when everything fits
+    static float maxScroll(int index) { return maxScrolls[index]; }
+
+    // Widget id of type and index, -1 when it is not laid out (a scroll bar
+    // with nothing to scroll)
+    static int find(WidgetType type, int index = 0);
+    static const Widget& get(WidgetType type, int index = 0) { return widgets[find(type, index)]; }
+    static const Widget& widget(int id) { return widgets[id]; }
+    static size_t widgetCount() { return widgets.size(); }
+    static int gridColumns() { return columns; }
+    static int gridRows() { return rows; }
+
+    static const Stats& getStats() { return stats; }
+    static void resetStats() { stats = Stats(); }
+
+private:
+    static constexpr int MAX_INDEX = 9; // Transform fields
+
+    static void build(const ApplicationState& state);
+    static void buildTopBar();
+    static void buildLeftBar(const ApplicationState& state);
+    static void buildRightBar(const ApplicationState& state);
+    static void buildAxisGroup();
+    static void buildGrid();
+    static int add(WidgetType type, int index, int parent, float x1, float y1, float x2, float y2);
+    static int add(WidgetType type, int index, int parent, float x1, float y1, float x2, float y2,
+                   float width, float height);
+    static int cellColumn(float x);
+    static int cellRow(float y);
+
+    static std::vector<Widget> widgets;
+    static int slots[WIDGET_TYPE_COUNT][MAX_INDEX];
+    static std::vector<uint32_t> cellStart;   // Per cell, into cellWidgets; one extra at the end
+    static std::vector<uint16_t> cellWidgets; // Widget ids, ascending within a cell
+    static int columns;
+    static int rows;
+    static int builtWidth;
+    static int builtHeight;
+    static float builtScrolls[3];
+    static float maxScrolls[3];
+    static int hovered;
+    static Stats stats;
+};
+
+#endif
@@ -0,0 +1,201 @@
+#include "../include/core/CommandBuffer.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace {
+    const char FILE_MAGIC[4] = {'B', 'L', 'C', 'B'};
+    const uint32_t FILE_VERSION = 1;
+
+    // Payload bytes every command of a type carries
+    uint16_t payloadSize(CommandType type) {
+        switch (type) {
+            case CommandType::BIND_MESH:
+            case CommandType::BIND_TEXTURE:
+            case CommandType::SET_BLEND:
+                return sizeof(int32_t);
+            case CommandType::SET_SCISSOR:
+                return sizeof(int32_t) * 4;
+            case CommandType::SET_MATRIX:
+                return sizeof(float) * 16;
+            case CommandType::SET_VECTOR:
+                return sizeof(float) * 4;
+            default:
+                return 0;
+        }
+    }
+}
+
+void CommandBuffer::push(CommandType type, uint8_t slot, const void* payload, uint16_t size) {
+    Header header = {type, slot, size};
+    size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(Header) + size);
+    std::memcpy(&bytes[offset], &header, sizeof(Header));
+    if (size > 0) {
+        std::memcpy(&bytes[offset + sizeof(Header)], payload, size);
+    }
+    commandCount++;
+}
+
+void CommandBuffer::bindMesh(uint32_t meshKey) {
+    push(CommandType::BIND_MESH, 0, &meshKey, sizeof(meshKey));
+}
+
+void CommandBuffer::bindTexture(int texture) {
+    int32_t value = texture;
+    push(CommandType::BIND_TEXTURE, 0, &value, sizeof(value));
+}
+
+void CommandBuffer::setBlend(bool enabled) {
+    int32_t value = enabled ? 1 : 0;
+    push(CommandType::SET_BLEND, 0, &value, sizeof(value));
+}
+
+void CommandBuffer::setScissor(int x, int y, int width, int height) {
+    int32_t box[4] = {x, y, width, height};
+    push(CommandType::SET_SCISSOR, 0, box, sizeof(box));
+}
+
+void CommandBuffer::disableScissor() {
+    push(CommandType::DISABLE_SCISSOR, 0, nullptr, 0);
+}
+
+void CommandBuffer::setMatrix(UniformSlot slot, const glm::mat4& matrix) {
+    push(CommandType::SET_MATRIX, (uint8_t)slot, &matrix[0][0], sizeof(float) * 16);
+}
+
+void CommandBuffer::setVector(UniformSlot slot, const glm::vec4& vector) {
+    push(CommandType::SET_VECTOR, (uint8_t)slot, &vector[0], sizeof(float) * 4);
+}
+
+void CommandBuffer::draw() {
+    push(CommandType::DRAW, 0, nullptr, 0);
+}
+
+bool CommandBuffer::next(size_t& offset, Command& command) const {
+    if (offset + sizeof(Header) > bytes.size()) {
+        return false;
+    }
+    Header header;
+    std::memcpy(&header, &bytes[offset], sizeof(Header));
+    if (offset + sizeof(Header) + header.size > bytes.size()) {
+        return false;
+    }
+    const unsigned char* payload = &bytes[offset] + sizeof(Header);
+    offset += sizeof(Header) + header.size;
+
+    command.type = header.type;
+    command.slot = (UniformSlot)header.slot;
+    command.floats = nullptr;
+    switch (header.type) {
+        case CommandType::SET_MATRIX:
+        case CommandType::SET_VECTOR:
+            // Payload offsets are multiples of four, so the floats can be read in place
+            command.floats = (const float*)payload;
+            break;
+        default:
+            std::memset(command.value, 0, sizeof(command.value));
+            std::memcpy(command.value, payload, header.size < sizeof(command.value) ? header.size : sizeof(command.value));
+            break;
+    }
+    return true;
+}
+
+CommandBuffer::Stats CommandBuffer::analyze() const {
+    Stats stats;
+    stats.bytes = bytes.size();
+    size_t offset = 0;
+    Command command;
+    while (next(offset, command)) {
+        if (command.type < CommandType::COUNT) {
+            stats.counts[(int)command.type]++;
+        }
+    }
+    return stats;
+}
+
+bool CommandBuffer::isWellFormed() const {
+    size_t offset = 0;
+    size_t commands = 0;
+    while (offset < bytes.size()) {
+        if (offset + sizeof(Header) > bytes.size()) {
+            return false;
+        }
+        Header header;
+        std::memcpy(&header, &bytes[offset], sizeof(Header));
+        if (header.type >= CommandType::COUNT || header.size != payloadSize(header.type) ||
+            offset + sizeof(Header) + header.size > bytes.size()) {
+            return false;
+        }
+        offset += sizeof(Header) + header.size;
+        commands++;
+    }
+    return commands == commandCount;
+}
+
+bool CommandBuffer::save(const std::string& path, const std::vector<CommandBuffer>& buffers) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cout << "ERROR: Cannot write command stream " << path << std::endl;
+        return false;
+    }
+    uint32_t count = (uint32_t)buffers.size();
+    bool ok = std::fwrite(FILE_MAGIC, 1, sizeof(FILE_MAGIC), file) == sizeof(FILE_MAGIC) &&
+              std::fwrite(&FILE_VERSION, sizeof(FILE_VERSION), 1, file) == 1 &&
+              std::fwrite(&count, sizeof(count), 1, file) == 1;
+    for (const CommandBuffer& buffer : buffers) {
+        uint64_t commands = buffer.commandCount;
+        uint64_t size = buffer.bytes.size();
+        ok = ok && std::fwrite(&commands, sizeof(commands), 1, file) == 1 &&
+             std::fwrite(&size, sizeof(size), 1, file) == 1 &&
+             (size == 0 || std::fwrite(buffer.bytes.data(), 1, size, file) == size);
+    }
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cout << "ERROR: Failed writing command stream " << path << std::endl;
+    }
+    return ok;
+}
+
+bool CommandBuffer::load(const std::string& path, std::vector<CommandBuffer>& buffers) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cout << "ERROR: Cannot read command stream " << path << std::endl;
+        return false;
+    }
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    // Buffer sizes are checked against what is left of the file before allocating
+    std::fseek(file, 0, SEEK_END);
+    long fileSize = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+
+    bool ok = fileSize >= 0 && std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              std::memcmp(magic, FILE_MAGIC, sizeof(magic)) == 0 &&
+              std::fread(&version, sizeof(version), 1, file) == 1 && version == FILE_VERSION &&
+              std::fread(&count, sizeof(count), 1, file) == 1;
+
+    buffers.clear();
+    for (uint32_t i = 0; ok && i < count; ++i) {
+        uint64_t commands = 0;
+        uint64_t size = 0;
+        ok = std::fread(&commands, sizeof(commands), 1, file) == 1 && std::fread(&size, sizeof(size), 1, file) == 1 &&
+             size <= (uint64_t)(fileSize - std::ftell(file));
+        if (!ok) {
+            break;
+        }
+        CommandBuffer buffer;
+        buffer.commandCount = (size_t)commands;
+        buffer.bytes.resize((size_t)size);
+        ok = (size == 0 || std::fread(buffer.bytes.data(), 1, (size_t)size, file) == size) && buffer.isWellFormed();
+        buffers.push_back(std::move(buffer));
+    }
+    std::fclose(file);
+    if (!ok) {
+        std::cout << "ERROR: Malformed command stream " << path << std::endl;
+        buffers.clear();
+    }
+    return ok;
+}
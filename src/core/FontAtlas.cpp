@@ -0,0 +1,159 @@
+#include "../include/core/FontAtlas.hpp"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+// stb_truetype packs with stb_rect_pack when it is included first
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "stb_rect_pack.h"
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "stb_truetype.h"
+
+namespace {
+    const int ATLAS_WIDTH = 256;
+    const int ATLAS_MAX_HEIGHT = 4096;
+    const int GLYPH_PADDING = 1;
+}
+
+bool FontAtlas::loadFile(const std::string& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good()) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !data.empty();
+}
+
+bool FontAtlas::build(const std::vector<uint8_t>& fontData, const std::vector<float>& pixelSizes) {
+    pixels.clear();
+    layouts.clear();
+    stbtt_fontinfo font;
+    if (fontData.empty() || pixelSizes.empty() ||
+        !stbtt_InitFont(&font, fontData.data(), stbtt_GetFontOffsetForIndex(fontData.data(), 0))) {
+        return false;
+    }
+
+    // Pack every size into one atlas, doubling its height until the glyphs fit
+    std::vector<stbtt_packedchar> packed(pixelSizes.size() * CHAR_COUNT);
+    std::vector<stbtt_pack_range> ranges(pixelSizes.size());
+    for (size_t s = 0; s < pixelSizes.size(); ++s) {
+        ranges[s] = stbtt_pack_range();
+        ranges[s].font_size = STBTT_POINT_SIZE(pixelSizes[s]);
+        ranges[s].first_unicode_codepoint_in_range = FIRST_CHAR;
+        ranges[s].num_chars = CHAR_COUNT;
+        ranges[s].chardata_for_range = &packed[s * CHAR_COUNT];
+    }
+    bool fits = false;
+    for (height = 64; height <= ATLAS_MAX_HEIGHT; height *= 2) {
+        width = ATLAS_WIDTH;
+        pixels.assign((size_t)width * height, 0);
+        stbtt_pack_context context;
+        if (!stbtt_PackBegin(&context, pixels.data(), width, height, 0, GLYPH_PADDING, nullptr)) {
+            break;
+        }
+        fits = stbtt_PackFontRanges(&context, fontData.data(), 0, ranges.data(), (int)ranges.size()) != 0;
+        stbtt_PackEnd(&context);
+        if (fits) {
+            break;
+        }
+    }
+    if (!fits) {
+        std::cout << "Font glyphs do not fit a " << ATLAS_WIDTH << "x" << ATLAS_MAX_HEIGHT << " atlas" << std::endl;
+        pixels.clear();
+        return false;
+    }
+
+    int fontAscent, fontDescent, lineGap;
+    stbtt_GetFontVMetrics(&font, &fontAscent, &fontDescent, &lineGap);
+    sizes = pixelSizes;
+    scales.resize(sizes.size());
+    ascents.resize(sizes.size());
+    descents.resize(sizes.size());
+    glyphs.resize(packed.size());
+    for (size_t s = 0; s < sizes.size(); ++s) {
+        scales[s] = stbtt_ScaleForMappingEmToPixels(&font, sizes[s]);
+        ascents[s] = fontAscent * scales[s];
+        descents[s] = fontDescent * scales[s];
+    }
+    for (size_t g = 0; g < packed.size(); ++g) {
+        const stbtt_packedchar& source = packed[g];
+        glyphs[g] = {source.x0, source.y0, source.x1, source.y1, source.xoff, source.yoff, source.xadvance};
+    }
+
+    // Kerning in font units, scaled per size when laying out
+    kerning.assign((size_t)CHAR_COUNT * CHAR_COUNT, 0);
+    for (int first = 0; first < CHAR_COUNT; ++first) {
+        for (int second = 0; second < CHAR_COUNT; ++second) {
+            kerning[first * CHAR_COUNT + second] =
+                (int16_t)stbtt_GetCodepointKernAdvance(&font, FIRST_CHAR + first, FIRST_CHAR + second);
+        }
+    }
+    layouts.resize(sizes.size());
+    return true;
+}
+
+int FontAtlas::sizeIndexFor(float pixelSize) const {
+    int best = 0;
+    for (int s = 1; s < (int)sizes.size(); ++s) {
+        if (std::fabs(sizes[s] - pixelSize) < std::fabs(sizes[best] - pixelSize)) {
+            best = s;
+        }
+    }
+    return best;
+}
+
+const FontAtlas::Layout& FontAtlas::layout(int size, const std::string& text) {
+    std::unordered_map<std::string, Layout>& cache = layouts[size];
+    auto it = cache.find(text);
+    if (it != cache.end()) {
+        stats.layoutHits++;
+        return it->second;
+    }
+    stats.layoutMisses++;
+    if (cache.size() >= LAYOUT_CACHE_MAX) {
+        cache.clear();
+    }
+
+    // Glyphs sit on whole pixels so the atlas texels map 1:1 to the screen
+    Layout result;
+    result.quads.reserve(text.size());
+    float pen = 0.0f;
+    int previous = -1;
+    for (char c : text) {
+        int character = (unsigned char)c - FIRST_CHAR;
+        if (character < 0 || character >= CHAR_COUNT) {
+            character = 0;
+        }
+        if (previous >= 0) {
+            pen += kerning[previous * CHAR_COUNT + character] * scales[size];
+        }
+        const Glyph& g = glyph(size, character);
+        if (g.x1 > g.x0 && g.y1 > g.y0) {
+            float x = std::floor(pen + g.xOffset + 0.5f);
+            float top = -std::floor(g.yOffset + 0.5f);
+            GlyphQuad quad;
+            quad.x0 = x;
+            quad.x1 = x + (g.x1 - g.x0);
+            quad.y1 = top;
+            quad.y0 = top - (g.y1 - g.y0);
+            quad.u0 = (float)g.x0 / width;
+            quad.u1 = (float)g.x1 / width;
+            quad.v0 = (float)g.y1 / height; // Bottom edge
+            quad.v1 = (float)g.y0 / height;
+            result.quads.push_back(quad);
+        }
+        pen += g.advance;
+        previous = character;
+    }
+    result.width = pen;
+    return cache.emplace(text, std::move(result)).first->second;
+}
+
+size_t FontAtlas::cachedLayouts() const {
+    size_t count = 0;
+    for (const auto& cache : layouts) {
+        count += cache.size();
+    }
+    return count;
+}
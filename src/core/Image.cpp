@@ -0,0 +1,79 @@
+#include "../include/core/Image.hpp"
+#include <iostream>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+bool Image::load(const std::string& path, Image& image) {
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load(false);
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        std::cout << "Failed to load image: " << path << " - " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(data, data + (size_t)width * height * 4);
+    stbi_image_free(data);
+    return true;
+}
+
+Image Image::fallbackTexture(int slot) {
+    const int texSize = 64;
+    Image image;
+    image.width = texSize;
+    image.height = texSize;
+    image.pixels.resize((size_t)texSize * texSize * 4);
+
+    // A different hue per slot
+    float hue = (slot * 60.0f) / 360.0f;
+    int hi = (int)(hue * 6);
+    float f = hue * 6 - hi;
+    float p = 0.0f;
+    float q = 1.0f - f;
+    float t = f;
+    float r, g, b;
+    switch (hi) {
+        case 0: r = 1.0f; g = t; b = p; break;
+        case 1: r = q; g = 1.0f; b = p; break;
+        case 2: r = p; g = 1.0f; b = t; break;
+        case 3: r = p; g = q; b = 1.0f; break;
+        case 4: r = t; g = p; b = 1.0f; break;
+        default: r = 1.0f; g = p; b = q; break;
+    }
+
+    for (int y = 0; y < texSize; y++) {
+        for (int x = 0; x < texSize; x++) {
+            uint8_t* pixel = &image.pixels[((size_t)y * texSize + x) * 4];
+
+            // White border and a bright center square mark it as a fallback
+            bool isBorder = (x < 4 || x >= texSize - 4 || y < 4 || y >= texSize - 4);
+            bool isCenter = (x >= texSize / 2 - 8 && x < texSize / 2 + 8 && y >= texSize / 2 - 8 && y < texSize / 2 + 8);
+            float scale = isCenter ? 255.0f : 128.0f;
+            if (isBorder) {
+                pixel[0] = pixel[1] = pixel[2] = 255;
+            } else {
+                pixel[0] = (uint8_t)(r * scale);
+                pixel[1] = (uint8_t)(g * scale);
+                pixel[2] = (uint8_t)(b * scale);
+            }
+            pixel[3] = 255;
+        }
+    }
+    return image;
+}
+
+bool Image::savePng(const std::string& path, bool flipRows) const {
+    if (empty()) {
+        return false;
+    }
+    stbi_flip_vertically_on_write(flipRows ? 1 : 0);
+    if (!stbi_write_png(path.c_str(), width, height, 4, pixels.data(), width * 4)) {
+        std::cout << "Failed to write image: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,143 @@
+#include "../include/core/RadixSort.hpp"
+#include <algorithm>
+#include <cstring>
+
+void RadixSort::countDigits(const std::vector<uint64_t>& keys) {
+    std::memset(counts, 0, sizeof(counts));
+    for (uint64_t key : keys) {
+        for (int pass = 0; pass < PASSES; ++pass) {
+            counts[pass][(key >> (pass * 8)) & 0xff]++;
+        }
+    }
+}
+
+void RadixSort::sort(std::vector<uint64_t>& keys) {
+    if (keys.size() < 2) {
+        return;
+    }
+    countDigits(keys);
+    keyScratch.resize(keys.size());
+
+    for (int pass = 0; pass < PASSES; ++pass) {
+        size_t* count = counts[pass];
+        int shift = pass * 8;
+        if (count[(keys[0] >> shift) & 0xff] == keys.size()) {
+            continue; // Every key has the same byte here
+        }
+
+        size_t offset = 0;
+        for (int digit = 0; digit < RADIX; ++digit) {
+            size_t n = count[digit];
+            count[digit] = offset;
+            offset += n;
+        }
+        for (uint64_t key : keys) {
+            keyScratch[count[(key >> shift) & 0xff]++] = key;
+        }
+        keys.swap(keyScratch);
+    }
+}
+
+void RadixSort::sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values) {
+    if (keys.size() < 2) {
+        return;
+    }
+    countDigits(keys);
+    keyScratch.resize(keys.size());
+    valueScratch.resize(values.size());
+
+    for (int pass = 0; pass < PASSES; ++pass) {
+        size_t* count = counts[pass];
+        int shift = pass * 8;
+        if (count[(keys[0] >> shift) & 0xff] == keys.size()) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int digit = 0; digit < RADIX; ++digit) {
+            size_t n = count[digit];
+            count[digit] = offset;
+            offset += n;
+        }
+        for (size_t i = 0; i < keys.size(); ++i) {
+            size_t destination = count[(keys[i] >> shift) & 0xff]++;
+            keyScratch[destination] = keys[i];
+            valueScratch[destination] = values[i];
+        }
+        keys.swap(keyScratch);
+        values.swap(valueScratch);
+    }
+}
+
+void RadixSort::sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, ThreadPool& pool) {
+    size_t n = keys.size();
+    if (n < PARALLEL_MIN_KEYS || pool.threadCount() == 1) {
+        sort(keys, values);
+        return;
+    }
+    keyScratch.resize(n);
+    valueScratch.resize(values.size());
+
+    // A few chunks per thread; chunk c always covers the same range, so the
+    // scatter offsets do not depend on which thread runs it
+    size_t chunkCount = std::min(n / 4096, (size_t)pool.threadCount() * 4);
+    chunkCounts.assign(chunkCount * PASSES * RADIX, 0);
+    auto chunkBegin = [&](size_t chunk) { return n * chunk / chunkCount; };
+    auto chunkDigits = [&](size_t chunk, int pass) { return &chunkCounts[(chunk * PASSES + pass) * RADIX]; };
+
+    // Every byte's histogram per chunk from one read; the totals show which
+    // bytes are the same in every key
+    pool.parallelFor(chunkCount, [&](size_t chunk, unsigned) {
+        for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+            for (int pass = 0; pass < PASSES; ++pass) {
+                chunkDigits(chunk, pass)[(keys[i] >> (pass * 8)) & 0xff]++;
+            }
+        }
+    });
+
+    bool firstPass = true;
+    for (int pass = 0; pass < PASSES; ++pass) {
+        int shift = pass * 8;
+        size_t sameDigit = 0;
+        int firstDigit = (int)((keys[0] >> shift) & 0xff);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            sameDigit += chunkDigits(chunk, pass)[firstDigit];
+        }
+        if (sameDigit == n) {
+            continue;
+        }
+
+        // Earlier passes reordered the keys, so the chunk histograms are stale
+        if (!firstPass) {
+            pool.parallelFor(chunkCount, [&](size_t chunk, unsigned) {
+                size_t* count = chunkDigits(chunk, pass);
+                std::fill(count, count + RADIX, (size_t)0);
+                for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+                    count[(keys[i] >> shift) & 0xff]++;
+                }
+            });
+        }
+        firstPass = false;
+
+        // Digit-major, chunk-minor offsets keep equal digits in input order
+        size_t offset = 0;
+        for (int digit = 0; digit < RADIX; ++digit) {
+            for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                size_t* count = chunkDigits(chunk, pass);
+                size_t c = count[digit];
+                count[digit] = offset;
+                offset += c;
+            }
+        }
+        pool.parallelFor(chunkCount, [&](size_t chunk, unsigned) {
+            size_t* count = chunkDigits(chunk, pass);
+            for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i) {
+                size_t destination = count[(keys[i] >> shift) & 0xff]++;
+                keyScratch[destination] = keys[i];
+                valueScratch[destination] = values[i];
+            }
+        });
+        keys.swap(keyScratch);
+        values.swap(valueScratch);
+    }
+}
@@ -0,0 +1,81 @@
+#include "../include/core/ThreadPool.hpp"
+
+ThreadPool::ThreadPool(unsigned workerCount) {
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i + 1);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t index, unsigned thread)>& fn) {
+    if (count == 0) {
+        return;
+    }
+    if (workers.empty() || count == 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        jobCount = count;
+        nextIndex.store(0, std::memory_order_relaxed);
+        pendingWorkers = (unsigned)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    runJob(0);
+
+    // Every worker checks in once per job, so fn stays alive until none can touch it
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return pendingWorkers == 0; });
+    job = nullptr;
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+    return pool;
+}
+
+void ThreadPool::workerLoop(unsigned thread) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        runJob(thread);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pendingWorkers == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runJob(unsigned thread) {
+    size_t index;
+    while ((index = nextIndex.fetch_add(1, std::memory_order_relaxed)) < jobCount) {
+        (*job)(index, thread);
+    }
+}
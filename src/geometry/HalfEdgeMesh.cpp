@@ -0,0 +1,156 @@
+#include "../include/geometry/HalfEdgeMesh.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+    struct PositionKey {
+        uint32_t bits[3];
+        bool operator==(const PositionKey& other) const {
+            return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+        }
+    };
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& key) const {
+            uint64_t h = key.bits[0] * 0x9e3779b1ULL;
+            h ^= (key.bits[1] + 0x85ebca6bULL) * 0xc2b2ae35ULL + (h << 6) + (h >> 2);
+            h ^= (key.bits[2] + 0x27d4eb2fULL) * 0x165667b1ULL + (h << 6) + (h >> 2);
+            return (size_t)h;
+        }
+    };
+
+    PositionKey makeKey(const float* position) {
+        PositionKey key;
+        for (int i = 0; i < 3; ++i) {
+            float value = position[i] + 0.0f; // Folds -0 into +0
+            std::memcpy(&key.bits[i], &value, sizeof(float));
+        }
+        return key;
+    }
+
+    // Higher vertex of an undirected edge plus the half-edge it came from
+    struct EdgeEntry {
+        uint32_t other;
+        int32_t halfEdge;
+    };
+}
+
+HalfEdgeMesh HalfEdgeMesh::fromMesh(const MeshData& mesh) {
+    HalfEdgeMesh result;
+    size_t faces = mesh.indices.size() / 3;
+    size_t halfEdges = faces * 3;
+
+    // Weld render vertices with bit-identical positions
+    std::vector<uint32_t> remap(mesh.vertices.size());
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> welded;
+    welded.reserve(mesh.vertices.size());
+    result.positions.reserve(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        const float* p = mesh.vertices[i].position;
+        auto inserted = welded.emplace(makeKey(p), (uint32_t)result.positions.size());
+        if (inserted.second) {
+            result.positions.emplace_back(p[0], p[1], p[2]);
+        }
+        remap[i] = inserted.first->second;
+    }
+
+    result.renderCorners.assign(mesh.indices.begin(), mesh.indices.begin() + halfEdges);
+    result.halfEdgeOrigin.resize(halfEdges);
+    for (size_t h = 0; h < halfEdges; ++h) {
+        result.halfEdgeOrigin[h] = remap[mesh.indices[h]];
+    }
+
+    // Pair half-edges by bucketing them on their lower vertex (counting sort), then
+    // sorting each bucket on the upper vertex so an edge's entries sit together;
+    // buckets are vertex valence sized, so this is O(valence log valence) per vertex
+    size_t vertexCount = result.positions.size();
+    std::vector<uint32_t> bucketStart(vertexCount + 1, 0);
+    for (size_t h = 0; h < halfEdges; ++h) {
+        uint32_t a = result.origin((int32_t)h), b = result.target((int32_t)h);
+        if (a != b) ++bucketStart[std::min(a, b) + 1];
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        bucketStart[v + 1] += bucketStart[v];
+    }
+    std::vector<EdgeEntry> edges(bucketStart[vertexCount]);
+    std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t h = 0; h < halfEdges; ++h) {
+        uint32_t a = result.origin((int32_t)h), b = result.target((int32_t)h);
+        if (a == b) continue; // Welding collapsed this edge
+        edges[fill[std::min(a, b)]++] = {std::max(a, b), (int32_t)h};
+    }
+
+    result.halfEdgeTwin.assign(halfEdges, INVALID);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        auto first = edges.begin() + bucketStart[v];
+        auto last = edges.begin() + bucketStart[v + 1];
+        std::sort(first, last, [](const EdgeEntry& a, const EdgeEntry& b) { return a.other < b.other; });
+
+        // A manifold edge yields exactly two entries running in opposite
+        // directions; non-manifold edges (three or more faces) stay unpaired
+        for (auto run = first; run != last;) {
+            auto end = run + 1;
+            while (end != last && end->other == run->other) ++end;
+            if (end - run == 2) {
+                int32_t h0 = run[0].halfEdge, h1 = run[1].halfEdge;
+                if (result.origin(h0) == result.target(h1)) {
+                    result.halfEdgeTwin[h0] = h1;
+                    result.halfEdgeTwin[h1] = h0;
+                }
+            }
+            run = end;
+        }
+    }
+
+    // Outgoing half-edge per vertex, preferring boundary ones so fans can be walked in one pass
+    result.vertexOutgoing.assign(result.positions.size(), INVALID);
+    for (size_t h = 0; h < halfEdges; ++h) {
+        int32_t& outgoing = result.vertexOutgoing[result.halfEdgeOrigin[h]];
+        if (outgoing == INVALID || result.halfEdgeTwin[h] == INVALID) {
+            outgoing = (int32_t)h;
+        }
+        if (result.halfEdgeTwin[h] == INVALID) {
+            result.boundary.push_back((int32_t)h);
+        }
+    }
+
+    return result;
+}
+
+bool HalfEdgeMesh::isBoundaryVertex(uint32_t v) const {
+    int32_t h = vertexOutgoing[v];
+    return h != INVALID && halfEdgeTwin[h] == INVALID;
+}
+
+void HalfEdgeMesh::faceNeighbors(int32_t f, int32_t out[3]) const {
+    for (int k = 0; k < 3; ++k) {
+        int32_t t = halfEdgeTwin[f * 3 + k];
+        out[k] = (t == INVALID) ? INVALID : face(t);
+    }
+}
+
+void HalfEdgeMesh::oneRing(uint32_t v, std::vector<uint32_t>& out) const {
+    out.clear();
+    forEachOneRing(v, [&out](uint32_t neighbor) { out.push_back(neighbor); });
+}
+
+glm::vec3 HalfEdgeMesh::faceNormal(int32_t f) const {
+    const glm::vec3& a = positions[halfEdgeOrigin[f * 3]];
+    const glm::vec3& b = positions[halfEdgeOrigin[f * 3 + 1]];
+    const glm::vec3& c = positions[halfEdgeOrigin[f * 3 + 2]];
+    glm::vec3 n = glm::cross(b - a, c - a);
+    float len = glm::length(n);
+    return len > 0.0f ? n / len : glm::vec3(0.0f);
+}
+
+glm::vec3 HalfEdgeMesh::faceCentroid(int32_t f) const {
+    return (positions[halfEdgeOrigin[f * 3]] + positions[halfEdgeOrigin[f * 3 + 1]] +
+            positions[halfEdgeOrigin[f * 3 + 2]]) / 3.0f;
+}
+
+size_t HalfEdgeMesh::byteSize() const {
+    return positions.size() * sizeof(glm::vec3) + halfEdgeOrigin.size() * sizeof(uint32_t) +
+           halfEdgeTwin.size() * sizeof(int32_t) + vertexOutgoing.size() * sizeof(int32_t) +
+           renderCorners.size() * sizeof(uint32_t) + boundary.size() * sizeof(int32_t);
+}
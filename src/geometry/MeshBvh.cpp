@@ -0,0 +1,259 @@
+#include "../include/geometry/MeshBvh.hpp"
+#include "../include/math/RayKernels.hpp"
+#include <algorithm>
+
+namespace {
+    const float EMPTY_MIN = 1e30f;
+    const float EMPTY_MAX = -1e30f;
+    const float DETERMINANT_EPSILON = 1e-12f;
+
+    struct Range {
+        uint32_t begin;
+        uint32_t end;
+    };
+}
+
+MeshBvh MeshBvh::build(const MeshData& mesh) {
+    MeshBvh bvh;
+    bvh.positions.reserve(mesh.vertices.size());
+    for (const Vertex& vertex : mesh.vertices) {
+        bvh.positions.emplace_back(vertex.position[0], vertex.position[1], vertex.position[2]);
+    }
+    bvh.indices = mesh.indices;
+
+    uint32_t count = (uint32_t)mesh.triangleCount();
+    if (count == 0) {
+        return bvh;
+    }
+
+    std::vector<BuildItem> items(count);
+    for (uint32_t face = 0; face < count; ++face) {
+        glm::vec3 a, b, c;
+        bvh.triangle(face, a, b, c);
+        items[face].boundsMin = glm::min(a, glm::min(b, c));
+        items[face].boundsMax = glm::max(a, glm::max(b, c));
+        items[face].centroid = items[face].boundsMin + items[face].boundsMax;
+        items[face].face = face;
+    }
+
+    bvh.nodes.reserve(count / (WIDTH * 4) + 1);
+    bvh.packets.reserve(count / (WIDTH / 2) + 1);
+    bvh.buildNode(items, 0, count);
+    return bvh;
+}
+
+bool MeshBvh::intersect(const Ray& ray, float maxDistance, TriangleHit& hit) const {
+    if (nodes.empty()) {
+        return false;
+    }
+
+    RayLanes lanes(ray);
+
+    struct Entry {
+        uint32_t node;
+        float distance;
+    };
+    Entry stack[64 * WIDTH];
+    int stackSize = 0;
+    stack[stackSize++] = Entry{0, 0.0f};
+
+    float best = maxDistance;
+    bool found = false;
+    alignas(32) float entry[WIDTH];
+
+    while (stackSize > 0) {
+        Entry current = stack[--stackSize];
+        if (current.distance >= best) {
+            continue;
+        }
+        const Node& node = nodes[current.node];
+        uint32_t hitMask = intersectRayBoxes(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, lanes,
+                                             best, entry);
+
+        // Visit the hit lanes nearest first: packets are tested right away,
+        // child nodes are pushed so the nearest one is popped next
+        int order[WIDTH];
+        int hitCount = 0;
+        for (int lane = 0; lane < WIDTH; ++lane) {
+            if ((hitMask & (1u << lane)) && node.child[lane] != EMPTY) {
+                int k = hitCount++;
+                while (k > 0 && entry[order[k - 1]] > entry[lane]) {
+                    order[k] = order[k - 1];
+                    --k;
+                }
+                order[k] = lane;
+            }
+        }
+
+        for (int k = hitCount; k-- > 0;) {
+            uint32_t child = node.child[order[k]];
+            if (!(child & LEAF_BIT)) {
+                stack[stackSize++] = Entry{child, entry[order[k]]};
+            }
+        }
+        for (int k = 0; k < hitCount; ++k) {
+            uint32_t child = node.child[order[k]];
+            if ((child & LEAF_BIT) && entry[order[k]] < best &&
+                intersectPacket(packets[child & ~LEAF_BIT], ray, best, hit)) {
+                best = hit.distance;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+void MeshBvh::triangle(uint32_t face, glm::vec3& a, glm::vec3& b, glm::vec3& c) const {
+    a = positions[indices[face * 3]];
+    b = positions[indices[face * 3 + 1]];
+    c = positions[indices[face * 3 + 2]];
+}
+
+size_t MeshBvh::byteSize() const {
+    return nodes.size() * sizeof(Node) + packets.size() * sizeof(Packet) +
+           positions.size() * sizeof(glm::vec3) + indices.size() * sizeof(uint32_t);
+}
+
+uint32_t MeshBvh::buildNode(std::vector<BuildItem>& items, uint32_t begin, uint32_t end) {
+    uint32_t node = (uint32_t)nodes.size();
+    nodes.emplace_back();
+    for (int lane = 0; lane < WIDTH; ++lane) {
+        nodes[node].minX[lane] = nodes[node].minY[lane] = nodes[node].minZ[lane] = EMPTY_MIN;
+        nodes[node].maxX[lane] = nodes[node].maxY[lane] = nodes[node].maxZ[lane] = EMPTY_MAX;
+        nodes[node].child[lane] = EMPTY;
+    }
+
+    // Halve the largest group at the centroid median of its widest axis until
+    // there are WIDTH groups or every group fits in one packet
+    Range groups[WIDTH];
+    int groupCount = 1;
+    groups[0] = Range{begin, end};
+    while (groupCount < WIDTH) {
+        int largest = 0;
+        for (int g = 1; g < groupCount; ++g) {
+            if (groups[g].end - groups[g].begin > groups[largest].end - groups[largest].begin) {
+                largest = g;
+            }
+        }
+        Range range = groups[largest];
+        if (range.end - range.begin <= (uint32_t)WIDTH) {
+            break;
+        }
+
+        glm::vec3 centroidMin(EMPTY_MIN), centroidMax(EMPTY_MAX);
+        for (uint32_t i = range.begin; i < range.end; ++i) {
+            centroidMin = glm::min(centroidMin, items[i].centroid);
+            centroidMax = glm::max(centroidMax, items[i].centroid);
+        }
+        glm::vec3 extent = centroidMax - centroidMin;
+        int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+        uint32_t mid = range.begin + (range.end - range.begin) / 2;
+        std::nth_element(items.begin() + range.begin, items.begin() + mid, items.begin() + range.end,
+                         [axis](const BuildItem& a, const BuildItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+        groups[largest] = Range{range.begin, mid};
+        groups[groupCount++] = Range{mid, range.end};
+    }
+
+    for (int lane = 0; lane < groupCount; ++lane) {
+        const Range& range = groups[lane];
+        glm::vec3 boundsMin(EMPTY_MIN), boundsMax(EMPTY_MAX);
+        for (uint32_t i = range.begin; i < range.end; ++i) {
+            boundsMin = glm::min(boundsMin, items[i].boundsMin);
+            boundsMax = glm::max(boundsMax, items[i].boundsMax);
+        }
+
+        uint32_t child = range.end - range.begin <= (uint32_t)WIDTH
+                             ? LEAF_BIT | buildPacket(items, range.begin, range.end)
+                             : buildNode(items, range.begin, range.end);
+        Node& target = nodes[node];
+        target.child[lane] = child;
+        target.minX[lane] = boundsMin.x;
+        target.minY[lane] = boundsMin.y;
+        target.minZ[lane] = boundsMin.z;
+        target.maxX[lane] = boundsMax.x;
+        target.maxY[lane] = boundsMax.y;
+        target.maxZ[lane] = boundsMax.z;
+    }
+    return node;
+}
+
+uint32_t MeshBvh::buildPacket(const std::vector<BuildItem>& items, uint32_t begin, uint32_t end) {
+    uint32_t index = (uint32_t)packets.size();
+    packets.emplace_back();
+    Packet& packet = packets.back();
+
+    for (int lane = 0; lane < WIDTH; ++lane) {
+        // Unused lanes repeat a zero-area triangle, which the determinant test rejects
+        glm::vec3 a(0.0f), b(0.0f), c(0.0f);
+        uint32_t face = EMPTY;
+        if (begin + lane < end) {
+            face = items[begin + lane].face;
+            triangle(face, a, b, c);
+        }
+        glm::vec3 edge1 = b - a;
+        glm::vec3 edge2 = c - a;
+        packet.v0x[lane] = a.x;
+        packet.v0y[lane] = a.y;
+        packet.v0z[lane] = a.z;
+        packet.e1x[lane] = edge1.x;
+        packet.e1y[lane] = edge1.y;
+        packet.e1z[lane] = edge1.z;
+        packet.e2x[lane] = edge2.x;
+        packet.e2y[lane] = edge2.y;
+        packet.e2z[lane] = edge2.z;
+        packet.face[lane] = face;
+    }
+    return index;
+}
+
+bool MeshBvh::intersectPacket(const Packet& packet, const Ray& ray, float maxDistance, TriangleHit& hit) const {
+    // Moller-Trumbore on eight triangles at once
+    Float8 dx = Float8::broadcast(ray.direction.x);
+    Float8 dy = Float8::broadcast(ray.direction.y);
+    Float8 dz = Float8::broadcast(ray.direction.z);
+    Float8 e1x = Float8::load(packet.e1x), e1y = Float8::load(packet.e1y), e1z = Float8::load(packet.e1z);
+    Float8 e2x = Float8::load(packet.e2x), e2y = Float8::load(packet.e2y), e2z = Float8::load(packet.e2z);
+
+    Float8 px = dy * e2z - dz * e2y;
+    Float8 py = dz * e2x - dx * e2z;
+    Float8 pz = dx * e2y - dy * e2x;
+    Float8 determinant = e1x * px + e1y * py + e1z * pz;
+    Float8 inverse = Float8::broadcast(1.0f) / determinant;
+
+    Float8 sx = Float8::broadcast(ray.origin.x) - Float8::load(packet.v0x);
+    Float8 sy = Float8::broadcast(ray.origin.y) - Float8::load(packet.v0y);
+    Float8 sz = Float8::broadcast(ray.origin.z) - Float8::load(packet.v0z);
+    Float8 u = (sx * px + sy * py + sz * pz) * inverse;
+
+    Float8 qx = sy * e1z - sz * e1y;
+    Float8 qy = sz * e1x - sx * e1z;
+    Float8 qz = sx * e1y - sy * e1x;
+    Float8 v = (dx * qx + dy * qy + dz * qz) * inverse;
+    Float8 t = (e2x * qx + e2y * qy + e2z * qz) * inverse;
+
+    Float8 zero = Float8::broadcast(0.0f);
+    Float8 epsilon = Float8::broadcast(DETERMINANT_EPSILON);
+    Float8 valid = ((epsilon < determinant) | (determinant < zero - epsilon)) & (zero <= u) & (zero <= v) &
+                   (u + v <= Float8::broadcast(1.0f)) & (zero <= t) & (t < Float8::broadcast(maxDistance));
+    uint32_t mask = valid.mask();
+    if (mask == 0) {
+        return false;
+    }
+
+    alignas(32) float distances[WIDTH], us[WIDTH], vs[WIDTH];
+    t.store(distances);
+    u.store(us);
+    v.store(vs);
+    int nearest = -1;
+    for (int lane = 0; lane < WIDTH; ++lane) {
+        if ((mask & (1u << lane)) && (nearest < 0 || distances[lane] < distances[nearest])) {
+            nearest = lane;
+        }
+    }
+    hit.distance = distances[nearest];
+    hit.face = packet.face[nearest];
+    hit.u = us[nearest];
+    hit.v = vs[nearest];
+    return true;
+}
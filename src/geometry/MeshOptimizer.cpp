@@ -0,0 +1,354 @@
+#include "../include/geometry/MeshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+    struct VertexKey {
+        uint32_t bits[8];
+        bool operator==(const VertexKey& other) const {
+            return std::memcmp(bits, other.bits, sizeof(bits)) == 0;
+        }
+    };
+
+    struct VertexKeyHash {
+        size_t operator()(const VertexKey& key) const {
+            uint64_t h = 0xcbf29ce484222325ULL;
+            for (uint32_t word : key.bits) {
+                h = (h ^ word) * 0x100000001b3ULL;
+            }
+            return (size_t)(h ^ (h >> 32));
+        }
+    };
+
+    VertexKey makeKey(const Vertex& vertex) {
+        VertexKey key;
+        const float* values = reinterpret_cast<const float*>(&vertex);
+        for (int i = 0; i < 8; ++i) {
+            float value = values[i] + 0.0f; // Folds -0 into +0
+            std::memcpy(&key.bits[i], &value, sizeof(float));
+        }
+        return key;
+    }
+
+    // Forsyth's scoring: recently used vertices and low remaining valence win
+    const float CACHE_DECAY_POWER = 1.5f;
+    const float LAST_TRIANGLE_SCORE = 0.75f;
+    const float VALENCE_BOOST_SCALE = 2.0f;
+    const float VALENCE_BOOST_POWER = 0.5f;
+
+    float vertexScore(int cachePosition, uint32_t remaining) {
+        if (remaining == 0) {
+            return -1.0f;
+        }
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                score = LAST_TRIANGLE_SCORE;
+            } else {
+                const float scaler = 1.0f / (MeshOptimizer::FORSYTH_CACHE_SIZE - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+        return score + VALENCE_BOOST_SCALE * std::pow((float)remaining, -VALENCE_BOOST_POWER);
+    }
+
+    // Simulated FIFO; calls onMiss(triangle, misses) for each triangle
+    template <typename Fn>
+    void simulateFifo(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize, Fn onTriangle) {
+        std::vector<uint32_t> stamp(vertexCount, 0);
+        uint32_t time = (uint32_t)cacheSize + 1;
+        for (size_t t = 0; t < indices.size() / 3; ++t) {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = indices[t * 3 + k];
+                if (time - stamp[v] > (uint32_t)cacheSize) {
+                    stamp[v] = time++;
+                    ++misses;
+                }
+            }
+            onTriangle(t, misses);
+        }
+    }
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(MeshData& mesh) {
+    return optimize(mesh, Options());
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(MeshData& mesh, const Options& options) {
+    Report report;
+    report.verticesBefore = mesh.vertices.size();
+    report.before = analyzeVertexCache(mesh.indices, mesh.vertices.size());
+
+    if (options.weld) {
+        weldVertices(mesh);
+    }
+    if (options.vertexCache) {
+        optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    }
+    if (options.overdraw) {
+        report.overdrawApplied = optimizeOverdraw(mesh.indices, mesh.vertices, options.overdrawThreshold);
+    }
+    optimizeVertexFetch(mesh);
+
+    report.verticesAfter = mesh.vertices.size();
+    report.after = analyzeVertexCache(mesh.indices, mesh.vertices.size());
+    return report;
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                                            int cacheSize) {
+    CacheStats result;
+    size_t triangles = indices.size() / 3;
+    if (triangles == 0) {
+        return result;
+    }
+
+    size_t transformed = 0;
+    simulateFifo(indices, vertexCount, cacheSize, [&transformed](size_t, int misses) { transformed += misses; });
+
+    std::vector<bool> referenced(vertexCount, false);
+    size_t unique = 0;
+    for (uint32_t index : indices) {
+        if (!referenced[index]) {
+            referenced[index] = true;
+            ++unique;
+        }
+    }
+
+    result.acmr = (float)transformed / triangles;
+    result.atvr = (float)transformed / unique;
+    return result;
+}
+
+void MeshOptimizer::weldVertices(MeshData& mesh) {
+    std::vector<uint32_t> remap(mesh.vertices.size());
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+    unique.reserve(mesh.vertices.size());
+
+    std::vector<Vertex> welded;
+    welded.reserve(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        auto inserted = unique.emplace(makeKey(mesh.vertices[i]), (uint32_t)welded.size());
+        if (inserted.second) {
+            welded.push_back(mesh.vertices[i]);
+        }
+        remap[i] = inserted.first->second;
+    }
+    if (welded.size() == mesh.vertices.size()) {
+        return;
+    }
+
+    for (uint32_t& index : mesh.indices) {
+        index = remap[index];
+    }
+    mesh.vertices.swap(welded);
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Triangles adjacent to each vertex, in CSR form
+    std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (uint32_t index : indices) {
+        ++adjacencyStart[index + 1];
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyStart[v + 1] += adjacencyStart[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        uint32_t v = indices[i];
+        adjacency[adjacencyStart[v] + remaining[v]++] = (uint32_t)(i / 3);
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        score[v] = vertexScore(-1, remaining[v]);
+    }
+    std::vector<float> triangleScore(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+
+    // Cache holds up to FORSYTH_CACHE_SIZE entries plus the three being pushed
+    std::vector<uint32_t> cache, nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    size_t scanCursor = 0;
+    int64_t best = 0;
+    float bestScore = triangleScore[0];
+    for (size_t t = 1; t < triangleCount; ++t) {
+        if (triangleScore[t] > bestScore) {
+            bestScore = triangleScore[t];
+            best = (int64_t)t;
+        }
+    }
+
+    while (true) {
+        if (best < 0) {
+            // Nothing adjacent to the cache is left; resume from the first unemitted triangle
+            while (scanCursor < triangleCount && emitted[scanCursor]) ++scanCursor;
+            if (scanCursor == triangleCount) break;
+            best = (int64_t)scanCursor;
+        }
+
+        uint32_t t = (uint32_t)best;
+        emitted[t] = true;
+        const uint32_t* tri = &indices[(size_t)t * 3];
+        output.insert(output.end(), tri, tri + 3);
+
+        // Drop the triangle from its vertices' adjacency lists
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            uint32_t* begin = &adjacency[adjacencyStart[v]];
+            uint32_t* end = begin + remaining[v];
+            *std::find(begin, end, t) = *(end - 1);
+            --remaining[v];
+        }
+
+        // Move the triangle's vertices to the front of the LRU cache
+        nextCache.assign(tri, tri + 3);
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                nextCache.push_back(v);
+            }
+        }
+        cache.swap(nextCache);
+
+        // Rescore cached vertices (and those just evicted) and their triangles
+        for (size_t i = 0; i < cache.size(); ++i) {
+            uint32_t v = cache[i];
+            cachePosition[v] = (i < (size_t)FORSYTH_CACHE_SIZE) ? (int)i : -1;
+            float newScore = vertexScore(cachePosition[v], remaining[v]);
+            float delta = newScore - score[v];
+            score[v] = newScore;
+            for (uint32_t a = adjacencyStart[v]; a < adjacencyStart[v] + remaining[v]; ++a) {
+                triangleScore[adjacency[a]] += delta;
+            }
+        }
+        if (cache.size() > (size_t)FORSYTH_CACHE_SIZE) {
+            cache.resize(FORSYTH_CACHE_SIZE);
+        }
+
+        // Next triangle is the best one touching the cache
+        best = -1;
+        bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t a = adjacencyStart[v]; a < adjacencyStart[v] + remaining[v]; ++a) {
+                uint32_t candidate = adjacency[a];
+                if (triangleScore[candidate] > bestScore) {
+                    bestScore = triangleScore[candidate];
+                    best = candidate;
+                }
+            }
+        }
+    }
+
+    indices.swap(output);
+}
+
+bool MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+                                     float threshold) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return false;
+    }
+    CacheStats baseline = analyzeVertexCache(indices, vertices.size());
+
+    // Clusters start wherever the cache fully restarts (all three vertices missed)
+    std::vector<size_t> clusterStart;
+    simulateFifo(indices, vertices.size(), ANALYSIS_CACHE_SIZE, [&clusterStart](size_t t, int misses) {
+        if (t == 0 || misses == 3) clusterStart.push_back(t);
+    });
+    clusterStart.push_back(triangleCount);
+    size_t clusterCount = clusterStart.size() - 1;
+    if (clusterCount < 2) {
+        return false;
+    }
+
+    // Area-weighted mesh centroid, then per-cluster centroid and average normal
+    double meshCenter[3] = {0.0, 0.0, 0.0};
+    double meshArea = 0.0;
+    std::vector<double> clusterData(clusterCount * 7, 0.0); // centroid xyz, normal xyz, area
+    for (size_t c = 0; c < clusterCount; ++c) {
+        double* data = &clusterData[c * 7];
+        for (size_t t = clusterStart[c]; t < clusterStart[c + 1]; ++t) {
+            const float* a = vertices[indices[t * 3]].position;
+            const float* b = vertices[indices[t * 3 + 1]].position;
+            const float* p = vertices[indices[t * 3 + 2]].position;
+            double u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            double v[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+            double n[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+            double area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * 0.5;
+            for (int k = 0; k < 3; ++k) {
+                data[k] += (a[k] + b[k] + p[k]) / 3.0 * area;
+                data[k + 3] += n[k] * 0.5;
+            }
+            data[6] += area;
+        }
+        for (int k = 0; k < 3; ++k) meshCenter[k] += data[k];
+        meshArea += data[6];
+    }
+    if (meshArea <= 0.0) {
+        return false;
+    }
+    for (int k = 0; k < 3; ++k) meshCenter[k] /= meshArea;
+
+    // Clusters facing outward from the center draw first: they tend to occlude the rest
+    std::vector<std::pair<double, size_t>> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        const double* data = &clusterData[c * 7];
+        double key = 0.0;
+        double normalLength = std::sqrt(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+        if (data[6] > 0.0 && normalLength > 0.0) {
+            for (int k = 0; k < 3; ++k) {
+                key += (data[k] / data[6] - meshCenter[k]) * data[k + 3] / normalLength;
+            }
+        }
+        order[c] = std::make_pair(-key, c);
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) { return a.first < b.first; });
+
+    std::vector<uint32_t> sorted;
+    sorted.reserve(indices.size());
+    for (const auto& entry : order) {
+        size_t c = entry.second;
+        sorted.insert(sorted.end(), indices.begin() + clusterStart[c] * 3, indices.begin() + clusterStart[c + 1] * 3);
+    }
+
+    if (analyzeVertexCache(sorted, vertices.size()).acmr > baseline.acmr * threshold) {
+        return false;
+    }
+    indices.swap(sorted);
+    return true;
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& mesh) {
+    const uint32_t UNUSED = 0xffffffffu;
+    std::vector<uint32_t> remap(mesh.vertices.size(), UNUSED);
+    std::vector<Vertex> ordered;
+    ordered.reserve(mesh.vertices.size());
+
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = (uint32_t)ordered.size();
+            ordered.push_back(mesh.vertices[index]);
+        }
+        index = remap[index];
+    }
+    mesh.vertices.swap(ordered);
+}
@@ -0,0 +1,244 @@
+#include "../include/geometry/PrimitiveGenerator.hpp"
+#include "../include/geometry/PrimitiveTables.hpp"
+#include "../include/geometry/Tessellator.hpp"
+#include <cmath>
+#include <functional>
+
+namespace {
+    Vertex lane(float x, float y, float z, float nx, float ny, float nz, float s, float t) {
+        return {{x, y, z}, {nx, ny, nz}, {s, t}};
+    }
+
+    // Copies a unit-size table, scaling positions and renormalizing normals
+    MeshData fromTable(const Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount,
+                       float sx, float sy, float sz) {
+        MeshData mesh;
+        mesh.vertices.assign(vertices, vertices + vertexCount);
+        mesh.indices.assign(indices, indices + indexCount);
+        if (sx == 1.0f && sy == 1.0f && sz == 1.0f) {
+            return mesh;
+        }
+        for (Vertex& v : mesh.vertices) {
+            v.position[0] *= sx;
+            v.position[1] *= sy;
+            v.position[2] *= sz;
+            float nx = v.normal[0] / sx, ny = v.normal[1] / sy, nz = v.normal[2] / sz;
+            float len = std::sqrt(nx * nx + ny * ny + nz * nz);
+            v.normal[0] = nx / len;
+            v.normal[1] = ny / len;
+            v.normal[2] = nz / len;
+        }
+        return mesh;
+    }
+
+    // Flat cap at height y: center vertex followed by a ring of slices + 1 vertices
+    void addCap(MeshData& mesh, const RingTable& ring, float radius, float y, bool facingUp) {
+        int count = ring.segments + 1;
+        float ny = facingUp ? 1.0f : -1.0f;
+
+        std::vector<Vertex> lanes(count);
+        for (int i = 0; i < count; ++i) {
+            lanes[i] = lane(ring.cos[i], 0.0f, ring.sin[i], 0.0f, 0.0f, 0.0f, ring.cos[i], ring.sin[i]);
+        }
+
+        uint32_t center = (uint32_t)mesh.vertices.size();
+        mesh.vertices.push_back(lane(0.0f, y, 0.0f, 0.0f, ny, 0.0f, 0.5f, 0.5f));
+        mesh.vertices.resize(mesh.vertices.size() + count);
+        Tessellator::emitRow(&mesh.vertices[center + 1], lanes.data(),
+                             lane(radius, 0.0f, radius, 0.0f, 0.0f, 0.0f, 0.5f, 0.5f),
+                             lane(0.0f, y, 0.0f, 0.0f, ny, 0.0f, 0.5f, 0.5f), count);
+        Tessellator::appendFanIndices(mesh.indices, center, center + 1, ring.segments, facingUp);
+    }
+}
+
+PrimitiveParams PrimitiveParams::defaultsFor(ShapeType shape) {
+    PrimitiveParams params;
+    params.shape = shape;
+    switch (shape) {
+        case ShapeType::CUBE:
+            params.radius = 1.0f;
+            break;
+        case ShapeType::SPHERE:
+            params.radius = 0.5f;
+            params.slices = 20;
+            params.stacks = 20;
+            break;
+        case ShapeType::CONE:
+        case ShapeType::CYLINDER:
+            params.radius = 0.5f;
+            params.height = 1.0f;
+            params.slices = 20;
+            break;
+        case ShapeType::TORUS:
+            params.radius = 0.5f;
+            params.height = 0.2f;
+            params.slices = 20;
+            params.stacks = 10;
+            break;
+        case ShapeType::PYRAMID:
+            params.radius = 1.0f;
+            params.height = 1.0f;
+            break;
+        default:
+            break;
+    }
+    return params;
+}
+
+size_t PrimitiveParamsHash::operator()(const PrimitiveParams& params) const {
+    size_t seed = std::hash<int>()(static_cast<int>(params.shape));
+    auto combine = [&seed](size_t value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+    };
+    combine(std::hash<float>()(params.radius));
+    combine(std::hash<float>()(params.height));
+    combine(std::hash<int>()(params.slices));
+    combine(std::hash<int>()(params.stacks));
+    return seed;
+}
+
+MeshData PrimitiveGenerator::generate(const PrimitiveParams& params) {
+    switch (params.shape) {
+        case ShapeType::CUBE:
+            return generateCube(params.radius);
+        case ShapeType::SPHERE:
+            return generateSphere(params.radius, params.slices, params.stacks);
+        case ShapeType::CONE:
+            return generateCone(params.radius, params.height, params.slices);
+        case ShapeType::CYLINDER:
+            return generateCylinder(params.radius, params.height, params.slices);
+        case ShapeType::TORUS:
+            return generateTorus(params.radius, params.height, params.slices, params.stacks);
+        case ShapeType::PYRAMID:
+            return generatePyramid(params.radius, params.height);
+        default:
+            return MeshData();
+    }
+}
+
+HalfEdgeMesh PrimitiveGenerator::generateTopology(const PrimitiveParams& params) {
+    return HalfEdgeMesh::fromMesh(generate(params));
+}
+
+MeshData PrimitiveGenerator::generateCube(float size) {
+    return fromTable(PrimitiveTables::CUBE_VERTICES, 24, PrimitiveTables::CUBE_INDICES, 36, size, size, size);
+}
+
+MeshData PrimitiveGenerator::generateSphere(float radius, int slices, int stacks) {
+    const RingTable& theta = Tessellator::ring(slices);
+    const RingTable& phi = Tessellator::ring(stacks, true);
+    int cols = slices + 1;
+
+    std::vector<Vertex> lanes(cols);
+    for (int j = 0; j < cols; ++j) {
+        lanes[j] = lane(theta.cos[j], 0.0f, theta.sin[j], theta.cos[j], 0.0f, theta.sin[j], theta.u[j], 0.0f);
+    }
+
+    MeshData mesh;
+    mesh.vertices.resize((size_t)(stacks + 1) * cols);
+    for (int i = 0; i <= stacks; ++i) {
+        float sinPhi = phi.sin[i];
+        float cosPhi = phi.cos[i];
+        // Texture coordinates based on spherical mapping
+        Tessellator::emitRow(&mesh.vertices[(size_t)i * cols], lanes.data(),
+                             lane(radius * sinPhi, 0.0f, radius * sinPhi, sinPhi, 0.0f, sinPhi, 1.0f, 0.0f),
+                             lane(0.0f, radius * cosPhi, 0.0f, 0.0f, cosPhi, 0.0f, 0.0f, phi.u[i]), cols);
+    }
+
+    // Skip the zero-area triangles that touch the poles
+    Tessellator::appendGridIndices(mesh.indices, 0, stacks + 1, cols, true, true);
+    return mesh;
+}
+
+MeshData PrimitiveGenerator::generateCone(float base, float height, int slices) {
+    const RingTable& ring = Tessellator::ring(slices);
+    const RingTable& mid = Tessellator::ring(slices * 2);
+    int count = slices + 1;
+
+    MeshData mesh;
+    mesh.vertices.reserve(count + 1 + count + slices);
+    mesh.indices.reserve((size_t)slices * 6);
+
+    addCap(mesh, ring, base, -height / 2, false);
+
+    // Side: one apex per segment so every triangle gets a usable apex normal
+    float slant = std::sqrt(height * height + base * base);
+    float ny = base / slant;
+    float nr = height / slant;
+
+    std::vector<Vertex> lanes(count);
+    for (int i = 0; i < count; ++i) {
+        lanes[i] = lane(ring.cos[i], 0.0f, ring.sin[i], ring.cos[i], 0.0f, ring.sin[i], ring.u[i], 0.0f);
+    }
+    uint32_t side = (uint32_t)mesh.vertices.size();
+    mesh.vertices.resize(mesh.vertices.size() + count);
+    Tessellator::emitRow(&mesh.vertices[side], lanes.data(),
+                         lane(base, 0.0f, base, nr, 0.0f, nr, 1.0f, 0.0f),
+                         lane(0.0f, -height / 2, 0.0f, 0.0f, ny, 0.0f, 0.0f, 0.0f), count);
+
+    uint32_t apex = (uint32_t)mesh.vertices.size();
+    for (int i = 0; i < slices; ++i) {
+        mesh.vertices.push_back(lane(0.0f, height / 2, 0.0f, nr * mid.cos[i * 2 + 1], ny, nr * mid.sin[i * 2 + 1], 0.5f, 1.0f));
+        mesh.indices.push_back(apex + i);
+        mesh.indices.push_back(side + i + 1);
+        mesh.indices.push_back(side + i);
+    }
+    return mesh;
+}
+
+MeshData PrimitiveGenerator::generateCylinder(float radius, float height, int slices) {
+    const RingTable& ring = Tessellator::ring(slices);
+    int count = slices + 1;
+
+    MeshData mesh;
+    mesh.vertices.reserve((count + 1) * 2 + count * 2);
+    mesh.indices.reserve((size_t)slices * 12);
+
+    addCap(mesh, ring, radius, height / 2, true);
+    addCap(mesh, ring, radius, -height / 2, false);
+
+    // Side: a two-row grid, top row first
+    std::vector<Vertex> lanes(count);
+    for (int i = 0; i < count; ++i) {
+        lanes[i] = lane(ring.cos[i], 0.0f, ring.sin[i], ring.cos[i], 0.0f, ring.sin[i], ring.u[i], 0.0f);
+    }
+    uint32_t side = (uint32_t)mesh.vertices.size();
+    mesh.vertices.resize(mesh.vertices.size() + count * 2);
+    Vertex scale = lane(radius, 0.0f, radius, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f);
+    Tessellator::emitRow(&mesh.vertices[side], lanes.data(), scale,
+                         lane(0.0f, height / 2, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f), count);
+    Tessellator::emitRow(&mesh.vertices[side + count], lanes.data(), scale,
+                         lane(0.0f, -height / 2, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f), count);
+    Tessellator::appendGridIndices(mesh.indices, side, 2, count);
+    return mesh;
+}
+
+MeshData PrimitiveGenerator::generateTorus(float majorRadius, float minorRadius, int majorSlices, int minorSlices) {
+    const RingTable& major = Tessellator::ring(majorSlices);
+    const RingTable& minor = Tessellator::ring(minorSlices);
+    int cols = minorSlices + 1;
+
+    // The tube cross-section is identical for every major ring, so it is built once
+    std::vector<Vertex> lanes(cols);
+    for (int j = 0; j < cols; ++j) {
+        float ring = majorRadius + minorRadius * minor.cos[j];
+        lanes[j] = lane(ring, minorRadius * minor.sin[j], ring, minor.cos[j], minor.sin[j], minor.cos[j], 0.0f, minor.u[j]);
+    }
+
+    MeshData mesh;
+    mesh.vertices.resize((size_t)(majorSlices + 1) * cols);
+    for (int i = 0; i <= majorSlices; ++i) {
+        float cosPhi = major.cos[i];
+        float sinPhi = major.sin[i];
+        Tessellator::emitRow(&mesh.vertices[(size_t)i * cols], lanes.data(),
+                             lane(cosPhi, 1.0f, sinPhi, cosPhi, 1.0f, sinPhi, 0.0f, 1.0f),
+                             lane(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, major.u[i], 0.0f), cols);
+    }
+
+    Tessellator::appendGridIndices(mesh.indices, 0, majorSlices + 1, cols);
+    return mesh;
+}
+
+MeshData PrimitiveGenerator::generatePyramid(float base, float height) {
+    return fromTable(PrimitiveTables::PYRAMID_VERTICES, 16, PrimitiveTables::PYRAMID_INDICES, 18, base, height, base);
+}
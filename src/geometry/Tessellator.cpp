@@ -0,0 +1,121 @@
+#include "../include/geometry/Tessellator.hpp"
+#include "../include/core/Constants.hpp"
+#include <glm/simd/platform.h>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace {
+    std::map<std::pair<int, bool>, RingTable> ringTables;
+    std::mutex ringTablesMutex;
+}
+
+const RingTable& Tessellator::ring(int segments, bool halfTurn) {
+    std::lock_guard<std::mutex> lock(ringTablesMutex);
+
+    auto key = std::make_pair(segments, halfTurn);
+    auto it = ringTables.find(key);
+    if (it != ringTables.end()) {
+        return it->second;
+    }
+
+    RingTable table;
+    table.segments = segments;
+    table.halfTurn = halfTurn;
+    table.cos.resize(segments + 1);
+    table.sin.resize(segments + 1);
+    table.u.resize(segments + 1);
+
+    double span = halfTurn ? Constants::PI_DOUBLE : 2.0 * Constants::PI_DOUBLE;
+    for (int i = 0; i <= segments; ++i) {
+        double angle = span * i / segments;
+        table.cos[i] = (float)std::cos(angle);
+        table.sin[i] = (float)std::sin(angle);
+        table.u[i] = (float)i / segments;
+    }
+    // Close the ring exactly so seam vertices weld bit-for-bit
+    table.cos[segments] = halfTurn ? -1.0f : table.cos[0];
+    table.sin[segments] = halfTurn ? 0.0f : table.sin[0];
+
+    return ringTables.emplace(key, std::move(table)).first->second;
+}
+
+void Tessellator::emitRow(Vertex* out, const Vertex* lanes, const Vertex& scale, const Vertex& offset, int count) {
+    static_assert(sizeof(Vertex) == 8 * sizeof(float), "Vertex must be eight packed floats");
+
+    const float* src = reinterpret_cast<const float*>(lanes);
+    float* dst = reinterpret_cast<float*>(out);
+    const float* s = reinterpret_cast<const float*>(&scale);
+    const float* o = reinterpret_cast<const float*>(&offset);
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+    __m256 vs = _mm256_loadu_ps(s);
+    __m256 vo = _mm256_loadu_ps(o);
+    for (int i = 0; i < count; ++i) {
+        __m256 v = _mm256_loadu_ps(src + i * 8);
+#   if GLM_ARCH & GLM_ARCH_AVX2_BIT
+        _mm256_storeu_ps(dst + i * 8, _mm256_fmadd_ps(v, vs, vo));
+#   else
+        _mm256_storeu_ps(dst + i * 8, _mm256_add_ps(_mm256_mul_ps(v, vs), vo));
+#   endif
+    }
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+    __m128 s0 = _mm_loadu_ps(s), s1 = _mm_loadu_ps(s + 4);
+    __m128 o0 = _mm_loadu_ps(o), o1 = _mm_loadu_ps(o + 4);
+    for (int i = 0; i < count; ++i) {
+        __m128 lo = _mm_loadu_ps(src + i * 8);
+        __m128 hi = _mm_loadu_ps(src + i * 8 + 4);
+        _mm_storeu_ps(dst + i * 8, _mm_add_ps(_mm_mul_ps(lo, s0), o0));
+        _mm_storeu_ps(dst + i * 8 + 4, _mm_add_ps(_mm_mul_ps(hi, s1), o1));
+    }
+#else
+    for (int i = 0; i < count; ++i) {
+        for (int k = 0; k < 8; ++k) {
+            dst[i * 8 + k] = src[i * 8 + k] * s[k] + o[k];
+        }
+    }
+#endif
+}
+
+void Tessellator::appendGridIndices(std::vector<uint32_t>& indices, uint32_t base, int rows, int cols,
+                                    bool skipFirstRowTop, bool skipLastRowBottom) {
+    size_t triangles = (size_t)(rows - 1) * (cols - 1) * 2;
+    if (skipFirstRowTop) triangles -= cols - 1;
+    if (skipLastRowBottom) triangles -= cols - 1;
+
+    size_t start = indices.size();
+    indices.resize(start + triangles * 3);
+    uint32_t* out = indices.data() + start;
+
+    for (int i = 0; i < rows - 1; ++i) {
+        bool top = !(skipFirstRowTop && i == 0);
+        bool bottom = !(skipLastRowBottom && i == rows - 2);
+        uint32_t a = base + i * cols;
+        for (int j = 0; j < cols - 1; ++j, ++a) {
+            uint32_t c = a + cols;
+            if (top) {
+                out[0] = a;
+                out[1] = a + 1;
+                out[2] = c;
+                out += 3;
+            }
+            if (bottom) {
+                out[0] = a + 1;
+                out[1] = c + 1;
+                out[2] = c;
+                out += 3;
+            }
+        }
+    }
+}
+
+void Tessellator::appendFanIndices(std::vector<uint32_t>& indices, uint32_t center, uint32_t ring, int count,
+                                   bool facingUp) {
+    indices.reserve(indices.size() + (size_t)count * 3);
+    for (int i = 0; i < count; ++i) {
+        indices.push_back(center);
+        indices.push_back(facingUp ? ring + i + 1 : ring + i);
+        indices.push_back(facingUp ? ring + i : ring + i + 1);
+    }
+}
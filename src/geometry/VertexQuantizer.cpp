@@ -0,0 +1,168 @@
+#include "../include/geometry/VertexQuantizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const float SNORM16_MAX = 32767.0f;
+    const float UNORM16_MAX = 65535.0f;
+
+    int16_t toSnorm16(float value) {
+        value = std::max(-1.0f, std::min(1.0f, value));
+        return (int16_t)std::lround(value * SNORM16_MAX);
+    }
+
+    uint16_t toUnorm16(float value) {
+        value = std::max(0.0f, std::min(1.0f, value));
+        return (uint16_t)std::lround(value * UNORM16_MAX);
+    }
+
+    // Same rule as GL's normalized signed integer fetch
+    float fromSnorm16(int16_t value) {
+        return std::max(value / SNORM16_MAX, -1.0f);
+    }
+
+    float signNotZero(float value) {
+        return value >= 0.0f ? 1.0f : -1.0f;
+    }
+}
+
+QuantizedMesh VertexQuantizer::quantize(const MeshData& mesh) {
+    QuantizedMesh packed;
+    if (mesh.vertices.empty()) {
+        return packed;
+    }
+
+    glm::vec3 lo(std::numeric_limits<float>::max());
+    glm::vec3 hi(-std::numeric_limits<float>::max());
+    glm::vec2 uvLo(std::numeric_limits<float>::max());
+    glm::vec2 uvHi(-std::numeric_limits<float>::max());
+    for (const Vertex& v : mesh.vertices) {
+        glm::vec3 p(v.position[0], v.position[1], v.position[2]);
+        glm::vec2 uv(v.texCoord[0], v.texCoord[1]);
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+        uvLo = glm::min(uvLo, uv);
+        uvHi = glm::max(uvHi, uv);
+    }
+
+    // Degenerate extents (flat meshes) still need a non-zero scale
+    packed.center = (lo + hi) * 0.5f;
+    packed.halfExtent = glm::max((hi - lo) * 0.5f, glm::vec3(1e-6f));
+    packed.uvMin = uvLo;
+    packed.uvExtent = glm::max(uvHi - uvLo, glm::vec2(1e-6f));
+
+    packed.vertices.resize(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        const Vertex& v = mesh.vertices[i];
+        PackedVertex& out = packed.vertices[i];
+        for (int k = 0; k < 3; ++k) {
+            out.position[k] = toSnorm16((v.position[k] - packed.center[k]) / packed.halfExtent[k]);
+        }
+        out.position[3] = 0;
+        encodeOctahedral(glm::vec3(v.normal[0], v.normal[1], v.normal[2]), out.normal);
+        for (int k = 0; k < 2; ++k) {
+            out.texCoord[k] = toUnorm16((v.texCoord[k] - packed.uvMin[k]) / packed.uvExtent[k]);
+        }
+    }
+
+    if (mesh.vertices.size() <= 65536) {
+        packed.shortIndices.assign(mesh.indices.begin(), mesh.indices.end());
+    } else {
+        packed.indices = mesh.indices;
+    }
+    return packed;
+}
+
+QuantizationReport VertexQuantizer::measure(const MeshData& source, const QuantizedMesh& packed) {
+    QuantizationReport report;
+    report.floatBytes = source.byteSize();
+    report.packedBytes = packed.byteSize();
+    report.positionErrorBound = glm::length(packed.halfExtent) * 0.5f / SNORM16_MAX;
+    report.uvErrorBound = glm::length(packed.uvExtent) * 0.5f / UNORM16_MAX;
+
+    float maxAngle = 0.0f;
+    for (size_t i = 0; i < source.vertices.size() && i < packed.vertices.size(); ++i) {
+        const Vertex& v = source.vertices[i];
+        const PackedVertex& q = packed.vertices[i];
+
+        glm::vec3 p(v.position[0], v.position[1], v.position[2]);
+        report.maxPositionError = std::max(report.maxPositionError, glm::length(decodePosition(packed, q) - p));
+
+        glm::vec3 n(v.normal[0], v.normal[1], v.normal[2]);
+        float length = glm::length(n);
+        if (length > 0.0f) {
+            // atan2 of |cross| and dot stays precise for tiny angles, unlike acos
+            glm::vec3 decoded = decodeNormal(q);
+            float angle = std::atan2(glm::length(glm::cross(decoded, n / length)), glm::dot(decoded, n / length));
+            maxAngle = std::max(maxAngle, angle);
+        }
+
+        glm::vec2 uv(v.texCoord[0], v.texCoord[1]);
+        report.maxUvError = std::max(report.maxUvError, glm::length(decodeTexCoord(packed, q) - uv));
+    }
+    report.maxNormalErrorDegrees = glm::degrees(maxAngle);
+    return report;
+}
+
+glm::vec3 VertexQuantizer::decodePosition(const QuantizedMesh& mesh, const PackedVertex& vertex) {
+    glm::vec3 unit(fromSnorm16(vertex.position[0]), fromSnorm16(vertex.position[1]), fromSnorm16(vertex.position[2]));
+    return mesh.center + unit * mesh.halfExtent;
+}
+
+glm::vec3 VertexQuantizer::decodeNormal(const PackedVertex& vertex) {
+    return decodeOctahedral(vertex.normal);
+}
+
+glm::vec2 VertexQuantizer::decodeTexCoord(const QuantizedMesh& mesh, const PackedVertex& vertex) {
+    glm::vec2 unit(vertex.texCoord[0] / UNORM16_MAX, vertex.texCoord[1] / UNORM16_MAX);
+    return mesh.uvMin + unit * mesh.uvExtent;
+}
+
+void VertexQuantizer::encodeOctahedral(const glm::vec3& normal, int16_t out[2]) {
+    // Project onto the octahedron |x| + |y| + |z| = 1, then fold the lower half over
+    float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (sum == 0.0f) {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+    float x = normal.x / sum;
+    float y = normal.y / sum;
+    if (normal.z < 0.0f) {
+        float foldedX = (1.0f - std::abs(y)) * signNotZero(x);
+        float foldedY = (1.0f - std::abs(x)) * signNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    // Rounding each axis independently can be off by one step; keep the closest of the four candidates
+    float fx = std::floor(x * SNORM16_MAX), fy = std::floor(y * SNORM16_MAX);
+    float bestDot = -2.0f;
+    for (int dx = 0; dx <= 1; ++dx) {
+        for (int dy = 0; dy <= 1; ++dy) {
+            int16_t candidate[2] = {
+                (int16_t)std::max(-SNORM16_MAX, std::min(SNORM16_MAX, fx + dx)),
+                (int16_t)std::max(-SNORM16_MAX, std::min(SNORM16_MAX, fy + dy))
+            };
+            float dot = glm::dot(decodeOctahedral(candidate), normal / glm::length(normal));
+            if (dot > bestDot) {
+                bestDot = dot;
+                out[0] = candidate[0];
+                out[1] = candidate[1];
+            }
+        }
+    }
+}
+
+glm::vec3 VertexQuantizer::decodeOctahedral(const int16_t encoded[2]) {
+    glm::vec3 n(fromSnorm16(encoded[0]), fromSnorm16(encoded[1]), 0.0f);
+    n.z = 1.0f - std::abs(n.x) - std::abs(n.y);
+    if (n.z < 0.0f) {
+        float x = n.x;
+        n.x = (1.0f - std::abs(n.y)) * signNotZero(x);
+        n.y = (1.0f - std::abs(x)) * signNotZero(n.y);
+    }
+    float length = glm::length(n);
+    return length > 0.0f ? n / length : glm::vec3(0.0f, 0.0f, 1.0f);
+}
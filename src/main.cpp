@@ -1,4 +1,5 @@
 #include "BlenderLite.hpp"
+#include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -15,642 +16,561 @@ void cursor_position_callback(GLFWwindow* window, double xpos, double ypos);
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 void handleTextInput(GLFWwindow* window, int key, int scancode, int action, int mods);
 void handleCharacterInput(GLFWwindow* window, unsigned int codepoint);
-
-// Enhanced 3D shape drawing functions with texture mapping
-void drawCube(ApplicationState& appState) {
-    glBegin(GL_QUADS);
-
-    // Front face
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(0.5f, 0.5f, 0.5f);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-0.5f, 0.5f, 0.5f);
-
-    // Back face
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, -0.5f, -0.5f);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(-0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, -0.5f, -0.5f);
-
-    // Top face
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, 0.5f, 0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, 0.5f, 0.5f);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(0.5f, 0.5f, -0.5f);
-
-    // Bottom face
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(-0.5f, -0.5f, -0.5f);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(0.5f, -0.5f, -0.5f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, -0.5f, 0.5f);
-
-    // Right face
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(0.5f, -0.5f, -0.5f);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(0.5f, 0.5f, -0.5f);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(0.5f, 0.5f, 0.5f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(0.5f, -0.5f, 0.5f);
-
-    // Left face
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-0.5f, -0.5f, -0.5f);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-0.5f, -0.5f, 0.5f);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(-0.5f, 0.5f, 0.5f);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-0.5f, 0.5f, -0.5f);
-
-    glEnd();
-}
-
-void drawSphere(float radius, int slices, int stacks, ApplicationState& appState) {
-    for (int i = 0; i <= stacks; ++i) {
-        float phi = Constants::PI * i / stacks;
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= slices; ++j) {
-            float theta = 2.0f * Constants::PI * j / slices;
-            float x = radius * sin(phi) * cos(theta);
-            float y = radius * cos(phi);
-            float z = radius * sin(phi) * sin(theta);
-
-            // Texture coordinates based on spherical mapping
-            float s = (float)j / slices;
-            float t = (float)i / stacks;
-            glTexCoord2f(s, t);
-            glVertex3f(x, y, z);
-
-            float x2 = radius * sin(phi + Constants::PI / stacks) * cos(theta);
-            float y2 = radius * cos(phi + Constants::PI / stacks);
-            float z2 = radius * sin(phi + Constants::PI / stacks) * sin(theta);
-
-            float t2 = (float)(i + 1) / stacks;
-            glTexCoord2f(s, t2);
-            glVertex3f(x2, y2, z2);
-        }
-        glEnd();
-    }
-}
-
-void drawCone(float base, float height, int slices, ApplicationState& appState) {
-    // Base
-    glBegin(GL_TRIANGLE_FAN);
-    glTexCoord2f(0.5f, 0.5f);
-    glVertex3f(0.0f, -height/2, 0.0f);
-    for (int i = 0; i <= slices; ++i) {
-        float theta = 2.0f * Constants::PI * i / slices;
-        float x = base * cos(theta);
-        float z = base * sin(theta);
-        float s = 0.5f + 0.5f * cos(theta);
-        float t = 0.5f + 0.5f * sin(theta);
-        glTexCoord2f(s, t);
-        glVertex3f(x, -height/2, z);
-    }
-    glEnd();
-
-    // Side
-    glBegin(GL_TRIANGLE_FAN);
-    glTexCoord2f(0.5f, 1.0f);
-    glVertex3f(0.0f, height/2, 0.0f);
-    for (int i = 0; i <= slices; ++i) {
-        float theta = 2.0f * Constants::PI * i / slices;
-        float x = base * cos(theta);
-        float z = base * sin(theta);
-        float s = (float)i / slices;
-        glTexCoord2f(s, 0.0f);
-        glVertex3f(x, -height/2, z);
-    }
-    glEnd();
-}
-
-void drawCylinder(float radius, float height, int slices, ApplicationState& appState) {
-    // Top
-    glBegin(GL_TRIANGLE_FAN);
-    glTexCoord2f(0.5f, 0.5f);
-    glVertex3f(0.0f, height/2, 0.0f);
-    for (int i = 0; i <= slices; ++i) {
-        float theta = 2.0f * Constants::PI * i / slices;
-        float x = radius * cos(theta);
-        float z = radius * sin(theta);
-        float s = 0.5f + 0.5f * cos(theta);
-        float t = 0.5f + 0.5f * sin(theta);
-        glTexCoord2f(s, t);
-        glVertex3f(x, height/2, z);
-    }
-    glEnd();
-
-    // Bottom
-    glBegin(GL_TRIANGLE_FAN);
-    glTexCoord2f(0.5f, 0.5f);
-    glVertex3f(0.0f, -height/2, 0.0f);
-    for (int i = 0; i <= slices; ++i) {
-        float theta = 2.0f * Constants::PI * i / slices;
-        float x = radius * cos(theta);
-        float z = radius * sin(theta);
-        float s = 0.5f + 0.5f * cos(theta);
-        float t = 0.5f + 0.5f * sin(theta);
-        glTexCoord2f(s, t);
-        glVertex3f(x, -height/2, z);
-    }
-    glEnd();
-
-    // Side
-    glBegin(GL_QUAD_STRIP);
-    for (int i = 0; i <= slices; ++i) {
-        float theta = 2.0f * Constants::PI * i / slices;
-        float x = radius * cos(theta);
-        float z = radius * sin(theta);
-        float s = (float)i / slices;
-
-        glTexCoord2f(s, 1.0f);
-        glVertex3f(x, height/2, z);
-        glTexCoord2f(s, 0.0f);
-        glVertex3f(x, -height/2, z);
-    }
-    glEnd();
-}
-
-void drawTorus(float majorRadius, float minorRadius, int majorSlices, int minorSlices, ApplicationState& appState) {
-    for (int i = 0; i < majorSlices; ++i) {
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= minorSlices; ++j) {
-            for (int k = 0; k <= 1; ++k) {
-                float phi = 2.0f * Constants::PI * (i + k) / majorSlices;
-                float theta = 2.0f * Constants::PI * j / minorSlices;
-
-                float x = (majorRadius + minorRadius * cos(theta)) * cos(phi);
-                float y = minorRadius * sin(theta);
-                float z = (majorRadius + minorRadius * cos(theta)) * sin(phi);
-
-                // Texture coordinates
-                float s = (float)(i + k) / majorSlices;
-                float t = (float)j / minorSlices;
-                glTexCoord2f(s, t);
-                glVertex3f(x, y, z);
-            }
+void window_focus_callback(GLFWwindow* window, int focused);
+void window_refresh_callback(GLFWwindow* window);
+
+// Per-frame work every canvas view shares: the selected object's edits,
+// world matrices and the BVH. False when there is nothing to draw.
+bool prepareScene(ApplicationState& appState) {
+    SceneEditor::syncSelected(appState);
+    appState.frameStats.resetCounters();
+
+    Scene& scene = appState.scene;
+    if (scene.size() == 0) {
+        for (SceneView& view : appState.views) {
+            view.visibleObjects.clear();
+            view.cullStats = SceneBvh::CullStats();
         }
-        glEnd();
+        return false;
     }
-}
-
-void drawPyramid(float base, float height, ApplicationState& appState) {
-    // Base
-    glBegin(GL_QUADS);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-base/2, -height/2, -base/2);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(base/2, -height/2, -base/2);
-    glTexCoord2f(1.0f, 1.0f); glVertex3f(base/2, -height/2, base/2);
-    glTexCoord2f(0.0f, 1.0f); glVertex3f(-base/2, -height/2, base/2);
-    glEnd();
-
-    // Front face
-    glBegin(GL_TRIANGLES);
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, height/2, 0.0f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-base/2, -height/2, base/2);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(base/2, -height/2, base/2);
-    glEnd();
-
-    // Right face
-    glBegin(GL_TRIANGLES);
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, height/2, 0.0f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(base/2, -height/2, base/2);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(base/2, -height/2, -base/2);
-    glEnd();
+    scene.updateWorldMatrices();
 
-    // Back face
-    glBegin(GL_TRIANGLES);
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, height/2, 0.0f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(base/2, -height/2, -base/2);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-base/2, -height/2, -base/2);
-    glEnd();
-
-    // Left face
-    glBegin(GL_TRIANGLES);
-    glTexCoord2f(0.5f, 1.0f); glVertex3f(0.0f, height/2, 0.0f);
-    glTexCoord2f(0.0f, 0.0f); glVertex3f(-base/2, -height/2, -base/2);
-    glTexCoord2f(1.0f, 0.0f); glVertex3f(-base/2, -height/2, base/2);
-    glEnd();
+    // The BVH is kept current even with culling off because picking traverses it
+    appState.sceneBvh.update(scene);
+    return true;
 }
 
-void drawCurrentShape(ApplicationState& appState) {
-    if (appState.currentShape == ShapeType::NONE) {
-        return;
-    }
+// Culls and draws the scene through one view's camera into the current viewport
+void drawSceneView(ApplicationState& appState, SceneView& view) {
+    Scene& scene = appState.scene;
+    const Camera& camera = view.camera;
+    int viewportHeight = view.height;
+    std::vector<int8_t>& lodLevels = view.lodLevelsFor(scene);
 
     // Enable depth testing for 3D
-    glEnable(GL_DEPTH_TEST);
+    GlState::enable(GL_DEPTH_TEST);
 
     // Set up projection matrix
-    glMatrixMode(GL_PROJECTION);
+    GlState::matrixMode(GL_PROJECTION);
     glPushMatrix();
-    glLoadIdentity();
-
-    // Manual perspective projection matrix
-    float aspect = 1.0f;
-    float fov = 45.0f * Constants::PI / 180.0f;
-    float close = 0.1f;
-    float faar = 100.0f;
-
-    float f = 1.0f / tan(fov / 2.0f);
-    float range = close - faar;
-
-    float projection[16] = {
-        f / aspect, 0, 0, 0,
-        0, f, 0, 0,
-        0, 0, (faar + close) / range, -1,
-        0, 0, (2 * faar * close) / range, 0
-    };
-
-    glMultMatrixf(projection);
+    glLoadMatrixf(glm::value_ptr(camera.projection()));
 
-    // Set up modelview matrix
-    glMatrixMode(GL_MODELVIEW);
+    GlState::matrixMode(GL_MODELVIEW);
     glPushMatrix();
-    glLoadIdentity();
 
-    // Manual camera setup
-    float eyeX = 0.0f, eyeY = 0.0f, eyeZ = 3.0f;
-    float centerX = 0.0f, centerY = 0.0f, centerZ = 0.0f;
-    float upX = 0.0f, upY = 1.0f, upZ = 0.0f;
-
-    float forward[3] = {
-        centerX - eyeX,
-        centerY - eyeY,
-        centerZ - eyeZ
-    };
-
-    // Normalize forward vector
-    float length = sqrt(forward[0]*forward[0] + forward[1]*forward[1] + forward[2]*forward[2]);
-    forward[0] /= length;
-    forward[1] /= length;
-    forward[2] /= length;
-
-    // Right = forward x up
-    float right[3] = {
-        forward[1] * upZ - forward[2] * upY,
-        forward[2] * upX - forward[0] * upZ,
-        forward[0] * upY - forward[1] * upX
-    };
-
-    // Normalize right vector
-    length = sqrt(right[0]*right[0] + right[1]*right[1] + right[2]*right[2]);
-    right[0] /= length;
-    right[1] /= length;
-    right[2] /= length;
-
-    // Up = right x forward
-    float actualUp[3] = {
-        right[1] * forward[2] - right[2] * forward[1],
-        right[2] * forward[0] - right[0] * forward[2],
-        right[0] * forward[1] - right[1] * forward[0]
-    };
-
-    float view[16] = {
-        right[0], actualUp[0], -forward[0], 0,
-        right[1], actualUp[1], -forward[1], 0,
-        right[2], actualUp[2], -forward[2], 0,
-        -(right[0]*eyeX + right[1]*eyeY + right[2]*eyeZ),
-        -(actualUp[0]*eyeX + actualUp[1]*eyeY + actualUp[2]*eyeZ),
-        forward[0]*eyeX + forward[1]*eyeY + forward[2]*eyeZ,
-        1
-    };
-
-    glMultMatrixf(view);
-
-    // Apply transformations from appState
-    glTranslatef(appState.translate[0], appState.translate[1], appState.translate[2]);
-    glScalef(appState.scale[0], appState.scale[1], appState.scale[2]);
-    glRotatef(appState.rotate[0], 1.0f, 0.0f, 0.0f);
-    glRotatef(appState.rotate[1], 0.0f, 1.0f, 0.0f);
-    glRotatef(appState.rotate[2], 0.0f, 0.0f, 1.0f);
-
-    // NEW: Check if shape uses texture or color
-    bool usesTexture = PrimitiveRenderer::shapeHasTexture(appState.currentShape, appState);
+    // Only objects whose bounds touch the view frustum reach the draw path
+    std::vector<uint32_t>& visible = view.visibleObjects;
+    visible.clear();
+    if (appState.frustumCulling) {
+        appState.sceneBvh.cull(scene, Frustum::fromMatrix(camera.viewProjection()), visible, &view.cullStats);
+    } else {
+        for (uint32_t i = 0; i < scene.size(); ++i) {
+            if (scene.flags[i] & ObjectFlags::VISIBLE) {
+                visible.push_back(i);
+            }
+        }
+        view.cullStats.visible = (uint32_t)visible.size();
+        view.cullStats.culled = (uint32_t)(scene.size() - visible.size());
+        view.cullStats.nodesVisited = 0;
+    }
+
+    // Then drop objects hidden behind the largest ones on screen
+    if (appState.occlusionCulling) {
+        appState.occlusionCuller.cull(scene, camera, lodLevels, visible, ThreadPool::shared());
+    }
+
+    // Blended objects are pulled out and sorted back to front for a pass of their own
+    TransparentPass& transparentPass = view.transparentPass;
+    transparentPass.build(scene, visible, camera, viewportHeight, lodLevels, ThreadPool::shared());
+    const std::vector<uint32_t>& opaque = transparentPass.getOpaque();
+
+    // Core-profile shaders when selected; otherwise one instanced draw per
+    // (mesh, texture) batch, falling back to per-object draws sorted by the
+    // state they need
+    FrameStats& stats = appState.frameStats;
+    bool drawn = false;
+    if (appState.useCoreRenderer) {
+        view.renderQueue.build(scene, opaque, camera, viewportHeight, lodLevels);
+        drawn = ShaderRenderer::drawScene(scene, view.renderQueue, camera, stats);
+        stats.unsortedStateChanges += view.renderQueue.getUnsortedChanges().total();
+    }
+    if (!drawn && appState.useInstancing) {
+        drawn = InstancedRenderer::drawScene(scene, opaque, camera, viewportHeight, lodLevels, stats);
+    }
+    if (!drawn) {
+        view.renderQueue.build(scene, opaque, camera, viewportHeight, lodLevels);
+        CommandRecorder::record(scene, view.renderQueue, camera, ThreadPool::shared(), view.commands);
+        CommandExecutor::execute(view.commands, stats);
+        stats.unsortedStateChanges += view.renderQueue.getUnsortedChanges().total();
+    }
+    TransparentRenderer::draw(scene, transparentPass, camera.view(), stats);
+    stats.transparentObjects += transparentPass.getStats().objects;
+    stats.sortedTriangles += transparentPass.getStats().sortedTriangles;
+    stats.transparentSortMs += transparentPass.getStats().sortMs;
+    stats.viewsDrawn++;
 
-    if (usesTexture) {
-        int textureID = PrimitiveRenderer::getShapeTexture(appState.currentShape, appState);
+    // Restore matrices
+    glPopMatrix();
+    GlState::matrixMode(GL_PROJECTION);
+    glPopMatrix();
+    GlState::matrixMode(GL_MODELVIEW);
 
-        if (textureID != -1 && textureID < PrimitiveRenderer::textureIDs.size() &&
-            PrimitiveRenderer::textureIDs[textureID] != 0) {
-            // Enable texturing with proper parameters
-            glEnable(GL_TEXTURE_2D);
-            glBindTexture(GL_TEXTURE_2D, PrimitiveRenderer::textureIDs[textureID]);
+    // Disable depth testing and texturing for 2D UI
+    GlState::disable(GL_DEPTH_TEST);
+    GlState::disable(GL_TEXTURE_2D);
+}
 
-            // Set texture parameters (important!)
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+// LOD level and screen size of the selected object as the front view sees it
+void updateSelectedLod(ApplicationState& appState) {
+    int64_t selected = appState.scene.indexOf(appState.selectedObject);
+    if (selected < 0) {
+        return;
+    }
+    SceneView& view = appState.views[0];
+    std::vector<int8_t>& lodLevels = view.lodLevelsFor(appState.scene);
+    float screenRadius = 0.0f;
+    LodSelector::selectForObject(appState.scene, (size_t)selected, view.camera, view.height, lodLevels, &screenRadius);
+    appState.lodLevel = lodLevels[selected];
+    appState.lodScreenRadius = screenRadius;
+}
 
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Use white to preserve texture colors
-        } else {
-            // Fallback to color if texture is invalid
-            glDisable(GL_TEXTURE_2D);
-            glColor3f(appState.currentColor[0], appState.currentColor[1], appState.currentColor[2]);
-        }
-    } else {
-        // Use regular coloring
-        glDisable(GL_TEXTURE_2D);
-        glColor3f(appState.currentColor[0], appState.currentColor[1], appState.currentColor[2]);
+// The front view alone, drawn straight into the window with a full-window
+// viewport and the canvas's square-aspect camera
+void drawScene(ApplicationState& appState, int width, int height) {
+    SceneView& view = appState.views[0];
+    view.kind = SceneView::FRONT;
+    view.camera = Camera::canvasDefault();
+    view.x = 0;
+    view.y = 0;
+    view.width = width;
+    view.height = height;
+    view.drawn = false;
+    if (!prepareScene(appState)) {
+        return;
     }
+    drawSceneView(appState, view);
+    updateSelectedLod(appState);
+}
 
-    // Draw the selected shape
-    switch (appState.currentShape) {
-        case ShapeType::CUBE:
-            drawCube(appState);
-            break;
-        case ShapeType::SPHERE:
-            drawSphere(0.5f, 20, 20, appState);
-            break;
-        case ShapeType::CONE:
-            drawCone(0.5f, 1.0f, 20, appState);
-            break;
-        case ShapeType::CYLINDER:
-            drawCylinder(0.5f, 1.0f, 20, appState);
+// Render settings that change what a view shows without touching the scene
+uint64_t viewSettings(const ApplicationState& appState) {
+    return (uint64_t)appState.useInstancing | ((uint64_t)appState.useCoreRenderer << 1) |
+           ((uint64_t)appState.frustumCulling << 2) | ((uint64_t)appState.occlusionCulling << 3) |
+           ((uint64_t)appState.compactVertices << 4);
+}
+
+// Everything a UI layer region shows, so it is redrawn only when one of these
+// changed: the hovered widget if it is in the region, and per region the state
+// its widgets show
+uint64_t uiRegionKey(const ApplicationState& appState, UiLayer::Region region) {
+    uint64_t key = UiLayer::mix(region, (uint64_t)(UiLayout::hoveredIn(region) + 1));
+    switch (region) {
+        case UiLayer::LEFT_BAR:
+            key = UiLayer::mix(key, (uint64_t)appState.currentShape);
+            key = UiLayer::mix(key, (uint64_t)(appState.selectedTexture + 1));
+            key = UiLayer::mixFloat(key, appState.leftPanelShapesScroll);
+            key = UiLayer::mixFloat(key, appState.leftPanelTexturesScroll);
             break;
-        case ShapeType::TORUS:
-            drawTorus(0.5f, 0.2f, 20, 10, appState);
+        case UiLayer::RIGHT_BAR:
+            for (int axis = 0; axis < 3; ++axis) {
+                key = UiLayer::mixFloat(key, appState.rotate[axis]);
+                key = UiLayer::mixFloat(key, appState.scale[axis]);
+                key = UiLayer::mixFloat(key, appState.translate[axis]);
+            }
+            key = UiLayer::mix(key, (uint64_t)(appState.activeInputField.panelType + 1));
+            key = UiLayer::mix(key, (uint64_t)(appState.activeInputField.axis + 1));
+            key = UiLayer::mix(key, appState.activeInputField.active);
+            key = UiLayer::mixString(key, appState.activeInputField.text);
+            key = UiLayer::mixFloat(key, appState.rightPanelScroll);
             break;
-        case ShapeType::PYRAMID:
-            drawPyramid(1.0f, 1.0f, appState);
+        case UiLayer::AXIS_BUTTONS:
+            for (int axis = 0; axis < 3; ++axis) {
+                key = UiLayer::mix(key, appState.axisSelected[axis]);
+            }
             break;
         default:
             break;
     }
-
-    // Restore matrices
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-
-    // Disable depth testing and texturing for 2D UI
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_TEXTURE_2D);
+    return key;
 }
 
-// REMOVED: draw3DAxes function - we're moving the axes to be above the buttons
-
-void drawAxisButtons(float leftEdgeNDC, float canvasY1, float canvasY2, int width, int height) {
-    // Save current matrix state
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-
-    // Use the full screen projection since we're positioning relative to leftEdgeNDC
-    glOrtho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-
-    // Button size and spacing
-    float buttonSize = 0.035f;
-    float buttonGap = 0.002f;
-    float marginY = 0.03f;
-
-    // Position buttons attached to the left sidebar's right edge
-    float startX = leftEdgeNDC;
-    float startY = canvasY1 + marginY;
-
-    // X button (Red)
-    float xBtnX1 = startX;
-    float xBtnX2 = xBtnX1 + buttonSize;
-    float xBtnY1 = startY;
-    float xBtnY2 = xBtnY1 + buttonSize;
+// Starts a UI layer region over one of UiLayout's bars
+bool beginUiRegion(UiLayer::Region region, UiLayout::WidgetType bar) {
+    const UiLayout::Rect& rect = UiLayout::get(bar).rect;
+    return UiLayer::beginRegion(region, rect.x1, rect.y1, rect.x2, rect.y2, uiRegionKey(appState, region));
+}
 
-    bool hoverX = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, xBtnX1, xBtnY1, xBtnX2, xBtnY2);
+// Front, top, side and perspective views in the canvas quadrants (window
+// pixels, origin at the bottom left). Each view is redrawn into its own
+// framebuffer only when the scene, its camera or the render settings changed,
+// and shown with a blit every frame.
+void drawQuadViews(ApplicationState& appState, int canvasX, int canvasY, int canvasWidth, int canvasHeight,
+                   int width, int height) {
+    static const SceneView::Kind QUAD_KINDS[ApplicationState::VIEW_COUNT] = {
+        SceneView::FRONT, SceneView::TOP, SceneView::SIDE, SceneView::PERSPECTIVE
+    };
+    int halfWidth = canvasWidth / 2;
+    int halfHeight = canvasHeight / 2;
+    bool hasObjects = prepareScene(appState);
+    uint64_t sceneRevision = appState.scene.getRevision();
+    uint64_t settings = viewSettings(appState);
+
+    for (int v = 0; v < ApplicationState::VIEW_COUNT; ++v) {
+        // Front bottom-left, top above it, side bottom-right, perspective above it
+        SceneView& view = appState.views[v];
+        view.kind = QUAD_KINDS[v];
+        view.x = canvasX + (v >= 2 ? canvasWidth - halfWidth : 0);
+        view.y = canvasY + (v % 2 == 1 ? canvasHeight - halfHeight : 0);
+        view.width = halfWidth - 1;
+        view.height = halfHeight - 1;
+        if (view.width <= 0 || view.height <= 0) {
+            continue;
+        }
+        view.camera = SceneView::cameraFor(view.kind, (float)view.width / view.height);
 
-    if (appState.axisSelected[0]) {
-        PrimitiveRenderer::drawRect(xBtnX1, xBtnY1, xBtnX2, xBtnY2, 1.0f, 0.5f, 0.5f);
-    } else if (hoverX) {
-        PrimitiveRenderer::drawRect(xBtnX1, xBtnY1, xBtnX2, xBtnY2, 1.0f, 0.8f, 0.8f);
-    } else {
-        PrimitiveRenderer::drawRect(xBtnX1, xBtnY1, xBtnX2, xBtnY2, 1.0f, 0.0f, 0.0f);
+        if (!view.needsRedraw(sceneRevision, settings)) {
+            ViewFramebuffers::present(v, view.x, view.y);
+            continue;
+        }
+        if (ViewFramebuffers::bind(v, view.width, view.height)) {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            if (hasObjects) {
+                drawSceneView(appState, view);
+            }
+            ViewFramebuffers::unbind();
+            view.markDrawn(sceneRevision, settings);
+            ViewFramebuffers::present(v, view.x, view.y);
+        } else if (hasObjects) {
+            // No framebuffer objects: draw into the window every frame
+            GlState::viewport(view.x, view.y, view.width, view.height);
+            GlState::enable(GL_SCISSOR_TEST);
+            GlState::scissor(view.x, view.y, view.width, view.height);
+            glClear(GL_DEPTH_BUFFER_BIT);
+            drawSceneView(appState, view);
+            GlState::disable(GL_SCISSOR_TEST);
+        }
     }
-    PrimitiveRenderer::drawOutlineRect(xBtnX1, xBtnY1, xBtnX2, xBtnY2, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("X", xBtnX1 + buttonSize * 0.3f, xBtnY1 + buttonSize * 0.3f, GLUT_BITMAP_HELVETICA_10);
-
-    // Y button (Green)
-    float yBtnX1 = xBtnX2 + buttonGap;
-    float yBtnX2 = yBtnX1 + buttonSize;
-    float yBtnY1 = startY;
-    float yBtnY2 = yBtnY1 + buttonSize;
-
-    bool hoverY = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, yBtnX1, yBtnY1, yBtnX2, yBtnY2);
-
-    if (appState.axisSelected[1]) {
-        PrimitiveRenderer::drawRect(yBtnX1, yBtnY1, yBtnX2, yBtnY2, 0.5f, 1.0f, 0.5f);
-    } else if (hoverY) {
-        PrimitiveRenderer::drawRect(yBtnX1, yBtnY1, yBtnX2, yBtnY2, 0.8f, 1.0f, 0.8f);
-    } else {
-        PrimitiveRenderer::drawRect(yBtnX1, yBtnY1, yBtnX2, yBtnY2, 0.0f, 1.0f, 0.0f);
+    GlState::viewport(0, 0, width, height);
+    if (hasObjects) {
+        updateSelectedLod(appState);
     }
-    PrimitiveRenderer::drawOutlineRect(yBtnX1, yBtnY1, yBtnX2, yBtnY2, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Y", yBtnX1 + buttonSize * 0.3f, yBtnY1 + buttonSize * 0.3f, GLUT_BITMAP_HELVETICA_10);
-
-    // Z button (Blue)
-    float zBtnX1 = yBtnX2 + buttonGap;
-    float zBtnX2 = zBtnX1 + buttonSize;
-    float zBtnY1 = startY;
-    float zBtnY2 = zBtnY1 + buttonSize;
-
-    bool hoverZ = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, zBtnX1, zBtnY1, zBtnX2, zBtnY2);
+}
 
-    if (appState.axisSelected[2]) {
-        PrimitiveRenderer::drawRect(zBtnX1, zBtnY1, zBtnX2, zBtnY2, 0.5f, 0.5f, 1.0f);
-    } else if (hoverZ) {
-        PrimitiveRenderer::drawRect(zBtnX1, zBtnY1, zBtnX2, zBtnY2, 0.8f, 0.8f, 1.0f);
-    } else {
-        PrimitiveRenderer::drawRect(zBtnX1, zBtnY1, zBtnX2, zBtnY2, 0.0f, 0.0f, 1.0f);
+// Outlines each quad view and names it in its top-left corner
+void drawQuadViewLabels(const ApplicationState& appState, int width, int height) {
+    for (const SceneView& view : appState.views) {
+        float x1 = -1.0f + 2.0f * view.x / width;
+        float y1 = -1.0f + 2.0f * view.y / height;
+        float x2 = -1.0f + 2.0f * (view.x + view.width) / width;
+        float y2 = -1.0f + 2.0f * (view.y + view.height) / height;
+        PrimitiveRenderer::drawOutlineRect(x1, y1, x2, y2, 0.2f, 0.2f, 0.2f, 1.0f);
+        PrimitiveRenderer::setTextColor(0.85f, 0.85f, 0.85f);
+        PrimitiveRenderer::drawText(SceneView::nameOf(view.kind), x1 + PrimitiveRenderer::pxToNDCx(6, width),
+                                    y2 - PrimitiveRenderer::pxToNDCy(16, height));
     }
-    PrimitiveRenderer::drawOutlineRect(zBtnX1, zBtnY1, zBtnX2, zBtnY2, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Z", zBtnX1 + buttonSize * 0.3f, zBtnY1 + buttonSize * 0.3f, GLUT_BITMAP_HELVETICA_10);
-
-    // Store hover state for mouse click detection
-    appState.axisHovered[0] = hoverX;
-    appState.axisHovered[1] = hoverY;
-    appState.axisHovered[2] = hoverZ;
-
-    // NEW: Draw vector arrows ABOVE the buttons (moved from main canvas)
-    float arrowY = startY + buttonSize + 0.015f; // Position above buttons
-    float axisLength = 0.02f; // Much smaller arrows
-    float arrowSize = 0.005f; // Smaller arrow heads
+}
 
-    // X axis (Red) - lighter color if selected
-    if (appState.axisSelected[0]) {
-        glColor3f(1.0f, 0.5f, 0.5f); // Light red when selected
-    } else {
-        glColor3f(1.0f, 0.0f, 0.0f); // Normal red
+// Ray-casts the cursor into the scene when it is over the canvas
+void updateHoverPick(ApplicationState& appState, float canvasX1, float canvasY1, float canvasX2, float canvasY2,
+                     int width, int height) {
+    appState.hoverPick = PickResult();
+    if (appState.scene.size() == 0) {
+        return;
     }
-    float xCenter = (xBtnX1 + xBtnX2) * 0.5f;
-    glBegin(GL_LINES);
-    glVertex2f(xCenter, arrowY);
-    glVertex2f(xCenter + axisLength, arrowY);
-    glEnd();
-
-    // X arrow
-    glBegin(GL_TRIANGLES);
-    glVertex2f(xCenter + axisLength, arrowY);
-    glVertex2f(xCenter + axisLength - arrowSize, arrowY - arrowSize);
-    glVertex2f(xCenter + axisLength - arrowSize, arrowY + arrowSize);
-    glEnd();
 
-    // Y axis (Green) - lighter color if selected
-    if (appState.axisSelected[1]) {
-        glColor3f(0.5f, 1.0f, 0.5f); // Light green when selected
-    } else {
-        glColor3f(0.0f, 1.0f, 0.0f); // Normal green
+    float windowNdcX = (float)(2.0 * appState.mouseX / width - 1.0);
+    float windowNdcY = (float)(1.0 - 2.0 * appState.mouseY / height);
+    if (windowNdcX < canvasX1 || windowNdcX > canvasX2 || windowNdcY < canvasY1 || windowNdcY > canvasY2) {
+        return;
     }
-    float yCenter = (yBtnX1 + yBtnX2) * 0.5f;
-    glBegin(GL_LINES);
-    glVertex2f(yCenter, arrowY);
-    glVertex2f(yCenter, arrowY + axisLength);
-    glEnd();
 
-    // Y arrow
-    glBegin(GL_TRIANGLES);
-    glVertex2f(yCenter, arrowY + axisLength);
-    glVertex2f(yCenter - arrowSize, arrowY + axisLength - arrowSize);
-    glVertex2f(yCenter + arrowSize, arrowY + axisLength - arrowSize);
-    glEnd();
-
-    // Z axis (Blue) - lighter color if selected
-    if (appState.axisSelected[2]) {
-        glColor3f(0.5f, 0.5f, 1.0f); // Light blue when selected
-    } else {
-        glColor3f(0.0f, 0.0f, 1.0f); // Normal blue
+    // The ray goes through the view under the cursor, in that view's NDC; the
+    // single front view covers the whole window
+    double pixelX = appState.mouseX;
+    double pixelY = height - appState.mouseY;
+    int viewCount = appState.quadView ? ApplicationState::VIEW_COUNT : 1;
+    SceneView* view = nullptr;
+    for (int v = 0; v < viewCount; ++v) {
+        SceneView& candidate = appState.views[v];
+        if (pixelX >= candidate.x && pixelX < candidate.x + candidate.width && pixelY >= candidate.y &&
+            pixelY < candidate.y + candidate.height) {
+            view = &candidate;
+            appState.hoverView = v;
+        }
     }
-    float zCenter = (zBtnX1 + zBtnX2) * 0.5f;
-    glBegin(GL_LINES);
-    glVertex2f(zCenter, arrowY);
-    glVertex2f(zCenter - axisLength * 0.7f, arrowY - axisLength * 0.7f);
-    glEnd();
+    if (view == nullptr) {
+        return;
+    }
+    float ndcX = (float)(2.0 * (pixelX - view->x) / view->width - 1.0);
+    float ndcY = (float)(2.0 * (pixelY - view->y) / view->height - 1.0);
 
-    // Z arrow
-    glBegin(GL_TRIANGLES);
-    glVertex2f(zCenter - axisLength * 0.7f, arrowY - axisLength * 0.7f);
-    glVertex2f(zCenter - axisLength * 0.7f + arrowSize, arrowY - axisLength * 0.7f + arrowSize);
-    glVertex2f(zCenter - axisLength * 0.7f + arrowSize * 0.5f, arrowY - axisLength * 0.7f - arrowSize * 0.5f);
-    glEnd();
+    double start = glfwGetTime();
+    Ray ray = view->camera.rayThroughNdc(ndcX, ndcY);
+    appState.hoverPick = ScenePicker::pick(appState.scene, appState.sceneBvh, ray,
+                                           view->lodLevelsFor(appState.scene));
+    appState.pickMicros = (glfwGetTime() - start) * 1e6;
+}
 
-    // Draw axis labels with corresponding colors
-    if (appState.axisSelected[0]) {
-        glColor3f(1.0f, 0.5f, 0.5f);
-    } else {
-        glColor3f(1.0f, 0.0f, 0.0f);
+// Outlines the hovered face on top of the view it was picked in
+void drawPickHighlight(const ApplicationState& appState, int width, int height) {
+    if (!appState.hoverPick.hit()) {
+        return;
     }
-    PrimitiveRenderer::drawText("X", xCenter + axisLength + 0.003f, arrowY - 0.002f, GLUT_BITMAP_HELVETICA_10);
 
-    if (appState.axisSelected[1]) {
-        glColor3f(0.5f, 1.0f, 0.5f);
-    } else {
-        glColor3f(0.0f, 1.0f, 0.0f);
-    }
-    PrimitiveRenderer::drawText("Y", yCenter - 0.002f, arrowY + axisLength + 0.003f, GLUT_BITMAP_HELVETICA_10);
+    const SceneView& view = appState.views[appState.hoverView];
+    const Camera& camera = view.camera;
+    GlState::viewport(view.x, view.y, view.width, view.height);
+    GlState::matrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadMatrixf(glm::value_ptr(camera.projection()));
+    GlState::matrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadMatrixf(glm::value_ptr(camera.view()));
 
-    if (appState.axisSelected[2]) {
-        glColor3f(0.5f, 0.5f, 1.0f);
-    } else {
-        glColor3f(0.0f, 0.0f, 1.0f);
+    GlState::disable(GL_DEPTH_TEST);
+    GlState::disable(GL_TEXTURE_2D);
+    glLineWidth(2.0f);
+    glColor3f(1.0f, 0.85f, 0.2f);
+    glBegin(GL_LINE_LOOP);
+    for (const glm::vec3& corner : appState.hoverPick.corners) {
+        glVertex3f(corner.x, corner.y, corner.z);
     }
-    PrimitiveRenderer::drawText("Z", zCenter - axisLength * 0.7f - 0.005f, arrowY - axisLength * 0.7f - 0.005f, GLUT_BITMAP_HELVETICA_10);
+    glEnd();
+    glLineWidth(1.0f);
 
-    // Restore matrix state
     glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
+    GlState::matrixMode(GL_PROJECTION);
     glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
+    GlState::matrixMode(GL_MODELVIEW);
+    GlState::viewport(0, 0, width, height);
 }
 
-// ... rest of the file remains exactly the same until the main function ...
-
-void checkShapeButtonClicks(double xpos, double ypos, int width, int height, ApplicationState& appState) {
-    // Calculate the shapes panel position
-    float leftPanelWidth = PrimitiveRenderer::pxToNDCx((int)(Constants::LEFT_BAR_WIDTH * 0.85f), width);
-    float leftPanelHeight = PrimitiveRenderer::pxToNDCy(310, height);
-    float leftPanelGap = PrimitiveRenderer::pxToNDCy(20, height);
-    float leftVerticalOffset = PrimitiveRenderer::pxToNDCy(5, height);
-
-    float texturesPanelY = -1.0f + appState.leftPanelTexturesScroll + leftVerticalOffset;
-    float shapesPanelY = texturesPanelY + leftPanelHeight + leftPanelGap + appState.leftPanelShapesScroll;
+// Saves the scene just drawn as gl_frame.png, renders the same objects with
+// the software rasterizer into software_frame.png, and reports how far apart
+// they are. Must run before anything is drawn over the scene.
+void captureSceneComparison(ApplicationState& appState, int width, int height) {
+    Image glFrame;
+    glFrame.width = width;
+    glFrame.height = height;
+    glFrame.pixels.resize((size_t)width * height * 4);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, glFrame.pixels.data());
+
+    static SoftwareRenderer renderer;
+    static bool texturesLoaded = false;
+    if (!texturesLoaded) {
+        std::vector<Image> textures;
+        for (const char* file : Constants::TEXTURE_FILES) {
+            textures.emplace_back();
+            if (!Image::load(file, textures.back())) {
+                textures.back() = Image::fallbackTexture((int)textures.size() - 1);
+            }
+        }
+        renderer.setTextures(textures);
+        texturesLoaded = true;
+    }
+    renderer.resize(width, height);
+    renderer.clear(glm::vec4(0.12f, 0.12f, 0.15f, 1.0f));
+    SceneView& front = appState.views[0];
+    renderer.render(appState.scene, front.visibleObjects, front.camera, front.lodLevelsFor(appState.scene),
+                    ThreadPool::shared());
+    Image softwareFrame = renderer.getImage();
+
+    // Pixels differing by more than a few levels in any channel
+    size_t differing = 0;
+    for (size_t i = 0; i < glFrame.pixels.size(); i += 4) {
+        for (int channel = 0; channel < 3; ++channel) {
+            if (std::abs(glFrame.pixels[i + channel] - softwareFrame.pixels[i + channel]) > 8) {
+                differing++;
+                break;
+            }
+        }
+    }
+    glFrame.savePng("gl_frame.png", true);
+    softwareFrame.savePng("software_frame.png", true);
+    std::cout << "Saved gl_frame.png and software_frame.png: " << differing << " of " << (size_t)width * height
+              << " pixels differ (software " << renderer.getStats().setupMs + renderer.getStats().rasterMs
+              << " ms)" << std::endl;
+}
 
-    float panelX1 = -1.0f + PrimitiveRenderer::pxToNDCx(5, width);
-    float buttonWidth = (leftPanelWidth - PrimitiveRenderer::pxToNDCx(40, width)) / 2.0f;
-    float buttonHeight = PrimitiveRenderer::pxToNDCy(75, height);
-    float buttonGap = PrimitiveRenderer::pxToNDCx(8, width);
-    float rowGap = PrimitiveRenderer::pxToNDCy(10, height);
+// REMOVED: draw3DAxes function - we're moving the axes to be above the buttons
 
-    float contentHeight = (buttonHeight * 3) + (rowGap * 2);
-    float maxScroll = std::max(0.0f, contentHeight - leftPanelHeight);
-    float scrollOffset = std::max(0.0f, std::min(maxScroll, -appState.leftPanelShapesScroll));
+void drawAxisButtons() {
+    // Positioned in window NDC by UiLayout, attached to the left sidebar's right edge
+    const UiLayout::Widget* buttons[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        buttons[axis] = &UiLayout::get(UiLayout::AXIS_BUTTON, axis);
+        const UiLayout::Rect& button = buttons[axis]->rect;
+        float buttonSize = buttons[axis]->width;
 
-    float row1Y = shapesPanelY + leftPanelHeight - PrimitiveRenderer::pxToNDCy(50, height) + scrollOffset;
+        // X red, Y green, Z blue; lighter when selected, lighter still when hovered
+        float other = appState.axisSelected[axis] ? 0.5f : UiLayout::isHovered(UiLayout::AXIS_BUTTON, axis) ? 0.8f : 0.0f;
+        PrimitiveRenderer::drawRect(button.x1, button.y1, button.x2, button.y2,
+                                    axis == 0 ? 1.0f : other, axis == 1 ? 1.0f : other, axis == 2 ? 1.0f : other);
+        PrimitiveRenderer::drawOutlineRect(button.x1, button.y1, button.x2, button.y2, 0.0f, 0.0f, 0.0f, 1.5f);
 
-    // Check Cube button
-    float cubeX1 = panelX1 + PrimitiveRenderer::pxToNDCx(10, width);
-    float cubeX2 = cubeX1 + buttonWidth;
-    if (PrimitiveRenderer::isInsideNDC(xpos, ypos, width, height, cubeX1, row1Y - buttonHeight, cubeX2, row1Y)) {
-        appState.currentShape = ShapeType::CUBE;
-        std::cout << "Cube generated!\n";
-        return;
+        PrimitiveRenderer::setTextColor(1.0f, 1.0f, 1.0f);
+        PrimitiveRenderer::drawText(std::string(1, "XYZ"[axis]), button.x1 + buttonSize * 0.3f, button.y1 + buttonSize * 0.3f, GLUT_BITMAP_HELVETICA_10);
     }
 
-    // Check Sphere button
-    float sphereX1 = cubeX2 + buttonGap;
-    float sphereX2 = sphereX1 + buttonWidth;
-    if (PrimitiveRenderer::isInsideNDC(xpos, ypos, width, height, sphereX1, row1Y - buttonHeight, sphereX2, row1Y)) {
-        appState.currentShape = ShapeType::SPHERE;
-        std::cout << "Sphere generated!\n";
-        return;
-    }
+    // NEW: Draw vector arrows ABOVE the buttons (moved from main canvas)
+    float arrowY = buttons[0]->rect.y2 + 0.015f; // Position above buttons
+    float axisLength = 0.02f; // Much smaller arrows
+    float arrowSize = 0.005f; // Smaller arrow heads
 
-    float row2Y = row1Y - buttonHeight - rowGap;
+    // Axis colors, lighter when selected
+    float lift[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        lift[axis] = appState.axisSelected[axis] ? 0.5f : 0.0f;
+    }
+    const float red[3] = {1.0f, lift[0], lift[0]};
+    const float green[3] = {lift[1], 1.0f, lift[1]};
+    const float blue[3] = {lift[2], lift[2], 1.0f};
+
+    // X axis (Red) with its arrow
+    float xCenter = (buttons[0]->rect.x1 + buttons[0]->rect.x2) * 0.5f;
+    PrimitiveRenderer::drawLine(xCenter, arrowY, xCenter + axisLength, arrowY, red[0], red[1], red[2]);
+    PrimitiveRenderer::drawTriangle(xCenter + axisLength, arrowY,
+                                    xCenter + axisLength - arrowSize, arrowY - arrowSize,
+                                    xCenter + axisLength - arrowSize, arrowY + arrowSize, red[0], red[1], red[2]);
+
+    // Y axis (Green) with its arrow
+    float yCenter = (buttons[1]->rect.x1 + buttons[1]->rect.x2) * 0.5f;
+    PrimitiveRenderer::drawLine(yCenter, arrowY, yCenter, arrowY + axisLength, green[0], green[1], green[2]);
+    PrimitiveRenderer::drawTriangle(yCenter, arrowY + axisLength,
+                                    yCenter - arrowSize, arrowY + axisLength - arrowSize,
+                                    yCenter + arrowSize, arrowY + axisLength - arrowSize, green[0], green[1], green[2]);
+
+    // Z axis (Blue) with its arrow
+    float zCenter = (buttons[2]->rect.x1 + buttons[2]->rect.x2) * 0.5f;
+    PrimitiveRenderer::drawLine(zCenter, arrowY, zCenter - axisLength * 0.7f, arrowY - axisLength * 0.7f,
+                                blue[0], blue[1], blue[2]);
+    PrimitiveRenderer::drawTriangle(zCenter - axisLength * 0.7f, arrowY - axisLength * 0.7f,
+                                    zCenter - axisLength * 0.7f + arrowSize, arrowY - axisLength * 0.7f + arrowSize,
+                                    zCenter - axisLength * 0.7f + arrowSize * 0.5f, arrowY - axisLength * 0.7f - arrowSize * 0.5f,
+                                    blue[0], blue[1], blue[2]);
 
-    // Check Cone button
-    float coneX1 = panelX1 + PrimitiveRenderer::pxToNDCx(10, width);
-    float coneX2 = coneX1 + buttonWidth;
-    if (PrimitiveRenderer::isInsideNDC(xpos, ypos, width, height, coneX1, row2Y - buttonHeight, coneX2, row2Y)) {
-        appState.currentShape = ShapeType::CONE;
-        std::cout << "Cone generated!\n";
-        return;
-    }
+    // Draw axis labels with corresponding colors
+    PrimitiveRenderer::setTextColor(red[0], red[1], red[2]);
+    PrimitiveRenderer::drawText("X", xCenter + axisLength + 0.003f, arrowY - 0.002f, GLUT_BITMAP_HELVETICA_10);
+    PrimitiveRenderer::setTextColor(green[0], green[1], green[2]);
+    PrimitiveRenderer::drawText("Y", yCenter - 0.002f, arrowY + axisLength + 0.003f, GLUT_BITMAP_HELVETICA_10);
+    PrimitiveRenderer::setTextColor(blue[0], blue[1], blue[2]);
+    PrimitiveRenderer::drawText("Z", zCenter - axisLength * 0.7f - 0.005f, arrowY - axisLength * 0.7f - 0.005f, GLUT_BITMAP_HELVETICA_10);
+}
 
-    // Check Cylinder button
-    float cylinderX1 = coneX2 + buttonGap;
-    float cylinderX2 = cylinderX1 + buttonWidth;
-    if (PrimitiveRenderer::isInsideNDC(xpos, ypos, width, height, cylinderX1, row2Y - buttonHeight, cylinderX2, row2Y)) {
-        appState.currentShape = ShapeType::CYLINDER;
-        std::cout << "Cylinder generated!\n";
-        return;
+// Left sidebar with the textures panel under the shapes panel
+void drawLeftSidebar(int width, int height) {
+    const UiLayout::Rect& bar = UiLayout::get(UiLayout::LEFT_BAR).rect;
+    PrimitiveRenderer::drawRect(bar.x1, bar.y1, bar.x2, bar.y2, 0.5f, 0.5f, 0.5f);
+    Panels::drawTexturesPanel(appState, width, height);
+    Panels::drawShapesPanel(appState, width, height);
+}
+
+// Right sidebar with the rotation, scaling and translation panels and its scroll bar
+void drawRightSidebar(int width, int height) {
+    const UiLayout::Rect& bar = UiLayout::get(UiLayout::RIGHT_BAR).rect;
+    PrimitiveRenderer::drawRect(bar.x1, bar.y1, bar.x2, bar.y2, 0.5f, 0.5f, 0.5f);
+    for (int panel = 0; panel < 3; ++panel) {
+        Panels::drawTransformPanel(panel, appState, width, height);
     }
 
-    float row3Y = row2Y - buttonHeight - rowGap;
+    // Draw scroll bars
+    const UiLayout::Rect& track = UiLayout::get(UiLayout::SCROLL_TRACK, 2).rect;
+    const UiLayout::Rect& thumb = UiLayout::get(UiLayout::SCROLL_THUMB, 2).rect;
+    PrimitiveRenderer::drawRect(track.x1, track.y1, track.x2, track.y2, 0.3f, 0.3f, 0.3f);
+    PrimitiveRenderer::drawRect(thumb.x1, thumb.y1, thumb.x2, thumb.y2, 0.6f, 0.6f, 0.6f);
+}
 
-    // Check Torus button
-    float torusX1 = panelX1 + PrimitiveRenderer::pxToNDCx(10, width);
-    float torusX2 = torusX1 + buttonWidth;
-    if (PrimitiveRenderer::isInsideNDC(xpos, ypos, width, height, torusX1, row3Y - buttonHeight, torusX2, row3Y)) {
-        appState.currentShape = ShapeType::TORUS;
-        std::cout << "Torus generated!\n";
-        return;
+// Blocks until the next frame should be drawn: in continuous mode only for
+// the unfocused frame cap, otherwise also until an event marks it dirty
+void waitForRedraw(GLFWwindow* window, double lastFrameStart) {
+    glfwPollEvents();
+    while (!glfwWindowShouldClose(window)) {
+        double minInterval = appState.windowFocused ? 0.0 : 1.0 / Constants::UNFOCUSED_FRAME_RATE;
+        double wait = lastFrameStart + minInterval - glfwGetTime();
+        if (!appState.continuousRedraw && !appState.needsRedraw) {
+            glfwWaitEvents();
+        } else if (wait > 0.0) {
+            glfwWaitEventsTimeout(wait);
+        } else {
+            return;
+        }
     }
+}
 
-    // Check Pyramid button
-    float pyramidX1 = torusX2 + buttonGap;
-    float pyramidX2 = pyramidX1 + buttonWidth;
-    if (PrimitiveRenderer::isInsideNDC(xpos, ypos, width, height, pyramidX1, row3Y - buttonHeight, pyramidX2, row3Y)) {
-        appState.currentShape = ShapeType::PYRAMID;
-        std::cout << "Pyramid generated!\n";
-        return;
+void handleShortcutKey(int key, int action) {
+    if (action != GLFW_PRESS) return;
+
+    if (key == GLFW_KEY_F1) {
+        appState.continuousRedraw = !appState.continuousRedraw;
+        std::cout << "Redraw " << (appState.continuousRedraw ? "continuously" : "on demand") << std::endl;
+    } else if (key == GLFW_KEY_F2) {
+        appState.quadView = !appState.quadView;
+        std::cout << "Quad view " << (appState.quadView ? "on" : "off") << std::endl;
+    } else if (key == GLFW_KEY_F3) {
+        appState.showStats = !appState.showStats;
+    } else if (key == GLFW_KEY_F4) {
+        appState.compactVertices = !appState.compactVertices;
+        MeshCache::setVertexFormat(appState.compactVertices ? VertexFormat::PACKED16 : VertexFormat::FLOAT32);
+    } else if (key == GLFW_KEY_TAB) {
+        SceneEditor::selectNext(appState);
+    } else if (key == GLFW_KEY_DELETE) {
+        SceneEditor::removeSelected(appState);
+    } else if (key == GLFW_KEY_P) {
+        SceneEditor::parentToPreviousSelection(appState);
+    } else if (key == GLFW_KEY_U) {
+        SceneEditor::clearParent(appState);
+    } else if (key == GLFW_KEY_F5) {
+        // Cycle the benchmark scenes: N copies of every shape in view, then 100k
+        // objects scattered far beyond the canvas for frustum culling, then 20k
+        // objects behind a wall for occlusion culling
+        static const int BENCHMARK_COPIES[] = {0, 100, 1000, 10000};
+        appState.benchmarkLevel = (appState.benchmarkLevel + 1) % 6;
+        if (appState.benchmarkLevel == 4) {
+            SceneGenerator::populateScattered(appState.scene, 100000, 100.0f);
+        } else if (appState.benchmarkLevel == 5) {
+            SceneGenerator::populateOccluded(appState.scene, 20000);
+        } else {
+            SceneGenerator::populateBenchmark(appState.scene, BENCHMARK_COPIES[appState.benchmarkLevel]);
+        }
+        appState.selectedObject = ObjectHandle();
+        appState.previousSelectedObject = ObjectHandle();
+        std::cout << "Benchmark scene: " << appState.scene.size() << " objects" << std::endl;
+    } else if (key == GLFW_KEY_F6) {
+        appState.useInstancing = !appState.useInstancing;
+        std::cout << "Instanced rendering " << (appState.useInstancing ? "on" : "off") << std::endl;
+    } else if (key == GLFW_KEY_F7) {
+        appState.frustumCulling = !appState.frustumCulling;
+        std::cout << "Frustum culling " << (appState.frustumCulling ? "on" : "off") << std::endl;
+    } else if (key == GLFW_KEY_F8) {
+        appState.occlusionCulling = !appState.occlusionCulling;
+        std::cout << "Occlusion culling " << (appState.occlusionCulling ? "on" : "off") << std::endl;
+    } else if (key == GLFW_KEY_F9) {
+        appState.showOcclusionBuffer = !appState.showOcclusionBuffer;
+    } else if (key == GLFW_KEY_F10) {
+        appState.useCoreRenderer = !appState.useCoreRenderer;
+        std::cout << "Renderer: " << (appState.useCoreRenderer ? "core profile" : "legacy") << std::endl;
+    } else if (key == GLFW_KEY_F11) {
+        // Dump the last recorded scene commands for offline replay and analysis
+        const std::vector<CommandBuffer>& commands = appState.views[0].commands;
+        if (commands.empty()) {
+            std::cout << "No scene commands recorded yet (turn off instancing with F6)" << std::endl;
+        } else if (CommandBuffer::save("frame_commands.blcb", commands)) {
+            std::cout << "Saved " << commands.size() << " command buffers to frame_commands.blcb" << std::endl;
+        }
+    } else if (key == GLFW_KEY_F12) {
+        appState.captureScene = true;
     }
 }
 
 // Text input handling functions
 void handleTextInput(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    if (!appState.activeInputField.active) return;
+    appState.needsRedraw = true;
+    if (!appState.activeInputField.active) {
+        handleShortcutKey(key, action);
+        return;
+    }
 
     if (action == GLFW_PRESS) {
         // Handle backspace
@@ -703,6 +623,7 @@ void handleTextInput(GLFWwindow* window, int key, int scancode, int action, int
 }
 
 void handleCharacterInput(GLFWwindow* window, unsigned int codepoint) {
+    appState.needsRedraw = true;
     if (!appState.activeInputField.active) return;
 
     // Only allow digits, decimal point, and minus sign
@@ -745,6 +666,8 @@ int main() {
     glfwSetMouseButtonCallback(window, mouse_button_callback);
     glfwSetCursorPosCallback(window, cursor_position_callback);
     glfwSetScrollCallback(window, scroll_callback);
+    glfwSetWindowFocusCallback(window, window_focus_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
 
     // Add these new callbacks for text input
     glfwSetKeyCallback(window, handleTextInput);
@@ -761,13 +684,26 @@ int main() {
     int argc = 0;
     char** argv = nullptr;
     glutInit(&argc, argv);
+    TextRenderer::init();
 
     // Enable depth testing
-    glEnable(GL_DEPTH_TEST);
+    GlState::enable(GL_DEPTH_TEST);
     glClearColor(0.12f, 0.12f, 0.15f, 1.0f);
 
+    double lastFrameStart = glfwGetTime();
     while (!glfwWindowShouldClose(window)) {
+        // Sleep until input or the frame cap lets the next frame through;
+        // whatever arrives while it is drawn marks the one after dirty
+        waitForRedraw(window, lastFrameStart);
+        if (glfwWindowShouldClose(window)) {
+            break;
+        }
+        appState.needsRedraw = false;
+
+        double frameStart = glfwGetTime();
         processInput(window);
+        // Every view drawn with the core renderer this frame shares one ring segment
+        ShaderRenderer::beginFrame();
 
         // Clear both color and depth buffers
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -780,20 +716,22 @@ int main() {
             width = Constants::MIN_WINDOW_WIDTH + Constants::LEFT_BAR_WIDTH + Constants::RIGHT_BAR_WIDTH;
         }
 
-        // Calculate edges using fixed widths
-        float leftEdgeNDC = -1.0f + (2.0f * Constants::LEFT_BAR_WIDTH / width);
-        float rightEdgeNDC = 1.0f - (2.0f * Constants::RIGHT_BAR_WIDTH / width);
-        float topEdgeNDC = 1.0f - (2.0f * Constants::TOP_BAR_HEIGHT / height);
+        // Lay the UI out again if the window or a panel scroll changed; the
+        // canvas fills what the bars leave
+        UiLayout::update(width, height, appState);
+        float leftEdgeNDC = UiLayout::get(UiLayout::LEFT_BAR).rect.x2;
+        float rightEdgeNDC = UiLayout::get(UiLayout::RIGHT_BAR).rect.x1;
+        float topEdgeNDC = UiLayout::get(UiLayout::TOP_BAR).rect.y1;
 
         // Set viewport to full window
-        glViewport(0, 0, width, height);
+        GlState::viewport(0, 0, width, height);
 
         // Set up proper 2D projection for the entire window first
-        glMatrixMode(GL_PROJECTION);
+        GlState::matrixMode(GL_PROJECTION);
         glLoadIdentity();
         glOrtho(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0);
 
-        glMatrixMode(GL_MODELVIEW);
+        GlState::matrixMode(GL_MODELVIEW);
         glLoadIdentity();
 
         // Draw canvas background first
@@ -802,80 +740,123 @@ int main() {
         float canvasY1 = -1.0f;
         float canvasY2 = topEdgeNDC - PrimitiveRenderer::pxToNDCy(6, height);
 
+        UiRenderer::begin(width, height);
         PrimitiveRenderer::drawRect(canvasX1, canvasY1, canvasX2, canvasY2, 0.12f, 0.12f, 0.15f);
         PrimitiveRenderer::drawOutlineRect(canvasX1, canvasY1, canvasX2, canvasY2, 0.2f, 0.2f, 0.2f, 1.0f);
+        UiRenderer::end();
 
         // Now draw 3D shapes with proper depth testing
-        glEnable(GL_DEPTH_TEST);
-        drawCurrentShape(appState);
-        glDisable(GL_DEPTH_TEST);
-
-        // Now draw UI elements on top
-        // Draw static sidebars
-        PrimitiveRenderer::drawRect(-1.0f, -1.0f, leftEdgeNDC, topEdgeNDC, 0.5f, 0.5f, 0.5f);
-        PrimitiveRenderer::drawRect(rightEdgeNDC, -1.0f, 1.0f, topEdgeNDC, 0.5f, 0.5f, 0.5f);
-        PrimitiveRenderer::drawRect(-1.0f, topEdgeNDC, 1.0f, 1.0f, 0.45f, 0.45f, 0.45f);
-
-        // Draw UI panels
-        Panels::drawTopBarUI(width, height, appState);
-
-        float leftPanelWidth = PrimitiveRenderer::pxToNDCx((int)(Constants::LEFT_BAR_WIDTH * 0.85f), width);
-        float leftPanelHeight = PrimitiveRenderer::pxToNDCy(310, height);
-        float leftPanelGap = PrimitiveRenderer::pxToNDCy(20, height);
-        float leftVerticalOffset = PrimitiveRenderer::pxToNDCy(5, height);
-
-        float texturesPanelY = -1.0f + appState.leftPanelTexturesScroll + leftVerticalOffset;
-        Panels::drawTexturesPanel(-1.0f + PrimitiveRenderer::pxToNDCx(5, width), texturesPanelY,
-            leftPanelWidth, leftPanelHeight, appState, width, height);
-
-        float shapesPanelY = texturesPanelY + leftPanelHeight + leftPanelGap + appState.leftPanelShapesScroll;
-        Panels::drawShapesPanel(-1.0f + PrimitiveRenderer::pxToNDCx(5, width), shapesPanelY,
-            leftPanelWidth, leftPanelHeight, appState, width, height);
-
-        float panelWidth = PrimitiveRenderer::pxToNDCx((int)(Constants::RIGHT_BAR_WIDTH * 0.85f), width);
-        float panelHeight = PrimitiveRenderer::pxToNDCy(180, height);
-        float panelGap = PrimitiveRenderer::pxToNDCy(15, height);
-        float totalPanelsHeight = (panelHeight * 3) + (panelGap * 2);
-        float rightVerticalOffset = PrimitiveRenderer::pxToNDCy(50, height);
-
-        Panels::drawTransformPanel(rightEdgeNDC + PrimitiveRenderer::pxToNDCx(5, width), -1.0f + appState.rightPanelScroll + rightVerticalOffset,
-            panelWidth, panelHeight,
-            "Rotation", appState.rotate, appState, width, height);
-
-        float scalePanelY = -1.0f + panelHeight + panelGap + appState.rightPanelScroll + rightVerticalOffset;
-        Panels::drawTransformPanel(rightEdgeNDC + PrimitiveRenderer::pxToNDCx(5, width), scalePanelY,
-            panelWidth, panelHeight,
-            "Scaling", appState.scale, appState, width, height);
-
-        float translatePanelY = -1.0f + (panelHeight * 2) + (panelGap * 2) + appState.rightPanelScroll + rightVerticalOffset;
-        Panels::drawTransformPanel(rightEdgeNDC + PrimitiveRenderer::pxToNDCx(5, width), translatePanelY,
-            panelWidth, panelHeight,
-            "Translate", appState.translate, appState, width, height);
-
-        // Draw scroll bars
-        float scrollBarWidth = PrimitiveRenderer::pxToNDCx(8, width);
-        float scrollBarX = 1.0f - scrollBarWidth;
-        float scrollBarHeight = topEdgeNDC - (-1.0f);
-        float scrollThumbHeight = scrollBarHeight * 0.3f;
-        float maxScroll = totalPanelsHeight - (topEdgeNDC - (-1.0f));
-        if (maxScroll < 0) maxScroll = 0;
-        float scrollProgress = 0.0f;
-        if (maxScroll > 0) {
-            scrollProgress = std::max(0.0f, std::min(1.0f, -appState.rightPanelScroll / maxScroll));
+        if (appState.quadView) {
+            int canvasLeftPx = (int)((canvasX1 + 1.0f) * 0.5f * width) + 1;
+            int canvasRightPx = (int)((canvasX2 + 1.0f) * 0.5f * width);
+            int canvasTopPx = (int)((canvasY2 + 1.0f) * 0.5f * height);
+            drawQuadViews(appState, canvasLeftPx, 0, canvasRightPx - canvasLeftPx, canvasTopPx, width, height);
+            UiRenderer::begin(width, height);
+            drawQuadViewLabels(appState, width, height);
+            UiRenderer::end();
+        } else {
+            GlState::enable(GL_DEPTH_TEST);
+            drawScene(appState, width, height);
+            GlState::disable(GL_DEPTH_TEST);
+        }
+        if (appState.captureScene) {
+            appState.captureScene = false;
+            if (appState.quadView) {
+                std::cout << "Scene capture compares the single front view; leave quad view first (F2)" << std::endl;
+            } else {
+                captureSceneComparison(appState, width, height);
+            }
+        }
+        updateHoverPick(appState, canvasX1, canvasY1, canvasX2, canvasY2, width, height);
+        drawPickHighlight(appState, width, height);
+
+        // Occlusion buffer inset in the canvas's bottom-right corner; the buffer
+        // covers the whole window, so the inset is a scaled copy of it. Quad
+        // views share the culler, so its buffer is only meaningful for one view.
+        if (appState.showOcclusionBuffer && appState.occlusionCulling && !appState.quadView &&
+            appState.scene.size() > 0) {
+            float insetSize = (canvasX2 - canvasX1) * 0.35f;
+            OcclusionDebugView::draw(appState.occlusionCuller, appState.views[0].camera,
+                                     canvasX2 - insetSize, canvasY1, canvasX2, canvasY1 + insetSize);
         }
-        float scrollThumbY = -1.0f + (1.0f - scrollProgress) * scrollBarHeight;
 
-        PrimitiveRenderer::drawRect(scrollBarX, -1.0f, scrollBarX + scrollBarWidth, topEdgeNDC, 0.3f, 0.3f, 0.3f);
-        PrimitiveRenderer::drawRect(scrollBarX, scrollThumbY - scrollThumbHeight, scrollBarX + scrollBarWidth, scrollThumbY, 0.6f, 0.6f, 0.6f);
+        // Now draw UI elements on top. The top bar, sidebars and axis buttons live in
+        // the UI layer, each redrawn (batched into a few draws) only when what it
+        // shows changed, and the layer is composited over the canvas every frame
+        IconAtlas::prepare(width, height);
+        UiLayer::begin(width, height);
 
-        // REMOVED: draw3DAxes call - axes are now drawn above the buttons
-        // Draw axis buttons with vector arrows above them
-        drawAxisButtons(leftEdgeNDC, canvasY1, canvasY2, width, height);
+        if (beginUiRegion(UiLayer::TOP_BAR, UiLayout::TOP_BAR)) {
+            PrimitiveRenderer::drawRect(-1.0f, topEdgeNDC, 1.0f, 1.0f, 0.45f, 0.45f, 0.45f);
+            Panels::drawTopBarUI(width, height);
+            UiLayer::endRegion();
+        }
+
+        if (beginUiRegion(UiLayer::LEFT_BAR, UiLayout::LEFT_BAR)) {
+            drawLeftSidebar(width, height);
+            UiLayer::endRegion();
+        }
 
+        if (beginUiRegion(UiLayer::RIGHT_BAR, UiLayout::RIGHT_BAR)) {
+            drawRightSidebar(width, height);
+            UiLayer::endRegion();
+        }
+
+        // REMOVED: draw3DAxes call - axes are now drawn above the buttons
+        // Draw axis buttons with vector arrows above them; the region covers
+        // their labels, over the canvas's bottom-left corner
+        if (beginUiRegion(UiLayer::AXIS_BUTTONS, UiLayout::AXIS_GROUP)) {
+            drawAxisButtons();
+            UiLayer::endRegion();
+        }
+        UiLayer::composite();
+
+        // The stats overlay changes every frame, so it is drawn straight to the window
+        UiRenderer::begin(width, height);
+        Panels::drawStatsOverlay(canvasX1, canvasY2, width, height, appState);
+        UiRenderer::end();
+
+        // On demand, the time between frames is mostly spent waiting for input,
+        // so the frame time is the time it took to draw
+        double frameEnd = glfwGetTime();
+        double frameTime = appState.continuousRedraw ? frameStart - lastFrameStart : frameEnd - frameStart;
+        appState.frameStats.recordFrame(frameTime * 1000.0, (frameEnd - frameStart) * 1000.0);
+        appState.frameStats.countRedraw(frameEnd);
+        lastFrameStart = frameStart;
+        appState.frameStats.glCallsIssued = GlState::getCounters().issued;
+        appState.frameStats.glCallsElided = GlState::getCounters().elided;
+        GlState::resetCounters();
+        appState.frameStats.uiDrawCalls = UiRenderer::getStats().drawCalls;
+        appState.frameStats.uiTextStrings = UiRenderer::getStats().textStrings;
+        appState.frameStats.uiGlyphs = UiRenderer::getStats().glyphs;
+        appState.frameStats.uiLayoutsBuilt = TextRenderer::getAtlas().getStats().layoutMisses;
+        TextRenderer::getAtlas().resetStats();
+        appState.frameStats.uiPrimitives = UiRenderer::getStats().primitives;
+        appState.frameStats.uiMs = UiRenderer::getStats().cpuMs;
+        UiRenderer::resetStats();
+        appState.frameStats.uiRegionsDrawn = UiLayer::getStats().regionsDrawn;
+        appState.frameStats.uiRegionsCached = UiLayer::getStats().regionsCached;
+        UiLayer::resetStats();
+        appState.frameStats.uiLayoutBuilds = UiLayout::getStats().builds;
+        appState.frameStats.uiHitTests = UiLayout::getStats().hitTests;
+        appState.frameStats.uiHitRectsTested = UiLayout::getStats().rectsTested;
+        UiLayout::resetStats();
+
+        ShaderRenderer::endFrame();
         glfwSwapBuffers(window);
-        glfwPollEvents();
     }
 
+    // GPU meshes must be released while the context is still alive
+    InstancedRenderer::shutdown();
+    OcclusionDebugView::shutdown();
+    ViewFramebuffers::shutdown();
+    UiLayer::shutdown();
+    IconAtlas::shutdown();
+    UiRenderer::shutdown();
+    TextRenderer::shutdown();
+    ShaderRenderer::shutdown();
+    MeshCache::clear();
+
     glfwTerminate();
 
     // Cleanup textures
@@ -887,7 +868,20 @@ int main() {
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     (void)window;
-    glViewport(0,0,width,height);
+    GlState::viewport(0,0,width,height);
+    appState.needsRedraw = true;
+}
+
+void window_focus_callback(GLFWwindow* window, int focused) {
+    (void)window;
+    appState.windowFocused = focused == GLFW_TRUE;
+    appState.needsRedraw = true;
+}
+
+// The window was uncovered or resized and its contents need drawing again
+void window_refresh_callback(GLFWwindow* window) {
+    (void)window;
+    appState.needsRedraw = true;
 }
 
 void processInput(GLFWwindow *window) {
@@ -896,14 +890,11 @@ void processInput(GLFWwindow *window) {
 }
 
 void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
+    appState.needsRedraw = true;
     double xpos, ypos;
     glfwGetCursorPos(window, &xpos, &ypos);
-    int width, height;
-    glfwGetWindowSize(window, &width, &height);
 
     if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-        appState.mouseClicked = true; // Set mouse clicked flag
-
         // Store the original values before deactivating (for cancellation)
         static float originalValues[3] = {0.0f, 0.0f, 0.0f};
         static bool hasOriginalValues = false;
@@ -934,21 +925,13 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
             std::cout << "Input field deactivated\n";
         }
 
-        // Check shape button clicks first
-        checkShapeButtonClicks(xpos, ypos, width, height, appState);
+        // Buttons, fields and axis toggles act on the widget under the cursor
+        bool onWidget = Panels::handleClick(UiLayout::hitTest(xpos, ypos), appState);
 
-        // Toggle axis selection when clicking axis buttons
-        if (appState.axisHovered[0]) {
-            appState.axisSelected[0] = !appState.axisSelected[0];
-            std::cout << "X axis " << (appState.axisSelected[0] ? "selected" : "deselected") << "!\n";
-        }
-        if (appState.axisHovered[1]) {
-            appState.axisSelected[1] = !appState.axisSelected[1];
-            std::cout << "Y axis " << (appState.axisSelected[1] ? "selected" : "deselected") << "!\n";
-        }
-        if (appState.axisHovered[2]) {
-            appState.axisSelected[2] = !appState.axisSelected[2];
-            std::cout << "Z axis " << (appState.axisSelected[2] ? "selected" : "deselected") << "!\n";
+        // Clicking an object on the canvas selects it
+        if (appState.hoverPick.hit() && !onWidget && appState.scene.isValid(appState.hoverPick.object)) {
+            SceneEditor::select(appState, appState.hoverPick.object);
+            std::cout << "Picked object, face " << appState.hoverPick.face << std::endl;
         }
 
         // Check if we're starting to drag any selected axis
@@ -967,7 +950,6 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
 
     } else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE) {
         appState.draggingAxis = false;
-        appState.mouseClicked = false; // Reset mouse clicked flag
         std::cout << "Stopped dragging\n";
     }
     (void)mods;
@@ -977,6 +959,14 @@ void cursor_position_callback(GLFWwindow* window, double xpos, double ypos) {
     appState.mouseX = xpos;
     appState.mouseY = ypos;
 
+    // Moving over a still panel changes nothing on screen; only a new hovered
+    // widget, the hover pick over the canvas (or clearing its highlight on
+    // the way out) and an axis drag need a frame
+    bool hoverChanged = UiLayout::setCursor(xpos, ypos);
+    if (hoverChanged || appState.draggingAxis || appState.hoverPick.hit() || UiLayout::isOverCanvas(xpos, ypos)) {
+        appState.needsRedraw = true;
+    }
+
     // Handle axis dragging
     if (appState.draggingAxis) {
         double dx = xpos - appState.dragStartX;
@@ -1006,6 +996,7 @@ void cursor_position_callback(GLFWwindow* window, double xpos, double ypos) {
 void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
     (void)window;
     (void)xoffset;
+    appState.needsRedraw = true;
 
     int width, height;
     glfwGetWindowSize(window, &width, &height);
@@ -1013,19 +1004,14 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
     double mx, my;
     glfwGetCursorPos(window, &mx, &my);
 
-    if (mx < Constants::LEFT_BAR_WIDTH) {
-        if (my < height / 2) {
-            appState.leftPanelShapesScroll += yoffset * 20.0f;
-            float maxShapesScroll = 400.0f;
-            appState.leftPanelShapesScroll = std::max(-maxShapesScroll, std::min(0.0f, appState.leftPanelShapesScroll));
-        } else {
-            appState.leftPanelTexturesScroll += yoffset * 20.0f;
-            float maxTexturesScroll = 400.0f;
-            appState.leftPanelTexturesScroll = std::max(-maxTexturesScroll, std::min(0.0f, appState.leftPanelTexturesScroll));
-        }
-    } else {
-        appState.rightPanelScroll += yoffset * 20.0f;
-        float maxScroll = 400.0f;
-        appState.rightPanelScroll = std::max(-maxScroll, std::min(0.0f, appState.rightPanelScroll));
+    // The panel the cursor is over scrolls 20 pixels a notch, as far as the
+    // layout says its content reaches
+    int index = UiLayout::scrollAt(mx, my);
+    if (index < 0) {
+        return;
     }
+    float* scrolls[3] = {&appState.leftPanelTexturesScroll, &appState.leftPanelShapesScroll, &appState.rightPanelScroll};
+    float& scroll = *scrolls[index];
+    scroll += (float)yoffset * PrimitiveRenderer::pxToNDCy(20, height);
+    scroll = std::max(-UiLayout::maxScroll(index), std::min(0.0f, scroll));
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "../include/math/Camera.hpp"
+#include "../include/core/Constants.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+glm::mat4 Camera::projection() const {
+    return glm::perspective(fovY, aspect, nearPlane, farPlane);
+}
+
+glm::mat4 Camera::view() const {
+    return glm::lookAt(eye, center, up);
+}
+
+Ray Camera::rayThroughNdc(float ndcX, float ndcY) const {
+    glm::mat4 inverse = glm::inverse(viewProjection());
+    glm::vec4 nearPoint = inverse * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverse * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+
+    Ray ray;
+    ray.origin = glm::vec3(nearPoint) / nearPoint.w;
+    ray.direction = glm::normalize(glm::vec3(farPoint) / farPoint.w - ray.origin);
+    return ray;
+}
+
+Camera Camera::canvasDefault() {
+    Camera camera;
+    camera.eye = glm::vec3(Constants::CAMERA_EYE[0], Constants::CAMERA_EYE[1], Constants::CAMERA_EYE[2]);
+    camera.fovY = glm::radians(Constants::CAMERA_FOV_DEGREES);
+    camera.nearPlane = Constants::CAMERA_NEAR;
+    camera.farPlane = Constants::CAMERA_FAR;
+    return camera;
+}
+
+glm::mat4 TransformMath::modelMatrix(const float translate[3], const float scale[3], const float rotateDegrees[3]) {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(translate[0], translate[1], translate[2]));
+    model = glm::scale(model, glm::vec3(scale[0], scale[1], scale[2]));
+    model = glm::rotate(model, glm::radians(rotateDegrees[0]), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rotateDegrees[1]), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rotateDegrees[2]), glm::vec3(0.0f, 0.0f, 1.0f));
+    return model;
+}
+
+glm::mat4 TransformMath::modelMatrix(const glm::vec3& translate, const glm::vec3& scale, const glm::vec3& rotateDegrees) {
+    glm::vec3 r = glm::radians(rotateDegrees);
+    float cx = std::cos(r.x), sx = std::sin(r.x);
+    float cy = std::cos(r.y), sy = std::sin(r.y);
+    float cz = std::cos(r.z), sz = std::sin(r.z);
+
+    // Rows of Rx * Ry * Rz, each scaled by its axis of S (m[column][row])
+    glm::mat4 model(1.0f);
+    model[0][0] = scale.x * cy * cz;
+    model[1][0] = scale.x * -cy * sz;
+    model[2][0] = scale.x * sy;
+    model[0][1] = scale.y * (cx * sz + sx * sy * cz);
+    model[1][1] = scale.y * (cx * cz - sx * sy * sz);
+    model[2][1] = scale.y * -sx * cy;
+    model[0][2] = scale.z * (sx * sz - cx * sy * cz);
+    model[1][2] = scale.z * (sx * cz + cx * sy * sz);
+    model[2][2] = scale.z * cx * cy;
+    model[3] = glm::vec4(translate, 1.0f);
+    return model;
+}
+
+float TransformMath::maxAxisScale(const float scale[3]) {
+    return std::max(std::fabs(scale[0]), std::max(std::fabs(scale[1]), std::fabs(scale[2])));
+}
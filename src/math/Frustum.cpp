@@ -0,0 +1,34 @@
+#include "../include/math/Frustum.hpp"
+
+Frustum Frustum::fromMatrix(const glm::mat4& viewProjection) {
+    // glm is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; ++i) {
+        rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    }
+
+    Frustum frustum;
+    frustum.planes[0] = rows[3] + rows[0];
+    frustum.planes[1] = rows[3] - rows[0];
+    frustum.planes[2] = rows[3] + rows[1];
+    frustum.planes[3] = rows[3] - rows[1];
+    frustum.planes[4] = rows[3] + rows[2];
+    frustum.planes[5] = rows[3] - rows[2];
+    for (glm::vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+bool Frustum::intersectsAabb(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const {
+    for (const glm::vec4& plane : planes) {
+        // Corner furthest along the plane normal
+        glm::vec3 corner(plane.x >= 0.0f ? boundsMax.x : boundsMin.x,
+                         plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+                         plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+        if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
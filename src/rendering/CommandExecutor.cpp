@@ -0,0 +1,121 @@
+#include "../include/rendering/CommandExecutor.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/MeshCache.hpp"
+#include "../include/rendering/PrimitiveRenderer.hpp"
+#include "../include/scene/RenderQueue.hpp"
+#include <glm/gtc/type_ptr.hpp>
+
+void CommandExecutor::execute(const std::vector<CommandBuffer>& buffers, FrameStats& stats) {
+    State state;
+    for (const CommandBuffer& buffer : buffers) {
+        size_t offset = 0;
+        CommandBuffer::Command command;
+        while (buffer.next(offset, command)) {
+            execute(command, state, stats);
+        }
+    }
+
+    if (!state.started) {
+        return;
+    }
+    MeshCache::unbindMesh();
+    GlState::bindTexture(0);
+    GlState::disable(GL_TEXTURE_2D);
+    GlState::disable(GL_BLEND);
+    GlState::disable(GL_SCISSOR_TEST);
+}
+
+void CommandExecutor::execute(const CommandBuffer::Command& command, State& state, FrameStats& stats) {
+    // Buffers re-emit their leading state, so only real transitions are counted
+    switch (command.type) {
+    case CommandType::BIND_MESH: {
+        uint32_t key = (uint32_t)command.value[0];
+        if (state.mesh == nullptr || key != state.meshKey) {
+            state.mesh = &MeshCache::acquire(RenderQueue::paramsForMesh(key));
+            MeshCache::bindMesh(*state.mesh);
+            state.meshKey = key;
+            state.started = true;
+            stats.stateChanges++;
+        }
+        break;
+    }
+    case CommandType::BIND_TEXTURE: {
+        int texture = command.value[0];
+        if (!state.textureSet || texture != state.texture) {
+            GLuint id = texture >= 0 && texture < (int)PrimitiveRenderer::textureIDs.size()
+                            ? PrimitiveRenderer::textureIDs[texture] : 0;
+            if (id != 0) {
+                GlState::enable(GL_TEXTURE_2D);
+                GlState::bindTexture(id);
+            } else {
+                GlState::disable(GL_TEXTURE_2D);
+            }
+            state.textured = id != 0;
+            state.texture = texture;
+            state.textureSet = true;
+            state.started = true;
+            stats.stateChanges++;
+        }
+        break;
+    }
+    case CommandType::SET_BLEND: {
+        bool blended = command.value[0] != 0;
+        if (!state.blendSet || blended != state.blending) {
+            if (blended) {
+                GlState::enable(GL_BLEND);
+                GlState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            } else {
+                GlState::disable(GL_BLEND);
+            }
+            state.blending = blended;
+            state.blendSet = true;
+            state.started = true;
+            stats.stateChanges++;
+        }
+        break;
+    }
+    case CommandType::SET_SCISSOR:
+        GlState::enable(GL_SCISSOR_TEST);
+        GlState::scissor(command.value[0], command.value[1], command.value[2], command.value[3]);
+        state.started = true;
+        break;
+    case CommandType::DISABLE_SCISSOR:
+        GlState::disable(GL_SCISSOR_TEST);
+        break;
+    case CommandType::SET_MATRIX: {
+        glm::mat4 matrix = glm::make_mat4(command.floats);
+        if (command.slot == UniformSlot::PROJECTION) {
+            GlState::matrixMode(GL_PROJECTION);
+            glLoadMatrixf(command.floats);
+            GlState::matrixMode(GL_MODELVIEW);
+        } else if (command.slot == UniformSlot::VIEW) {
+            state.view = matrix;
+            glLoadMatrixf(command.floats);
+        } else if (command.slot == UniformSlot::MODEL) {
+            glLoadMatrixf(glm::value_ptr(state.view * matrix));
+        }
+        break;
+    }
+    case CommandType::SET_VECTOR:
+        if (command.slot == UniformSlot::COLOR) {
+            state.color = glm::make_vec4(command.floats);
+        }
+        break;
+    case CommandType::DRAW:
+        if (state.mesh == nullptr) {
+            break;
+        }
+        // Textured objects are drawn with white so the texture shows unmodified
+        if (state.textured) {
+            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        } else {
+            glColor4fv(glm::value_ptr(state.color));
+        }
+        MeshCache::drawBound(*state.mesh);
+        stats.drawCalls++;
+        stats.instances++;
+        break;
+    default:
+        break;
+    }
+}
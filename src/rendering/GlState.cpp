@@ -0,0 +1,148 @@
+#include "../include/rendering/GlState.hpp"
+
+GlState::Counters GlState::counters;
+int8_t GlState::enabled[GlState::CAP_COUNT] = {-1, -1, -1, -1, -1};
+bool GlState::known[GlState::VAL_COUNT] = {};
+GLuint GlState::texture = 0;
+GLenum GlState::blendSource = 0;
+GLenum GlState::blendDestination = 0;
+GLenum GlState::blendSourceAlpha = 0;
+GLenum GlState::blendDestinationAlpha = 0;
+GLint GlState::scissorBox[4] = {0, 0, 0, 0};
+GLint GlState::viewportBox[4] = {0, 0, 0, 0};
+GLuint GlState::program = 0;
+GLuint GlState::vertexArray = 0;
+GLenum GlState::matrix = 0;
+
+int GlState::capabilitySlot(GLenum capability) {
+    switch (capability) {
+        case GL_TEXTURE_2D: return CAP_TEXTURE_2D;
+        case GL_BLEND: return CAP_BLEND;
+        case GL_DEPTH_TEST: return CAP_DEPTH_TEST;
+        case GL_SCISSOR_TEST: return CAP_SCISSOR_TEST;
+        case GL_CULL_FACE: return CAP_CULL_FACE;
+        default: return -1;
+    }
+}
+
+bool GlState::changed(Value value, bool differs) {
+    if (differs || !known[value]) {
+        known[value] = true;
+        counters.issued++;
+        return true;
+    }
+    counters.elided++;
+    return false;
+}
+
+void GlState::enable(GLenum capability) {
+    setEnabled(capability, true);
+}
+
+void GlState::disable(GLenum capability) {
+    setEnabled(capability, false);
+}
+
+void GlState::setEnabled(GLenum capability, bool enable) {
+    int slot = capabilitySlot(capability);
+    if (slot >= 0 && enabled[slot] == (int8_t)enable) {
+        counters.elided++;
+        return;
+    }
+    counters.issued++;
+    if (slot >= 0) {
+        enabled[slot] = (int8_t)enable;
+    }
+    if (enable) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+}
+
+bool GlState::isEnabled(GLenum capability) {
+    int slot = capabilitySlot(capability);
+    if (slot < 0 || enabled[slot] < 0) {
+        return glIsEnabled(capability) == GL_TRUE;
+    }
+    return enabled[slot] == 1;
+}
+
+void GlState::bindTexture(GLuint id) {
+    if (changed(VAL_TEXTURE, texture != id)) {
+        texture = id;
+        glBindTexture(GL_TEXTURE_2D, id);
+    }
+}
+
+void GlState::blendFunc(GLenum source, GLenum destination) {
+    if (changed(VAL_BLEND_FUNC, blendSource != source || blendDestination != destination ||
+                                blendSourceAlpha != source || blendDestinationAlpha != destination)) {
+        blendSource = blendSourceAlpha = source;
+        blendDestination = blendDestinationAlpha = destination;
+        glBlendFunc(source, destination);
+    }
+}
+
+void GlState::blendFuncSeparate(GLenum source, GLenum destination, GLenum sourceAlpha, GLenum destinationAlpha) {
+    if (changed(VAL_BLEND_FUNC, blendSource != source || blendDestination != destination ||
+                                blendSourceAlpha != sourceAlpha || blendDestinationAlpha != destinationAlpha)) {
+        blendSource = source;
+        blendDestination = destination;
+        blendSourceAlpha = sourceAlpha;
+        blendDestinationAlpha = destinationAlpha;
+        glBlendFuncSeparate(source, destination, sourceAlpha, destinationAlpha);
+    }
+}
+
+void GlState::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (changed(VAL_SCISSOR, scissorBox[0] != x || scissorBox[1] != y || scissorBox[2] != width ||
+                scissorBox[3] != height)) {
+        scissorBox[0] = x;
+        scissorBox[1] = y;
+        scissorBox[2] = width;
+        scissorBox[3] = height;
+        glScissor(x, y, width, height);
+    }
+}
+
+void GlState::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    if (changed(VAL_VIEWPORT, viewportBox[0] != x || viewportBox[1] != y || viewportBox[2] != width ||
+                viewportBox[3] != height)) {
+        viewportBox[0] = x;
+        viewportBox[1] = y;
+        viewportBox[2] = width;
+        viewportBox[3] = height;
+        glViewport(x, y, width, height);
+    }
+}
+
+void GlState::useProgram(GLuint id) {
+    if (changed(VAL_PROGRAM, program != id)) {
+        program = id;
+        glUseProgram(id);
+    }
+}
+
+void GlState::bindVertexArray(GLuint vao) {
+    if (changed(VAL_VERTEX_ARRAY, vertexArray != vao)) {
+        vertexArray = vao;
+        glBindVertexArray(vao);
+    }
+}
+
+void GlState::matrixMode(GLenum mode) {
+    if (changed(VAL_MATRIX_MODE, matrix != mode)) {
+        matrix = mode;
+        glMatrixMode(mode);
+    }
+}
+
+void GlState::invalidate() {
+    for (int8_t& state : enabled) {
+        state = -1;
+    }
+    for (bool& value : known) {
+        value = false;
+    }
+}
@@ -0,0 +1,218 @@
+#include "../include/rendering/IconAtlas.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/UiRenderer.hpp"
+#include "../include/core/Constants.hpp"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+GLuint IconAtlas::texture = 0;
+int IconAtlas::builtWidth = 0;
+int IconAtlas::builtHeight = 0;
+int IconAtlas::cellWidth = 0;
+int IconAtlas::cellHeight = 0;
+bool IconAtlas::failed = false;
+
+namespace {
+    // Icons reach this many ICON_SIZEs from their center (the torus's outer edge)
+    const float ICON_REACH = 1.3f;
+
+    // Collects an icon's triangles around (x, y), one unit being scaleX by
+    // scaleY in NDC, so the icon is one batched primitive
+    struct IconPen {
+        struct Point {
+            float x, y, shade;
+        };
+
+        float x, y, scaleX, scaleY;
+        std::vector<UiRenderer::Vertex> vertices;
+
+        IconPen(float centerX, float centerY, float unitX, float unitY)
+            : x(centerX), y(centerY), scaleX(unitX), scaleY(unitY) {}
+
+        void corner(const Point& p) {
+            vertices.push_back({x + p.x * scaleX, y + p.y * scaleY, 0.0f, 0.0f, UiRenderer::packColor(p.shade, p.shade, p.shade)});
+        }
+        void triangle(const Point& a, const Point& b, const Point& c) {
+            corner(a);
+            corner(b);
+            corner(c);
+        }
+        // Corners in order around the quad
+        void quad(const Point& a, const Point& b, const Point& c, const Point& d) {
+            triangle(a, b, c);
+            triangle(a, c, d);
+        }
+        void draw() {
+            UiRenderer::triangles(vertices.data(), vertices.size());
+        }
+    };
+
+    void traceIcon(ShapeType shape, IconPen& pen) {
+        switch (shape) {
+            case ShapeType::CUBE:
+                // Front face (light gray); the right and top faces are edge-on in this flat view
+                pen.quad({-1.0f, -1.0f, 0.8f}, {1.0f, -1.0f, 0.8f}, {1.0f, 1.0f, 0.8f}, {-1.0f, 1.0f, 0.8f});
+                break;
+            case ShapeType::SPHERE: {
+                int slices = 8;
+                int stacks = 6;
+                for (int i = 0; i <= stacks; ++i) {
+                    float phi = Constants::PI * i / stacks;
+                    float nextPhi = phi + Constants::PI / stacks;
+                    for (int j = 0; j < slices; ++j) {
+                        float theta = 2.0f * Constants::PI * j / slices;
+                        float nextTheta = 2.0f * Constants::PI * (j + 1) / slices;
+
+                        // Vary color based on position for 3D effect
+                        IconPen::Point corners[4] = {
+                            {sinf(phi) * cosf(theta), cosf(phi), 0.5f + cosf(phi) * 0.3f},
+                            {sinf(nextPhi) * cosf(theta), cosf(nextPhi), 0.5f + cosf(nextPhi) * 0.3f},
+                            {sinf(nextPhi) * cosf(nextTheta), cosf(nextPhi), 0.5f + cosf(nextPhi) * 0.3f},
+                            {sinf(phi) * cosf(nextTheta), cosf(phi), 0.5f + cosf(phi) * 0.3f}};
+                        pen.quad(corners[0], corners[1], corners[2], corners[3]);
+                    }
+                }
+                break;
+            }
+            case ShapeType::CONE:
+                // Side (gradient from dark to light); the base is edge-on in this flat view
+                for (int i = 0; i < 16; ++i) {
+                    float theta = 2.0f * Constants::PI * i / 16;
+                    float nextTheta = 2.0f * Constants::PI * (i + 1) / 16;
+                    pen.triangle({0.0f, 1.0f, 0.4f}, {cosf(theta), -1.0f, 0.6f - fabsf(sinf(theta)) * 0.2f},
+                                 {cosf(nextTheta), -1.0f, 0.6f - fabsf(sinf(nextTheta)) * 0.2f});
+                }
+                break;
+            case ShapeType::CYLINDER:
+                // Side (medium gray), a little smaller; the caps are edge-on in this flat view
+                pen.quad({-0.8f, -0.8f, 0.6f}, {0.8f, -0.8f, 0.6f}, {0.8f, 0.8f, 0.6f}, {-0.8f, 0.8f, 0.6f});
+                break;
+            case ShapeType::TORUS: {
+                float majorRadius = 1.0f;
+                float minorRadius = 0.3f;
+                int majorSlices = 12;
+                int minorSlices = 8;
+
+                // Vary color based on position
+                auto torusPoint = [&](int major, int minor) {
+                    float phi = 2.0f * Constants::PI * major / majorSlices;
+                    float theta = 2.0f * Constants::PI * minor / minorSlices;
+                    return IconPen::Point{(majorRadius + minorRadius * cosf(theta)) * cosf(phi), minorRadius * sinf(theta),
+                                          0.5f + cosf(theta) * 0.3f};
+                };
+                for (int i = 0; i < majorSlices; ++i) {
+                    for (int j = 0; j < minorSlices; ++j) {
+                        pen.quad(torusPoint(i, j), torusPoint(i + 1, j), torusPoint(i + 1, j + 1), torusPoint(i, j + 1));
+                    }
+                }
+                break;
+            }
+            case ShapeType::PYRAMID:
+                // Front face (medium gray), then the back face (medium-dark gray) over it;
+                // the base and the side faces are edge-on in this flat view
+                pen.triangle({-1.0f, -1.0f, 0.6f}, {1.0f, -1.0f, 0.6f}, {0.0f, 1.0f, 0.6f});
+                pen.triangle({1.0f, -1.0f, 0.5f}, {-1.0f, -1.0f, 0.5f}, {0.0f, 1.0f, 0.5f});
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void IconAtlas::prepare(int width, int height) {
+    if (failed || width <= 0 || height <= 0 || (texture != 0 && builtWidth == width && builtHeight == height)) {
+        return;
+    }
+
+    // One cell per icon in a row, with a pixel of transparent margin around each
+    int halfWidth = (int)std::ceil(ICON_REACH * ICON_SIZE * 0.5f * width) + 1;
+    int halfHeight = (int)std::ceil(ICON_REACH * ICON_SIZE * 0.5f * height) + 1;
+    cellWidth = halfWidth * 2;
+    cellHeight = halfHeight * 2;
+    int atlasWidth = cellWidth * ICON_COUNT;
+    int atlasHeight = cellHeight;
+
+    if (texture == 0) {
+        glGenTextures(1, &texture);
+    }
+    GlState::bindTexture(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, atlasWidth, atlasHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GlState::bindTexture(0);
+
+    GLint windowFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &windowFramebuffer);
+    GLuint framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cout << "Icon atlas framebuffer incomplete, drawing icons directly" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)windowFramebuffer);
+        glDeleteFramebuffers(1, &framebuffer);
+        shutdown();
+        failed = true;
+        return;
+    }
+
+    GLfloat clearColor[4];
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+    GlState::viewport(0, 0, atlasWidth, atlasHeight);
+    GlState::disable(GL_SCISSOR_TEST);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Same pixels per unit as on the window, each icon centered on its cell's middle texel corner
+    UiRenderer::begin(atlasWidth, atlasHeight);
+    for (int i = 0; i < ICON_COUNT; ++i) {
+        float centerX = -1.0f + 2.0f * (i * cellWidth + halfWidth) / atlasWidth;
+        float centerY = -1.0f + 2.0f * halfHeight / atlasHeight;
+        IconPen pen(centerX, centerY, ICON_SIZE * width / atlasWidth, ICON_SIZE * height / atlasHeight);
+        traceIcon((ShapeType)((int)ShapeType::CUBE + i), pen);
+        pen.draw();
+    }
+    UiRenderer::end();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)windowFramebuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    GlState::viewport(0, 0, width, height);
+    builtWidth = width;
+    builtHeight = height;
+}
+
+void IconAtlas::draw(ShapeType shape, float x, float y, int width, int height) {
+    int index = (int)shape - (int)ShapeType::CUBE;
+    if (index < 0 || index >= ICON_COUNT) {
+        return;
+    }
+    if (texture == 0 || builtWidth != width || builtHeight != height) {
+        IconPen pen(x, y, ICON_SIZE, ICON_SIZE);
+        traceIcon(shape, pen);
+        pen.draw();
+        return;
+    }
+
+    // The cell lands on whole pixels so its texels map 1:1 to the window
+    float left = std::floor((x + 1.0f) * 0.5f * width + 0.5f) - cellWidth / 2;
+    float bottom = std::floor((y + 1.0f) * 0.5f * height + 0.5f) - cellHeight / 2;
+    float u0 = (float)index / ICON_COUNT;
+    float u1 = (float)(index + 1) / ICON_COUNT;
+    UiRenderer::texturedRect(-1.0f + 2.0f * left / width, -1.0f + 2.0f * bottom / height,
+                             -1.0f + 2.0f * (left + cellWidth) / width, -1.0f + 2.0f * (bottom + cellHeight) / height,
+                             texture, u0, 0.0f, u1, 1.0f);
+}
+
+void IconAtlas::shutdown() {
+    if (texture != 0) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+        GlState::invalidate();
+    }
+    builtWidth = 0;
+    builtHeight = 0;
+}
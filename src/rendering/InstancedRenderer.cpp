@@ -0,0 +1,241 @@
+#include "../include/rendering/InstancedRenderer.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/PrimitiveRenderer.hpp"
+#include "../include/rendering/ShaderProgram.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+#include <string>
+
+InstanceBatcher InstancedRenderer::batcher;
+GLuint InstancedRenderer::instanceBuffer = 0;
+GLuint InstancedRenderer::floatProgram = 0;
+GLuint InstancedRenderer::packedProgram = 0;
+bool InstancedRenderer::shadersFailed = false;
+
+namespace {
+    // Generic slots 10-14 stay clear of the conventional attributes some
+    // compatibility drivers alias onto generic indices (texcoord0 is 8)
+    const GLuint INSTANCE_MODEL = 10; // Four consecutive slots, one per column
+    const GLuint INSTANCE_COLOR = 14;
+    const GLuint PACKED_POSITION = 0;
+    const GLuint PACKED_TEXCOORD = 2;
+
+    // Float meshes come through the fixed-function arrays their VAOs record;
+    // packed meshes are decoded like MeshCache's packed shader
+    const char* INSTANCED_VERTEX_SHADER = R"(
+attribute vec4 instanceModel0;
+attribute vec4 instanceModel1;
+attribute vec4 instanceModel2;
+attribute vec4 instanceModel3;
+attribute vec4 instanceColor;
+
+#ifdef PACKED
+attribute vec3 packedPosition;
+attribute vec2 packedTexCoord;
+uniform vec3 decodeCenter;
+uniform vec3 decodeHalfExtent;
+uniform vec2 decodeUvMin;
+uniform vec2 decodeUvExtent;
+#endif
+
+uniform mat4 viewProjection;
+
+varying vec2 texCoord;
+varying vec4 color;
+
+void main() {
+#ifdef PACKED
+    vec3 position = decodeCenter + packedPosition * decodeHalfExtent;
+    texCoord = decodeUvMin + packedTexCoord * decodeUvExtent;
+#else
+    vec3 position = gl_Vertex.xyz;
+    texCoord = gl_MultiTexCoord0.xy;
+#endif
+    mat4 model = mat4(instanceModel0, instanceModel1, instanceModel2, instanceModel3);
+    gl_Position = viewProjection * model * vec4(position, 1.0);
+    color = instanceColor;
+}
+)";
+
+    const char* INSTANCED_FRAGMENT_SHADER = R"(
+uniform sampler2D diffuse;
+uniform bool useTexture;
+
+varying vec2 texCoord;
+varying vec4 color;
+
+void main() {
+    gl_FragColor = useTexture ? texture2D(diffuse, texCoord) * color : color;
+}
+)";
+
+    struct InstancedUniforms {
+        GLint viewProjection = -1;
+        GLint useTexture = -1;
+        GLint center = -1;
+        GLint halfExtent = -1;
+        GLint uvMin = -1;
+        GLint uvExtent = -1;
+    };
+    InstancedUniforms floatUniforms;
+    InstancedUniforms packedUniforms;
+
+    GLuint buildProgram(bool packed, InstancedUniforms& uniforms) {
+        std::string header = packed ? "#version 120\n#define PACKED\n" : "#version 120\n";
+        std::string vertexSource = header + INSTANCED_VERTEX_SHADER;
+        std::string fragmentSource = header + INSTANCED_FRAGMENT_SHADER;
+
+        std::vector<std::pair<GLuint, const char*>> attributes = {
+            {INSTANCE_MODEL, "instanceModel0"},
+            {INSTANCE_MODEL + 1, "instanceModel1"},
+            {INSTANCE_MODEL + 2, "instanceModel2"},
+            {INSTANCE_MODEL + 3, "instanceModel3"},
+            {INSTANCE_COLOR, "instanceColor"}
+        };
+        if (packed) {
+            attributes.push_back({PACKED_POSITION, "packedPosition"});
+            attributes.push_back({PACKED_TEXCOORD, "packedTexCoord"});
+        }
+
+        GLuint program = ShaderProgram::build(packed ? "instanced packed" : "instanced", vertexSource.c_str(),
+                                              fragmentSource.c_str(), attributes);
+        if (program == 0) {
+            return 0;
+        }
+
+        uniforms.viewProjection = glGetUniformLocation(program, "viewProjection");
+        uniforms.useTexture = glGetUniformLocation(program, "useTexture");
+        uniforms.center = glGetUniformLocation(program, "decodeCenter");
+        uniforms.halfExtent = glGetUniformLocation(program, "decodeHalfExtent");
+        uniforms.uvMin = glGetUniformLocation(program, "decodeUvMin");
+        uniforms.uvExtent = glGetUniformLocation(program, "decodeUvExtent");
+
+        GlState::useProgram(program);
+        glUniform1i(glGetUniformLocation(program, "diffuse"), 0);
+        GlState::useProgram(0);
+        return program;
+    }
+}
+
+bool InstancedRenderer::drawScene(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera,
+                                  int viewportHeightPx, std::vector<int8_t>& lodLevels, FrameStats& stats) {
+    if (programFor(VertexFormat::FLOAT32) == 0) {
+        return false;
+    }
+
+    batcher.build(scene, objects, camera, viewportHeightPx, lodLevels);
+    const std::vector<InstanceData>& instances = batcher.getInstances();
+    if (instances.empty()) {
+        return true;
+    }
+
+    // Orphan and refill so the driver never waits on last frame's instances
+    if (instanceBuffer == 0) {
+        glGenBuffers(1, &instanceBuffer);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    GLsizeiptr bytes = (GLsizeiptr)(instances.size() * sizeof(InstanceData));
+    glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glm::mat4 viewProjection = camera.viewProjection();
+    GLuint boundProgram = 0;
+
+    for (const InstanceBatch& batch : batcher.getBatches()) {
+        const GpuMesh& mesh = MeshCache::acquire(batch.params);
+        if (mesh.vao == 0 || mesh.indexCount == 0) {
+            continue;
+        }
+
+        GLuint program = programFor(mesh.format);
+        if (program == 0) {
+            continue;
+        }
+        const InstancedUniforms& uniforms = mesh.format == VertexFormat::PACKED16 ? packedUniforms : floatUniforms;
+        if (program != boundProgram) {
+            GlState::useProgram(program);
+            glUniformMatrix4fv(uniforms.viewProjection, 1, GL_FALSE, glm::value_ptr(viewProjection));
+            boundProgram = program;
+        }
+
+        ObjectMaterial material;
+        material.texture = batch.texture;
+        PrimitiveRenderer::applyMaterial(material);
+        bool textured = GlState::isEnabled(GL_TEXTURE_2D);
+        glUniform1i(uniforms.useTexture, textured ? 1 : 0);
+        // Every batch binds its VAO and texture state, plus blending when textured
+        stats.stateChanges += textured ? 3 : 2;
+
+        if (mesh.format == VertexFormat::PACKED16) {
+            glUniform3fv(uniforms.center, 1, glm::value_ptr(mesh.center));
+            glUniform3fv(uniforms.halfExtent, 1, glm::value_ptr(mesh.halfExtent));
+            glUniform2fv(uniforms.uvMin, 1, glm::value_ptr(mesh.uvMin));
+            glUniform2fv(uniforms.uvExtent, 1, glm::value_ptr(mesh.uvExtent));
+        }
+
+        GlState::bindVertexArray(mesh.vao);
+        bindInstanceAttributes(batch.first);
+        glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr, (GLsizei)batch.count);
+        // The attributes live in the mesh's VAO; leave it as the non-instanced path expects
+        unbindInstanceAttributes();
+        GlState::bindVertexArray(0);
+
+        stats.drawCalls++;
+        stats.batches++;
+        stats.instances += batch.count;
+    }
+
+    GlState::useProgram(0);
+    return true;
+}
+
+void InstancedRenderer::shutdown() {
+    if (instanceBuffer != 0) {
+        glDeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+    }
+    ShaderProgram::destroy(floatProgram);
+    ShaderProgram::destroy(packedProgram);
+}
+
+GLuint InstancedRenderer::programFor(VertexFormat format) {
+    if (shadersFailed) {
+        return 0;
+    }
+    GLuint& program = format == VertexFormat::PACKED16 ? packedProgram : floatProgram;
+    if (program == 0) {
+        bool packed = format == VertexFormat::PACKED16;
+        program = buildProgram(packed, packed ? packedUniforms : floatUniforms);
+        if (program == 0) {
+            // Stay on the per-object path rather than retrying every frame
+            shadersFailed = true;
+            std::cout << "Instanced rendering unavailable, drawing objects individually" << std::endl;
+        }
+    }
+    return program;
+}
+
+void InstancedRenderer::bindInstanceAttributes(size_t firstInstance) {
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    const GLsizei stride = sizeof(InstanceData);
+    size_t base = firstInstance * sizeof(InstanceData);
+    for (GLuint column = 0; column < 4; ++column) {
+        glEnableVertexAttribArray(INSTANCE_MODEL + column);
+        glVertexAttribPointer(INSTANCE_MODEL + column, 4, GL_FLOAT, GL_FALSE, stride,
+                              (const void*)(base + offsetof(InstanceData, model) + column * 4 * sizeof(float)));
+        glVertexAttribDivisor(INSTANCE_MODEL + column, 1);
+    }
+    glEnableVertexAttribArray(INSTANCE_COLOR);
+    glVertexAttribPointer(INSTANCE_COLOR, 4, GL_FLOAT, GL_FALSE, stride,
+                          (const void*)(base + offsetof(InstanceData, color)));
+    glVertexAttribDivisor(INSTANCE_COLOR, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedRenderer::unbindInstanceAttributes() {
+    for (GLuint attribute = INSTANCE_MODEL; attribute <= INSTANCE_COLOR; ++attribute) {
+        glVertexAttribDivisor(attribute, 0);
+        glDisableVertexAttribArray(attribute);
+    }
+}
@@ -0,0 +1,338 @@
+#include "../include/rendering/MeshCache.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/ShaderProgram.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+
+std::unordered_map<PrimitiveParams, GpuMesh, PrimitiveParamsHash> MeshCache::meshes;
+MeshCache::Stats MeshCache::stats;
+VertexFormat MeshCache::vertexFormat = VertexFormat::FLOAT32;
+GLuint MeshCache::packedShader = 0;
+GLuint MeshCache::streamIndexBuffer = 0;
+bool MeshCache::packedShaderFailed = false;
+
+namespace {
+    enum PackedAttribute : GLuint {
+        PACKED_POSITION = 0,
+        PACKED_NORMAL = 1,
+        PACKED_TEXCOORD = 2
+    };
+
+    // Decodes PackedVertex and reproduces the fixed-function look (current
+    // color, modulated by the bound texture when texturing is enabled)
+    const char* PACKED_VERTEX_SHADER = R"(#version 120
+attribute vec3 packedPosition;
+attribute vec2 packedNormal;
+attribute vec2 packedTexCoord;
+
+uniform vec3 decodeCenter;
+uniform vec3 decodeHalfExtent;
+uniform vec2 decodeUvMin;
+uniform vec2 decodeUvExtent;
+
+varying vec2 texCoord;
+varying vec3 viewNormal;
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        vec2 signs = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+        n.xy = (1.0 - abs(n.yx)) * signs;
+    }
+    return normalize(n);
+}
+
+void main() {
+    vec3 position = decodeCenter + packedPosition * decodeHalfExtent;
+    gl_Position = gl_ModelViewProjectionMatrix * vec4(position, 1.0);
+    viewNormal = gl_NormalMatrix * decodeOctahedral(packedNormal);
+    texCoord = decodeUvMin + packedTexCoord * decodeUvExtent;
+    gl_FrontColor = gl_Color;
+}
+)";
+
+    const char* PACKED_FRAGMENT_SHADER = R"(#version 120
+uniform sampler2D diffuse;
+uniform bool useTexture;
+
+varying vec2 texCoord;
+varying vec3 viewNormal;
+
+void main() {
+    gl_FragColor = useTexture ? texture2D(diffuse, texCoord) * gl_Color : gl_Color;
+}
+)";
+
+    struct PackedUniforms {
+        GLint center = -1;
+        GLint halfExtent = -1;
+        GLint uvMin = -1;
+        GLint uvExtent = -1;
+        GLint diffuse = -1;
+        GLint useTexture = -1;
+    } packedUniforms;
+}
+
+const GpuMesh& MeshCache::acquire(const PrimitiveParams& params) {
+    auto it = meshes.find(params);
+    if (it != meshes.end()) {
+        stats.hits++;
+        return it->second;
+    }
+
+    stats.misses++;
+    MeshData data = PrimitiveGenerator::generate(params);
+    MeshOptimizer::Report report = MeshOptimizer::optimize(data);
+    GpuMesh mesh;
+    if (vertexFormat == VertexFormat::PACKED16 && packedProgram() != 0) {
+        QuantizedMesh packed = VertexQuantizer::quantize(data);
+        mesh = uploadPacked(packed);
+        mesh.quantization = VertexQuantizer::measure(data, packed);
+    } else {
+        mesh = upload(data);
+    }
+    mesh.optimization = report;
+    stats.bytesResident += mesh.bytes;
+    stats.meshCount++;
+    return meshes.emplace(params, mesh).first->second;
+}
+
+const GpuMesh* MeshCache::find(const PrimitiveParams& params) {
+    auto it = meshes.find(params);
+    return it != meshes.end() ? &it->second : nullptr;
+}
+
+void MeshCache::draw(const PrimitiveParams& params) {
+    drawMesh(acquire(params));
+}
+
+void MeshCache::drawMesh(const GpuMesh& mesh) {
+    if (mesh.vao == 0 || mesh.indexCount == 0) {
+        return;
+    }
+    bindMesh(mesh);
+    drawBound(mesh);
+    unbindMesh();
+}
+
+void MeshCache::bindMesh(const GpuMesh& mesh) {
+    if (mesh.format == VertexFormat::PACKED16) {
+        GlState::useProgram(packedShader);
+        glUniform3fv(packedUniforms.center, 1, glm::value_ptr(mesh.center));
+        glUniform3fv(packedUniforms.halfExtent, 1, glm::value_ptr(mesh.halfExtent));
+        glUniform2fv(packedUniforms.uvMin, 1, glm::value_ptr(mesh.uvMin));
+        glUniform2fv(packedUniforms.uvExtent, 1, glm::value_ptr(mesh.uvExtent));
+    } else {
+        GlState::useProgram(0);
+    }
+    GlState::bindVertexArray(mesh.vao);
+}
+
+void MeshCache::drawBound(const GpuMesh& mesh) {
+    if (mesh.indexCount == 0) {
+        return;
+    }
+    // Texturing may change between draws of the same mesh
+    if (mesh.format == VertexFormat::PACKED16) {
+        glUniform1i(packedUniforms.useTexture, GlState::isEnabled(GL_TEXTURE_2D) ? 1 : 0);
+    }
+    glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, nullptr);
+}
+
+void MeshCache::drawBoundIndices(const GpuMesh& mesh, const std::vector<uint32_t>& indices) {
+    if (indices.empty()) {
+        return;
+    }
+    if (streamIndexBuffer == 0) {
+        glGenBuffers(1, &streamIndexBuffer);
+    }
+    if (mesh.format == VertexFormat::PACKED16) {
+        glUniform1i(packedUniforms.useTexture, GlState::isEnabled(GL_TEXTURE_2D) ? 1 : 0);
+    }
+
+    // The element buffer binding is VAO state, so the mesh's own is restored after
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, streamIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size() * sizeof(uint32_t), indices.data());
+    glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+}
+
+void MeshCache::unbindMesh() {
+    GlState::bindVertexArray(0);
+    GlState::useProgram(0);
+}
+
+void MeshCache::release(const PrimitiveParams& params) {
+    auto it = meshes.find(params);
+    if (it == meshes.end()) {
+        return;
+    }
+    stats.bytesResident -= it->second.bytes;
+    stats.meshCount--;
+    destroy(it->second);
+    meshes.erase(it);
+}
+
+void MeshCache::clear() {
+    for (auto& entry : meshes) {
+        destroy(entry.second);
+    }
+    meshes.clear();
+    if (streamIndexBuffer != 0) {
+        glDeleteBuffers(1, &streamIndexBuffer);
+        streamIndexBuffer = 0;
+    }
+    stats.bytesResident = 0;
+    stats.meshCount = 0;
+}
+
+const MeshCache::Stats& MeshCache::getStats() {
+    return stats;
+}
+
+void MeshCache::setVertexFormat(VertexFormat format) {
+    if (format == vertexFormat) {
+        return;
+    }
+    clear();
+    vertexFormat = format;
+    std::cout << "Mesh vertex format: " << (format == VertexFormat::PACKED16 ? "packed 16-bit" : "float") << std::endl;
+}
+
+VertexFormat MeshCache::getVertexFormat() {
+    return vertexFormat;
+}
+
+GpuMesh MeshCache::upload(const MeshData& data) {
+    GpuMesh mesh;
+    if (data.indices.empty()) {
+        return mesh;
+    }
+
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ibo);
+
+    GlState::bindVertexArray(mesh.vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(Vertex), data.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(uint32_t), data.indices.data(), GL_STATIC_DRAW);
+
+    // Fixed-function client arrays; the VAO records them together with the index buffer
+    const GLsizei stride = sizeof(Vertex);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, stride, (const void*)offsetof(Vertex, position));
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glNormalPointer(GL_FLOAT, stride, (const void*)offsetof(Vertex, normal));
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glTexCoordPointer(2, GL_FLOAT, stride, (const void*)offsetof(Vertex, texCoord));
+    glEnableVertexAttribArray(FLOAT_POSITION_ATTRIBUTE);
+    glVertexAttribPointer(FLOAT_POSITION_ATTRIBUTE, 3, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(FLOAT_TEXCOORD_ATTRIBUTE);
+    glVertexAttribPointer(FLOAT_TEXCOORD_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, stride, (const void*)offsetof(Vertex, texCoord));
+
+    GlState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    mesh.indexCount = (GLsizei)data.indices.size();
+    mesh.bytes = data.byteSize();
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        std::cout << "OpenGL error after uploading mesh: " << error << std::endl;
+    }
+    return mesh;
+}
+
+GpuMesh MeshCache::uploadPacked(const QuantizedMesh& data) {
+    GpuMesh mesh;
+    if (data.indexCount() == 0) {
+        return mesh;
+    }
+
+    glGenVertexArrays(1, &mesh.vao);
+    glGenBuffers(1, &mesh.vbo);
+    glGenBuffers(1, &mesh.ibo);
+
+    GlState::bindVertexArray(mesh.vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(PackedVertex), data.vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ibo);
+    if (data.usesShortIndices()) {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.shortIndices.size() * sizeof(uint16_t), data.shortIndices.data(), GL_STATIC_DRAW);
+        mesh.indexType = GL_UNSIGNED_SHORT;
+    } else {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, data.indices.size() * sizeof(uint32_t), data.indices.data(), GL_STATIC_DRAW);
+        mesh.indexType = GL_UNSIGNED_INT;
+    }
+
+    // Normalized integer attributes; the shader applies the AABB and UV ranges
+    const GLsizei stride = sizeof(PackedVertex);
+    glEnableVertexAttribArray(PACKED_POSITION);
+    glVertexAttribPointer(PACKED_POSITION, 3, GL_SHORT, GL_TRUE, stride, (const void*)offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(PACKED_NORMAL);
+    glVertexAttribPointer(PACKED_NORMAL, 2, GL_SHORT, GL_TRUE, stride, (const void*)offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(PACKED_TEXCOORD);
+    glVertexAttribPointer(PACKED_TEXCOORD, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, (const void*)offsetof(PackedVertex, texCoord));
+
+    GlState::bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    mesh.indexCount = (GLsizei)data.indexCount();
+    mesh.bytes = data.byteSize();
+    mesh.format = VertexFormat::PACKED16;
+    mesh.center = data.center;
+    mesh.halfExtent = data.halfExtent;
+    mesh.uvMin = data.uvMin;
+    mesh.uvExtent = data.uvExtent;
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        std::cout << "OpenGL error after uploading packed mesh: " << error << std::endl;
+    }
+    return mesh;
+}
+
+GLuint MeshCache::packedProgram() {
+    if (packedShader != 0 || packedShaderFailed) {
+        return packedShader;
+    }
+
+    packedShader = ShaderProgram::build("packed mesh", PACKED_VERTEX_SHADER, PACKED_FRAGMENT_SHADER,
+                                        {{PACKED_POSITION, "packedPosition"},
+                                         {PACKED_NORMAL, "packedNormal"},
+                                         {PACKED_TEXCOORD, "packedTexCoord"}});
+    if (packedShader == 0) {
+        // Keep drawing float meshes rather than retrying every frame
+        packedShaderFailed = true;
+        std::cout << "Packed vertex format unavailable, using float vertices" << std::endl;
+        return 0;
+    }
+
+    packedUniforms.center = glGetUniformLocation(packedShader, "decodeCenter");
+    packedUniforms.halfExtent = glGetUniformLocation(packedShader, "decodeHalfExtent");
+    packedUniforms.uvMin = glGetUniformLocation(packedShader, "decodeUvMin");
+    packedUniforms.uvExtent = glGetUniformLocation(packedShader, "decodeUvExtent");
+    packedUniforms.diffuse = glGetUniformLocation(packedShader, "diffuse");
+    packedUniforms.useTexture = glGetUniformLocation(packedShader, "useTexture");
+
+    GlState::useProgram(packedShader);
+    glUniform1i(packedUniforms.diffuse, 0);
+    GlState::useProgram(0);
+    return packedShader;
+}
+
+void MeshCache::destroy(GpuMesh& mesh) {
+    if (mesh.vao != 0) glDeleteVertexArrays(1, &mesh.vao);
+    if (mesh.vbo != 0) glDeleteBuffers(1, &mesh.vbo);
+    if (mesh.ibo != 0) glDeleteBuffers(1, &mesh.ibo);
+    mesh = GpuMesh();
+    // Deleting a bound VAO rebinds 0 behind the state cache
+    GlState::invalidate();
+}
@@ -0,0 +1,73 @@
+#include "../include/rendering/OcclusionDebugView.hpp"
+#include "../include/rendering/GlState.hpp"
+#include <algorithm>
+
+GLuint OcclusionDebugView::texture = 0;
+std::vector<unsigned char> OcclusionDebugView::pixels;
+
+void OcclusionDebugView::draw(const OcclusionCuller& culler, const Camera& camera, float x1, float y1, float x2,
+                              float y2) {
+    const float* depth = culler.getDepth();
+    if (!depth) {
+        return;
+    }
+    int width = culler.getSettings().width;
+    int height = culler.getSettings().height;
+
+    // View distance from window depth, then brightness falling off to black at 30 units
+    float nearPlane = camera.nearPlane;
+    float farPlane = camera.farPlane;
+    pixels.resize((size_t)width * height);
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        if (depth[i] >= 1.0f) {
+            pixels[i] = 0;
+            continue;
+        }
+        float ndcZ = depth[i] * 2.0f - 1.0f;
+        float distance = 2.0f * nearPlane * farPlane / (farPlane + nearPlane - ndcZ * (farPlane - nearPlane));
+        pixels[i] = (unsigned char)(40.0f + 215.0f * std::max(0.0f, 1.0f - distance / 30.0f));
+    }
+
+    if (texture == 0) {
+        glGenTextures(1, &texture);
+        GlState::bindTexture(texture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else {
+        GlState::bindTexture(texture);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Row 0 of the buffer is the bottom of the screen, matching texture t = 0
+    GlState::enable(GL_TEXTURE_2D);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(x1, y1);
+    glTexCoord2f(1.0f, 0.0f); glVertex2f(x2, y1);
+    glTexCoord2f(1.0f, 1.0f); glVertex2f(x2, y2);
+    glTexCoord2f(0.0f, 1.0f); glVertex2f(x1, y2);
+    glEnd();
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    GlState::bindTexture(0);
+    GlState::disable(GL_TEXTURE_2D);
+
+    glColor3f(0.8f, 0.8f, 0.8f);
+    glBegin(GL_LINE_LOOP);
+    glVertex2f(x1, y1);
+    glVertex2f(x2, y1);
+    glVertex2f(x2, y2);
+    glVertex2f(x1, y2);
+    glEnd();
+}
+
+void OcclusionDebugView::shutdown() {
+    if (texture != 0) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+        GlState::invalidate();
+    }
+}
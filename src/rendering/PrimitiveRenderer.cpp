@@ -1,98 +1,48 @@
 #include "../include/rendering/PrimitiveRenderer.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/UiRenderer.hpp"
 #include "../include/core/Constants.hpp"
+#include "../include/core/Image.hpp"
 #include <cmath>
 #include <vector>
 #include <iostream>
 #include <fstream>
 
-#define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 // Initialize static member
 std::vector<GLuint> PrimitiveRenderer::textureIDs;
+uint32_t PrimitiveRenderer::textColor = 0xffffffffu;
 
-// NEW: Function to apply texture to a shape
-void PrimitiveRenderer::applyTextureToShape(ShapeType shapeType, int textureID, ApplicationState& appState) {
-    if (shapeType != ShapeType::NONE) {
-        int shapeIndex = static_cast<int>(shapeType) - 1; // Convert enum to index (0-5)
-        if (shapeIndex >= 0 && shapeIndex < 6) {
-            appState.shapeTextures[shapeIndex] = textureID;
-            appState.shapeUsesTexture[shapeIndex] = true; // Mark as using texture
-            std::cout << "Applied texture " << textureID << " to shape " << shapeIndex << std::endl;
-        }
-    }
-}
-
-// NEW: Function to apply color to a shape (remove texture)
-void PrimitiveRenderer::applyColorToShape(ShapeType shapeType, ApplicationState& appState) {
-    if (shapeType != ShapeType::NONE) {
-        int shapeIndex = static_cast<int>(shapeType) - 1;
-        if (shapeIndex >= 0 && shapeIndex < 6) {
-            appState.shapeUsesTexture[shapeIndex] = false; // Mark as using color
-            std::cout << "Applied color to shape " << shapeIndex << std::endl;
-        }
-    }
+// The draws below go through UiRenderer, which batches them between its
+// begin and end calls and draws them right away otherwise
+void PrimitiveRenderer::drawRect(float x1, float y1, float x2, float y2, float r, float g, float b) {
+    UiRenderer::rect(x1, y1, x2, y2, UiRenderer::packColor(r, g, b));
 }
 
-// NEW: Function to get texture for a shape
-int PrimitiveRenderer::getShapeTexture(ShapeType shapeType, ApplicationState& appState) {
-    if (shapeType != ShapeType::NONE) {
-        int shapeIndex = static_cast<int>(shapeType) - 1;
-        if (shapeIndex >= 0 && shapeIndex < 6) {
-            return appState.shapeTextures[shapeIndex];
-        }
-    }
-    return -1;
+void PrimitiveRenderer::drawOutlineRect(float x1, float y1, float x2, float y2, float lineR, float lineG, float lineB, float lineWidth) {
+    UiRenderer::outline(x1, y1, x2, y2, UiRenderer::packColor(lineR, lineG, lineB), lineWidth);
 }
 
-// NEW: Function to check if shape uses texture
-bool PrimitiveRenderer::shapeHasTexture(ShapeType shapeType, ApplicationState& appState) {
-    if (shapeType != ShapeType::NONE) {
-        int shapeIndex = static_cast<int>(shapeType) - 1;
-        if (shapeIndex >= 0 && shapeIndex < 6) {
-            return appState.shapeUsesTexture[shapeIndex];
-        }
-    }
-    return false;
+void PrimitiveRenderer::drawCircle(float cx, float cy, float radius, int segments, float r, float g, float b) {
+    UiRenderer::circle(cx, cy, radius, segments, UiRenderer::packColor(r, g, b));
 }
 
-void PrimitiveRenderer::drawRect(float x1, float y1, float x2, float y2, float r, float g, float b) {
-    glColor3f(r, g, b);
-    glBegin(GL_QUADS);
-    glVertex2f(x1, y1);
-    glVertex2f(x2, y1);
-    glVertex2f(x2, y2);
-    glVertex2f(x1, y2);
-    glEnd();
+void PrimitiveRenderer::drawLine(float x1, float y1, float x2, float y2, float r, float g, float b, float lineWidth) {
+    UiRenderer::line(x1, y1, x2, y2, UiRenderer::packColor(r, g, b), lineWidth);
 }
 
-void PrimitiveRenderer::drawOutlineRect(float x1, float y1, float x2, float y2, float lineR, float lineG, float lineB, float lineWidth) {
-    glColor3f(lineR, lineG, lineB);
-    glLineWidth(lineWidth);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(x1, y1);
-    glVertex2f(x2, y1);
-    glVertex2f(x2, y2);
-    glVertex2f(x1, y2);
-    glEnd();
+void PrimitiveRenderer::drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3, float r, float g, float b) {
+    uint32_t color = UiRenderer::packColor(r, g, b);
+    UiRenderer::triangle({x1, y1, 0.0f, 0.0f, color}, {x2, y2, 0.0f, 0.0f, color}, {x3, y3, 0.0f, 0.0f, color});
 }
 
-void PrimitiveRenderer::drawCircle(float cx, float cy, float radius, int segments, float r, float g, float b) {
-    glColor3f(r,g,b);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex2f(cx, cy);
-    for (int i=0;i<=segments;i++){
-        float a = (float)i / (float)segments * 2.0f * Constants::PI;
-        glVertex2f(cx + cosf(a)*radius, cy + sinf(a)*radius);
-    }
-    glEnd();
+void PrimitiveRenderer::setTextColor(float r, float g, float b) {
+    textColor = UiRenderer::packColor(r, g, b);
 }
 
 void PrimitiveRenderer::drawText(const std::string &text, float x, float y, void* font) {
-    glRasterPos2f(x, y);
-    for (char c : text) {
-        glutBitmapCharacter(font, (int)c);
-    }
+    UiRenderer::text(text, x, y, font, textColor);
 }
 
 float PrimitiveRenderer::pxToNDCx(int px, int width) {
@@ -115,7 +65,11 @@ bool PrimitiveRenderer::isInsideNDC(double mx, double my, int width, int height,
 }
 
 void PrimitiveRenderer::setScissor(int x, int y, int width, int height, int screenHeight) {
-    glScissor(x, screenHeight - y - height, width, height);
+    UiRenderer::setClip(x, screenHeight - y - height, width, height);
+}
+
+void PrimitiveRenderer::clearScissor() {
+    UiRenderer::clearClip();
 }
 
 bool PrimitiveRenderer::loadTexture(const std::string& filename, GLuint& textureID) {
@@ -140,7 +94,7 @@ bool PrimitiveRenderer::loadTexture(const std::string& filename, GLuint& texture
         std::cout << "Loading texture: " << filename << " (" << width << "x" << height << ", channels: " << nrChannels << ")" << std::endl;
 
         glGenTextures(1, &textureID);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        GlState::bindTexture(textureID);
 
         // Set texture parameters - USE COMPATIBLE CONSTANTS
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -179,6 +133,26 @@ bool PrimitiveRenderer::loadTexture(const std::string& filename, GLuint& texture
     }
 }
 
+void PrimitiveRenderer::applyMaterial(const ObjectMaterial& material) {
+    int textureID = material.texture;
+
+    if (textureID >= 0 && textureID < (int)textureIDs.size() &&
+        textureIDs[textureID] != 0) {
+        // Enable texturing with proper parameters
+        // Wrap and filter parameters are set once when the texture is loaded
+        GlState::enable(GL_TEXTURE_2D);
+        GlState::bindTexture(textureIDs[textureID]);
+
+        GlState::enable(GL_BLEND);
+        GlState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Use white to preserve texture colors
+    } else {
+        // Use regular coloring
+        GlState::disable(GL_TEXTURE_2D);
+        glColor3f(material.color.r, material.color.g, material.color.b);
+    }
+}
+
 void PrimitiveRenderer::drawTexturedRect(float x1, float y1, float x2, float y2, GLuint textureID) {
     if (textureID == 0) {
         // Draw a colored fallback if texture is invalid
@@ -186,49 +160,21 @@ void PrimitiveRenderer::drawTexturedRect(float x1, float y1, float x2, float y2,
         return;
     }
 
-    // Save current state
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, textureID);
-
-    // Enable blending for textures with transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Set color to white to preserve texture colors
-    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-
-    glBegin(GL_QUADS);
-    // Correct texture coordinates - match vertex order
-    glTexCoord2f(0.0f, 1.0f); glVertex2f(x1, y1); // Bottom-left
-    glTexCoord2f(1.0f, 1.0f); glVertex2f(x2, y1); // Bottom-right
-    glTexCoord2f(1.0f, 0.0f); glVertex2f(x2, y2); // Top-right
-    glTexCoord2f(0.0f, 0.0f); glVertex2f(x1, y2); // Top-left
-    glEnd();
-
-    // Restore state
-    glPopAttrib();
+    // Top of the image at y2
+    UiRenderer::texturedRect(x1, y1, x2, y2, textureID, 0.0f, 1.0f, 1.0f, 0.0f);
 }
 
 void PrimitiveRenderer::initTextures() {
     std::cout << "Initializing textures..." << std::endl;
 
     // Load all textures as PNG files
-    std::vector<std::string> textureFiles = {
-        "textures/texture1.png",
-        "textures/texture2.png",
-        "textures/texture3.png",
-        "textures/texture4.png",
-        "textures/texture5.png",
-        "textures/texture6.png"
-    };
+    std::vector<std::string> textureFiles(std::begin(Constants::TEXTURE_FILES), std::end(Constants::TEXTURE_FILES));
 
     textureIDs.resize(textureFiles.size(), 0);
     int loadedCount = 0;
 
     // Enable texturing globally
-    glEnable(GL_TEXTURE_2D);
+    GlState::enable(GL_TEXTURE_2D);
 
     for (size_t i = 0; i < textureFiles.size(); ++i) {
         GLuint textureID = 0;
@@ -240,72 +186,28 @@ void PrimitiveRenderer::initTextures() {
             std::cout << "Creating fallback texture for slot " << i << std::endl;
             // Create a fallback texture that shows the texture number
             glGenTextures(1, &textureIDs[i]);
-            glBindTexture(GL_TEXTURE_2D, textureIDs[i]);
-
-            // Create a simple colored texture with the texture number
-            const int texSize = 64;
-            unsigned char fallbackData[texSize * texSize * 3];
-
-            for (int y = 0; y < texSize; y++) {
-                for (int x = 0; x < texSize; x++) {
-                    int index = (y * texSize + x) * 3;
-
-                    // Create a colored background based on texture index
-                    float hue = (i * 60.0f) / 360.0f; // Different color for each texture
-                    float r, g, b;
-
-                    // Simple HSV to RGB conversion
-                    int hi = (int)(hue * 6);
-                    float f = hue * 6 - hi;
-                    float p = 0.0f;
-                    float q = 1.0f - f;
-                    float t = f;
-
-                    switch (hi) {
-                        case 0: r = 1.0f; g = t; b = p; break;
-                        case 1: r = q; g = 1.0f; b = p; break;
-                        case 2: r = p; g = 1.0f; b = t; break;
-                        case 3: r = p; g = q; b = 1.0f; break;
-                        case 4: r = t; g = p; b = 1.0f; break;
-                        default: r = 1.0f; g = p; b = q; break;
-                    }
-
-                    // Add a pattern to show it's a fallback
-                    bool isBorder = (x < 4 || x >= texSize-4 || y < 4 || y >= texSize-4);
-                    bool isCenter = (x >= texSize/2-8 && x < texSize/2+8 && y >= texSize/2-8 && y < texSize/2+8);
-
-                    if (isBorder) {
-                        fallbackData[index] = 255;
-                        fallbackData[index + 1] = 255;
-                        fallbackData[index + 2] = 255;
-                    } else if (isCenter) {
-                        // Draw the texture number in the center
-                        fallbackData[index] = (unsigned char)(r * 255);
-                        fallbackData[index + 1] = (unsigned char)(g * 255);
-                        fallbackData[index + 2] = (unsigned char)(b * 255);
-                    } else {
-                        fallbackData[index] = (unsigned char)(r * 128);
-                        fallbackData[index + 1] = (unsigned char)(g * 128);
-                        fallbackData[index + 2] = (unsigned char)(b * 128);
-                    }
-                }
-            }
+            GlState::bindTexture(textureIDs[i]);
+
+            // Same placeholder the headless renderer uses, so both show it alike
+            Image fallback = Image::fallbackTexture((int)i);
 
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, texSize, texSize, 0, GL_RGB, GL_UNSIGNED_BYTE, fallbackData);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, fallback.width, fallback.height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         fallback.pixels.data());
 
             // Generate mipmaps
-            gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGB, texSize, texSize, GL_RGB, GL_UNSIGNED_BYTE, fallbackData);
+            gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA, fallback.width, fallback.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                              fallback.pixels.data());
 
             std::cout << "Created fallback texture with ID: " << textureIDs[i] << std::endl;
         }
     }
 
     // Unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GlState::bindTexture(0);
 
     std::cout << "Texture initialization complete. Loaded " << loadedCount << " out of " << textureFiles.size() << " textures." << std::endl;
     std::cout << "Texture IDs: ";
@@ -324,4 +226,5 @@ void PrimitiveRenderer::cleanupTextures() {
         }
     }
     textureIDs.clear();
+    GlState::invalidate();
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "../include/rendering/ShaderProgram.hpp"
+#include <iostream>
+#include <string>
+
+GLuint ShaderProgram::build(const char* name, const char* vertexSource, const char* fragmentSource,
+                            const std::vector<std::pair<GLuint, const char*>>& attributes) {
+    GLuint vertexShader = compile(name, GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = compile(name, GL_FRAGMENT_SHADER, fragmentSource);
+    if (vertexShader == 0 || fragmentShader == 0) {
+        if (vertexShader != 0) glDeleteShader(vertexShader);
+        if (fragmentShader != 0) glDeleteShader(fragmentShader);
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    for (const auto& attribute : attributes) {
+        glBindAttribLocation(program, attribute.first, attribute.second);
+    }
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        GLint length = 0;
+        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+        std::string log(length > 0 ? length : 1, '\0');
+        glGetProgramInfoLog(program, (GLsizei)log.size(), nullptr, &log[0]);
+        std::cout << "ERROR: Failed to link shader program " << name << ": " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+void ShaderProgram::destroy(GLuint& program) {
+    if (program != 0) {
+        glDeleteProgram(program);
+        program = 0;
+    }
+}
+
+GLuint ShaderProgram::compile(const char* name, GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE) {
+        GLint length = 0;
+        glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+        std::string log(length > 0 ? length : 1, '\0');
+        glGetShaderInfoLog(shader, (GLsizei)log.size(), nullptr, &log[0]);
+        std::cout << "ERROR: Failed to compile " << (type == GL_VERTEX_SHADER ? "vertex" : "fragment")
+                  << " shader " << name << ": " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
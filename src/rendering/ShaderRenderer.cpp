@@ -0,0 +1,362 @@
+#include "../include/rendering/ShaderRenderer.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/PrimitiveRenderer.hpp"
+#include "../include/rendering/ShaderProgram.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+GLuint ShaderRenderer::floatProgram = 0;
+GLuint ShaderRenderer::packedProgram = 0;
+bool ShaderRenderer::shadersFailed = false;
+GLuint ShaderRenderer::cameraBuffer = 0;
+GLuint ShaderRenderer::objectBuffer = 0;
+size_t ShaderRenderer::objectStride = 0;
+size_t ShaderRenderer::objectCapacity = 0;
+unsigned char* ShaderRenderer::mapped = nullptr;
+int ShaderRenderer::segment = 0;
+size_t ShaderRenderer::segmentUsed = 0;
+GLsync ShaderRenderer::fences[ShaderRenderer::FRAMES_IN_FLIGHT] = {};
+std::vector<unsigned char> ShaderRenderer::staging;
+
+namespace {
+    const GLuint CAMERA_BINDING = 0;
+    const GLuint OBJECT_BINDING = 1;
+
+    // Packed meshes use MeshCache's packed attribute slots
+    const GLuint PACKED_POSITION = 0;
+    const GLuint PACKED_TEXCOORD = 2;
+
+    // Shared by both stages; block layouts must match across a program
+    const char* UNIFORM_BLOCKS = R"(
+layout(std140) uniform CameraData {
+    mat4 viewProjection;
+    mat4 view;
+};
+
+layout(std140) uniform ObjectData {
+    mat4 model;
+    vec4 color;
+    vec4 decodeCenter;
+    vec4 decodeHalfExtent;
+    vec4 decodeUv;
+} object;
+)";
+
+    const char* VERTEX_SHADER = R"(
+#ifdef PACKED
+layout(location = PACKED_POSITION) in vec3 packedPosition;
+layout(location = PACKED_TEXCOORD) in vec2 packedTexCoord;
+#else
+layout(location = FLOAT_POSITION) in vec3 position;
+layout(location = FLOAT_TEXCOORD) in vec2 vertexTexCoord;
+#endif
+
+out vec2 texCoord;
+
+void main() {
+#ifdef PACKED
+    vec3 localPosition = object.decodeCenter.xyz + packedPosition * object.decodeHalfExtent.xyz;
+    texCoord = object.decodeUv.xy + packedTexCoord * object.decodeUv.zw;
+#else
+    vec3 localPosition = position;
+    texCoord = vertexTexCoord;
+#endif
+    gl_Position = viewProjection * (object.model * vec4(localPosition, 1.0));
+}
+)";
+
+    const char* FRAGMENT_SHADER = R"(
+uniform sampler2D diffuse;
+
+in vec2 texCoord;
+out vec4 fragColor;
+
+void main() {
+    fragColor = object.decodeCenter.w > 0.5 ? texture(diffuse, texCoord) * object.color : object.color;
+}
+)";
+
+    GLuint buildProgram(bool packed) {
+        std::string header = "#version 330 core\n";
+        if (packed) {
+            header += "#define PACKED\n";
+        }
+        header += "#define PACKED_POSITION " + std::to_string(PACKED_POSITION) + "\n";
+        header += "#define PACKED_TEXCOORD " + std::to_string(PACKED_TEXCOORD) + "\n";
+        header += "#define FLOAT_POSITION " + std::to_string(MeshCache::FLOAT_POSITION_ATTRIBUTE) + "\n";
+        header += "#define FLOAT_TEXCOORD " + std::to_string(MeshCache::FLOAT_TEXCOORD_ATTRIBUTE) + "\n";
+        std::string vertexSource = header + UNIFORM_BLOCKS + VERTEX_SHADER;
+        std::string fragmentSource = header + UNIFORM_BLOCKS + FRAGMENT_SHADER;
+
+        GLuint program = ShaderProgram::build(packed ? "core packed" : "core", vertexSource.c_str(),
+                                              fragmentSource.c_str());
+        if (program == 0) {
+            return 0;
+        }
+
+        glUniformBlockBinding(program, glGetUniformBlockIndex(program, "CameraData"), CAMERA_BINDING);
+        glUniformBlockBinding(program, glGetUniformBlockIndex(program, "ObjectData"), OBJECT_BINDING);
+        GlState::useProgram(program);
+        glUniform1i(glGetUniformLocation(program, "diffuse"), 0);
+        GlState::useProgram(0);
+        return program;
+    }
+}
+
+void ShaderRenderer::beginFrame() {
+    segmentUsed = 0;
+    if (!mapped) {
+        return;
+    }
+    segment = (segment + 1) % FRAMES_IN_FLIGHT;
+
+    // Wait until the GPU has finished the frame that last used this segment
+    GLsync& fence = fences[segment];
+    if (fence) {
+        while (true) {
+            GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            if (result != GL_TIMEOUT_EXPIRED) {
+                break;
+            }
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void ShaderRenderer::endFrame() {
+    // The GPU owns this segment until the fence passes
+    if (mapped && segmentUsed > 0) {
+        fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+bool ShaderRenderer::drawScene(const Scene& scene, const RenderQueue& queue, const Camera& camera, FrameStats& stats) {
+    if (!ensurePrograms()) {
+        return false;
+    }
+    const std::vector<uint64_t>& keys = queue.getKeys();
+    const std::vector<uint32_t>& objects = queue.getObjects();
+    if (keys.empty()) {
+        return true;
+    }
+    if (!ensureObjectCapacity(segmentUsed + keys.size())) {
+        return false;
+    }
+
+    // Camera block, once per view
+    glm::mat4 cameraData[2] = {camera.viewProjection(), camera.view()};
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(cameraData), cameraData);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, cameraBuffer);
+
+    // Per-object blocks, in draw order, after the views already drawn this frame
+    unsigned char* out = beginObjectWrites(keys.size());
+    const GpuMesh* mesh = nullptr;
+    for (size_t k = 0; k < keys.size(); ++k) {
+        if (k == 0 || RenderQueue::meshOf(keys[k]) != RenderQueue::meshOf(keys[k - 1])) {
+            mesh = &MeshCache::acquire(RenderQueue::paramsOf(keys[k]));
+        }
+        uint32_t object = objects[k];
+        int texture = RenderQueue::textureOf(keys[k]);
+        bool textured = texture >= 0 && texture < (int)PrimitiveRenderer::textureIDs.size() &&
+                        PrimitiveRenderer::textureIDs[texture] != 0;
+
+        ObjectData data;
+        std::memcpy(data.model, glm::value_ptr(scene.worldMatrices[object]), sizeof(data.model));
+        const glm::vec3& color = scene.materials[object].color;
+        // Textured objects are drawn with white so the texture shows unmodified
+        data.color[0] = textured ? 1.0f : color.r;
+        data.color[1] = textured ? 1.0f : color.g;
+        data.color[2] = textured ? 1.0f : color.b;
+        data.color[3] = 1.0f;
+        data.decodeCenter[0] = mesh->center.x;
+        data.decodeCenter[1] = mesh->center.y;
+        data.decodeCenter[2] = mesh->center.z;
+        data.decodeCenter[3] = textured ? 1.0f : 0.0f;
+        data.decodeHalfExtent[0] = mesh->halfExtent.x;
+        data.decodeHalfExtent[1] = mesh->halfExtent.y;
+        data.decodeHalfExtent[2] = mesh->halfExtent.z;
+        data.decodeHalfExtent[3] = 0.0f;
+        data.decodeUv[0] = mesh->uvMin.x;
+        data.decodeUv[1] = mesh->uvMin.y;
+        data.decodeUv[2] = mesh->uvExtent.x;
+        data.decodeUv[3] = mesh->uvExtent.y;
+        std::memcpy(out + k * objectStride, &data, sizeof(data));
+    }
+    endObjectWrites(keys.size());
+    size_t segmentOffset = mapped ? ((size_t)segment * objectCapacity + segmentUsed) * objectStride : 0;
+    if (mapped) {
+        segmentUsed += keys.size();
+    }
+
+    // Submission in key order, changing only the state whose key bits differ
+    uint32_t boundMesh = 0;
+    int boundTexture = -1;
+    bool blending = false;
+    for (size_t k = 0; k < keys.size(); ++k) {
+        uint64_t key = keys[k];
+        bool first = k == 0;
+
+        uint32_t meshBits = RenderQueue::meshOf(key);
+        if (first || meshBits != boundMesh) {
+            mesh = &MeshCache::acquire(RenderQueue::paramsOf(key));
+            GlState::useProgram(mesh->format == VertexFormat::PACKED16 ? packedProgram : floatProgram);
+            GlState::bindVertexArray(mesh->vao);
+            boundMesh = meshBits;
+            stats.stateChanges++;
+        }
+
+        int texture = RenderQueue::textureOf(key);
+        if (first || texture != boundTexture) {
+            GLuint id = texture >= 0 && texture < (int)PrimitiveRenderer::textureIDs.size()
+                            ? PrimitiveRenderer::textureIDs[texture] : 0;
+            GlState::bindTexture(id);
+            boundTexture = texture;
+            stats.stateChanges++;
+        }
+
+        bool blended = RenderQueue::isBlended(key);
+        if (first || blended != blending) {
+            if (blended) {
+                GlState::enable(GL_BLEND);
+                GlState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            } else {
+                GlState::disable(GL_BLEND);
+            }
+            blending = blended;
+            stats.stateChanges++;
+        }
+
+        if (mesh->vao == 0 || mesh->indexCount == 0) {
+            continue;
+        }
+        glBindBufferRange(GL_UNIFORM_BUFFER, OBJECT_BINDING, objectBuffer,
+                          (GLintptr)(segmentOffset + k * objectStride), sizeof(ObjectData));
+        glDrawElements(GL_TRIANGLES, mesh->indexCount, mesh->indexType, nullptr);
+        stats.drawCalls++;
+        stats.instances++;
+    }
+
+    GlState::useProgram(0);
+    GlState::bindVertexArray(0);
+    GlState::bindTexture(0);
+    GlState::disable(GL_BLEND);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    return true;
+}
+
+void ShaderRenderer::shutdown() {
+    releaseObjectBuffer();
+    if (cameraBuffer != 0) {
+        glDeleteBuffers(1, &cameraBuffer);
+        cameraBuffer = 0;
+    }
+    ShaderProgram::destroy(floatProgram);
+    ShaderProgram::destroy(packedProgram);
+    GlState::invalidate();
+}
+
+bool ShaderRenderer::ensurePrograms() {
+    if (shadersFailed) {
+        return false;
+    }
+    if (floatProgram != 0) {
+        return true;
+    }
+
+    floatProgram = buildProgram(false);
+    packedProgram = buildProgram(true);
+    if (floatProgram == 0 || packedProgram == 0) {
+        ShaderProgram::destroy(floatProgram);
+        ShaderProgram::destroy(packedProgram);
+        shadersFailed = true;
+        std::cout << "Core-profile renderer unavailable, using the legacy path" << std::endl;
+        return false;
+    }
+
+    glGenBuffers(1, &cameraBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment = std::max(alignment, 16);
+    objectStride = (sizeof(ObjectData) + alignment - 1) / alignment * alignment;
+    return true;
+}
+
+bool ShaderRenderer::ensureObjectCapacity(size_t objectCount) {
+    if (objectBuffer != 0 && objectCount <= objectCapacity) {
+        return true;
+    }
+    size_t capacity = std::max(objectCount, std::max(objectCapacity * 2, (size_t)1024));
+    releaseObjectBuffer();
+
+    glGenBuffers(1, &objectBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, objectBuffer);
+    if (glBufferStorage) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr bytes = (GLsizeiptr)(FRAMES_IN_FLIGHT * capacity * objectStride);
+        glBufferStorage(GL_UNIFORM_BUFFER, bytes, nullptr, flags);
+        mapped = (unsigned char*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, bytes, flags);
+        if (!mapped) {
+            // Storage is immutable, so fall back on a fresh buffer
+            glDeleteBuffers(1, &objectBuffer);
+            glGenBuffers(1, &objectBuffer);
+            glBindBuffer(GL_UNIFORM_BUFFER, objectBuffer);
+        }
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    if (!mapped) {
+        std::cout << "Persistent mapping unavailable, streaming object data by orphaning" << std::endl;
+    }
+    // Views drawn earlier this frame keep the old buffer alive until the GPU is done with it
+    objectCapacity = capacity;
+    segment = 0;
+    segmentUsed = 0;
+    return true;
+}
+
+void ShaderRenderer::releaseObjectBuffer() {
+    for (GLsync& fence : fences) {
+        if (fence) {
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (objectBuffer != 0) {
+        if (mapped) {
+            glBindBuffer(GL_UNIFORM_BUFFER, objectBuffer);
+            glUnmapBuffer(GL_UNIFORM_BUFFER);
+            glBindBuffer(GL_UNIFORM_BUFFER, 0);
+            mapped = nullptr;
+        }
+        glDeleteBuffers(1, &objectBuffer);
+        objectBuffer = 0;
+    }
+    objectCapacity = 0;
+}
+
+unsigned char* ShaderRenderer::beginObjectWrites(size_t objectCount) {
+    if (!mapped) {
+        staging.resize(objectCount * objectStride);
+        return staging.data();
+    }
+    return mapped + ((size_t)segment * objectCapacity + segmentUsed) * objectStride;
+}
+
+void ShaderRenderer::endObjectWrites(size_t objectCount) {
+    if (mapped) {
+        return; // Coherent mapping: writes are visible to the next draws
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, objectBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)(objectCount * objectStride), staging.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
@@ -0,0 +1,80 @@
+#include "../include/rendering/TextRenderer.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/core/Constants.hpp"
+#include <GL/glut.h>
+#include <iostream>
+#include <vector>
+
+FontAtlas TextRenderer::atlas;
+GLuint TextRenderer::texture = 0;
+std::string TextRenderer::fontPath;
+
+namespace {
+    // The GLUT bitmap sizes the UI uses
+    const std::vector<float> BAKED_SIZES = {10.0f, 12.0f, 18.0f};
+}
+
+bool TextRenderer::init() {
+    shutdown();
+    std::vector<uint8_t> fontData;
+    for (const char* path : Constants::FONT_FILES) {
+        if (FontAtlas::loadFile(path, fontData) && atlas.build(fontData, BAKED_SIZES)) {
+            fontPath = path;
+            break;
+        }
+    }
+    if (atlas.empty()) {
+        std::cout << "No UI font found, drawing GLUT bitmap text" << std::endl;
+        return false;
+    }
+
+    glGenTextures(1, &texture);
+    GlState::bindTexture(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    // Coverage in alpha, so the modulated vertex color tints it
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, atlas.getWidth(), atlas.getHeight(), 0, GL_ALPHA, GL_UNSIGNED_BYTE,
+                 atlas.getPixels().data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    GlState::bindTexture(0);
+
+    std::cout << "UI font: " << fontPath << " (" << atlas.getWidth() << "x" << atlas.getHeight() << " atlas)"
+              << std::endl;
+    return true;
+}
+
+void TextRenderer::shutdown() {
+    if (texture != 0) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+        GlState::invalidate();
+    }
+    atlas = FontAtlas();
+    fontPath.clear();
+}
+
+float TextRenderer::pixelSizeOf(void* glutFont) {
+    if (glutFont == GLUT_BITMAP_HELVETICA_10 || glutFont == GLUT_BITMAP_TIMES_ROMAN_10) {
+        return 10.0f;
+    }
+    if (glutFont == GLUT_BITMAP_HELVETICA_12) {
+        return 12.0f;
+    }
+    if (glutFont == GLUT_BITMAP_8_BY_13) {
+        return 13.0f;
+    }
+    if (glutFont == GLUT_BITMAP_9_BY_15) {
+        return 15.0f;
+    }
+    if (glutFont == GLUT_BITMAP_HELVETICA_18) {
+        return 18.0f;
+    }
+    return 24.0f;
+}
+
+int TextRenderer::sizeFor(void* glutFont) {
+    return atlas.sizeIndexFor(pixelSizeOf(glutFont));
+}
@@ -0,0 +1,66 @@
+#include "../include/rendering/TransparentRenderer.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/MeshCache.hpp"
+#include "../include/rendering/PrimitiveRenderer.hpp"
+#include "../include/scene/RenderQueue.hpp"
+#include <glm/gtc/type_ptr.hpp>
+
+void TransparentRenderer::draw(const Scene& scene, const TransparentPass& pass, const glm::mat4& view,
+                               FrameStats& stats) {
+    const std::vector<uint32_t>& objects = pass.getObjects();
+    const std::vector<uint32_t>& meshes = pass.getMeshes();
+    if (objects.empty()) {
+        return;
+    }
+
+    GlState::enable(GL_BLEND);
+    GlState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    stats.stateChanges++;
+
+    const GpuMesh* mesh = nullptr;
+    uint32_t meshKey = 0;
+    int texture = -2;
+    for (size_t k = 0; k < objects.size(); ++k) {
+        uint32_t i = objects[k];
+        if (mesh == nullptr || meshes[k] != meshKey) {
+            mesh = &MeshCache::acquire(RenderQueue::paramsForMesh(meshes[k]));
+            MeshCache::bindMesh(*mesh);
+            meshKey = meshes[k];
+            stats.stateChanges++;
+        }
+
+        const ObjectMaterial& material = scene.materials[i];
+        GLuint id = material.texture >= 0 && material.texture < (int)PrimitiveRenderer::textureIDs.size()
+                        ? PrimitiveRenderer::textureIDs[material.texture] : 0;
+        if (material.texture != texture) {
+            if (id != 0) {
+                GlState::enable(GL_TEXTURE_2D);
+                GlState::bindTexture(id);
+            } else {
+                GlState::disable(GL_TEXTURE_2D);
+            }
+            texture = material.texture;
+            stats.stateChanges++;
+        }
+
+        // Textured objects are drawn with white so the texture shows unmodified
+        if (id != 0) {
+            glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+        } else {
+            glColor4f(material.color.r, material.color.g, material.color.b, 1.0f);
+        }
+        glLoadMatrixf(glm::value_ptr(view * scene.worldMatrices[i]));
+        if (!pass.getSortedIndices().empty()) {
+            MeshCache::drawBoundIndices(*mesh, pass.getSortedIndices());
+        } else {
+            MeshCache::drawBound(*mesh);
+        }
+        stats.drawCalls++;
+        stats.instances++;
+    }
+
+    MeshCache::unbindMesh();
+    GlState::bindTexture(0);
+    GlState::disable(GL_TEXTURE_2D);
+    GlState::disable(GL_BLEND);
+}
@@ -0,0 +1,188 @@
+#include "../include/rendering/UiLayer.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/UiRenderer.hpp"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+GLuint UiLayer::framebuffer = 0;
+GLuint UiLayer::texture = 0;
+int UiLayer::layerWidth = 0;
+int UiLayer::layerHeight = 0;
+int UiLayer::windowWidth = 0;
+int UiLayer::windowHeight = 0;
+GLint UiLayer::windowFramebuffer = 0;
+bool UiLayer::failed = false;
+int UiLayer::drawing = -1;
+UiLayer::RegionState UiLayer::regions[REGION_COUNT];
+UiLayer::Stats UiLayer::stats;
+
+void UiLayer::begin(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+    if (!failed && (framebuffer == 0 || layerWidth != width || layerHeight != height)) {
+        allocate(width, height);
+    }
+}
+
+bool UiLayer::beginRegion(Region region, float x1, float y1, float x2, float y2, uint64_t key) {
+    RegionState& state = regions[region];
+    if (isCaching() && state.valid && state.key == key) {
+        stats.regionsCached++;
+        return false;
+    }
+    stats.regionsDrawn++;
+
+    int left = (int)std::floor((x1 + 1.0f) * 0.5f * windowWidth + 0.5f);
+    int bottom = (int)std::floor((y1 + 1.0f) * 0.5f * windowHeight + 0.5f);
+    int right = (int)std::floor((x2 + 1.0f) * 0.5f * windowWidth + 0.5f);
+    int top = (int)std::floor((y2 + 1.0f) * 0.5f * windowHeight + 0.5f);
+
+    if (isCaching()) {
+        // Only this region's pixels are cleared; the others keep their last drawing
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &windowFramebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        GLfloat clearColor[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+        GlState::enable(GL_SCISSOR_TEST);
+        GlState::scissor(left, bottom, right - left, top - bottom);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+        GlState::disable(GL_SCISSOR_TEST);
+    }
+
+    state.key = key;
+    drawing = region;
+    UiRenderer::setBounds(left, bottom, right - left, top - bottom);
+    UiRenderer::begin(windowWidth, windowHeight);
+    return true;
+}
+
+void UiLayer::endRegion() {
+    if (drawing < 0) {
+        return;
+    }
+    UiRenderer::end();
+    UiRenderer::clearBounds();
+    if (isCaching()) {
+        glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)windowFramebuffer);
+    }
+    regions[drawing].valid = true;
+    drawing = -1;
+}
+
+void UiLayer::composite() {
+    if (!isCaching()) {
+        return;
+    }
+    bool wasTextured = GlState::isEnabled(GL_TEXTURE_2D);
+    bool wasBlending = GlState::isEnabled(GL_BLEND);
+    bool wasDepthTested = GlState::isEnabled(GL_DEPTH_TEST);
+    bool wasScissored = GlState::isEnabled(GL_SCISSOR_TEST);
+    GlState::useProgram(0);
+    GlState::disable(GL_DEPTH_TEST);
+    GlState::disable(GL_SCISSOR_TEST);
+    GlState::enable(GL_BLEND);
+    GlState::blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    GlState::enable(GL_TEXTURE_2D);
+    GlState::bindTexture(texture);
+
+    // Row 0 of the layer is the bottom of the window, matching texture t = 0
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(-1.0f, -1.0f);
+    glTexCoord2f(1.0f, 0.0f); glVertex2f(1.0f, -1.0f);
+    glTexCoord2f(1.0f, 1.0f); glVertex2f(1.0f, 1.0f);
+    glTexCoord2f(0.0f, 1.0f); glVertex2f(-1.0f, 1.0f);
+    glEnd();
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    GlState::setEnabled(GL_TEXTURE_2D, wasTextured);
+    GlState::setEnabled(GL_BLEND, wasBlending);
+    GlState::setEnabled(GL_DEPTH_TEST, wasDepthTested);
+    GlState::setEnabled(GL_SCISSOR_TEST, wasScissored);
+}
+
+void UiLayer::invalidate() {
+    for (RegionState& region : regions) {
+        region.valid = false;
+    }
+}
+
+uint64_t UiLayer::mix(uint64_t key, uint64_t value) {
+    key ^= value + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+    return key;
+}
+
+uint64_t UiLayer::mixFloat(uint64_t key, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mix(key, bits);
+}
+
+uint64_t UiLayer::mixString(uint64_t key, const std::string& value) {
+    key = mix(key, value.size());
+    for (char c : value) {
+        key = mix(key, (unsigned char)c);
+    }
+    return key;
+}
+
+void UiLayer::shutdown() {
+    if (framebuffer != 0) {
+        glDeleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    if (texture != 0) {
+        glDeleteTextures(1, &texture);
+        texture = 0;
+        GlState::invalidate();
+    }
+    layerWidth = 0;
+    layerHeight = 0;
+    invalidate();
+}
+
+bool UiLayer::allocate(int width, int height) {
+    if (texture == 0) {
+        glGenTextures(1, &texture);
+    }
+    GlState::bindTexture(texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GlState::bindTexture(0);
+
+    if (framebuffer == 0) {
+        glGenFramebuffers(1, &framebuffer);
+    }
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (complete) {
+        // Nothing is drawn yet: transparent everywhere
+        GLfloat clearColor[4];
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+        GlState::disable(GL_SCISSOR_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFramebuffer);
+
+    if (!complete) {
+        std::cout << "UI layer framebuffer incomplete, drawing the UI every frame" << std::endl;
+        shutdown();
+        failed = true;
+        return false;
+    }
+    layerWidth = width;
+    layerHeight = height;
+    invalidate();
+    return true;
+}
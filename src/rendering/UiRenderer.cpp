@@ -0,0 +1,487 @@
+#include "../include/rendering/UiRenderer.hpp"
+#include "../include/rendering/GlState.hpp"
+#include "../include/rendering/TextRenderer.hpp"
+#include "../include/core/Constants.hpp"
+#include "../include/core/Timing.hpp"
+#include <GL/glut.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+bool UiRenderer::recording = false;
+int UiRenderer::viewportWidth = 0;
+int UiRenderer::viewportHeight = 0;
+bool UiRenderer::clipActive = false;
+UiRenderer::Clip UiRenderer::activeClip = {0, 0, 0, 0};
+bool UiRenderer::boundsActive = false;
+UiRenderer::Clip UiRenderer::bounds = {0, 0, 0, 0};
+std::chrono::steady_clock::time_point UiRenderer::beginTime;
+std::vector<UiRenderer::Vertex> UiRenderer::staged;
+std::vector<UiRenderer::Vertex> UiRenderer::ordered;
+std::vector<UiRenderer::Command> UiRenderer::commands;
+std::vector<UiRenderer::Text> UiRenderer::texts;
+std::vector<UiRenderer::Clip> UiRenderer::clips;
+std::vector<UiRenderer::Batch> UiRenderer::batches;
+std::vector<uint32_t> UiRenderer::batchOf;
+std::vector<uint32_t> UiRenderer::sortedCommands;
+GLuint UiRenderer::vao = 0;
+GLuint UiRenderer::vbo = 0;
+UiRenderer::Stats UiRenderer::stats;
+
+namespace {
+    // Batches a primitive looks back over for one sharing its state
+    const size_t BATCH_LOOKBACK = 64;
+
+    bool overlaps(const float* a, const float* b) {
+        return a[0] < b[2] && b[0] < a[2] && a[1] < b[3] && b[1] < a[3];
+    }
+}
+
+uint32_t UiRenderer::packColor(float r, float g, float b, float a) {
+    auto byte = [](float c) { return (uint32_t)(std::min(std::max(c, 0.0f), 1.0f) * 255.0f + 0.5f); };
+    return byte(r) | (byte(g) << 8) | (byte(b) << 16) | (byte(a) << 24);
+}
+
+void UiRenderer::begin(int width, int height) {
+    if (recording) {
+        flush();
+    }
+    recording = true;
+    viewportWidth = width;
+    viewportHeight = height;
+    beginTime = std::chrono::steady_clock::now();
+}
+
+void UiRenderer::end() {
+    if (!recording) {
+        return;
+    }
+    flush();
+    recording = false;
+    stats.cpuMs += Timing::millisecondsSince(beginTime);
+}
+
+void UiRenderer::rect(float x1, float y1, float x2, float y2, uint32_t color) {
+    uint32_t first = (uint32_t)staged.size();
+    quad(x1, y1, x2, y2, color);
+    addVertices(0, first);
+}
+
+void UiRenderer::outline(float x1, float y1, float x2, float y2, uint32_t color, float lineWidthPx) {
+    requireViewport();
+    float left = std::min(x1, x2), right = std::max(x1, x2);
+    float bottom = std::min(y1, y2), top = std::max(y1, y2);
+    // Half the width in NDC is lineWidthPx / 2 pixels of 2 / size each
+    float hx = lineWidthPx / viewportWidth;
+    float hy = lineWidthPx / viewportHeight;
+
+    uint32_t first = (uint32_t)staged.size();
+    quad(left - hx, bottom - hy, right + hx, bottom + hy, color);
+    quad(left - hx, top - hy, right + hx, top + hy, color);
+    quad(left - hx, bottom + hy, left + hx, top - hy, color);
+    quad(right - hx, bottom + hy, right + hx, top - hy, color);
+    addVertices(0, first);
+}
+
+void UiRenderer::line(float x1, float y1, float x2, float y2, uint32_t color, float lineWidthPx) {
+    requireViewport();
+    // Offset perpendicular to the line in pixels, so the width is the same at any angle
+    float dx = (x2 - x1) * viewportWidth * 0.5f;
+    float dy = (y2 - y1) * viewportHeight * 0.5f;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) {
+        return;
+    }
+    float nx = -dy / length * lineWidthPx / viewportWidth;
+    float ny = dx / length * lineWidthPx / viewportHeight;
+
+    uint32_t first = (uint32_t)staged.size();
+    staged.push_back({x1 + nx, y1 + ny, 0.0f, 0.0f, color});
+    staged.push_back({x1 - nx, y1 - ny, 0.0f, 0.0f, color});
+    staged.push_back({x2 - nx, y2 - ny, 0.0f, 0.0f, color});
+    staged.push_back({x1 + nx, y1 + ny, 0.0f, 0.0f, color});
+    staged.push_back({x2 - nx, y2 - ny, 0.0f, 0.0f, color});
+    staged.push_back({x2 + nx, y2 + ny, 0.0f, 0.0f, color});
+    addVertices(0, first);
+}
+
+void UiRenderer::circle(float cx, float cy, float radius, int segments, uint32_t color) {
+    uint32_t first = (uint32_t)staged.size();
+    float previousX = cx + radius, previousY = cy;
+    for (int i = 1; i <= segments; ++i) {
+        float a = (float)i / (float)segments * 2.0f * Constants::PI;
+        float x = cx + cosf(a) * radius, y = cy + sinf(a) * radius;
+        staged.push_back({cx, cy, 0.0f, 0.0f, color});
+        staged.push_back({previousX, previousY, 0.0f, 0.0f, color});
+        staged.push_back({x, y, 0.0f, 0.0f, color});
+        previousX = x;
+        previousY = y;
+    }
+    addVertices(0, first);
+}
+
+void UiRenderer::triangle(const Vertex& a, const Vertex& b, const Vertex& c) {
+    uint32_t first = (uint32_t)staged.size();
+    staged.push_back(a);
+    staged.push_back(b);
+    staged.push_back(c);
+    addVertices(0, first);
+}
+
+void UiRenderer::triangles(const Vertex* vertices, size_t count) {
+    uint32_t first = (uint32_t)staged.size();
+    staged.insert(staged.end(), vertices, vertices + count - count % 3);
+    addVertices(0, first);
+}
+
+void UiRenderer::texturedRect(float x1, float y1, float x2, float y2, GLuint texture, float u0, float v0, float u1,
+                              float v1) {
+    const uint32_t white = 0xffffffffu;
+    uint32_t first = (uint32_t)staged.size();
+    staged.push_back({x1, y1, u0, v0, white});
+    staged.push_back({x2, y1, u1, v0, white});
+    staged.push_back({x2, y2, u1, v1, white});
+    staged.push_back({x1, y1, u0, v0, white});
+    staged.push_back({x2, y2, u1, v1, white});
+    staged.push_back({x1, y2, u0, v1, white});
+    addVertices(texture, first);
+}
+
+void UiRenderer::text(const std::string& text, float x, float y, void* font, uint32_t color) {
+    if (text.empty()) {
+        return;
+    }
+    requireViewport();
+    if (TextRenderer::isReady()) {
+        // Glyph quads from the cached layout, from an origin on a whole pixel
+        // so atlas texels land on pixels
+        const FontAtlas::Layout& run = TextRenderer::getAtlas().layout(TextRenderer::sizeFor(font), text);
+        float originX = std::floor((x + 1.0f) * 0.5f * viewportWidth + 0.5f);
+        float originY = std::floor((y + 1.0f) * 0.5f * viewportHeight + 0.5f);
+        float scaleX = 2.0f / viewportWidth;
+        float scaleY = 2.0f / viewportHeight;
+        uint32_t first = (uint32_t)staged.size();
+        for (const FontAtlas::GlyphQuad& glyph : run.quads) {
+            float x1 = -1.0f + (originX + glyph.x0) * scaleX;
+            float y1 = -1.0f + (originY + glyph.y0) * scaleY;
+            float x2 = -1.0f + (originX + glyph.x1) * scaleX;
+            float y2 = -1.0f + (originY + glyph.y1) * scaleY;
+            staged.push_back({x1, y1, glyph.u0, glyph.v0, color});
+            staged.push_back({x2, y1, glyph.u1, glyph.v0, color});
+            staged.push_back({x2, y2, glyph.u1, glyph.v1, color});
+            staged.push_back({x1, y1, glyph.u0, glyph.v0, color});
+            staged.push_back({x2, y2, glyph.u1, glyph.v1, color});
+            staged.push_back({x1, y2, glyph.u0, glyph.v1, color});
+        }
+        stats.glyphs += (uint32_t)run.quads.size();
+        addVertices(TextRenderer::getTexture(), first);
+        return;
+    }
+
+    // Extent for batching and clipping; descenders reach about a third below the baseline
+    float ascent = TextRenderer::pixelSizeOf(font);
+    float widthPx = (float)glutBitmapLength(font, (const unsigned char*)text.c_str());
+    float bounds[4] = {x, y - ascent * 0.6f / viewportHeight, x + widthPx * 2.0f / viewportWidth,
+                       y + ascent * 2.0f / viewportHeight};
+    texts.push_back({text, x, y, font, color});
+    addCommand(0, true, (uint32_t)texts.size() - 1, 1, bounds);
+}
+
+void UiRenderer::setClip(int x, int y, int width, int height) {
+    clipActive = true;
+    activeClip = {x, y, width, height};
+}
+
+void UiRenderer::clearClip() {
+    clipActive = false;
+}
+
+void UiRenderer::setBounds(int x, int y, int width, int height) {
+    boundsActive = true;
+    bounds = {x, y, width, height};
+}
+
+void UiRenderer::clearBounds() {
+    boundsActive = false;
+}
+
+bool UiRenderer::currentClip(Clip& clip) {
+    if (!clipActive && !boundsActive) {
+        return false;
+    }
+    if (!boundsActive || !clipActive) {
+        clip = clipActive ? activeClip : bounds;
+        return true;
+    }
+    int x1 = std::max(activeClip.x, bounds.x);
+    int y1 = std::max(activeClip.y, bounds.y);
+    int x2 = std::min(activeClip.x + activeClip.width, bounds.x + bounds.width);
+    int y2 = std::min(activeClip.y + activeClip.height, bounds.y + bounds.height);
+    clip = {x1, y1, std::max(0, x2 - x1), std::max(0, y2 - y1)};
+    return true;
+}
+
+void UiRenderer::shutdown() {
+    if (vbo != 0) {
+        glDeleteBuffers(1, &vbo);
+        vbo = 0;
+    }
+    if (vao != 0) {
+        glDeleteVertexArrays(1, &vao);
+        vao = 0;
+    }
+    staged.clear();
+    ordered.clear();
+    commands.clear();
+    texts.clear();
+    clips.clear();
+    GlState::invalidate();
+}
+
+void UiRenderer::requireViewport() {
+    // Recording got the size from begin; single draws ask GL
+    if (!recording) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        viewportWidth = std::max(1, (int)viewport[2]);
+        viewportHeight = std::max(1, (int)viewport[3]);
+    }
+}
+
+void UiRenderer::quad(float x1, float y1, float x2, float y2, uint32_t color) {
+    staged.push_back({x1, y1, 0.0f, 0.0f, color});
+    staged.push_back({x2, y1, 0.0f, 0.0f, color});
+    staged.push_back({x2, y2, 0.0f, 0.0f, color});
+    staged.push_back({x1, y1, 0.0f, 0.0f, color});
+    staged.push_back({x2, y2, 0.0f, 0.0f, color});
+    staged.push_back({x1, y2, 0.0f, 0.0f, color});
+}
+
+void UiRenderer::addVertices(GLuint texture, uint32_t first) {
+    uint32_t count = (uint32_t)staged.size() - first;
+    if (count == 0) {
+        return;
+    }
+    float bounds[4] = {staged[first].x, staged[first].y, staged[first].x, staged[first].y};
+    for (uint32_t i = first + 1; i < first + count; ++i) {
+        bounds[0] = std::min(bounds[0], staged[i].x);
+        bounds[1] = std::min(bounds[1], staged[i].y);
+        bounds[2] = std::max(bounds[2], staged[i].x);
+        bounds[3] = std::max(bounds[3], staged[i].y);
+    }
+    addCommand(texture, false, first, count, bounds);
+}
+
+void UiRenderer::addCommand(GLuint texture, bool isText, uint32_t first, uint32_t count, const float* bounds) {
+    Command command;
+    command.texture = texture;
+    command.clip = -1;
+    command.isText = isText;
+    command.first = first;
+    command.count = count;
+    std::copy(bounds, bounds + 4, command.bounds);
+
+    Clip clip;
+    if (currentClip(clip)) {
+        // Batching only needs the visible part; primitives clipped away entirely are dropped
+        requireViewport();
+        float clipX1 = -1.0f + 2.0f * clip.x / viewportWidth;
+        float clipY1 = -1.0f + 2.0f * clip.y / viewportHeight;
+        float clipX2 = -1.0f + 2.0f * (clip.x + clip.width) / viewportWidth;
+        float clipY2 = -1.0f + 2.0f * (clip.y + clip.height) / viewportHeight;
+        command.bounds[0] = std::max(command.bounds[0], clipX1);
+        command.bounds[1] = std::max(command.bounds[1], clipY1);
+        command.bounds[2] = std::min(command.bounds[2], clipX2);
+        command.bounds[3] = std::min(command.bounds[3], clipY2);
+        if (command.bounds[0] >= command.bounds[2] || command.bounds[1] >= command.bounds[3]) {
+            if (isText) {
+                texts.pop_back();
+            } else {
+                staged.resize(first);
+            }
+            return;
+        }
+        const Clip& last = clips.empty() ? clip : clips.back();
+        if (clips.empty() || last.x != clip.x || last.y != clip.y || last.width != clip.width ||
+            last.height != clip.height) {
+            clips.push_back(clip);
+        }
+        command.clip = (int)clips.size() - 1;
+    }
+
+    commands.push_back(command);
+    stats.primitives++;
+    if (!recording) {
+        auto start = std::chrono::steady_clock::now();
+        flush();
+        stats.cpuMs += Timing::millisecondsSince(start);
+    }
+}
+
+bool UiRenderer::sameClip(int a, int b) {
+    if (a == b) {
+        return true;
+    }
+    if (a < 0 || b < 0) {
+        return false;
+    }
+    const Clip& first = clips[a];
+    const Clip& second = clips[b];
+    return first.x == second.x && first.y == second.y && first.width == second.width &&
+           first.height == second.height;
+}
+
+void UiRenderer::flush() {
+    if (commands.empty()) {
+        staged.clear();
+        texts.clear();
+        clips.clear();
+        return;
+    }
+
+    // Each primitive joins the latest batch with its state unless something
+    // drawn after that batch overlaps it, so reordering never changes the picture
+    batches.clear();
+    batchOf.resize(commands.size());
+    for (size_t i = 0; i < commands.size(); ++i) {
+        const Command& command = commands[i];
+        int target = -1;
+        size_t stop = batches.size() > BATCH_LOOKBACK ? batches.size() - BATCH_LOOKBACK : 0;
+        for (size_t b = batches.size(); b-- > stop;) {
+            const Batch& batch = batches[b];
+            if (batch.texture == command.texture && batch.isText == command.isText &&
+                sameClip(batch.clip, command.clip)) {
+                target = (int)b;
+                break;
+            }
+            if (overlaps(batch.bounds, command.bounds)) {
+                break;
+            }
+        }
+        if (target < 0) {
+            Batch batch;
+            batch.texture = command.texture;
+            batch.clip = command.clip;
+            batch.isText = command.isText;
+            std::copy(command.bounds, command.bounds + 4, batch.bounds);
+            batch.commandCount = 0;
+            batch.vertexCount = 0;
+            target = (int)batches.size();
+            batches.push_back(batch);
+        } else {
+            Batch& batch = batches[target];
+            batch.bounds[0] = std::min(batch.bounds[0], command.bounds[0]);
+            batch.bounds[1] = std::min(batch.bounds[1], command.bounds[1]);
+            batch.bounds[2] = std::max(batch.bounds[2], command.bounds[2]);
+            batch.bounds[3] = std::max(batch.bounds[3], command.bounds[3]);
+        }
+        batches[target].commandCount++;
+        batches[target].vertexCount += command.isText ? 0 : command.count;
+        batchOf[i] = (uint32_t)target;
+    }
+
+    // Counting sort of commands and their vertices by batch, stable within a batch
+    uint32_t commandOffset = 0, vertexOffset = 0;
+    for (Batch& batch : batches) {
+        batch.firstCommand = commandOffset;
+        batch.firstVertex = vertexOffset;
+        commandOffset += batch.commandCount;
+        vertexOffset += batch.vertexCount;
+        batch.commandCount = 0;
+        batch.vertexCount = 0;
+    }
+    sortedCommands.resize(commands.size());
+    ordered.resize(vertexOffset);
+    for (size_t i = 0; i < commands.size(); ++i) {
+        const Command& command = commands[i];
+        Batch& batch = batches[batchOf[i]];
+        sortedCommands[batch.firstCommand + batch.commandCount++] = (uint32_t)i;
+        if (!command.isText) {
+            std::copy(staged.begin() + command.first, staged.begin() + command.first + command.count,
+                      ordered.begin() + batch.firstVertex + batch.vertexCount);
+            batch.vertexCount += command.count;
+        }
+    }
+
+    if (vao == 0) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+        GlState::bindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        // Fixed-function client arrays, recorded by the VAO
+        const GLsizei stride = sizeof(Vertex);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, stride, (const void*)offsetof(Vertex, x));
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, stride, (const void*)offsetof(Vertex, u));
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(4, GL_UNSIGNED_BYTE, stride, (const void*)offsetof(Vertex, color));
+    } else {
+        GlState::bindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    }
+    if (!ordered.empty()) {
+        glBufferData(GL_ARRAY_BUFFER, ordered.size() * sizeof(Vertex), ordered.data(), GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // The UI draws over everything with alpha blending, adding each primitive's
+    // coverage to the target's alpha; restore the enables it changes
+    bool wasTextured = GlState::isEnabled(GL_TEXTURE_2D);
+    bool wasBlending = GlState::isEnabled(GL_BLEND);
+    bool wasDepthTested = GlState::isEnabled(GL_DEPTH_TEST);
+    bool wasScissored = GlState::isEnabled(GL_SCISSOR_TEST);
+    GlState::useProgram(0);
+    GlState::disable(GL_DEPTH_TEST);
+    GlState::enable(GL_BLEND);
+    GlState::blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    for (const Batch& batch : batches) {
+        applyClip(batch.clip);
+        if (batch.isText) {
+            // Bitmap fragments are textured like any other, so text draws untextured
+            GlState::disable(GL_TEXTURE_2D);
+            for (uint32_t c = 0; c < batch.commandCount; ++c) {
+                const Text& text = texts[commands[sortedCommands[batch.firstCommand + c]].first];
+                // The raster color is latched by glRasterPos
+                glColor4ub(text.color & 0xff, (text.color >> 8) & 0xff, (text.color >> 16) & 0xff, text.color >> 24);
+                glRasterPos2f(text.x, text.y);
+                for (char character : text.text) {
+                    glutBitmapCharacter(text.font, (int)character);
+                }
+                stats.textStrings++;
+            }
+            continue;
+        }
+        if (batch.texture != 0) {
+            GlState::enable(GL_TEXTURE_2D);
+            GlState::bindTexture(batch.texture);
+        } else {
+            GlState::disable(GL_TEXTURE_2D);
+        }
+        glDrawArrays(GL_TRIANGLES, (GLint)batch.firstVertex, (GLsizei)batch.vertexCount);
+        stats.drawCalls++;
+    }
+    GlState::bindVertexArray(0);
+
+    GlState::setEnabled(GL_TEXTURE_2D, wasTextured);
+    GlState::setEnabled(GL_BLEND, wasBlending);
+    GlState::setEnabled(GL_DEPTH_TEST, wasDepthTested);
+    GlState::setEnabled(GL_SCISSOR_TEST, wasScissored);
+
+    stats.vertices += (uint32_t)ordered.size();
+    staged.clear();
+    commands.clear();
+    texts.clear();
+    clips.clear();
+}
+
+void UiRenderer::applyClip(int clip) {
+    if (clip < 0) {
+        GlState::disable(GL_SCISSOR_TEST);
+        return;
+    }
+    const Clip& rect = clips[clip];
+    GlState::enable(GL_SCISSOR_TEST);
+    GlState::scissor(rect.x, rect.y, rect.width, rect.height);
+}
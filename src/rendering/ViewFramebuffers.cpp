@@ -0,0 +1,78 @@
+#include "../include/rendering/ViewFramebuffers.hpp"
+#include "../include/rendering/GlState.hpp"
+#include <iostream>
+
+ViewFramebuffers::Target ViewFramebuffers::targets[MAX_VIEWS];
+bool ViewFramebuffers::failed = false;
+
+bool ViewFramebuffers::bind(int view, int width, int height) {
+    if (failed || view < 0 || view >= MAX_VIEWS || width <= 0 || height <= 0) {
+        return false;
+    }
+    Target& target = targets[view];
+    if (target.framebuffer == 0 || target.width != width || target.height != height) {
+        destroy(target);
+        glGenRenderbuffers(1, &target.color);
+        glBindRenderbuffer(GL_RENDERBUFFER, target.color);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        glGenRenderbuffers(1, &target.depth);
+        glBindRenderbuffer(GL_RENDERBUFFER, target.depth);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        glGenFramebuffers(1, &target.framebuffer);
+        glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target.color);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target.depth);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cout << "View framebuffer incomplete, drawing views directly" << std::endl;
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            destroy(target);
+            failed = true;
+            return false;
+        }
+        target.width = width;
+        target.height = height;
+    } else {
+        glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    }
+    GlState::viewport(0, 0, width, height);
+    return true;
+}
+
+void ViewFramebuffers::unbind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void ViewFramebuffers::present(int view, int x, int y) {
+    if (view < 0 || view >= MAX_VIEWS || targets[view].framebuffer == 0) {
+        return;
+    }
+    // Blits are clipped by the scissor test like draws
+    const Target& target = targets[view];
+    GlState::disable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, target.framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, target.width, target.height, x, y, x + target.width, y + target.height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void ViewFramebuffers::shutdown() {
+    for (Target& target : targets) {
+        destroy(target);
+    }
+}
+
+void ViewFramebuffers::destroy(Target& target) {
+    if (target.framebuffer != 0) {
+        glDeleteFramebuffers(1, &target.framebuffer);
+    }
+    if (target.color != 0) {
+        glDeleteRenderbuffers(1, &target.color);
+    }
+    if (target.depth != 0) {
+        glDeleteRenderbuffers(1, &target.depth);
+    }
+    target = Target();
+}
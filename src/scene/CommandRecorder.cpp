@@ -0,0 +1,48 @@
+#include "../include/scene/CommandRecorder.hpp"
+#include <algorithm>
+
+void CommandRecorder::record(const Scene& scene, const RenderQueue& queue, const Camera& camera, ThreadPool& pool,
+                             std::vector<CommandBuffer>& buffers, size_t drawsPerBuffer) {
+    size_t runs = std::max((size_t)1, (queue.size() + drawsPerBuffer - 1) / drawsPerBuffer);
+    buffers.resize(runs);
+
+    pool.parallelFor(runs, [&](size_t run, unsigned) {
+        CommandBuffer& buffer = buffers[run];
+        buffer.clear();
+        if (run == 0) {
+            buffer.setMatrix(UniformSlot::PROJECTION, camera.projection());
+            buffer.setMatrix(UniformSlot::VIEW, camera.view());
+        }
+        size_t begin = run * drawsPerBuffer;
+        recordRun(scene, queue, begin, std::min(queue.size(), begin + drawsPerBuffer), buffer);
+    });
+}
+
+void CommandRecorder::recordRun(const Scene& scene, const RenderQueue& queue, size_t begin, size_t end,
+                                CommandBuffer& buffer) {
+    const std::vector<uint64_t>& keys = queue.getKeys();
+    const std::vector<uint32_t>& objects = queue.getObjects();
+
+    for (size_t k = begin; k < end; ++k) {
+        uint64_t key = keys[k];
+        bool first = k == begin;
+
+        uint32_t mesh = RenderQueue::meshOf(key);
+        if (first || mesh != RenderQueue::meshOf(keys[k - 1])) {
+            buffer.bindMesh(mesh);
+        }
+        int texture = RenderQueue::textureOf(key);
+        if (first || texture != RenderQueue::textureOf(keys[k - 1])) {
+            buffer.bindTexture(texture);
+        }
+        bool blended = RenderQueue::isBlended(key);
+        if (first || blended != RenderQueue::isBlended(keys[k - 1])) {
+            buffer.setBlend(blended);
+        }
+
+        uint32_t object = objects[k];
+        buffer.setVector(UniformSlot::COLOR, glm::vec4(scene.materials[object].color, 1.0f));
+        buffer.setMatrix(UniformSlot::MODEL, scene.worldMatrices[object]);
+        buffer.draw();
+    }
+}
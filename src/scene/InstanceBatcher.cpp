@@ -0,0 +1,55 @@
+#include "../include/scene/InstanceBatcher.hpp"
+#include "../include/scene/LodSelector.hpp"
+#include <cstring>
+
+namespace {
+    // shape (4 bits) | LOD level + 1 (4 bits) | texture + 1 (24 bits)
+    uint32_t batchKey(ShapeType shape, int level, int texture) {
+        return ((uint32_t)shape << 28) | ((uint32_t)(level + 1) << 24) | ((uint32_t)(texture + 1) & 0xffffffu);
+    }
+}
+
+void InstanceBatcher::build(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera,
+                            int viewportHeightPx, std::vector<int8_t>& lodLevels) {
+    keys.clear();
+    batches.clear();
+
+    for (uint32_t i : objects) {
+        if (!(scene.flags[i] & ObjectFlags::VISIBLE) || scene.shapes[i] == ShapeType::NONE) {
+            continue;
+        }
+        LodSelector::selectForObject(scene, i, camera, viewportHeightPx, lodLevels);
+        int level = LodSelector::usesLod(scene.shapes[i]) ? lodLevels[i] : -1;
+        uint32_t key = batchKey(scene.shapes[i], level, scene.materials[i].texture);
+        keys.push_back(((uint64_t)key << 32) | (uint32_t)i);
+    }
+    sorter.sort(keys);
+
+    instances.resize(keys.size());
+    uint32_t currentKey = 0;
+    for (size_t k = 0; k < keys.size(); ++k) {
+        uint32_t key = (uint32_t)(keys[k] >> 32);
+        size_t object = (size_t)(keys[k] & 0xffffffffu);
+
+        if (batches.empty() || key != currentKey) {
+            currentKey = key;
+            InstanceBatch batch;
+            int level = (int)((key >> 24) & 0xf) - 1;
+            batch.params = LodSelector::paramsForLevel(PrimitiveParams::defaultsFor(scene.shapes[object]), level);
+            batch.texture = scene.materials[object].texture;
+            batch.first = (uint32_t)k;
+            batches.push_back(batch);
+        }
+        batches.back().count++;
+
+        InstanceData& instance = instances[k];
+        std::memcpy(instance.model, &scene.worldMatrices[object][0][0], sizeof(instance.model));
+        // Textured objects are drawn with white so the texture shows unmodified
+        const ObjectMaterial& material = scene.materials[object];
+        bool textured = material.texture != -1;
+        instance.color[0] = textured ? 1.0f : material.color.r;
+        instance.color[1] = textured ? 1.0f : material.color.g;
+        instance.color[2] = textured ? 1.0f : material.color.b;
+        instance.color[3] = 1.0f;
+    }
+}
@@ -0,0 +1,103 @@
+#include "../include/scene/LodSelector.hpp"
+#include "../include/core/Constants.hpp"
+#include <algorithm>
+#include <cmath>
+
+constexpr int LodSelector::LEVEL_SLICES[LodSelector::LEVEL_COUNT];
+
+float LodSelector::boundingRadius(const PrimitiveParams& params) {
+    switch (params.shape) {
+        case ShapeType::CUBE:
+            return params.radius * 0.8660254f; // Half the space diagonal
+        case ShapeType::SPHERE:
+            return params.radius;
+        case ShapeType::CONE:
+        case ShapeType::CYLINDER:
+            return std::sqrt(params.radius * params.radius + params.height * params.height * 0.25f);
+        case ShapeType::TORUS:
+            return params.radius + params.height;
+        case ShapeType::PYRAMID:
+            return std::sqrt(params.radius * params.radius * 0.5f + params.height * params.height * 0.25f);
+        default:
+            return 0.0f;
+    }
+}
+
+float LodSelector::projectedRadius(float worldRadius, float distance, float fovYRadians, int viewportHeightPx) {
+    float focal = 1.0f / std::tan(fovYRadians / 2.0f);
+    if (distance <= worldRadius) {
+        // Camera inside the bounds: treat as filling the viewport
+        return (float)viewportHeightPx;
+    }
+    return worldRadius * focal / distance * viewportHeightPx * 0.5f;
+}
+
+float LodSelector::requiredSlices(float radiusPx) {
+    if (radiusPx <= MAX_ERROR_PX) {
+        return 0.0f;
+    }
+    // Sagitta of one segment: r * (1 - cos(PI / slices)) <= error
+    return Constants::PI / std::acos(1.0f - MAX_ERROR_PX / radiusPx);
+}
+
+int LodSelector::selectLevel(float radiusPx, int currentLevel) {
+    float needed = requiredSlices(radiusPx);
+
+    if (currentLevel >= 0 && currentLevel < LEVEL_COUNT) {
+        float upper = LEVEL_SLICES[currentLevel] * (1.0f + HYSTERESIS);
+        float lower = currentLevel > 0 ? LEVEL_SLICES[currentLevel - 1] * (1.0f - HYSTERESIS) : 0.0f;
+        if (needed <= upper && needed >= lower) {
+            return currentLevel;
+        }
+    }
+
+    for (int level = 0; level < LEVEL_COUNT; ++level) {
+        if (LEVEL_SLICES[level] >= needed) {
+            return level;
+        }
+    }
+    return LEVEL_COUNT - 1;
+}
+
+PrimitiveParams LodSelector::paramsForLevel(const PrimitiveParams& base, int level) {
+    if (!usesLod(base.shape) || level < 0) {
+        return base;
+    }
+    int slices = LEVEL_SLICES[std::min(level, LEVEL_COUNT - 1)];
+
+    PrimitiveParams params = base;
+    params.slices = slices;
+    if (base.shape == ShapeType::SPHERE || base.shape == ShapeType::TORUS) {
+        // Sphere stacks sweep half a turn and the torus tube is thinner than its ring
+        params.stacks = std::max(3, slices / 2);
+    }
+    return params;
+}
+
+bool LodSelector::usesLod(ShapeType shape) {
+    return shape == ShapeType::SPHERE || shape == ShapeType::CONE ||
+           shape == ShapeType::CYLINDER || shape == ShapeType::TORUS;
+}
+
+PrimitiveParams LodSelector::selectForObject(const Scene& scene, size_t index, const Camera& camera,
+                                             int viewportHeightPx, std::vector<int8_t>& lodLevels,
+                                             float* screenRadiusPx) {
+    PrimitiveParams params = PrimitiveParams::defaultsFor(scene.shapes[index]);
+    if (!usesLod(params.shape)) {
+        return params;
+    }
+
+    // World-space bounds from the cached world matrix, so parent scaling counts too
+    const glm::mat4& world = scene.worldMatrices[index];
+    float maxScale = std::max(glm::length(glm::vec3(world[0])),
+                              std::max(glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2]))));
+    float worldRadius = boundingRadius(params) * maxScale;
+    float radiusPx = projectedRadius(worldRadius, glm::length(glm::vec3(world[3]) - camera.eye), camera.fovY,
+                                     viewportHeightPx);
+    int level = selectLevel(radiusPx, lodLevels[index]);
+    lodLevels[index] = (int8_t)level;
+    if (screenRadiusPx) {
+        *screenRadiusPx = radiusPx;
+    }
+    return paramsForLevel(params, level);
+}
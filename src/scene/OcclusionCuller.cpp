@@ -0,0 +1,352 @@
+#include "../include/scene/OcclusionCuller.hpp"
+#include "../include/scene/SceneBvh.hpp"
+#include "../include/scene/ScenePicker.hpp"
+#include "../include/scene/TransparentPass.hpp"
+#include "../include/core/Timing.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    // Pixel-center offsets of the eight lanes of a depth block
+    alignas(32) const float LANE_OFFSETS[8] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+
+    // Projects the eight corners of a box; false if any corner is behind the eye.
+    // Corners are built from one transformed corner plus the transformed edges.
+    bool projectBox(const glm::mat4& viewProjection, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+                    glm::vec3& ndcMin, glm::vec3& ndcMax) {
+        glm::vec3 size = boundsMax - boundsMin;
+        glm::vec4 base = viewProjection * glm::vec4(boundsMin, 1.0f);
+        glm::vec4 edgeX = viewProjection[0] * size.x;
+        glm::vec4 edgeY = viewProjection[1] * size.y;
+        glm::vec4 edgeZ = viewProjection[2] * size.z;
+        ndcMin = glm::vec3(1e30f);
+        ndcMax = glm::vec3(-1e30f);
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec4 clip = base;
+            if (corner & 1) clip += edgeX;
+            if (corner & 2) clip += edgeY;
+            if (corner & 4) clip += edgeZ;
+            if (clip.w <= 1e-6f) {
+                return false;
+            }
+            glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            ndcMin = glm::min(ndcMin, ndc);
+            ndcMax = glm::max(ndcMax, ndc);
+        }
+        return true;
+    }
+}
+
+OcclusionCuller::OcclusionCuller() : OcclusionCuller(Settings()) {}
+
+OcclusionCuller::OcclusionCuller(const Settings& settings) : settings(settings) {
+    tilesX = settings.width / TILE_WIDTH;
+    tilesY = settings.height / TILE_HEIGHT;
+    depth.resize((size_t)settings.width * settings.height / 8);
+    tileMaxDepth.assign((size_t)tilesX * tilesY, 1.0f);
+}
+
+void OcclusionCuller::cull(const Scene& scene, const Camera& camera, const std::vector<int8_t>& lodLevels,
+                           std::vector<uint32_t>& objects, ThreadPool& pool) {
+    stats = Stats();
+    auto start = std::chrono::steady_clock::now();
+    glm::mat4 viewProjection = camera.viewProjection();
+
+    projectCandidates(scene, viewProjection, objects, pool);
+    selectOccluders(scene, lodLevels, objects);
+    stats.occluders = (uint32_t)occluders.size();
+
+    // Transform and bin each occluder on whichever thread picks it up
+    if (scratch.size() != pool.threadCount()) {
+        scratch.resize(pool.threadCount());
+    }
+    for (ThreadScratch& threadScratch : scratch) {
+        threadScratch.triangles.clear();
+        threadScratch.bins.resize((size_t)tilesX * tilesY);
+        for (std::vector<uint32_t>& bin : threadScratch.bins) {
+            bin.clear();
+        }
+    }
+    pool.parallelFor(occluders.size(), [&](size_t i, unsigned thread) {
+        setupOccluder(scene, occluders[i], *occluderMeshes[i], viewProjection, scratch[thread]);
+    });
+    for (const ThreadScratch& threadScratch : scratch) {
+        stats.triangles += (uint32_t)threadScratch.triangles.size();
+    }
+
+    pool.parallelFor((size_t)tilesX * tilesY, [this](size_t tile, unsigned) { rasterizeTile((int)tile); });
+    stats.rasterMs = Timing::millisecondsSince(start);
+
+    // Test every candidate, then compact the survivors in order
+    start = std::chrono::steady_clock::now();
+    hidden.assign(objects.size(), 0);
+    const size_t chunk = 256;
+    if (!occluders.empty()) {
+        pool.parallelFor((objects.size() + chunk - 1) / chunk, [&](size_t c, unsigned) {
+            size_t end = std::min(objects.size(), (c + 1) * chunk);
+            for (size_t i = c * chunk; i < end; ++i) {
+                hidden[i] = isOccluded(screenBoxes[i]) ? 1 : 0;
+            }
+        });
+    }
+    size_t kept = 0;
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (!hidden[i]) {
+            objects[kept++] = objects[i];
+        }
+    }
+    stats.tested = (uint32_t)objects.size();
+    stats.culled = (uint32_t)(objects.size() - kept);
+    objects.resize(kept);
+    stats.testMs = Timing::millisecondsSince(start);
+}
+
+void OcclusionCuller::projectCandidates(const Scene& scene, const glm::mat4& viewProjection,
+                                        const std::vector<uint32_t>& objects, ThreadPool& pool) {
+    screenBoxes.resize(objects.size());
+    const size_t chunk = 1024;
+    pool.parallelFor((objects.size() + chunk - 1) / chunk, [&](size_t c, unsigned) {
+        size_t end = std::min(objects.size(), (c + 1) * chunk);
+        for (size_t i = c * chunk; i < end; ++i) {
+            glm::vec3 boundsMin, boundsMax;
+            SceneBvh::worldBounds(scene, objects[i], boundsMin, boundsMax);
+            ScreenBox& box = screenBoxes[i];
+            box.inFront = projectBox(viewProjection, boundsMin, boundsMax, box.ndcMin, box.ndcMax);
+        }
+    });
+}
+
+void OcclusionCuller::selectOccluders(const Scene& scene, const std::vector<int8_t>& lodLevels,
+                                      const std::vector<uint32_t>& objects) {
+    // Rank by the screen area of the projected bounding box; boxes crossing the
+    // eye plane count as full-screen. Blended objects are seen through, so
+    // only opaque ones may hide what is behind them
+    candidates.clear();
+    for (size_t i = 0; i < objects.size(); ++i) {
+        if (scene.shapes[objects[i]] == ShapeType::NONE || TransparentPass::isTransparent(scene, objects[i])) {
+            continue;
+        }
+        const ScreenBox& box = screenBoxes[i];
+        float area = 1.0f;
+        if (box.inFront) {
+            glm::vec2 low = glm::max(glm::vec2(box.ndcMin), glm::vec2(-1.0f));
+            glm::vec2 high = glm::min(glm::vec2(box.ndcMax), glm::vec2(1.0f));
+            glm::vec2 size = glm::max(high - low, glm::vec2(0.0f));
+            area = size.x * size.y * 0.25f;
+        }
+        if (area >= settings.minOccluderArea) {
+            candidates.emplace_back(area, objects[i]);
+        }
+    }
+
+    size_t count = std::min(candidates.size(), (size_t)settings.maxOccluders);
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+                          return a.first > b.first;
+                      });
+
+    occluders.clear();
+    occluderMeshes.clear();
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t object = candidates[i].second;
+        occluders.push_back(object);
+        occluderMeshes.push_back(&ScenePicker::meshFor(ScenePicker::paramsFor(scene, object, lodLevels)));
+    }
+}
+
+void OcclusionCuller::setupOccluder(const Scene& scene, uint32_t object, const MeshBvh& mesh,
+                                    const glm::mat4& viewProjection, ThreadScratch& threadScratch) {
+    const glm::mat4& world = scene.worldMatrices[object];
+    glm::mat4 transform = viewProjection * world;
+    // A mirroring transform flips the winding of every triangle
+    bool mirrored = glm::determinant(glm::mat3(world)) < 0.0f;
+
+    const std::vector<glm::vec3>& positions = mesh.getPositions();
+    const std::vector<uint32_t>& indices = mesh.getIndices();
+    threadScratch.clip.resize(positions.size());
+    for (size_t v = 0; v < positions.size(); ++v) {
+        threadScratch.clip[v] = transform * glm::vec4(positions[v], 1.0f);
+    }
+
+    float width = (float)settings.width;
+    float height = (float)settings.height;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        ScreenTriangle triangle;
+        bool clipped = false;
+        for (int k = 0; k < 3; ++k) {
+            const glm::vec4& clip = threadScratch.clip[indices[i + (mirrored ? 2 - k : k)]];
+            // Triangles reaching behind the near plane are dropped; that only loses occlusion
+            if (clip.w <= 1e-6f || clip.z < -clip.w) {
+                clipped = true;
+                break;
+            }
+            float inverseW = 1.0f / clip.w;
+            triangle.x[k] = (clip.x * inverseW * 0.5f + 0.5f) * width;
+            triangle.y[k] = (clip.y * inverseW * 0.5f + 0.5f) * height;
+            triangle.z[k] = std::min(clip.z * inverseW * 0.5f + 0.5f, 1.0f);
+        }
+        if (clipped) {
+            continue;
+        }
+
+        float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+                     (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+        if (area <= 0.0f) {
+            continue; // Back-facing or degenerate: the front faces of a closed mesh are nearer
+        }
+
+        float minX = std::min(triangle.x[0], std::min(triangle.x[1], triangle.x[2]));
+        float maxX = std::max(triangle.x[0], std::max(triangle.x[1], triangle.x[2]));
+        float minY = std::min(triangle.y[0], std::min(triangle.y[1], triangle.y[2]));
+        float maxY = std::max(triangle.y[0], std::max(triangle.y[1], triangle.y[2]));
+        if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) {
+            continue;
+        }
+
+        int tileX0 = std::max(0, (int)minX / TILE_WIDTH);
+        int tileX1 = std::min(tilesX - 1, (int)maxX / TILE_WIDTH);
+        int tileY0 = std::max(0, (int)minY / TILE_HEIGHT);
+        int tileY1 = std::min(tilesY - 1, (int)maxY / TILE_HEIGHT);
+        uint32_t index = (uint32_t)threadScratch.triangles.size();
+        threadScratch.triangles.push_back(triangle);
+        for (int ty = tileY0; ty <= tileY1; ++ty) {
+            for (int tx = tileX0; tx <= tileX1; ++tx) {
+                threadScratch.bins[(size_t)ty * tilesX + tx].push_back(index);
+            }
+        }
+    }
+}
+
+void OcclusionCuller::rasterizeTile(int tile) {
+    int x0 = (tile % tilesX) * TILE_WIDTH;
+    int y0 = (tile / tilesX) * TILE_HEIGHT;
+    int x1 = x0 + TILE_WIDTH;
+    int y1 = y0 + TILE_HEIGHT;
+
+    int blocksPerRow = settings.width / 8;
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; x += 8) {
+            std::fill(depth[(size_t)y * blocksPerRow + x / 8].v, depth[(size_t)y * blocksPerRow + x / 8].v + 8, 1.0f);
+        }
+    }
+
+    for (const ThreadScratch& threadScratch : scratch) {
+        for (uint32_t index : threadScratch.bins[tile]) {
+            rasterizeTriangle(threadScratch.triangles[index], x0, y0, x1, y1);
+        }
+    }
+
+    float farthest = 0.0f;
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; x += 8) {
+            const float* block = depth[(size_t)y * blocksPerRow + x / 8].v;
+            farthest = std::max(farthest, *std::max_element(block, block + 8));
+        }
+    }
+    tileMaxDepth[tile] = farthest;
+}
+
+void OcclusionCuller::rasterizeTriangle(const ScreenTriangle& t, int x0, int y0, int x1, int y1) {
+    // Edge functions, each >= 0 inside a counter-clockwise triangle: e(x, y) = a * x + b * y + c
+    float a[3], b[3], c[3];
+    for (int k = 0; k < 3; ++k) {
+        int from = (k + 1) % 3;
+        int to = (k + 2) % 3;
+        a[k] = -(t.y[to] - t.y[from]);
+        b[k] = t.x[to] - t.x[from];
+        c[k] = -(a[k] * t.x[from] + b[k] * t.y[from]);
+    }
+    // Depth plane from the barycentrics: edge k weighs vertex k
+    float area = a[0] * t.x[0] + b[0] * t.y[0] + c[0];
+    float inverseArea = 1.0f / area;
+    float za = (a[0] * t.z[0] + a[1] * t.z[1] + a[2] * t.z[2]) * inverseArea;
+    float zb = (b[0] * t.z[0] + b[1] * t.z[1] + b[2] * t.z[2]) * inverseArea;
+    float zc = (c[0] * t.z[0] + c[1] * t.z[1] + c[2] * t.z[2]) * inverseArea;
+
+    // Clip the triangle's pixel bounds to the tile, widened to whole blocks
+    float minX = std::min(t.x[0], std::min(t.x[1], t.x[2]));
+    float maxX = std::max(t.x[0], std::max(t.x[1], t.x[2]));
+    float minY = std::min(t.y[0], std::min(t.y[1], t.y[2]));
+    float maxY = std::max(t.y[0], std::max(t.y[1], t.y[2]));
+    int startX = std::max(x0, (int)std::floor(minX) & ~7);
+    int endX = std::min(x1, (int)std::ceil(maxX));
+    int startY = std::max(y0, (int)std::floor(minY));
+    int endY = std::min(y1, (int)std::ceil(maxY));
+
+    Float8 zero = Float8::broadcast(0.0f);
+    Float8 offsets = Float8::load(LANE_OFFSETS);
+    Float8 edgeA[3], zA = Float8::broadcast(za);
+    for (int k = 0; k < 3; ++k) {
+        edgeA[k] = Float8::broadcast(a[k]);
+    }
+
+    int blocksPerRow = settings.width / 8;
+    for (int y = startY; y < endY; ++y) {
+        float py = y + 0.5f;
+        Float8 rowEdge[3];
+        for (int k = 0; k < 3; ++k) {
+            rowEdge[k] = Float8::broadcast(b[k] * py + c[k]);
+        }
+        Float8 rowDepth = Float8::broadcast(zb * py + zc);
+
+        for (int x = startX; x < endX; x += 8) {
+            Float8 px = Float8::broadcast((float)x) + offsets;
+            Float8 inside = (zero <= edgeA[0] * px + rowEdge[0]) & (zero <= edgeA[1] * px + rowEdge[1]) &
+                            (zero <= edgeA[2] * px + rowEdge[2]);
+            if (inside.mask() == 0) {
+                continue;
+            }
+            float* block = depth[(size_t)y * blocksPerRow + x / 8].v;
+            Float8 current = Float8::load(block);
+            Float8 fragment = zA * px + rowDepth;
+            select(inside, min(current, fragment), current).store(block);
+        }
+    }
+}
+
+bool OcclusionCuller::isOccluded(const ScreenBox& box) const {
+    if (!box.inFront || box.ndcMin.z < -1.0f) {
+        return false; // Reaches the eye or near plane
+    }
+    const glm::vec3& ndcMin = box.ndcMin;
+    const glm::vec3& ndcMax = box.ndcMax;
+    float nearest = ndcMin.z * 0.5f + 0.5f;
+
+    // Every pixel the box's screen rectangle touches must hold something nearer
+    int x0 = std::max(0, (int)std::floor((ndcMin.x * 0.5f + 0.5f) * settings.width));
+    int x1 = std::min(settings.width, (int)std::ceil((ndcMax.x * 0.5f + 0.5f) * settings.width));
+    int y0 = std::max(0, (int)std::floor((ndcMin.y * 0.5f + 0.5f) * settings.height));
+    int y1 = std::min(settings.height, (int)std::ceil((ndcMax.y * 0.5f + 0.5f) * settings.height));
+    if (x0 >= x1 || y0 >= y1) {
+        return false; // Off-buffer boxes are the frustum culler's business
+    }
+
+    int blocksPerRow = settings.width / 8;
+    Float8 nearestLanes = Float8::broadcast(nearest);
+    for (int ty = y0 / TILE_HEIGHT; ty <= (y1 - 1) / TILE_HEIGHT; ++ty) {
+        for (int tx = x0 / TILE_WIDTH; tx <= (x1 - 1) / TILE_WIDTH; ++tx) {
+            if (tileMaxDepth[(size_t)ty * tilesX + tx] < nearest) {
+                continue; // Whole tile is nearer than the box
+            }
+
+            int rowStart = std::max(y0, ty * TILE_HEIGHT);
+            int rowEnd = std::min(y1, (ty + 1) * TILE_HEIGHT);
+            int colStart = std::max(x0, tx * TILE_WIDTH);
+            int colEnd = std::min(x1, (tx + 1) * TILE_WIDTH);
+            for (int y = rowStart; y < rowEnd; ++y) {
+                for (int x = colStart & ~7; x < colEnd; x += 8) {
+                    // Lanes outside [colStart, colEnd) are ignored
+                    uint32_t laneMask = 0xffu;
+                    if (x < colStart) laneMask &= 0xffu << (colStart - x);
+                    if (x + 8 > colEnd) laneMask &= 0xffu >> (x + 8 - colEnd);
+                    Float8 stored = Float8::load(depth[(size_t)y * blocksPerRow + x / 8].v);
+                    if ((nearestLanes <= stored).mask() & laneMask) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,97 @@
+#include "../include/scene/RenderQueue.hpp"
+#include "../include/scene/LodSelector.hpp"
+#include <algorithm>
+
+namespace {
+    const int PASS_SHIFT = 62;
+    const int BLENDED_SHIFT = 61;
+    const uint64_t DEPTH_MAX = (1u << 24) - 1;
+    const uint64_t TEXTURE_MAX = (1u << 12) - 1;
+
+    // Field positions below the blended bit for each layout
+    const int OPAQUE_TEXTURE_SHIFT = 49;
+    const int OPAQUE_MESH_SHIFT = 41;
+    const int OPAQUE_DEPTH_SHIFT = 17;
+    const int BLENDED_DEPTH_SHIFT = 37;
+    const int BLENDED_TEXTURE_SHIFT = 25;
+    const int BLENDED_MESH_SHIFT = 17;
+}
+
+uint64_t RenderQueue::makeKey(Pass pass, bool blended, int texture, ShapeType shape, int level, float depth) {
+    uint64_t textureBits = std::min<uint64_t>((uint64_t)(texture + 1), TEXTURE_MAX);
+    uint64_t meshBits = ((uint64_t)shape << 4) | (uint64_t)((level + 1) & 0xf);
+    uint64_t depthBits = (uint64_t)(std::min(std::max(depth, 0.0f), 1.0f) * DEPTH_MAX);
+
+    uint64_t key = ((uint64_t)pass << PASS_SHIFT) | ((uint64_t)blended << BLENDED_SHIFT);
+    if (blended) {
+        return key | ((DEPTH_MAX - depthBits) << BLENDED_DEPTH_SHIFT) | (textureBits << BLENDED_TEXTURE_SHIFT) |
+               (meshBits << BLENDED_MESH_SHIFT);
+    }
+    return key | (textureBits << OPAQUE_TEXTURE_SHIFT) | (meshBits << OPAQUE_MESH_SHIFT) |
+           (depthBits << OPAQUE_DEPTH_SHIFT);
+}
+
+bool RenderQueue::isBlended(uint64_t key) {
+    return (key >> BLENDED_SHIFT) & 1;
+}
+
+int RenderQueue::textureOf(uint64_t key) {
+    int shift = isBlended(key) ? BLENDED_TEXTURE_SHIFT : OPAQUE_TEXTURE_SHIFT;
+    return (int)((key >> shift) & TEXTURE_MAX) - 1;
+}
+
+uint32_t RenderQueue::meshOf(uint64_t key) {
+    int shift = isBlended(key) ? BLENDED_MESH_SHIFT : OPAQUE_MESH_SHIFT;
+    return (uint32_t)((key >> shift) & 0xff);
+}
+
+PrimitiveParams RenderQueue::paramsOf(uint64_t key) {
+    return paramsForMesh(meshOf(key));
+}
+
+PrimitiveParams RenderQueue::paramsForMesh(uint32_t mesh) {
+    ShapeType shape = (ShapeType)(mesh >> 4);
+    int level = (int)(mesh & 0xf) - 1;
+    return LodSelector::paramsForLevel(PrimitiveParams::defaultsFor(shape), level);
+}
+
+RenderQueue::StateChanges RenderQueue::countStateChanges(const std::vector<uint64_t>& keys) {
+    StateChanges changes;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        uint64_t key = keys[i];
+        bool first = i == 0;
+        if (first || meshOf(key) != meshOf(keys[i - 1])) changes.meshes++;
+        if (first || textureOf(key) != textureOf(keys[i - 1])) changes.textures++;
+        if (first || isBlended(key) != isBlended(keys[i - 1])) changes.blends++;
+    }
+    return changes;
+}
+
+void RenderQueue::build(const Scene& scene, const std::vector<uint32_t>& visibleObjects, const Camera& camera,
+                        int viewportHeightPx, std::vector<int8_t>& lodLevels) {
+    keys.clear();
+    objects.clear();
+
+    // Depth is the view distance over the far plane
+    glm::mat4 view = camera.view();
+    glm::vec3 viewRow(view[0][2], view[1][2], view[2][2]);
+    float inverseFar = 1.0f / camera.farPlane;
+
+    for (uint32_t i : visibleObjects) {
+        if (!(scene.flags[i] & ObjectFlags::VISIBLE) || scene.shapes[i] == ShapeType::NONE) {
+            continue;
+        }
+        LodSelector::selectForObject(scene, i, camera, viewportHeightPx, lodLevels);
+        int level = LodSelector::usesLod(scene.shapes[i]) ? lodLevels[i] : -1;
+        float viewZ = glm::dot(viewRow, glm::vec3(scene.worldMatrices[i][3])) + view[3][2];
+
+        // Textured draws are alpha blended
+        int texture = scene.materials[i].texture;
+        keys.push_back(makeKey(PASS_SCENE, texture != -1, texture, scene.shapes[i], level, -viewZ * inverseFar));
+        objects.push_back(i);
+    }
+
+    unsortedChanges = countStateChanges(keys);
+    sorter.sort(keys, objects);
+    sortedChanges = countStateChanges(keys);
+}
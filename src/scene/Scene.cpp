@@ -0,0 +1,326 @@
+#include "../include/scene/Scene.hpp"
+#include "../include/math/Camera.hpp"
+#include <algorithm>
+#include <type_traits>
+
+ObjectHandle Scene::add(ShapeType shape) {
+    uint32_t slotIndex = allocateSlot();
+    appendObject(shape, slotIndex, NO_PARENT);
+
+    ObjectHandle handle;
+    handle.index = slotIndex;
+    handle.generation = slots[slotIndex].generation;
+    return handle;
+}
+
+ObjectHandle Scene::add(ShapeType shape, ObjectHandle parent) {
+    ObjectHandle handle = add(shape);
+    if (isValid(parent)) {
+        setParent(handle, parent);
+    }
+    return handle;
+}
+
+bool Scene::remove(ObjectHandle handle) {
+    if (!isValid(handle)) {
+        return false;
+    }
+
+    uint32_t first = slots[handle.index].denseIndex;
+    uint32_t count = subtreeSizes[first];
+    uint32_t end = first + count;
+    uint32_t last = (uint32_t)shapes.size() - 1;
+    uint32_t parent = parents[first];
+
+    for (uint32_t i = first; i < end; ++i) {
+        releaseSlot(denseToSlot[i]);
+    }
+    structureRevision++;
+    revision++;
+    movedRanges.clear();
+
+    if (count == 1 && parent == NO_PARENT && parents[last] == NO_PARENT && subtreeSizes[last] == 1) {
+        // Flat case: move the last root-level object into the hole
+        if (first != last) {
+            forEachArray([first, last](auto& array) { array[first] = array[last]; });
+            slots[denseToSlot[first]].denseIndex = first;
+        }
+        forEachArray([](auto& array) { array.pop_back(); });
+    } else if (end == shapes.size()) {
+        // Subtree at the end of the arrays: truncate and shrink the ancestors
+        forEachArray([first](auto& array) { array.resize(first); });
+        for (uint32_t ancestor = parent; ancestor != NO_PARENT; ancestor = parents[ancestor]) {
+            subtreeSizes[ancestor] -= count;
+        }
+    } else {
+        // Dropping a whole subtree from a preorder sequence keeps it in preorder
+        std::vector<uint32_t> order;
+        order.reserve(shapes.size() - count);
+        for (uint32_t i = 0; i < shapes.size(); ++i) {
+            if (i < first || i >= end) order.push_back(i);
+        }
+        applyOrder(order);
+    }
+    return true;
+}
+
+void Scene::clear() {
+    // Release the slots so outstanding handles are invalidated, not reused as-is
+    for (uint32_t slotIndex : denseToSlot) {
+        releaseSlot(slotIndex);
+    }
+    forEachArray([](auto& array) { array.clear(); });
+    dirtySlots.clear();
+    structureRevision++;
+    revision++;
+    movedRanges.clear();
+}
+
+void Scene::reserve(size_t count) {
+    forEachArray([count](auto& array) { array.reserve(count); });
+    slots.reserve(count);
+}
+
+bool Scene::setParent(ObjectHandle handle, ObjectHandle parent) {
+    if (!isValid(handle)) {
+        return false;
+    }
+    uint32_t child = slots[handle.index].denseIndex;
+    uint32_t newParent = isValid(parent) ? slots[parent.index].denseIndex : NO_PARENT;
+    if (newParent != NO_PARENT && newParent >= child && newParent < child + subtreeSizes[child]) {
+        return false; // Would create a cycle
+    }
+    if (parents[child] == newParent) {
+        return true;
+    }
+
+    // Appending a root leaf to a subtree that already ends at the back (building trees depth-first)
+    uint32_t last = (uint32_t)shapes.size() - 1;
+    if (child == last && parents[child] == NO_PARENT && subtreeSizes[child] == 1 && newParent != NO_PARENT &&
+        newParent + subtreeSizes[newParent] == child) {
+        parents[child] = newParent;
+        for (uint32_t ancestor = newParent; ancestor != NO_PARENT; ancestor = parents[ancestor]) {
+            subtreeSizes[ancestor] += 1;
+        }
+        markDirty(child);
+        return true;
+    }
+    parents[child] = newParent;
+
+    // Regenerate the preorder from the parent links: children lists in CSR form, then an explicit-stack DFS
+    uint32_t count = (uint32_t)shapes.size();
+    std::vector<uint32_t> childStart(count + 2, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        ++childStart[(parents[i] == NO_PARENT ? count : parents[i]) + 1];
+    }
+    for (uint32_t i = 0; i <= count; ++i) {
+        childStart[i + 1] += childStart[i];
+    }
+    std::vector<uint32_t> children(count);
+    std::vector<uint32_t> fill(childStart.begin(), childStart.end() - 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        children[fill[parents[i] == NO_PARENT ? count : parents[i]]++] = i;
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    std::vector<uint32_t> stack;
+    for (uint32_t r = childStart[count + 1]; r > childStart[count]; --r) {
+        stack.push_back(children[r - 1]);
+    }
+    while (!stack.empty()) {
+        uint32_t node = stack.back();
+        stack.pop_back();
+        order.push_back(node);
+        for (uint32_t c = childStart[node + 1]; c > childStart[node]; --c) {
+            stack.push_back(children[c - 1]);
+        }
+    }
+    applyOrder(order);
+
+    markDirty(slots[handle.index].denseIndex);
+    return true;
+}
+
+ObjectHandle Scene::parentOf(ObjectHandle handle) const {
+    int64_t index = indexOf(handle);
+    if (index < 0 || parents[index] == NO_PARENT) {
+        return ObjectHandle();
+    }
+    return handleAt(parents[index]);
+}
+
+bool Scene::isValid(ObjectHandle handle) const {
+    return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+           slots[handle.index].denseIndex != ObjectHandle::INVALID_INDEX;
+}
+
+int64_t Scene::indexOf(ObjectHandle handle) const {
+    return isValid(handle) ? (int64_t)slots[handle.index].denseIndex : -1;
+}
+
+ObjectHandle Scene::handleAt(size_t index) const {
+    ObjectHandle handle;
+    if (index < denseToSlot.size()) {
+        handle.index = denseToSlot[index];
+        handle.generation = slots[handle.index].generation;
+    }
+    return handle;
+}
+
+void Scene::setLocalTransform(size_t index, const glm::vec3& position, const glm::vec3& scale, const glm::vec3& rotation) {
+    if (positions[index] == position && scales[index] == scale && rotations[index] == rotation) {
+        return;
+    }
+    positions[index] = position;
+    scales[index] = scale;
+    rotations[index] = rotation;
+    markDirty(index);
+}
+
+void Scene::markDirty(size_t index) {
+    revision++;
+    if (!(flags[index] & ObjectFlags::DIRTY)) {
+        flags[index] |= ObjectFlags::DIRTY;
+        dirtySlots.push_back(denseToSlot[index]);
+    }
+}
+
+void Scene::updateWorldMatrices() {
+    if (dirtySlots.empty()) {
+        return;
+    }
+
+    std::vector<uint32_t> roots;
+    roots.reserve(dirtySlots.size());
+    for (uint32_t slotIndex : dirtySlots) {
+        uint32_t index = slots[slotIndex].denseIndex;
+        if (index != ObjectHandle::INVALID_INDEX && (flags[index] & ObjectFlags::DIRTY)) {
+            roots.push_back(index);
+        }
+    }
+    dirtySlots.clear();
+    std::sort(roots.begin(), roots.end());
+
+    // Ancestors sort first, so a dirty node inside an already updated range is skipped
+    uint32_t coveredEnd = 0;
+    for (uint32_t root : roots) {
+        if (root < coveredEnd) {
+            continue;
+        }
+        coveredEnd = root + subtreeSizes[root];
+        recordMoved(root, coveredEnd);
+        for (uint32_t i = root; i < coveredEnd; ++i) {
+            glm::mat4 local = TransformMath::modelMatrix(positions[i], scales[i], rotations[i]);
+            worldMatrices[i] = parents[i] == NO_PARENT ? local : worldMatrices[parents[i]] * local;
+            flags[i] &= ~ObjectFlags::DIRTY;
+        }
+    }
+}
+
+void Scene::updateAllWorldMatrices() {
+    size_t count = shapes.size();
+    for (size_t i = 0; i < count; ++i) {
+        glm::mat4 local = TransformMath::modelMatrix(positions[i], scales[i], rotations[i]);
+        worldMatrices[i] = parents[i] == NO_PARENT ? local : worldMatrices[parents[i]] * local;
+        flags[i] &= ~ObjectFlags::DIRTY;
+    }
+    dirtySlots.clear();
+    movedRanges.clear();
+    recordMoved(0, (uint32_t)count);
+}
+
+void Scene::takeMovedRanges(std::vector<IndexRange>& out) {
+    out.swap(movedRanges);
+    movedRanges.clear();
+}
+
+uint32_t Scene::allocateSlot() {
+    if (freeHead != ObjectHandle::INVALID_INDEX) {
+        uint32_t slotIndex = freeHead;
+        freeHead = slots[slotIndex].nextFree;
+        slots[slotIndex].nextFree = ObjectHandle::INVALID_INDEX;
+        return slotIndex;
+    }
+    slots.emplace_back();
+    return (uint32_t)slots.size() - 1;
+}
+
+void Scene::releaseSlot(uint32_t slotIndex) {
+    Slot& slot = slots[slotIndex];
+    slot.denseIndex = ObjectHandle::INVALID_INDEX;
+    slot.generation++;
+    slot.nextFree = freeHead;
+    freeHead = slotIndex;
+}
+
+void Scene::appendObject(ShapeType shape, uint32_t slotIndex, uint32_t parent) {
+    slots[slotIndex].denseIndex = (uint32_t)shapes.size();
+
+    shapes.push_back(shape);
+    positions.emplace_back(0.0f);
+    scales.emplace_back(1.0f);
+    rotations.emplace_back(0.0f);
+    materials.emplace_back();
+    flags.push_back(ObjectFlags::VISIBLE);
+    worldMatrices.emplace_back(1.0f);
+    parents.push_back(parent);
+    subtreeSizes.push_back(1);
+    denseToSlot.push_back(slotIndex);
+    structureRevision++;
+    revision++;
+    movedRanges.clear();
+
+    markDirty(shapes.size() - 1);
+}
+
+void Scene::applyOrder(const std::vector<uint32_t>& order) {
+    std::vector<uint32_t> oldToNew(shapes.size(), NO_PARENT);
+    for (uint32_t k = 0; k < order.size(); ++k) {
+        oldToNew[order[k]] = k;
+    }
+
+    forEachArray([&order](auto& array) {
+        typename std::remove_reference<decltype(array)>::type reordered;
+        reordered.reserve(order.size());
+        for (uint32_t index : order) {
+            reordered.push_back(array[index]);
+        }
+        array.swap(reordered);
+    });
+
+    for (uint32_t k = 0; k < order.size(); ++k) {
+        if (parents[k] != NO_PARENT) {
+            parents[k] = oldToNew[parents[k]];
+        }
+        slots[denseToSlot[k]].denseIndex = k;
+    }
+    rebuildSubtreeSizes();
+    structureRevision++;
+    revision++;
+    movedRanges.clear();
+}
+
+void Scene::rebuildSubtreeSizes() {
+    std::fill(subtreeSizes.begin(), subtreeSizes.end(), 1u);
+    // Children follow their parents, so a reverse pass accumulates whole subtrees
+    for (size_t i = subtreeSizes.size(); i-- > 0;) {
+        if (parents[i] != NO_PARENT) {
+            subtreeSizes[parents[i]] += subtreeSizes[i];
+        }
+    }
+}
+
+void Scene::recordMoved(uint32_t begin, uint32_t end) {
+    uint32_t count = (uint32_t)shapes.size();
+    if (movedRanges.size() == 1 && movedRanges[0].begin == 0 && movedRanges[0].end >= count) {
+        return; // Everything is already covered
+    }
+    // Nobody may be consuming the ranges; past a point one range covering everything is cheaper
+    const size_t maxRanges = std::max<size_t>(4096, count / 8);
+    if (movedRanges.size() >= maxRanges) {
+        movedRanges.assign(1, IndexRange{0, count});
+        return;
+    }
+    movedRanges.push_back(IndexRange{begin, end});
+}
@@ -0,0 +1,403 @@
+#include "../include/scene/SceneBvh.hpp"
+#include "../include/scene/LodSelector.hpp"
+#include "../include/math/RayKernels.hpp"
+#include <glm/simd/platform.h>
+#include <algorithm>
+#include <utility>
+
+namespace {
+    // Empty lanes get an inverted box that fails every plane test without producing NaNs
+    const float EMPTY_MIN = 1e30f;
+    const float EMPTY_MAX = -1e30f;
+
+    float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        glm::vec3 size = glm::max(boundsMax - boundsMin, glm::vec3(0.0f));
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    // Tests eight lane boxes against the frustum. Returns the lanes not fully
+    // outside any plane; insideMask gets the lanes fully inside all planes.
+    uint32_t testLanes(const float* minX, const float* minY, const float* minZ,
+                       const float* maxX, const float* maxY, const float* maxZ,
+                       const Frustum& frustum, uint32_t& insideMask) {
+        uint32_t outside = 0;
+        uint32_t straddling = 0;
+
+        for (const glm::vec4& plane : frustum.planes) {
+            // The corner furthest along the normal decides "outside", the nearest one "inside"
+            const float* farX = plane.x >= 0.0f ? maxX : minX;
+            const float* farY = plane.y >= 0.0f ? maxY : minY;
+            const float* farZ = plane.z >= 0.0f ? maxZ : minZ;
+            const float* nearX = plane.x >= 0.0f ? minX : maxX;
+            const float* nearY = plane.y >= 0.0f ? minY : maxY;
+            const float* nearZ = plane.z >= 0.0f ? minZ : maxZ;
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+            __m256 a = _mm256_set1_ps(plane.x), b = _mm256_set1_ps(plane.y);
+            __m256 c = _mm256_set1_ps(plane.z), d = _mm256_set1_ps(plane.w);
+            __m256 zero = _mm256_setzero_ps();
+            __m256 farDistance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(a, _mm256_load_ps(farX)), _mm256_mul_ps(b, _mm256_load_ps(farY))),
+                _mm256_add_ps(_mm256_mul_ps(c, _mm256_load_ps(farZ)), d));
+            __m256 nearDistance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(a, _mm256_load_ps(nearX)), _mm256_mul_ps(b, _mm256_load_ps(nearY))),
+                _mm256_add_ps(_mm256_mul_ps(c, _mm256_load_ps(nearZ)), d));
+            outside |= (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(farDistance, zero, _CMP_LT_OQ));
+            straddling |= (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(nearDistance, zero, _CMP_LT_OQ));
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+            __m128 a = _mm_set1_ps(plane.x), b = _mm_set1_ps(plane.y);
+            __m128 c = _mm_set1_ps(plane.z), d = _mm_set1_ps(plane.w);
+            __m128 zero = _mm_setzero_ps();
+            for (int half = 0; half < 8; half += 4) {
+                __m128 farDistance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(a, _mm_load_ps(farX + half)), _mm_mul_ps(b, _mm_load_ps(farY + half))),
+                    _mm_add_ps(_mm_mul_ps(c, _mm_load_ps(farZ + half)), d));
+                __m128 nearDistance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(a, _mm_load_ps(nearX + half)), _mm_mul_ps(b, _mm_load_ps(nearY + half))),
+                    _mm_add_ps(_mm_mul_ps(c, _mm_load_ps(nearZ + half)), d));
+                outside |= (uint32_t)_mm_movemask_ps(_mm_cmplt_ps(farDistance, zero)) << half;
+                straddling |= (uint32_t)_mm_movemask_ps(_mm_cmplt_ps(nearDistance, zero)) << half;
+            }
+#else
+            for (int lane = 0; lane < 8; ++lane) {
+                float farDistance = plane.x * farX[lane] + plane.y * farY[lane] + plane.z * farZ[lane] + plane.w;
+                float nearDistance = plane.x * nearX[lane] + plane.y * nearY[lane] + plane.z * nearZ[lane] + plane.w;
+                outside |= (uint32_t)(farDistance < 0.0f) << lane;
+                straddling |= (uint32_t)(nearDistance < 0.0f) << lane;
+            }
+#endif
+        }
+
+        uint32_t hit = ~outside & 0xffu;
+        insideMask = ~straddling & hit;
+        return hit;
+    }
+}
+
+void SceneBvh::update(Scene& scene) {
+    scene.takeMovedRanges(movedRanges);
+    if (scene.getStructureRevision() != builtRevision) {
+        build(scene);
+        return;
+    }
+    if (movedRanges.empty()) {
+        return;
+    }
+
+    refit(scene, movedRanges);
+    // Refitting only stretches boxes; once the summed node area doubles a rebuild pays for itself
+    if (totalArea > builtArea * 2.0) {
+        build(scene);
+    }
+}
+
+void SceneBvh::build(const Scene& scene) {
+    size_t count = scene.size();
+    nodes.clear();
+    nodeAreas.clear();
+    objectLanes.assign(count, EMPTY);
+    buildMin.resize(count);
+    buildMax.resize(count);
+    buildItems.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        worldBounds(scene, i, buildMin[i], buildMax[i]);
+        buildItems[i].centroid = buildMin[i] + buildMax[i];
+        buildItems[i].object = (uint32_t)i;
+    }
+
+    builtRevision = scene.getStructureRevision();
+    rebuildCount++;
+    totalArea = 0.0;
+    if (count > 0) {
+        nodes.reserve(count / (WIDTH / 2) + 1);
+        nodeAreas.reserve(nodes.capacity());
+        buildNode(0, (uint32_t)count, EMPTY);
+    }
+    builtArea = totalArea;
+    nodeQueued.assign(nodes.size(), 0);
+}
+
+void SceneBvh::cull(const Scene& scene, const Frustum& frustum, std::vector<uint32_t>& visible,
+                    CullStats* stats) const {
+    size_t before = visible.size();
+    uint32_t nodesVisited = 0;
+
+    if (!nodes.empty()) {
+        std::vector<uint32_t> stack;
+        stack.reserve(128);
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            nodesVisited++;
+
+            uint32_t insideMask = 0;
+            uint32_t hit = testLanes(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, frustum,
+                                     insideMask);
+            for (int lane = 0; lane < WIDTH; ++lane) {
+                uint32_t child = node.child[lane];
+                if (!(hit & (1u << lane)) || child == EMPTY) {
+                    continue;
+                }
+                if (child & LEAF_BIT) {
+                    uint32_t object = child & ~LEAF_BIT;
+                    if (scene.flags[object] & ObjectFlags::VISIBLE) {
+                        visible.push_back(object);
+                    }
+                } else if (insideMask & (1u << lane)) {
+                    // Entirely inside the frustum: take the whole subtree untested
+                    appendSubtree(scene, child, visible);
+                } else {
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+
+    if (stats) {
+        stats->visible = (uint32_t)(visible.size() - before);
+        stats->culled = (uint32_t)objectLanes.size() - stats->visible;
+        stats->nodesVisited = nodesVisited;
+    }
+}
+
+float SceneBvh::raycast(const Scene& scene, const Ray& ray, float maxDistance,
+                        const std::function<float(uint32_t object, float closest)>& intersectObject) const {
+    if (nodes.empty()) {
+        return maxDistance;
+    }
+
+    RayLanes lanes(ray);
+
+    std::vector<std::pair<float, uint32_t>> stack;
+    stack.reserve(128);
+    stack.emplace_back(0.0f, 0u);
+    float closest = maxDistance;
+    alignas(32) float entry[WIDTH];
+
+    while (!stack.empty()) {
+        std::pair<float, uint32_t> current = stack.back();
+        stack.pop_back();
+        if (current.first >= closest) {
+            continue;
+        }
+        const Node& node = nodes[current.second];
+        uint32_t hit = intersectRayBoxes(node.minX, node.minY, node.minZ, node.maxX, node.maxY, node.maxZ, lanes, closest,
+                                         entry);
+
+        // Hit lanes sorted nearest first
+        int order[WIDTH];
+        int hitCount = 0;
+        for (int lane = 0; lane < WIDTH; ++lane) {
+            if ((hit & (1u << lane)) && node.child[lane] != EMPTY) {
+                int k = hitCount++;
+                while (k > 0 && entry[order[k - 1]] > entry[lane]) {
+                    order[k] = order[k - 1];
+                    --k;
+                }
+                order[k] = lane;
+            }
+        }
+
+        for (int k = hitCount; k-- > 0;) {
+            uint32_t child = node.child[order[k]];
+            if (!(child & LEAF_BIT)) {
+                stack.emplace_back(entry[order[k]], child);
+            }
+        }
+        for (int k = 0; k < hitCount; ++k) {
+            uint32_t child = node.child[order[k]];
+            if ((child & LEAF_BIT) && entry[order[k]] < closest) {
+                uint32_t object = child & ~LEAF_BIT;
+                if (scene.flags[object] & ObjectFlags::VISIBLE) {
+                    closest = intersectObject(object, closest);
+                }
+            }
+        }
+    }
+    return closest;
+}
+
+void SceneBvh::worldBounds(const Scene& scene, size_t index, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+    // Box around the bounding sphere, transformed: extent is |M| applied to the radius
+    float radius = LodSelector::boundingRadius(PrimitiveParams::defaultsFor(scene.shapes[index]));
+    const glm::mat4& world = scene.worldMatrices[index];
+    glm::vec3 center(world[3]);
+    glm::vec3 extent = radius * (glm::abs(glm::vec3(world[0])) + glm::abs(glm::vec3(world[1])) +
+                                 glm::abs(glm::vec3(world[2])));
+    boundsMin = center - extent;
+    boundsMax = center + extent;
+}
+
+uint32_t SceneBvh::buildNode(uint32_t begin, uint32_t end, uint32_t parentLane) {
+    uint32_t node = (uint32_t)nodes.size();
+    nodes.emplace_back();
+    nodeAreas.push_back(0.0f);
+    for (int lane = 0; lane < WIDTH; ++lane) {
+        setLane(node, lane, glm::vec3(EMPTY_MIN), glm::vec3(EMPTY_MAX));
+        nodes[node].child[lane] = EMPTY;
+    }
+    nodes[node].parentLane = parentLane;
+
+    // Split into up to WIDTH groups, halving the largest group at the centroid median of its widest axis
+    Scene::IndexRange groups[WIDTH];
+    int groupCount = 1;
+    groups[0] = Scene::IndexRange{begin, end};
+    while (groupCount < WIDTH) {
+        int largest = 0;
+        for (int g = 1; g < groupCount; ++g) {
+            if (groups[g].end - groups[g].begin > groups[largest].end - groups[largest].begin) {
+                largest = g;
+            }
+        }
+        Scene::IndexRange range = groups[largest];
+        if (range.end - range.begin <= 1) {
+            break;
+        }
+
+        glm::vec3 centroidMin(EMPTY_MIN), centroidMax(EMPTY_MAX);
+        for (uint32_t i = range.begin; i < range.end; ++i) {
+            centroidMin = glm::min(centroidMin, buildItems[i].centroid);
+            centroidMax = glm::max(centroidMax, buildItems[i].centroid);
+        }
+        glm::vec3 extent = centroidMax - centroidMin;
+        int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+        uint32_t mid = range.begin + (range.end - range.begin) / 2;
+        std::nth_element(buildItems.begin() + range.begin, buildItems.begin() + mid, buildItems.begin() + range.end,
+                         [axis](const BuildItem& a, const BuildItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+        groups[largest] = Scene::IndexRange{range.begin, mid};
+        groups[groupCount++] = Scene::IndexRange{mid, range.end};
+    }
+
+    for (int lane = 0; lane < groupCount; ++lane) {
+        const Scene::IndexRange& range = groups[lane];
+        if (range.end - range.begin == 1) {
+            uint32_t object = buildItems[range.begin].object;
+            nodes[node].child[lane] = LEAF_BIT | object;
+            setLane(node, lane, buildMin[object], buildMax[object]);
+            objectLanes[object] = node * WIDTH + lane;
+        } else {
+            uint32_t child = buildNode(range.begin, range.end, node * WIDTH + lane);
+            nodes[node].child[lane] = child;
+            glm::vec3 childMin, childMax;
+            nodeBounds(child, childMin, childMax);
+            setLane(node, lane, childMin, childMax);
+        }
+    }
+
+    glm::vec3 boundsMin, boundsMax;
+    nodeBounds(node, boundsMin, boundsMax);
+    nodeAreas[node] = surfaceArea(boundsMin, boundsMax);
+    totalArea += nodeAreas[node];
+    return node;
+}
+
+void SceneBvh::refit(const Scene& scene, const std::vector<Scene::IndexRange>& ranges) {
+    size_t moved = 0;
+    for (const Scene::IndexRange& range : ranges) {
+        moved += range.end - range.begin;
+    }
+
+    glm::vec3 boundsMin, boundsMax;
+    if (moved * 4 > objectLanes.size()) {
+        // Most of the scene moved: refit every leaf, then every node bottom-up
+        // (children are always stored after their parent)
+        for (size_t i = 0; i < objectLanes.size(); ++i) {
+            worldBounds(scene, i, boundsMin, boundsMax);
+            setLane(objectLanes[i] / WIDTH, objectLanes[i] % WIDTH, boundsMin, boundsMax);
+        }
+        totalArea = 0.0;
+        for (size_t node = nodes.size(); node-- > 0;) {
+            nodeBounds((uint32_t)node, boundsMin, boundsMax);
+            nodeAreas[node] = surfaceArea(boundsMin, boundsMax);
+            totalArea += nodeAreas[node];
+            uint32_t parentLane = nodes[node].parentLane;
+            if (parentLane != EMPTY) {
+                setLane(parentLane / WIDTH, parentLane % WIDTH, boundsMin, boundsMax);
+            }
+        }
+        return;
+    }
+
+    // Few objects moved: refit their leaves, then walk the touched nodes deepest
+    // first with a max-heap on node index so each ancestor is refit once
+    auto enqueue = [this](uint32_t node) {
+        if (!nodeQueued[node]) {
+            nodeQueued[node] = 1;
+            refitQueue.push_back(node);
+            std::push_heap(refitQueue.begin(), refitQueue.end());
+        }
+    };
+    for (const Scene::IndexRange& range : ranges) {
+        for (uint32_t i = range.begin; i < range.end && i < objectLanes.size(); ++i) {
+            worldBounds(scene, i, boundsMin, boundsMax);
+            setLane(objectLanes[i] / WIDTH, objectLanes[i] % WIDTH, boundsMin, boundsMax);
+            enqueue(objectLanes[i] / WIDTH);
+        }
+    }
+    while (!refitQueue.empty()) {
+        std::pop_heap(refitQueue.begin(), refitQueue.end());
+        uint32_t node = refitQueue.back();
+        refitQueue.pop_back();
+        nodeQueued[node] = 0;
+
+        nodeBounds(node, boundsMin, boundsMax);
+        float area = surfaceArea(boundsMin, boundsMax);
+        totalArea += area - nodeAreas[node];
+        nodeAreas[node] = area;
+
+        uint32_t parentLane = nodes[node].parentLane;
+        if (parentLane == EMPTY) {
+            continue;
+        }
+        const Node& parent = nodes[parentLane / WIDTH];
+        int lane = parentLane % WIDTH;
+        if (parent.minX[lane] == boundsMin.x && parent.minY[lane] == boundsMin.y && parent.minZ[lane] == boundsMin.z &&
+            parent.maxX[lane] == boundsMax.x && parent.maxY[lane] == boundsMax.y && parent.maxZ[lane] == boundsMax.z) {
+            continue; // Ancestors are unaffected
+        }
+        setLane(parentLane / WIDTH, lane, boundsMin, boundsMax);
+        enqueue(parentLane / WIDTH);
+    }
+}
+
+void SceneBvh::setLane(uint32_t node, int lane, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    Node& target = nodes[node];
+    target.minX[lane] = boundsMin.x;
+    target.minY[lane] = boundsMin.y;
+    target.minZ[lane] = boundsMin.z;
+    target.maxX[lane] = boundsMax.x;
+    target.maxY[lane] = boundsMax.y;
+    target.maxZ[lane] = boundsMax.z;
+}
+
+void SceneBvh::nodeBounds(uint32_t node, glm::vec3& boundsMin, glm::vec3& boundsMax) const {
+    const Node& source = nodes[node];
+    boundsMin = glm::vec3(EMPTY_MIN);
+    boundsMax = glm::vec3(EMPTY_MAX);
+    for (int lane = 0; lane < WIDTH; ++lane) {
+        if (source.child[lane] == EMPTY) {
+            continue;
+        }
+        boundsMin = glm::min(boundsMin, glm::vec3(source.minX[lane], source.minY[lane], source.minZ[lane]));
+        boundsMax = glm::max(boundsMax, glm::vec3(source.maxX[lane], source.maxY[lane], source.maxZ[lane]));
+    }
+}
+
+void SceneBvh::appendSubtree(const Scene& scene, uint32_t node, std::vector<uint32_t>& visible) const {
+    for (int lane = 0; lane < WIDTH; ++lane) {
+        uint32_t child = nodes[node].child[lane];
+        if (child == EMPTY) {
+            continue;
+        }
+        if (child & LEAF_BIT) {
+            uint32_t object = child & ~LEAF_BIT;
+            if (scene.flags[object] & ObjectFlags::VISIBLE) {
+                visible.push_back(object);
+            }
+        } else {
+            appendSubtree(scene, child, visible);
+        }
+    }
+}
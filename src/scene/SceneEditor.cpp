@@ -0,0 +1,99 @@
+#include "../include/scene/SceneEditor.hpp"
+#include "../include/scene/ShapeMaterial.hpp"
+#include <iostream>
+
+ObjectHandle SceneEditor::addShape(ApplicationState& appState, ShapeType shape) {
+    ObjectHandle handle = appState.scene.add(shape);
+    size_t index = (size_t)appState.scene.indexOf(handle);
+
+    ObjectMaterial& material = appState.scene.materials[index];
+    material.color = glm::vec3(appState.currentColor[0], appState.currentColor[1], appState.currentColor[2]);
+    material.texture = ShapeMaterial::shapeHasTexture(shape, appState) ? ShapeMaterial::getShapeTexture(shape, appState) : -1;
+    appState.scene.markChanged();
+
+    select(appState, handle);
+    return handle;
+}
+
+void SceneEditor::select(ApplicationState& appState, ObjectHandle handle) {
+    Scene& scene = appState.scene;
+
+    int64_t previous = scene.indexOf(appState.selectedObject);
+    if (previous >= 0) {
+        scene.flags[previous] &= ~ObjectFlags::SELECTED;
+    }
+
+    if (handle != appState.selectedObject) {
+        appState.previousSelectedObject = appState.selectedObject;
+    }
+    appState.selectedObject = handle;
+    int64_t index = scene.indexOf(handle);
+    if (index < 0) {
+        appState.selectedObject = ObjectHandle();
+        appState.currentShape = ShapeType::NONE;
+        appState.lodLevel = -1;
+        return;
+    }
+
+    scene.flags[index] |= ObjectFlags::SELECTED;
+    appState.currentShape = scene.shapes[index];
+    appState.lodLevel = appState.views[0].lodLevelsFor(scene)[index];
+    for (int axis = 0; axis < 3; ++axis) {
+        appState.translate[axis] = scene.positions[index][axis];
+        appState.scale[axis] = scene.scales[index][axis];
+        appState.rotate[axis] = scene.rotations[index][axis];
+    }
+}
+
+void SceneEditor::selectNext(ApplicationState& appState) {
+    const Scene& scene = appState.scene;
+    if (scene.size() == 0) {
+        return;
+    }
+    int64_t index = scene.indexOf(appState.selectedObject);
+    select(appState, scene.handleAt((size_t)((index + 1) % (int64_t)scene.size())));
+    std::cout << "Selected object " << appState.selectedObject.index << std::endl;
+}
+
+bool SceneEditor::removeSelected(ApplicationState& appState) {
+    if (!appState.scene.remove(appState.selectedObject)) {
+        return false;
+    }
+    std::cout << "Removed object " << appState.selectedObject.index << std::endl;
+
+    // Fall back to the most recently added object, if any
+    size_t count = appState.scene.size();
+    select(appState, count > 0 ? appState.scene.handleAt(count - 1) : ObjectHandle());
+    return true;
+}
+
+bool SceneEditor::parentToPreviousSelection(ApplicationState& appState) {
+    if (!appState.scene.isValid(appState.previousSelectedObject) ||
+        !appState.scene.setParent(appState.selectedObject, appState.previousSelectedObject)) {
+        std::cout << "Cannot parent: no previous selection or it is a child of the selected object" << std::endl;
+        return false;
+    }
+    std::cout << "Parented object " << appState.selectedObject.index << " to object "
+              << appState.previousSelectedObject.index << std::endl;
+    return true;
+}
+
+bool SceneEditor::clearParent(ApplicationState& appState) {
+    if (appState.scene.parentOf(appState.selectedObject).isNull()) {
+        return false;
+    }
+    appState.scene.setParent(appState.selectedObject, ObjectHandle());
+    std::cout << "Cleared parent of object " << appState.selectedObject.index << std::endl;
+    return true;
+}
+
+void SceneEditor::syncSelected(ApplicationState& appState) {
+    int64_t index = appState.scene.indexOf(appState.selectedObject);
+    if (index < 0) {
+        return;
+    }
+    appState.scene.setLocalTransform((size_t)index,
+                                     glm::vec3(appState.translate[0], appState.translate[1], appState.translate[2]),
+                                     glm::vec3(appState.scale[0], appState.scale[1], appState.scale[2]),
+                                     glm::vec3(appState.rotate[0], appState.rotate[1], appState.rotate[2]));
+}
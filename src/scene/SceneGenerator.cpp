@@ -0,0 +1,86 @@
+#include "../include/scene/SceneGenerator.hpp"
+#include "../include/core/Constants.hpp"
+#include <cmath>
+#include <random>
+
+namespace {
+    const ShapeType shapes[] = {ShapeType::CUBE, ShapeType::SPHERE, ShapeType::CONE,
+                                ShapeType::CYLINDER, ShapeType::TORUS, ShapeType::PYRAMID};
+    const int shapeCount = 6;
+}
+
+void SceneGenerator::populateBenchmark(Scene& scene, int copiesPerShape) {
+    scene.clear();
+    int total = copiesPerShape * shapeCount;
+    if (total <= 0) {
+        return;
+    }
+    scene.reserve(total);
+
+    // Grid spanning [-1, 1] in x and y and reaching 4 units back from the origin
+    int side = (int)std::ceil(std::cbrt((double)total));
+    float cell = 2.0f / side;
+    float depthCell = 4.0f / side;
+    float objectScale = cell * 0.4f;
+
+    for (int i = 0; i < total; ++i) {
+        int x = i % side;
+        int y = (i / side) % side;
+        int z = i / (side * side);
+
+        size_t index = (size_t)scene.indexOf(scene.add(shapes[i % shapeCount]));
+        scene.positions[index] = glm::vec3(-1.0f + (x + 0.5f) * cell, -1.0f + (y + 0.5f) * cell, -(z + 0.5f) * depthCell);
+        scene.scales[index] = glm::vec3(objectScale);
+        scene.rotations[index] = glm::vec3(25.0f * (i % 7), 40.0f * (i % 5), 0.0f);
+        scene.materials[index].color = glm::vec3((float)x / side, (float)y / side, 1.0f - (float)z / side);
+    }
+}
+
+void SceneGenerator::populateScattered(Scene& scene, int count, float extent) {
+    scene.clear();
+    if (count <= 0) {
+        return;
+    }
+    scene.reserve(count);
+
+    // Fixed seed so runs are comparable
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> coordinate(-extent, extent);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    for (int i = 0; i < count; ++i) {
+        size_t index = (size_t)scene.indexOf(scene.add(shapes[i % shapeCount]));
+        scene.positions[index] = glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+        scene.scales[index] = glm::vec3(0.1f + 0.2f * unit(rng));
+        scene.rotations[index] = glm::vec3(360.0f * unit(rng), 360.0f * unit(rng), 0.0f);
+        scene.materials[index].color = glm::vec3(unit(rng), unit(rng), unit(rng));
+    }
+}
+
+void SceneGenerator::populateOccluded(Scene& scene, int count) {
+    scene.clear();
+    scene.reserve(4 + (count > 0 ? count : 0));
+
+    // 2x2 wall one unit behind the origin with a thin cross-shaped gap
+    for (int i = 0; i < 4; ++i) {
+        size_t index = (size_t)scene.indexOf(scene.add(ShapeType::CUBE));
+        scene.positions[index] = glm::vec3(i % 2 ? 1.0f : -1.0f, i / 2 ? 0.8f : -0.8f, -1.0f);
+        scene.scales[index] = glm::vec3(1.9f, 1.5f, 0.1f);
+        scene.materials[index].color = glm::vec3(0.6f, 0.6f, 0.65f);
+    }
+
+    // Small objects filling the view volume behind the wall
+    std::mt19937 rng(54321);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> spread(-0.9f, 0.9f);
+    float halfSlope = std::tan(glm::radians(Constants::CAMERA_FOV_DEGREES) * 0.5f);
+    for (int i = 0; i < count; ++i) {
+        float z = -3.0f - 27.0f * unit(rng);
+        float halfSize = (Constants::CAMERA_EYE[2] - z) * halfSlope;
+        size_t index = (size_t)scene.indexOf(scene.add(shapes[i % shapeCount]));
+        scene.positions[index] = glm::vec3(spread(rng) * halfSize, spread(rng) * halfSize, z);
+        scene.scales[index] = glm::vec3(0.1f + 0.2f * unit(rng));
+        scene.rotations[index] = glm::vec3(360.0f * unit(rng), 360.0f * unit(rng), 0.0f);
+        scene.materials[index].color = glm::vec3(unit(rng), unit(rng), unit(rng));
+    }
+}
@@ -0,0 +1,72 @@
+#include "../include/scene/ScenePicker.hpp"
+#include "../include/scene/LodSelector.hpp"
+#include <cmath>
+#include <limits>
+
+std::unordered_map<PrimitiveParams, MeshBvh, PrimitiveParamsHash> ScenePicker::meshes;
+
+PickResult ScenePicker::pick(const Scene& scene, const SceneBvh& bvh, const Ray& ray,
+                             const std::vector<int8_t>& lodLevels) {
+    PickResult result;
+    uint32_t hitObject = ObjectHandle::INVALID_INDEX;
+    TriangleHit hitTriangle;
+
+    bvh.raycast(scene, ray, std::numeric_limits<float>::max(), [&](uint32_t object, float closest) {
+        if (scene.shapes[object] == ShapeType::NONE) {
+            return closest;
+        }
+        const glm::mat4& world = scene.worldMatrices[object];
+        if (std::fabs(glm::determinant(glm::mat3(world))) < 1e-12f) {
+            return closest; // Collapsed by a zero scale
+        }
+
+        // Object-space ray; the direction is not renormalized, so distances stay in world units
+        glm::mat4 inverse = glm::inverse(world);
+        Ray local;
+        local.origin = glm::vec3(inverse * glm::vec4(ray.origin, 1.0f));
+        local.direction = glm::vec3(inverse * glm::vec4(ray.direction, 0.0f));
+
+        TriangleHit candidate;
+        if (!meshFor(paramsFor(scene, object, lodLevels)).intersect(local, closest, candidate)) {
+            return closest;
+        }
+        hitObject = object;
+        hitTriangle = candidate;
+        return candidate.distance;
+    });
+
+    if (hitObject == ObjectHandle::INVALID_INDEX) {
+        return result;
+    }
+
+    result.object = scene.handleAt(hitObject);
+    result.face = hitTriangle.face;
+    result.barycentric = glm::vec3(1.0f - hitTriangle.u - hitTriangle.v, hitTriangle.u, hitTriangle.v);
+    result.distance = hitTriangle.distance;
+    result.position = ray.origin + ray.direction * hitTriangle.distance;
+
+    glm::vec3 a, b, c;
+    meshFor(paramsFor(scene, hitObject, lodLevels)).triangle(hitTriangle.face, a, b, c);
+    const glm::mat4& world = scene.worldMatrices[hitObject];
+    result.corners[0] = glm::vec3(world * glm::vec4(a, 1.0f));
+    result.corners[1] = glm::vec3(world * glm::vec4(b, 1.0f));
+    result.corners[2] = glm::vec3(world * glm::vec4(c, 1.0f));
+    return result;
+}
+
+PrimitiveParams ScenePicker::paramsFor(const Scene& scene, size_t index, const std::vector<int8_t>& lodLevels) {
+    PrimitiveParams params = PrimitiveParams::defaultsFor(scene.shapes[index]);
+    return LodSelector::paramsForLevel(params, lodLevels[index]);
+}
+
+const MeshBvh& ScenePicker::meshFor(const PrimitiveParams& params) {
+    auto it = meshes.find(params);
+    if (it != meshes.end()) {
+        return it->second;
+    }
+    return meshes.emplace(params, MeshBvh::build(PrimitiveGenerator::generate(params))).first->second;
+}
+
+void ScenePicker::clear() {
+    meshes.clear();
+}
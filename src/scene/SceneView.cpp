@@ -0,0 +1,49 @@
+#include "../include/scene/SceneView.hpp"
+
+std::vector<int8_t>& SceneView::lodLevelsFor(const Scene& scene) {
+    if (lodLevels.size() != scene.size() || lodStructureRevision != scene.getStructureRevision()) {
+        lodLevels.assign(scene.size(), -1);
+        lodStructureRevision = scene.getStructureRevision();
+    }
+    return lodLevels;
+}
+
+bool SceneView::needsRedraw(uint64_t sceneRevision, uint64_t settings) const {
+    return !drawn || sceneRevision != drawnSceneRevision || settings != drawnSettings || width != drawnWidth ||
+           height != drawnHeight || camera.viewProjection() != drawnViewProjection;
+}
+
+void SceneView::markDrawn(uint64_t sceneRevision, uint64_t settings) {
+    drawn = true;
+    drawnSceneRevision = sceneRevision;
+    drawnSettings = settings;
+    drawnViewProjection = camera.viewProjection();
+    drawnWidth = width;
+    drawnHeight = height;
+}
+
+Camera SceneView::cameraFor(Kind kind, float aspect) {
+    Camera camera = Camera::canvasDefault();
+    camera.aspect = aspect;
+    float distance = glm::length(camera.eye - camera.center);
+    if (kind == TOP) {
+        // Looking down with -Z towards the top of the view, as the front view shows it
+        camera.eye = camera.center + glm::vec3(0.0f, distance, 0.0f);
+        camera.up = glm::vec3(0.0f, 0.0f, -1.0f);
+    } else if (kind == SIDE) {
+        camera.eye = camera.center + glm::vec3(distance, 0.0f, 0.0f);
+    } else if (kind == PERSPECTIVE) {
+        camera.eye = camera.center + glm::normalize(glm::vec3(1.0f, 0.8f, 1.0f)) * distance;
+    }
+    return camera;
+}
+
+const char* SceneView::nameOf(Kind kind) {
+    switch (kind) {
+    case FRONT: return "Front";
+    case TOP: return "Top";
+    case SIDE: return "Side";
+    case PERSPECTIVE: return "Perspective";
+    default: return "";
+    }
+}
@@ -0,0 +1,59 @@
+#include "../include/scene/ShapeMaterial.hpp"
+#include <iostream>
+
+// Function to apply texture to a shape
+void ShapeMaterial::applyTextureToShape(ShapeType shapeType, int textureID, ApplicationState& appState) {
+    if (shapeType != ShapeType::NONE) {
+        int shapeIndex = static_cast<int>(shapeType) - 1; // Convert enum to index (0-5)
+        if (shapeIndex >= 0 && shapeIndex < 6) {
+            appState.shapeTextures[shapeIndex] = textureID;
+            appState.shapeUsesTexture[shapeIndex] = true; // Mark as using texture
+            int64_t object = appState.scene.indexOf(appState.selectedObject);
+            if (object >= 0) {
+                appState.scene.materials[object].texture = textureID;
+                appState.scene.markChanged();
+            }
+            std::cout << "Applied texture " << textureID << " to shape " << shapeIndex << std::endl;
+        }
+    }
+}
+
+// Function to apply color to a shape (remove texture)
+void ShapeMaterial::applyColorToShape(ShapeType shapeType, ApplicationState& appState) {
+    if (shapeType != ShapeType::NONE) {
+        int shapeIndex = static_cast<int>(shapeType) - 1;
+        if (shapeIndex >= 0 && shapeIndex < 6) {
+            appState.shapeUsesTexture[shapeIndex] = false; // Mark as using color
+            int64_t object = appState.scene.indexOf(appState.selectedObject);
+            if (object >= 0) {
+                appState.scene.materials[object].texture = -1;
+                appState.scene.materials[object].color =
+                    glm::vec3(appState.currentColor[0], appState.currentColor[1], appState.currentColor[2]);
+                appState.scene.markChanged();
+            }
+            std::cout << "Applied color to shape " << shapeIndex << std::endl;
+        }
+    }
+}
+
+// Function to get texture for a shape
+int ShapeMaterial::getShapeTexture(ShapeType shapeType, const ApplicationState& appState) {
+    if (shapeType != ShapeType::NONE) {
+        int shapeIndex = static_cast<int>(shapeType) - 1;
+        if (shapeIndex >= 0 && shapeIndex < 6) {
+            return appState.shapeTextures[shapeIndex];
+        }
+    }
+    return -1;
+}
+
+// Function to check if shape uses texture
+bool ShapeMaterial::shapeHasTexture(ShapeType shapeType, const ApplicationState& appState) {
+    if (shapeType != ShapeType::NONE) {
+        int shapeIndex = static_cast<int>(shapeType) - 1;
+        if (shapeIndex >= 0 && shapeIndex < 6) {
+            return appState.shapeUsesTexture[shapeIndex];
+        }
+    }
+    return false;
+}
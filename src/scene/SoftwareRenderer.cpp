@@ -0,0 +1,481 @@
+#include "../include/scene/SoftwareRenderer.hpp"
+#include "../include/geometry/PrimitiveGenerator.hpp"
+#include "../include/core/Timing.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    // Pixel-center offsets of the eight lanes of a span
+    alignas(32) const float LANE_OFFSETS[8] = {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f};
+
+    // Vertices are snapped to 1/256 pixel, as GL rasterizers do
+    const int SUBPIXEL_BITS = 8;
+    const int SUBPIXEL_MASK = (1 << SUBPIXEL_BITS) - 1;
+    const double SUBPIXEL_STEPS = 1 << SUBPIXEL_BITS;
+
+    // Rounds to the nearest subpixel; the offset keeps the truncation positive
+    int snapToSubpixel(float pixels) {
+        const double offset = 1 << 30;
+        return (int)((int64_t)(pixels * SUBPIXEL_STEPS + 0.5 + offset) - (int64_t)offset);
+    }
+
+    // Triangles reaching this many half-viewports past the screen are clipped,
+    // keeping screen coordinates small enough for float edge functions
+    const float GUARD_BAND = 8.0f;
+
+    // Clip planes as dot(plane, clip position) >= 0 inside
+    const glm::vec4 CLIP_PLANES[] = {
+        {0.0f, 0.0f, 1.0f, 1.0f},         // Near
+        {0.0f, 0.0f, -1.0f, 1.0f},        // Far
+        {-1.0f, 0.0f, 0.0f, GUARD_BAND},
+        {1.0f, 0.0f, 0.0f, GUARD_BAND},
+        {0.0f, -1.0f, 0.0f, GUARD_BAND},
+        {0.0f, 1.0f, 0.0f, GUARD_BAND},
+    };
+    const int CLIP_PLANE_COUNT = 6;
+    const int MAX_CLIP_VERTICES = 3 + CLIP_PLANE_COUNT;
+
+    uint8_t toByte(float value) {
+        return (uint8_t)std::lround(std::min(1.0f, std::max(0.0f, value)) * 255.0f);
+    }
+
+    uint32_t packColor(const glm::vec4& c) {
+        return (uint32_t)toByte(c.r) | (uint32_t)toByte(c.g) << 8 | (uint32_t)toByte(c.b) << 16 |
+               (uint32_t)toByte(c.a) << 24;
+    }
+
+    // glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) on RGBA8, alpha included
+    uint32_t blendOver(uint32_t source, uint32_t destination) {
+        uint32_t sourceAlpha = source >> 24;
+        if (sourceAlpha == 255) {
+            return source;
+        }
+        float alpha = sourceAlpha / 255.0f;
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            float s = ((source >> shift) & 0xFF) * alpha;
+            float d = ((destination >> shift) & 0xFF) * (1.0f - alpha);
+            result |= std::min(255u, (uint32_t)(s + d + 0.5f)) << shift;
+        }
+        return result;
+    }
+
+    // Bit k set when the position is outside the frustum side of plane k
+    uint32_t outcode(const glm::vec4& p) {
+        uint32_t code = 0;
+        if (p.z < -p.w) code |= 1;
+        if (p.z > p.w) code |= 2;
+        if (p.x > p.w) code |= 4;
+        if (p.x < -p.w) code |= 8;
+        if (p.y > p.w) code |= 16;
+        if (p.y < -p.w) code |= 32;
+        return code;
+    }
+
+    bool outsideGuardBand(const glm::vec4& p) {
+        float limit = GUARD_BAND * p.w;
+        return p.z < -p.w || p.z > p.w || std::fabs(p.x) > limit || std::fabs(p.y) > limit;
+    }
+}
+
+void SoftwareRenderer::resize(int newWidth, int newHeight) {
+    width = std::max(1, newWidth);
+    height = std::max(1, newHeight);
+    stride = (width + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE;
+    int rows = (height + TILE_SIZE - 1) / TILE_SIZE * TILE_SIZE;
+    tilesX = stride / TILE_SIZE;
+    tilesY = rows / TILE_SIZE;
+    color.assign((size_t)stride * rows, 0);
+    depth.resize((size_t)stride * rows / 8);
+    clear(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+}
+
+void SoftwareRenderer::clear(const glm::vec4& clearColor) {
+    std::fill(color.begin(), color.end(), packColor(clearColor));
+    for (DepthBlock& block : depth) {
+        std::fill(block.v, block.v + 8, 1.0f);
+    }
+}
+
+void SoftwareRenderer::render(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera,
+                              std::vector<int8_t>& lodLevels, ThreadPool& pool) {
+    queue.build(scene, objects, camera, height, lodLevels);
+    draw(scene, queue, camera, pool);
+}
+
+void SoftwareRenderer::draw(const Scene& scene, const RenderQueue& drawQueue, const Camera& camera, ThreadPool& pool) {
+    stats = Stats();
+    stats.draws = (uint32_t)drawQueue.size();
+    if (drawQueue.size() == 0 || width == 0) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    // Meshes are generated up front: the cache is not thread-safe. Sorted keys
+    // keep equal meshes together, so most draws reuse the previous lookup.
+    const std::vector<uint64_t>& keys = drawQueue.getKeys();
+    drawMeshes.resize(keys.size());
+    uint32_t lastMesh = 0;
+    const MeshData* last = nullptr;
+    for (size_t k = 0; k < keys.size(); ++k) {
+        uint32_t mesh = RenderQueue::meshOf(keys[k]);
+        if (last == nullptr || mesh != lastMesh) {
+            auto found = meshes.find(mesh);
+            if (found == meshes.end()) {
+                found = meshes.emplace(mesh, PrimitiveGenerator::generate(RenderQueue::paramsForMesh(mesh))).first;
+            }
+            last = &found->second;
+            lastMesh = mesh;
+        }
+        drawMeshes[k] = last;
+    }
+
+    // Several runs per thread so uneven draws still balance; each run keeps
+    // its own bins, and tiles replay the runs in order to keep draw order
+    size_t runCount = std::min(keys.size(), (size_t)pool.threadCount() * 8);
+    runs.resize(runCount);
+    for (RunScratch& run : runs) {
+        run.bins.resize((size_t)tilesX * tilesY);
+        for (std::vector<RasterTriangle>& bin : run.bins) {
+            bin.clear();
+        }
+        run.submitted = 0;
+        run.rasterized = 0;
+    }
+    glm::mat4 viewProjection = camera.viewProjection();
+    pool.parallelFor(runCount, [&](size_t index, unsigned) {
+        setupRun(scene, drawQueue, keys.size() * index / runCount, keys.size() * (index + 1) / runCount,
+                 viewProjection, runs[index]);
+    });
+    for (const RunScratch& run : runs) {
+        stats.triangles += run.submitted;
+        stats.rasterTriangles += run.rasterized;
+    }
+    stats.setupMs = Timing::millisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    pool.parallelFor((size_t)tilesX * tilesY, [this](size_t tile, unsigned) { rasterizeTile((int)tile); });
+    stats.rasterMs = Timing::millisecondsSince(start);
+}
+
+Image SoftwareRenderer::getImage() const {
+    Image image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize((size_t)width * height * 4);
+    for (int y = 0; y < height; ++y) {
+        const uint32_t* row = &color[(size_t)y * stride];
+        uint8_t* out = &image.pixels[(size_t)y * width * 4];
+        for (int x = 0; x < width; ++x) {
+            out[x * 4 + 0] = (uint8_t)(row[x]);
+            out[x * 4 + 1] = (uint8_t)(row[x] >> 8);
+            out[x * 4 + 2] = (uint8_t)(row[x] >> 16);
+            out[x * 4 + 3] = (uint8_t)(row[x] >> 24);
+        }
+    }
+    return image;
+}
+
+float SoftwareRenderer::depthAt(int x, int y) const {
+    size_t pixel = (size_t)y * stride + x;
+    return depth[pixel / 8].v[pixel % 8];
+}
+
+void SoftwareRenderer::setupRun(const Scene& scene, const RenderQueue& drawQueue, size_t begin, size_t end,
+                                const glm::mat4& viewProjection, RunScratch& run) {
+    const std::vector<uint64_t>& keys = drawQueue.getKeys();
+    const std::vector<uint32_t>& objects = drawQueue.getObjects();
+
+    for (size_t k = begin; k < end; ++k) {
+        uint32_t object = objects[k];
+        const MeshData& mesh = *drawMeshes[k];
+        glm::mat4 modelViewProjection = viewProjection * scene.worldMatrices[object];
+
+        // Textured draws are white modulated by the texture, as in GL
+        int texture = RenderQueue::textureOf(keys[k]);
+        if (texture >= (int)textures.size() || (texture >= 0 && textures[texture].empty())) {
+            texture = -1;
+        }
+        uint32_t drawColor = packColor(glm::vec4(scene.materials[object].color, 1.0f));
+
+        run.clip.resize(mesh.vertices.size());
+        for (size_t v = 0; v < mesh.vertices.size(); ++v) {
+            const Vertex& vertex = mesh.vertices[v];
+            run.clip[v].position = modelViewProjection * glm::vec4(vertex.position[0], vertex.position[1],
+                                                                   vertex.position[2], 1.0f);
+            run.clip[v].texCoord = glm::vec2(vertex.texCoord[0], vertex.texCoord[1]);
+        }
+
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            ClipVertex triangle[3] = {run.clip[mesh.indices[i]], run.clip[mesh.indices[i + 1]],
+                                      run.clip[mesh.indices[i + 2]]};
+            run.submitted++;
+            if (outcode(triangle[0].position) & outcode(triangle[1].position) & outcode(triangle[2].position)) {
+                continue;
+            }
+            if (!outsideGuardBand(triangle[0].position) && !outsideGuardBand(triangle[1].position) &&
+                !outsideGuardBand(triangle[2].position)) {
+                setupTriangle(triangle, drawColor, texture, run);
+                continue;
+            }
+
+            // Sutherland-Hodgman against the near, far and guard band planes
+            ClipVertex buffers[2][MAX_CLIP_VERTICES];
+            ClipVertex* input = buffers[0];
+            ClipVertex* output = buffers[1];
+            std::copy(triangle, triangle + 3, input);
+            int count = 3;
+            for (int p = 0; p < CLIP_PLANE_COUNT && count >= 3; ++p) {
+                const glm::vec4& plane = CLIP_PLANES[p];
+                int outCount = 0;
+                for (int v = 0; v < count; ++v) {
+                    const ClipVertex& a = input[v];
+                    const ClipVertex& b = input[(v + 1) % count];
+                    float da = glm::dot(plane, a.position);
+                    float db = glm::dot(plane, b.position);
+                    if (da >= 0.0f) {
+                        output[outCount++] = a;
+                    }
+                    if ((da >= 0.0f) != (db >= 0.0f)) {
+                        float t = da / (da - db);
+                        output[outCount].position = a.position + (b.position - a.position) * t;
+                        output[outCount].texCoord = a.texCoord + (b.texCoord - a.texCoord) * t;
+                        outCount++;
+                    }
+                }
+                std::swap(input, output);
+                count = outCount;
+            }
+            for (int v = 1; v + 1 < count; ++v) {
+                ClipVertex fan[3] = {input[0], input[v], input[v + 1]};
+                setupTriangle(fan, drawColor, texture, run);
+            }
+        }
+    }
+}
+
+void SoftwareRenderer::setupTriangle(const ClipVertex* vertices, uint32_t drawColor, int texture, RunScratch& run) {
+    // Window positions snapped to subpixels; the guard band keeps them well within int range
+    int sx[3], sy[3];
+    float z[3], inverseW[3], u[3], v[3];
+    for (int k = 0; k < 3; ++k) {
+        const glm::vec4& p = vertices[k].position;
+        inverseW[k] = 1.0f / p.w;
+        sx[k] = snapToSubpixel((p.x * inverseW[k] * 0.5f + 0.5f) * width);
+        sy[k] = snapToSubpixel((p.y * inverseW[k] * 0.5f + 0.5f) * height);
+        z[k] = p.z * inverseW[k] * 0.5f + 0.5f;
+        u[k] = vertices[k].texCoord.x * inverseW[k];
+        v[k] = vertices[k].texCoord.y * inverseW[k];
+    }
+
+    // Pixels whose centers can fall inside
+    RasterTriangle t;
+    t.minX = std::max(0, std::min(sx[0], std::min(sx[1], sx[2])) >> SUBPIXEL_BITS);
+    t.minY = std::max(0, std::min(sy[0], std::min(sy[1], sy[2])) >> SUBPIXEL_BITS);
+    t.maxX = std::min(width, (std::max(sx[0], std::max(sx[1], sx[2])) + SUBPIXEL_MASK) >> SUBPIXEL_BITS);
+    t.maxY = std::min(height, (std::max(sy[0], std::max(sy[1], sy[2])) + SUBPIXEL_MASK) >> SUBPIXEL_BITS);
+    if (t.minX >= t.maxX || t.minY >= t.maxY) {
+        return;
+    }
+
+    // Edge k runs between the other two vertices; relative to the bounds'
+    // corner so the float planes stay precise for small triangles
+    t.originX = t.minX;
+    t.originY = t.minY;
+    double rx[3], ry[3];
+    for (int k = 0; k < 3; ++k) {
+        rx[k] = (double)(sx[k] - (t.originX << SUBPIXEL_BITS)) / SUBPIXEL_STEPS;
+        ry[k] = (double)(sy[k] - (t.originY << SUBPIXEL_BITS)) / SUBPIXEL_STEPS;
+    }
+    double a[3], b[3], c[3];
+    for (int k = 0; k < 3; ++k) {
+        int from = (k + 1) % 3;
+        int to = (k + 2) % 3;
+        a[k] = -(ry[to] - ry[from]);
+        b[k] = rx[to] - rx[from];
+        c[k] = -(a[k] * rx[from] + b[k] * ry[from]);
+    }
+    double area = a[0] * rx[0] + b[0] * ry[0] + c[0];
+    if (area == 0.0) {
+        return;
+    }
+    // No face culling: clockwise triangles are flipped to count as front facing
+    if (area < 0.0) {
+        for (int k = 0; k < 3; ++k) {
+            a[k] = -a[k];
+            b[k] = -b[k];
+            c[k] = -c[k];
+        }
+        area = -area;
+    }
+
+    for (int k = 0; k < 3; ++k) {
+        t.edges[k] = {(float)a[k], (float)b[k], (float)c[k]};
+        // Top-left fill rule with y up: pixels on shared edges are drawn once
+        bool topLeft = a[k] > 0.0 || (a[k] == 0.0 && b[k] < 0.0);
+        t.thresholds[k] = topLeft ? 0.0f : FLT_MIN;
+    }
+
+    // Attribute planes from the barycentrics: edge k weighs vertex k
+    double inverseArea = 1.0 / area;
+    auto plane = [&](const float* values) {
+        return Plane{(float)((a[0] * values[0] + a[1] * values[1] + a[2] * values[2]) * inverseArea),
+                     (float)((b[0] * values[0] + b[1] * values[1] + b[2] * values[2]) * inverseArea),
+                     (float)((c[0] * values[0] + c[1] * values[1] + c[2] * values[2]) * inverseArea)};
+    };
+    t.depth = plane(z);
+    t.inverseW = plane(inverseW);
+    t.uOverW = plane(u);
+    t.vOverW = plane(v);
+    t.color = drawColor;
+    t.texture = texture;
+
+    run.rasterized++;
+    binTriangle(t, run);
+}
+
+void SoftwareRenderer::binTriangle(const RasterTriangle& t, RunScratch& run) {
+    int tileX0 = t.minX / TILE_SIZE;
+    int tileY0 = t.minY / TILE_SIZE;
+    int tileX1 = (t.maxX - 1) / TILE_SIZE;
+    int tileY1 = (t.maxY - 1) / TILE_SIZE;
+    for (int ty = tileY0; ty <= tileY1; ++ty) {
+        for (int tx = tileX0; tx <= tileX1; ++tx) {
+            run.bins[(size_t)ty * tilesX + tx].push_back(t);
+        }
+    }
+}
+
+void SoftwareRenderer::rasterizeTile(int tile) {
+    int x0 = (tile % tilesX) * TILE_SIZE;
+    int y0 = (tile / tilesX) * TILE_SIZE;
+    for (const RunScratch& run : runs) {
+        for (const RasterTriangle& triangle : run.bins[tile]) {
+            rasterizeTriangle(triangle, x0, y0, x0 + TILE_SIZE, y0 + TILE_SIZE);
+        }
+    }
+}
+
+void SoftwareRenderer::rasterizeTriangle(const RasterTriangle& t, int x0, int y0, int x1, int y1) {
+    // Spans start on a multiple of eight so they line up with the depth blocks
+    int startX = std::max(x0, t.minX) & ~7;
+    int endX = std::min(x1, t.maxX);
+    int startY = std::max(y0, t.minY);
+    int endY = std::min(y1, t.maxY);
+
+    Float8 offsets = Float8::load(LANE_OFFSETS);
+    Float8 edgeA[3], thresholds[3];
+    for (int k = 0; k < 3; ++k) {
+        edgeA[k] = Float8::broadcast(t.edges[k].a);
+        thresholds[k] = Float8::broadcast(t.thresholds[k]);
+    }
+    Float8 depthA = Float8::broadcast(t.depth.a);
+    bool wide = endX - startX > 16;
+    float inverseA[3];
+    for (int k = 0; k < 3; ++k) {
+        inverseA[k] = wide && t.edges[k].a != 0.0f ? 1.0f / t.edges[k].a : 0.0f;
+    }
+    bool textured = t.texture >= 0;
+    const Image* image = textured ? &textures[t.texture] : nullptr;
+
+    for (int y = startY; y < endY; ++y) {
+        float py = (float)(y - t.originY) + 0.5f;
+        Float8 rowEdge[3];
+        float rowMin = (float)startX;
+        float rowMax = (float)endX;
+        for (int k = 0; k < 3; ++k) {
+            float edgeRow = t.edges[k].b * py + t.edges[k].c;
+            rowEdge[k] = Float8::broadcast(edgeRow);
+            // On wide triangles, narrow the row to where the edges cross it, a
+            // pixel wider for rounding; the SIMD test still decides every pixel
+            if (wide) {
+                float crossing = t.originX - 0.5f - edgeRow * inverseA[k];
+                if (t.edges[k].a > 0.0f) {
+                    rowMin = std::max(rowMin, crossing - 1.0f);
+                } else if (t.edges[k].a < 0.0f) {
+                    rowMax = std::min(rowMax, crossing + 2.0f);
+                }
+            }
+        }
+        if (rowMin >= rowMax) {
+            continue;
+        }
+        int rowStart = std::max(startX, (int)rowMin & ~7);
+        int rowEnd = std::min(endX, (int)rowMax);
+        Float8 rowDepth = Float8::broadcast(t.depth.b * py + t.depth.c);
+
+        for (int x = rowStart; x < rowEnd; x += 8) {
+            Float8 px = Float8::broadcast((float)(x - t.originX)) + offsets;
+            Float8 inside = (thresholds[0] <= edgeA[0] * px + rowEdge[0]) &
+                            (thresholds[1] <= edgeA[1] * px + rowEdge[1]) &
+                            (thresholds[2] <= edgeA[2] * px + rowEdge[2]);
+            if (inside.mask() == 0) {
+                continue;
+            }
+
+            size_t pixel = (size_t)y * stride + x;
+            float* block = depth[pixel / 8].v;
+            Float8 current = Float8::load(block);
+            Float8 fragment = depthA * px + rowDepth;
+            Float8 pass = inside & (fragment < current);
+            int mask = pass.mask();
+            if (mask == 0) {
+                continue;
+            }
+            select(pass, fragment, current).store(block);
+
+            uint32_t* out = &color[pixel];
+            if (!textured) {
+                // Selects rather than branches: partial masks are unpredictable
+                for (int lane = 0; lane < 8; ++lane) {
+                    out[lane] = (mask >> lane) & 1 ? t.color : out[lane];
+                }
+                continue;
+            }
+
+            // Perspective-correct coordinates: interpolate u/w, v/w and 1/w, then divide
+            Float8 w = Float8::broadcast(1.0f) /
+                       (Float8::broadcast(t.inverseW.a) * px + Float8::broadcast(t.inverseW.b * py + t.inverseW.c));
+            alignas(32) float u[8];
+            alignas(32) float v[8];
+            ((Float8::broadcast(t.uOverW.a) * px + Float8::broadcast(t.uOverW.b * py + t.uOverW.c)) * w).store(u);
+            ((Float8::broadcast(t.vOverW.a) * px + Float8::broadcast(t.vOverW.b * py + t.vOverW.c)) * w).store(v);
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) {
+                    out[lane] = blendOver(sampleTexture(*image, u[lane], v[lane]), out[lane]);
+                }
+            }
+        }
+    }
+}
+
+uint32_t SoftwareRenderer::sampleTexture(const Image& image, float u, float v) const {
+    // GL_LINEAR with GL_REPEAT: texel centers at half coordinates
+    float fx = u * image.width - 0.5f;
+    float fy = v * image.height - 0.5f;
+    float floorX = std::floor(fx);
+    float floorY = std::floor(fy);
+    float wx = fx - floorX;
+    float wy = fy - floorY;
+    int ix0 = (int)floorX % image.width;
+    int iy0 = (int)floorY % image.height;
+    if (ix0 < 0) ix0 += image.width;
+    if (iy0 < 0) iy0 += image.height;
+    int ix1 = ix0 + 1 == image.width ? 0 : ix0 + 1;
+    int iy1 = iy0 + 1 == image.height ? 0 : iy0 + 1;
+
+    const uint8_t* p00 = &image.pixels[((size_t)iy0 * image.width + ix0) * 4];
+    const uint8_t* p10 = &image.pixels[((size_t)iy0 * image.width + ix1) * 4];
+    const uint8_t* p01 = &image.pixels[((size_t)iy1 * image.width + ix0) * 4];
+    const uint8_t* p11 = &image.pixels[((size_t)iy1 * image.width + ix1) * 4];
+    uint32_t result = 0;
+    for (int channel = 0; channel < 4; ++channel) {
+        float top = p00[channel] + (p10[channel] - p00[channel]) * wx;
+        float bottom = p01[channel] + (p11[channel] - p01[channel]) * wx;
+        float value = top + (bottom - top) * wy;
+        result |= (uint32_t)(value + 0.5f) << (channel * 8);
+    }
+    return result;
+}
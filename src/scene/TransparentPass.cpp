@@ -0,0 +1,116 @@
+#include "../include/scene/TransparentPass.hpp"
+#include "../include/geometry/MeshOptimizer.hpp"
+#include "../include/scene/LodSelector.hpp"
+#include "../include/scene/RenderQueue.hpp"
+#include "../include/core/Timing.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    const size_t KEY_CHUNK = 4096;
+    const uint64_t DEPTH_MAX = 0xffffffffull;
+
+    uint32_t meshKey(const Scene& scene, uint32_t object, const std::vector<int8_t>& lodLevels) {
+        int level = LodSelector::usesLod(scene.shapes[object]) ? lodLevels[object] : -1;
+        return ((uint32_t)scene.shapes[object] << 4) | (uint32_t)((level + 1) & 0xf);
+    }
+}
+
+uint32_t TransparentPass::quantizeDepth(float viewDepth, float nearPlane, float farPlane) {
+    float t = (viewDepth - nearPlane) / (farPlane - nearPlane);
+    t = std::min(std::max(t, 0.0f), 1.0f);
+    return (uint32_t)((double)t * (double)DEPTH_MAX);
+}
+
+void TransparentPass::build(const Scene& scene, const std::vector<uint32_t>& objects, const Camera& camera,
+                            int viewportHeightPx, std::vector<int8_t>& lodLevels, ThreadPool& pool) {
+    auto start = std::chrono::steady_clock::now();
+    opaque.clear();
+    transparent.clear();
+    meshes.clear();
+    sortedIndices.clear();
+    stats = Stats();
+
+    for (uint32_t i : objects) {
+        if (!(scene.flags[i] & ObjectFlags::VISIBLE) || scene.shapes[i] == ShapeType::NONE) {
+            continue;
+        }
+        (isTransparent(scene, i) ? transparent : opaque).push_back(i);
+    }
+    if (transparent.empty()) {
+        return;
+    }
+
+    // Far-to-near keys, so the ascending sort yields back to front
+    glm::mat4 view = camera.view();
+    glm::vec3 viewRow(view[0][2], view[1][2], view[2][2]);
+    keys.resize(transparent.size());
+    size_t chunks = (transparent.size() + KEY_CHUNK - 1) / KEY_CHUNK;
+    pool.parallelFor(chunks, [&](size_t chunk, unsigned) {
+        size_t end = std::min(transparent.size(), (chunk + 1) * KEY_CHUNK);
+        for (size_t k = chunk * KEY_CHUNK; k < end; ++k) {
+            uint32_t i = transparent[k];
+            LodSelector::selectForObject(scene, i, camera, viewportHeightPx, lodLevels);
+            float viewZ = glm::dot(viewRow, glm::vec3(scene.worldMatrices[i][3])) + view[3][2];
+            keys[k] = DEPTH_MAX - quantizeDepth(-viewZ, camera.nearPlane, camera.farPlane);
+        }
+    });
+    sorter.sort(keys, transparent, pool);
+
+    meshes.resize(transparent.size());
+    for (size_t k = 0; k < transparent.size(); ++k) {
+        meshes[k] = meshKey(scene, transparent[k], lodLevels);
+    }
+    stats.objects = (uint32_t)transparent.size();
+
+    if (transparent.size() == 1) {
+        sortTriangles(scene, transparent[0], meshes[0], camera, pool);
+    }
+    stats.sortMs = Timing::millisecondsSince(start);
+}
+
+void TransparentPass::sortTriangles(const Scene& scene, uint32_t object, uint32_t meshBits, const Camera& camera,
+                                    ThreadPool& pool) {
+    const MeshData& mesh = meshFor(meshBits);
+    size_t triangleCount = mesh.indices.size() / 3;
+    if (triangleCount < TRIANGLE_SORT_MIN) {
+        return;
+    }
+
+    // Centroid depth per triangle; a third of the summed view z is enough to order them
+    glm::mat4 modelView = camera.view() * scene.worldMatrices[object];
+    glm::vec3 viewRow(modelView[0][2], modelView[1][2], modelView[2][2]);
+    float viewOffset = modelView[3][2];
+    keys.resize(triangleCount);
+    triangleOrder.resize(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        float z = 0.0f;
+        for (int corner = 0; corner < 3; ++corner) {
+            const float* p = mesh.vertices[mesh.indices[t * 3 + corner]].position;
+            z += glm::dot(viewRow, glm::vec3(p[0], p[1], p[2]));
+        }
+        keys[t] = DEPTH_MAX - quantizeDepth(-(z / 3.0f + viewOffset), camera.nearPlane, camera.farPlane);
+        triangleOrder[t] = (uint32_t)t;
+    }
+    sorter.sort(keys, triangleOrder, pool);
+
+    sortedIndices.resize(triangleCount * 3);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* source = &mesh.indices[triangleOrder[t] * 3];
+        sortedIndices[t * 3] = source[0];
+        sortedIndices[t * 3 + 1] = source[1];
+        sortedIndices[t * 3 + 2] = source[2];
+    }
+    stats.sortedTriangles = (uint32_t)triangleCount;
+}
+
+const MeshData& TransparentPass::meshFor(uint32_t mesh) {
+    auto it = meshData.find(mesh);
+    if (it == meshData.end()) {
+        // Optimized like MeshCache's upload, so indices address the resident vertices
+        MeshData data = PrimitiveGenerator::generate(RenderQueue::paramsForMesh(mesh));
+        MeshOptimizer::optimize(data);
+        it = meshData.emplace(mesh, std::move(data)).first;
+    }
+    return it->second;
+}
@@ -1,5 +1,14 @@
+#include "../include/rendering/MeshCache.hpp"
 #include "../include/ui/Panels.hpp"
+#include "../include/ui/UiLayout.hpp"
+#include "../include/rendering/IconAtlas.hpp"
 #include "../include/rendering/PrimitiveRenderer.hpp"
+#include "../include/rendering/ShaderRenderer.hpp"
+#include "../include/rendering/TextRenderer.hpp"
+#include "../include/rendering/UiLayer.hpp"
+#include "../include/scene/SceneEditor.hpp"
+#include "../include/scene/LodSelector.hpp"
+#include "../include/scene/ShapeMaterial.hpp"
 #include "../include/core/Constants.hpp"
 #include <iostream>
 #include <algorithm>
@@ -7,6 +16,7 @@
 #include <cmath>
 #include <sstream>
 #include <iomanip>
+#include <vector>
 
 // Add this new function to handle color button clicks
 void handleColorButtonClick(int colorIndex, ApplicationState& state) {
@@ -45,812 +55,238 @@ void handleColorButtonClick(int colorIndex, ApplicationState& state) {
 
     // NEW: Apply color to current shape (remove texture)
     if (state.currentShape != ShapeType::NONE) {
-        PrimitiveRenderer::applyColorToShape(state.currentShape, state);
+        ShapeMaterial::applyColorToShape(state.currentShape, state);
         std::cout << "Color changed to button " << colorIndex << " and applied to current shape" << std::endl;
     } else {
         std::cout << "Color changed to button " << colorIndex << " (no shape selected)" << std::endl;
     }
 }
 
-void Panels::drawTopBarUI(int width, int height, ApplicationState& appState) {
-    float marginPx = 10.0f;
-    float marginX = PrimitiveRenderer::pxToNDCx((int)marginPx, width);
-    float topBarY2 = 1.0f;
-
-    float blenderWpx = 120.0f;
-    float blenderHpx = 48.0f;
-    float blenderX1 = -1.0f + marginX;
-    float blenderX2 = blenderX1 + PrimitiveRenderer::pxToNDCx((int)blenderWpx, width);
-    float blenderH = PrimitiveRenderer::pxToNDCy((int)blenderHpx, height);
-    float blenderY2 = topBarY2 - PrimitiveRenderer::pxToNDCy(8, height);
-    float blenderY1 = blenderY2 - blenderH;
-
-    PrimitiveRenderer::drawRect(blenderX1, blenderY1, blenderX2, blenderY2, 0.38f, 0.38f, 0.38f);
-    PrimitiveRenderer::drawOutlineRect(blenderX1, blenderY1, blenderX2, blenderY2, 0.0f, 0.0f, 0.0f, 2.0f);
-
-    glColor3f(1.0f, 0.0f, 0.0f);
-    float textX = (blenderX1 + blenderX2) * 0.5f - 0.06f;
-    float textY = (blenderY1 + blenderY2) * 0.5f - 0.01f;
-    PrimitiveRenderer::drawText("Blender Lite", textX, textY, GLUT_BITMAP_HELVETICA_18);
+namespace {
+    const char* SHAPE_LABELS[6] = {"Cube", "Sphere", "Cone", "Cylinder", "Torus", "Pyramid"};
+    const int SHAPE_LABEL_INSETS[6] = {20, 20, 25, 15, 25, 20}; // Pixels from a button's left edge
+    const char* TRANSFORM_TITLES[3] = {"Rotation", "Scaling", "Translate"};
+    const char AXIS_NAMES[3] = {'X', 'Y', 'Z'};
 
-    float groupX1 = blenderX2 + marginX;
-    float groupX2 = groupX1 + PrimitiveRenderer::pxToNDCx((int)(140), width);
-
-    float buttonHpx = 28.0f;
-    float saveH = PrimitiveRenderer::pxToNDCy((int)buttonHpx, height);
-    float gapV = PrimitiveRenderer::pxToNDCy(6, height);
-    float save1Y2 = blenderY2;
-    float save1Y1 = save1Y2 - saveH;
-    float save2Y2 = save1Y1 - gapV;
-    float save2Y1 = save2Y2 - saveH;
-
-    bool hoverSave = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, groupX1, save1Y1, groupX2, save1Y2);
-    PrimitiveRenderer::drawRect(groupX1, save1Y1, groupX2, save1Y2, 0.32f + (hoverSave ? 0.08f : 0.0f), 0.32f + (hoverSave ? 0.08f : 0.0f), 0.32f + (hoverSave ? 0.08f : 0.0f));
-    PrimitiveRenderer::drawOutlineRect(groupX1, save1Y1, groupX2, save1Y2, 0,0,0,1.5f);
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("Save", groupX1 + 0.02f, (save1Y1 + save1Y2) * 0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
-
-    bool hoverSaveAs = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, groupX1, save2Y1, groupX2, save2Y2);
-    PrimitiveRenderer::drawRect(groupX1, save2Y1, groupX2, save2Y2, 0.32f + (hoverSaveAs ? 0.08f : 0.0f), 0.32f + (hoverSaveAs ? 0.08f : 0.0f), 0.32f + (hoverSaveAs ? 0.08f : 0.0f));
-    PrimitiveRenderer::drawOutlineRect(groupX1, save2Y1, groupX2, save2Y2, 0,0,0,1.5f);
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("Save as", groupX1 + 0.01f, (save2Y1 + save2Y2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
-
-    float underY2 = save2Y1 - gapV - 0.0f;
-    float underH = saveH;
-    float underY1 = underY2 - underH;
-    float halfW = (groupX2 - groupX1 - marginX) * 0.5f;
-    float undoX1 = groupX1;
-    float undoX2 = groupX1 + halfW - marginX*0.5f;
-    float redoX1 = undoX2 + marginX*0.5f;
-    float redoX2 = groupX2;
-
-    bool hoverUndo = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, undoX1, underY1, undoX2, underY2);
-    bool hoverRedo = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, redoX1, underY1, redoX2, underY2);
-
-    PrimitiveRenderer::drawRect(undoX1, underY1, undoX2, underY2, 0.32f + (hoverUndo ? 0.08f : 0.0f), 0.32f + (hoverUndo ? 0.08f : 0.0f), 0.32f + (hoverUndo ? 0.08f : 0.0f));
-    PrimitiveRenderer::drawOutlineRect(undoX1, underY1, undoX2, underY2, 0,0,0,1.0f);
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("Undo", undoX1 + 0.01f, (underY1 + underY2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
-
-    PrimitiveRenderer::drawRect(redoX1, underY1, redoX2, underY2, 0.32f + (hoverRedo ? 0.08f : 0.0f), 0.32f + (hoverRedo ? 0.08f : 0.0f), 0.32f + (hoverRedo ? 0.08f : 0.0f));
-    PrimitiveRenderer::drawOutlineRect(redoX1, underY1, redoX2, underY2, 0,0,0,1.0f);
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("Redo", redoX1 + 0.01f, (underY1 + underY2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
-
-    float centerWpx = 300.0f;
-    float centerX1 = -PrimitiveRenderer::pxToNDCx((int)(centerWpx/2), width);
-    float centerX2 = PrimitiveRenderer::pxToNDCx((int)(centerWpx/2), width);
-
-    float pnameHpx = 20.0f;
-    float pnameH = PrimitiveRenderer::pxToNDCy((int)pnameHpx, height);
-    float pnameY2 = blenderY2;
-    float pnameY1 = pnameY2 - pnameH - PrimitiveRenderer::pxToNDCy(6, height);
-    PrimitiveRenderer::drawRect(centerX1, pnameY1, centerX2, pnameY2, 0.9f, 0.9f, 0.9f);
-    PrimitiveRenderer::drawOutlineRect(centerX1, pnameY1, centerX2, pnameY2, 0,0,0,1.0f);
-    glColor3f(0.2f,0.2f,0.2f);
-    PrimitiveRenderer::drawText("Project Name", centerX1 + 0.03f, (pnameY1 + pnameY2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
-
-    float npWpx = 150.0f;
-    float npX1 = -PrimitiveRenderer::pxToNDCx((int)(npWpx/2), width);
-    float npX2 = PrimitiveRenderer::pxToNDCx((int)(npWpx/2), width);
-    float npH = PrimitiveRenderer::pxToNDCy((int)buttonHpx, height);
-    float npY2 = pnameY1 - PrimitiveRenderer::pxToNDCy(8, height);
-    float npY1 = npY2 - npH;
-    bool hoverNewProj = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, npX1, npY1, npX2, npY2);
-    PrimitiveRenderer::drawRect(npX1, npY1, npX2, npY2, 0.32f + (hoverNewProj ? 0.08f : 0.0f), 0.32f + (hoverNewProj ? 0.08f : 0.0f), 0.32f + (hoverNewProj ? 0.08f : 0.0f));
-    PrimitiveRenderer::drawOutlineRect(npX1, npY1, npX2, npY2, 0,0,0,1.0f);
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("New Project", npX1 + 0.01f, (npY1 + npY2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
-
-    float camSizePx = 48.0f;
-    float camSize = PrimitiveRenderer::pxToNDCx((int)camSizePx, width);
-    float camX2 = 1.0f - PrimitiveRenderer::pxToNDCx(50, width);
-    float camX1 = camX2 - camSize;
-    float camY2 = blenderY2;
-    float camY1 = camY2 - PrimitiveRenderer::pxToNDCy((int)camSizePx, height);
-    bool hoverCam = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, camX1, camY1, camX2, camY2);
-    float camExpandPx = hoverCam ? 6.0f : 0.0f;
-    float camEx = PrimitiveRenderer::pxToNDCx((int)camExpandPx, width);
-
-    PrimitiveRenderer::drawRect(camX1 - camEx, camY1 - camEx, camX2 + camEx, camY2 + camEx, 0.3f, 0.3f, 0.3f);
-    PrimitiveRenderer::drawOutlineRect(camX1 - camEx, camY1 - camEx, camX2 + camEx, camY2 + camEx, 0,0,0,1.0f);
-
-    float camCx = (camX1 + camX2) * 0.5f;
-    float camCy = (camY1 + camY2) * 0.5f;
-    PrimitiveRenderer::drawCircle(camCx, camCy, std::min(camSize, PrimitiveRenderer::pxToNDCy((int)camSizePx, height)) * 0.25f + (hoverCam ? camEx*0.5f : 0.0f), 30, 0.12f, 0.12f, 0.12f);
-
-    glColor3f(1,1,1);
-    float textLine1Y = camY1 - PrimitiveRenderer::pxToNDCy(14, height);
-    float textLine2Y = textLine1Y - PrimitiveRenderer::pxToNDCy(22, height);
-    PrimitiveRenderer::drawText("Take a", camCx - 0.05f, textLine1Y, GLUT_BITMAP_HELVETICA_12);
-    PrimitiveRenderer::drawText("Screenshot", camCx - 0.09f, textLine2Y, GLUT_BITMAP_HELVETICA_12);
+    // The vector a transform panel edits, by ActiveInputField::panelType
+    float* transformValues(ApplicationState& state, int panel) {
+        return panel == 0 ? state.rotate : panel == 1 ? state.scale : state.translate;
+    }
 
-    float colorsPanelWpx = 220.0f;
-    float colorsPanelHpx = 80.0f;
-    float colorsPanelW = PrimitiveRenderer::pxToNDCx((int)colorsPanelWpx, width);
-    float colorsPanelH = PrimitiveRenderer::pxToNDCy((int)colorsPanelHpx, height);
+    // A gray top bar button, lighter under the cursor, labeled textInset from its left edge
+    void drawTopBarButton(UiLayout::WidgetType type, const char* label, float textInset, float outlineWidth) {
+        const UiLayout::Rect& button = UiLayout::get(type).rect;
+        float shade = 0.32f + (UiLayout::isHovered(type) ? 0.08f : 0.0f);
+        PrimitiveRenderer::drawRect(button.x1, button.y1, button.x2, button.y2, shade, shade, shade);
+        PrimitiveRenderer::drawOutlineRect(button.x1, button.y1, button.x2, button.y2, 0,0,0,outlineWidth);
+        PrimitiveRenderer::setTextColor(1,1,1);
+        PrimitiveRenderer::drawText(label, button.x1 + textInset, (button.y1 + button.y2) * 0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
+    }
 
-    float projectNameRight = centerX2;
-    float cameraLeft = camX1;
-    float colorsX1 = projectNameRight + PrimitiveRenderer::pxToNDCx(10, width);
-    float colorsX2 = colorsX1 + colorsPanelW;
+    // A side panel's scroll bar, when UiLayout gave it one
+    void drawScrollBar(int index) {
+        if (UiLayout::find(UiLayout::SCROLL_TRACK, index) < 0) {
+            return;
+        }
+        const UiLayout::Rect& track = UiLayout::get(UiLayout::SCROLL_TRACK, index).rect;
+        const UiLayout::Rect& thumb = UiLayout::get(UiLayout::SCROLL_THUMB, index).rect;
+        PrimitiveRenderer::drawRect(track.x1, track.y1, track.x2, track.y2, 0.3f, 0.3f, 0.3f);
+        PrimitiveRenderer::drawRect(thumb.x1, thumb.y1, thumb.x2, thumb.y2, 0.6f, 0.6f, 0.6f);
+    }
 
-    if (colorsX2 > cameraLeft - PrimitiveRenderer::pxToNDCx(10, width)) {
-        colorsX2 = cameraLeft - PrimitiveRenderer::pxToNDCx(10, width);
-        colorsX1 = colorsX2 - colorsPanelW;
+    // Clips to a panel, using the size it was laid out with like the panel's own rect
+    void clipToPanel(const UiLayout::Widget& panel, int width, int height) {
+        int panelXPx = (int)((panel.rect.x1 + 1.0f) * 0.5f * width);
+        int panelYPx = (int)((1.0f - panel.rect.y2) * 0.5f * height);
+        int panelWidthPx = (int)(panel.width * 0.5f * width);
+        int panelHeightPx = (int)(panel.height * 0.5f * height);
+        PrimitiveRenderer::setScissor(panelXPx, panelYPx, panelWidthPx, panelHeightPx, height);
     }
+}
 
-    float colorsY2 = topBarY2 - PrimitiveRenderer::pxToNDCy(8, height);
-    float colorsY1 = colorsY2 - colorsPanelH;
+void Panels::drawTopBarUI(int width, int height) {
+    const UiLayout::Rect& logo = UiLayout::get(UiLayout::LOGO).rect;
+    PrimitiveRenderer::drawRect(logo.x1, logo.y1, logo.x2, logo.y2, 0.38f, 0.38f, 0.38f);
+    PrimitiveRenderer::drawOutlineRect(logo.x1, logo.y1, logo.x2, logo.y2, 0.0f, 0.0f, 0.0f, 2.0f);
 
-    PrimitiveRenderer::drawRect(colorsX1, colorsY1, colorsX2, colorsY2, 0.4f, 0.4f, 0.4f);
-    PrimitiveRenderer::drawOutlineRect(colorsX1, colorsY1, colorsX2, colorsY2, 0, 0, 0, 2.0f);
+    PrimitiveRenderer::setTextColor(1.0f, 0.0f, 0.0f);
+    float textX = (logo.x1 + logo.x2) * 0.5f - 0.06f;
+    float textY = (logo.y1 + logo.y2) * 0.5f - 0.01f;
+    PrimitiveRenderer::drawText("Blender Lite", textX, textY, GLUT_BITMAP_HELVETICA_18);
 
-    glColor3f(1, 1, 1);
-    PrimitiveRenderer::drawText("Colors", colorsX1 + 0.02f, colorsY2 - PrimitiveRenderer::pxToNDCy(18, height), GLUT_BITMAP_HELVETICA_12);
+    drawTopBarButton(UiLayout::SAVE_BUTTON, "Save", 0.02f, 1.5f);
+    drawTopBarButton(UiLayout::SAVE_AS_BUTTON, "Save as", 0.01f, 1.5f);
+    drawTopBarButton(UiLayout::UNDO_BUTTON, "Undo", 0.01f, 1.0f);
+    drawTopBarButton(UiLayout::REDO_BUTTON, "Redo", 0.01f, 1.0f);
 
-    int numColors = 6;
-    float swatchPx = 20.0f;
-    float swatchGapPx = 5.0f;
-    float swatchSize = PrimitiveRenderer::pxToNDCx((int)swatchPx, width);
-    float swatchGap = PrimitiveRenderer::pxToNDCx((int)swatchGapPx, width);
-    float startSwX = colorsX1 + PrimitiveRenderer::pxToNDCx(10, width);
-    float swYTop = colorsY2 - PrimitiveRenderer::pxToNDCy(30, height);
-    float swYBottom = swYTop - swatchSize;
+    const UiLayout::Rect& projectName = UiLayout::get(UiLayout::PROJECT_NAME).rect;
+    PrimitiveRenderer::drawRect(projectName.x1, projectName.y1, projectName.x2, projectName.y2, 0.9f, 0.9f, 0.9f);
+    PrimitiveRenderer::drawOutlineRect(projectName.x1, projectName.y1, projectName.x2, projectName.y2, 0,0,0,1.0f);
+    PrimitiveRenderer::setTextColor(0.2f,0.2f,0.2f);
+    PrimitiveRenderer::drawText("Project Name", projectName.x1 + 0.03f, (projectName.y1 + projectName.y2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_18);
 
-    // Define colors for the buttons
-    struct Color { float r, g, b; };
-    Color colorArr[6] = {{0,0,0}, {1,1,1}, {1,0,0}, {0,1,0}, {0,0,1}, {1,0,1}};
+    drawTopBarButton(UiLayout::NEW_PROJECT_BUTTON, "New Project", 0.01f, 1.0f);
 
-    // Track hover states for color buttons
-    bool colorHovered[6] = {false};
-
-    for (int i = 0; i < numColors; i++) {
-        float sx1 = startSwX + i * (swatchSize + swatchGap);
-        float sx2 = sx1 + swatchSize;
-        bool hover = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, sx1, swYBottom, sx2, swYTop);
-        colorHovered[i] = hover;
-        float expandPx = hover ? 2.0f : 0.0f;
-        float ex = PrimitiveRenderer::pxToNDCx((int)expandPx, width);
-        PrimitiveRenderer::drawRect(sx1 - ex, swYBottom - ex, sx2 + ex, swYTop + ex, colorArr[i].r, colorArr[i].g, colorArr[i].b);
-        PrimitiveRenderer::drawOutlineRect(sx1 - ex, swYBottom - ex, sx2 + ex, swYTop + ex, 0, 0, 0, 1.0f);
-
-        // Handle color button clicks
-        if (hover && appState.mouseClicked) {
-            handleColorButtonClick(i, appState);
-        }
-    }
+    // The camera button grows under the cursor
+    const UiLayout::Widget& camera = UiLayout::get(UiLayout::CAMERA_BUTTON);
+    const UiLayout::Rect& cam = camera.rect;
+    bool hoverCam = UiLayout::isHovered(UiLayout::CAMERA_BUTTON);
+    float camEx = PrimitiveRenderer::pxToNDCx(hoverCam ? 6 : 0, width);
 
-    float vBtnPx = 22.0f;
-    float vW = PrimitiveRenderer::pxToNDCx((int)vBtnPx, width);
-    float vX1 = startSwX;
-    float vX2 = vX1 + vW;
-    float vY2 = swYBottom - PrimitiveRenderer::pxToNDCy(5, height);
-    float vY1 = vY2 - PrimitiveRenderer::pxToNDCy((int)vBtnPx, height);
-    bool hoverV = PrimitiveRenderer::isInsideNDC(appState.mouseX, appState.mouseY, width, height, vX1, vY1, vX2, vY2);
-    PrimitiveRenderer::drawRect(vX1, vY1, vX2, vY2, hoverV ? 0.6f : 0.25f, hoverV ? 0.6f : 0.25f, hoverV ? 0.6f : 0.25f);
-    PrimitiveRenderer::drawOutlineRect(vX1, vY1, vX2, vY2, 0, 0, 0, 1.0f);
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("V", vX1 + 0.005f, (vY1 + vY2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_12);
-
-    float shadesWpx = 80.0f;
-    float shadesHpx = 22.0f;
-    float shadesW = PrimitiveRenderer::pxToNDCx((int)shadesWpx, width);
-    float shadesH = PrimitiveRenderer::pxToNDCy((int)shadesHpx, height);
-    float shadesX1 = vX2 + PrimitiveRenderer::pxToNDCx(5, width);
-    float shadesX2 = shadesX1 + shadesW;
-    float shadesY2 = vY2;
-    float shadesY1 = vY2 - shadesH;
-    PrimitiveRenderer::drawRect(shadesX1, shadesY1, shadesX2, shadesY2, 0.3f, 0.3f, 0.3f);
-    PrimitiveRenderer::drawOutlineRect(shadesX1, shadesY1, shadesX2, shadesY2, 0, 0, 0, 1.0f);
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("Shades", shadesX1 + 0.01f, (shadesY1 + shadesY2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_12);
-}
+    PrimitiveRenderer::drawRect(cam.x1 - camEx, cam.y1 - camEx, cam.x2 + camEx, cam.y2 + camEx, 0.3f, 0.3f, 0.3f);
+    PrimitiveRenderer::drawOutlineRect(cam.x1 - camEx, cam.y1 - camEx, cam.x2 + camEx, cam.y2 + camEx, 0,0,0,1.0f);
 
-void Panels::drawTransformPanel(float panelX1, float panelY1, float panelWidth, float panelHeight,
-                               const std::string& title, float values[3],
-                               ApplicationState& state, int width, int height) {
-    PrimitiveRenderer::drawRect(panelX1, panelY1, panelX1 + panelWidth, panelY1 + panelHeight, 0.4f, 0.4f, 0.4f);
-    PrimitiveRenderer::drawOutlineRect(panelX1, panelY1, panelX1 + panelWidth, panelY1 + panelHeight, 0.0f, 0.0f, 0.0f, 2.0f);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText(title, panelX1 + PrimitiveRenderer::pxToNDCx(10, width), panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(25, height), GLUT_BITMAP_HELVETICA_18);
-    PrimitiveRenderer::drawText("Vector", panelX1 + PrimitiveRenderer::pxToNDCx(15, width), panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(45, height), GLUT_BITMAP_HELVETICA_12);
-
-    float inputBoxHeight = PrimitiveRenderer::pxToNDCy(25, height);
-    float inputBoxWidth = panelWidth - PrimitiveRenderer::pxToNDCx(30, width);
-    float inputY = panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(70, height);
-
-    // Determine panel type for input field identification
-    int panelType = -1;
-    if (title == "Rotation") panelType = 0;
-    else if (title == "Scaling") panelType = 1;
-    else if (title == "Translate") panelType = 2;
-
-    // X input box
-    float xBoxX1 = panelX1 + PrimitiveRenderer::pxToNDCx(15, width);
-    float xBoxX2 = xBoxX1 + inputBoxWidth;
-    float xBoxY1 = inputY - inputBoxHeight;
-    float xBoxY2 = inputY;
-
-    bool isXActive = (state.activeInputField.panelType == panelType && state.activeInputField.axis == 0);
-    bool hoverX = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, xBoxX1, xBoxY1, xBoxX2, xBoxY2);
-
-    // Draw input box with different color if active or hovered
-    if (isXActive) {
-        PrimitiveRenderer::drawRect(xBoxX1, xBoxY1, xBoxX2, xBoxY2, 0.7f, 0.7f, 0.9f);
-    } else if (hoverX) {
-        PrimitiveRenderer::drawRect(xBoxX1, xBoxY1, xBoxX2, xBoxY2, 0.6f, 0.6f, 0.6f);
-    } else {
-        PrimitiveRenderer::drawRect(xBoxX1, xBoxY1, xBoxX2, xBoxY2, 0.9f, 0.9f, 0.9f);
-    }
-    PrimitiveRenderer::drawOutlineRect(xBoxX1, xBoxY1, xBoxX2, xBoxY2, 0.0f, 0.0f, 0.0f, 1.0f);
+    float camCx = (cam.x1 + cam.x2) * 0.5f;
+    float camCy = (cam.y1 + cam.y2) * 0.5f;
+    PrimitiveRenderer::drawCircle(camCx, camCy, std::min(camera.width, camera.height) * 0.25f + (hoverCam ? camEx*0.5f : 0.0f), 30, 0.12f, 0.12f, 0.12f);
 
-    glColor3f(0.2f, 0.2f, 0.2f);
-    std::string xText;
-    if (isXActive) {
-        xText = "X: " + state.activeInputField.text;
-    } else {
-        std::ostringstream stream;
-        stream << std::fixed << std::setprecision(3) << values[0];
-        xText = "X: " + stream.str();
-    }
-    PrimitiveRenderer::drawText(xText, xBoxX1 + PrimitiveRenderer::pxToNDCx(5, width), inputY - PrimitiveRenderer::pxToNDCy(15, height), GLUT_BITMAP_HELVETICA_12);
-
-    // Y input box
-    inputY -= inputBoxHeight + PrimitiveRenderer::pxToNDCy(2, height);
-    float yBoxX1 = panelX1 + PrimitiveRenderer::pxToNDCx(15, width);
-    float yBoxX2 = yBoxX1 + inputBoxWidth;
-    float yBoxY1 = inputY - inputBoxHeight;
-    float yBoxY2 = inputY;
-
-    bool isYActive = (state.activeInputField.panelType == panelType && state.activeInputField.axis == 1);
-    bool hoverY = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, yBoxX1, yBoxY1, yBoxX2, yBoxY2);
-
-    if (isYActive) {
-        PrimitiveRenderer::drawRect(yBoxX1, yBoxY1, yBoxX2, yBoxY2, 0.7f, 0.7f, 0.9f);
-    } else if (hoverY) {
-        PrimitiveRenderer::drawRect(yBoxX1, yBoxY1, yBoxX2, yBoxY2, 0.6f, 0.6f, 0.6f);
-    } else {
-        PrimitiveRenderer::drawRect(yBoxX1, yBoxY1, yBoxX2, yBoxY2, 0.9f, 0.9f, 0.9f);
-    }
-    PrimitiveRenderer::drawOutlineRect(yBoxX1, yBoxY1, yBoxX2, yBoxY2, 0.0f, 0.0f, 0.0f, 1.0f);
+    PrimitiveRenderer::setTextColor(1,1,1);
+    float textLine1Y = cam.y1 - PrimitiveRenderer::pxToNDCy(14, height);
+    float textLine2Y = textLine1Y - PrimitiveRenderer::pxToNDCy(22, height);
+    PrimitiveRenderer::drawText("Take a", camCx - 0.05f, textLine1Y, GLUT_BITMAP_HELVETICA_12);
+    PrimitiveRenderer::drawText("Screenshot", camCx - 0.09f, textLine2Y, GLUT_BITMAP_HELVETICA_12);
 
-    glColor3f(0.2f, 0.2f, 0.2f);
-    std::string yText;
-    if (isYActive) {
-        yText = "Y: " + state.activeInputField.text;
-    } else {
-        std::ostringstream stream;
-        stream << std::fixed << std::setprecision(3) << values[1];
-        yText = "Y: " + stream.str();
-    }
-    PrimitiveRenderer::drawText(yText, yBoxX1 + PrimitiveRenderer::pxToNDCx(5, width), inputY - PrimitiveRenderer::pxToNDCy(15, height), GLUT_BITMAP_HELVETICA_12);
-
-    // Z input box
-    inputY -= inputBoxHeight + PrimitiveRenderer::pxToNDCy(2, height);
-    float zBoxX1 = panelX1 + PrimitiveRenderer::pxToNDCx(15, width);
-    float zBoxX2 = zBoxX1 + inputBoxWidth;
-    float zBoxY1 = inputY - inputBoxHeight;
-    float zBoxY2 = inputY;
-
-    bool isZActive = (state.activeInputField.panelType == panelType && state.activeInputField.axis == 2);
-    bool hoverZ = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, zBoxX1, zBoxY1, zBoxX2, zBoxY2);
-
-    if (isZActive) {
-        PrimitiveRenderer::drawRect(zBoxX1, zBoxY1, zBoxX2, zBoxY2, 0.7f, 0.7f, 0.9f);
-    } else if (hoverZ) {
-        PrimitiveRenderer::drawRect(zBoxX1, zBoxY1, zBoxX2, zBoxY2, 0.6f, 0.6f, 0.6f);
-    } else {
-        PrimitiveRenderer::drawRect(zBoxX1, zBoxY1, zBoxX2, zBoxY2, 0.9f, 0.9f, 0.9f);
-    }
-    PrimitiveRenderer::drawOutlineRect(zBoxX1, zBoxY1, zBoxX2, zBoxY2, 0.0f, 0.0f, 0.0f, 1.0f);
+    const UiLayout::Rect& colors = UiLayout::get(UiLayout::COLORS_PANEL).rect;
+    PrimitiveRenderer::drawRect(colors.x1, colors.y1, colors.x2, colors.y2, 0.4f, 0.4f, 0.4f);
+    PrimitiveRenderer::drawOutlineRect(colors.x1, colors.y1, colors.x2, colors.y2, 0, 0, 0, 2.0f);
 
-    glColor3f(0.2f, 0.2f, 0.2f);
-    std::string zText;
-    if (isZActive) {
-        zText = "Z: " + state.activeInputField.text;
-    } else {
-        std::ostringstream stream;
-        stream << std::fixed << std::setprecision(3) << values[2];
-        zText = "Z: " + stream.str();
-    }
-    PrimitiveRenderer::drawText(zText, zBoxX1 + PrimitiveRenderer::pxToNDCx(5, width), inputY - PrimitiveRenderer::pxToNDCy(15, height), GLUT_BITMAP_HELVETICA_12);
-
-    // Store original values for cancellation
-    static float originalValues[3] = {0.0f, 0.0f, 0.0f};
-    static bool hasOriginalValues = false;
-
-    // Handle input box clicks
-    if (state.mouseClicked) {
-        if (hoverX && !isXActive) {
-            // Store original value before activating
-            originalValues[0] = values[0];
-            originalValues[1] = values[1];
-            originalValues[2] = values[2];
-            hasOriginalValues = true;
-
-            state.activeInputField.panelType = panelType;
-            state.activeInputField.axis = 0;
-            state.activeInputField.active = true;
-            state.activeInputField.text = ""; // Start with empty text
-            std::cout << "Editing " << title << " X value\n";
-        } else if (hoverY && !isYActive) {
-            // Store original value before activating
-            originalValues[0] = values[0];
-            originalValues[1] = values[1];
-            originalValues[2] = values[2];
-            hasOriginalValues = true;
-
-            state.activeInputField.panelType = panelType;
-            state.activeInputField.axis = 1;
-            state.activeInputField.active = true;
-            state.activeInputField.text = ""; // Start with empty text
-            std::cout << "Editing " << title << " Y value\n";
-        } else if (hoverZ && !isZActive) {
-            // Store original value before activating
-            originalValues[0] = values[0];
-            originalValues[1] = values[1];
-            originalValues[2] = values[2];
-            hasOriginalValues = true;
-
-            state.activeInputField.panelType = panelType;
-            state.activeInputField.axis = 2;
-            state.activeInputField.active = true;
-            state.activeInputField.text = ""; // Start with empty text
-            std::cout << "Editing " << title << " Z value\n";
-        }
-    }
+    PrimitiveRenderer::setTextColor(1, 1, 1);
+    PrimitiveRenderer::drawText("Colors", colors.x1 + 0.02f, colors.y2 - PrimitiveRenderer::pxToNDCy(18, height), GLUT_BITMAP_HELVETICA_12);
 
-    float resetBtnY = inputY - inputBoxHeight - PrimitiveRenderer::pxToNDCy(10, height);
-    float resetBtnWidth = PrimitiveRenderer::pxToNDCx(60, width);
-    float resetBtnHeight = PrimitiveRenderer::pxToNDCy(25, height);
-    bool hoverReset = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height,
-                                                   panelX1 + PrimitiveRenderer::pxToNDCx(15, width), resetBtnY - resetBtnHeight,
-                                                   panelX1 + PrimitiveRenderer::pxToNDCx(15, width) + resetBtnWidth, resetBtnY);
+    // Define colors for the buttons
+    struct Color { float r, g, b; };
+    Color colorArr[6] = {{0,0,0}, {1,1,1}, {1,0,0}, {0,1,0}, {0,0,1}, {1,0,1}};
 
-    PrimitiveRenderer::drawRect(panelX1 + PrimitiveRenderer::pxToNDCx(15, width), resetBtnY - resetBtnHeight,
-                               panelX1 + PrimitiveRenderer::pxToNDCx(15, width) + resetBtnWidth, resetBtnY,
-                               0.32f + (hoverReset ? 0.08f : 0.0f), 0.32f + (hoverReset ? 0.08f : 0.0f), 0.32f + (hoverReset ? 0.08f : 0.0f));
-    PrimitiveRenderer::drawOutlineRect(panelX1 + PrimitiveRenderer::pxToNDCx(15, width), resetBtnY - resetBtnHeight,
-                                     panelX1 + PrimitiveRenderer::pxToNDCx(15, width) + resetBtnWidth, resetBtnY, 0,0,0,1.0f);
-
-    glColor3f(1,1,1);
-    PrimitiveRenderer::drawText("Reset", panelX1 + PrimitiveRenderer::pxToNDCx(25, width), resetBtnY - PrimitiveRenderer::pxToNDCy(15, height), GLUT_BITMAP_HELVETICA_12);
-
-    // Handle reset button click for all panels
-    if (hoverReset && state.mouseClicked) {
-        if (title == "Translate") {
-            // Reset translation to origin - NO LIMITS
-            state.translate[0] = 0.0f;
-            state.translate[1] = 0.0f;
-            state.translate[2] = 0.0f;
-            std::cout << "Translation reset to origin\n";
-        } else if (title == "Scaling") {
-            state.scale[0] = 1.0f;
-            state.scale[1] = 1.0f;
-            state.scale[2] = 1.0f;
-            std::cout << "Scaling reset to default values\n";
-        } else if (title == "Rotation") {
-            state.rotate[0] = 0.0f;
-            state.rotate[1] = 0.0f;
-            state.rotate[2] = 0.0f;
-            std::cout << "Rotation reset to default values\n";
-        }
+    // Swatches grow a little under the cursor
+    for (int i = 0; i < 6; i++) {
+        const UiLayout::Rect& swatch = UiLayout::get(UiLayout::COLOR_SWATCH, i).rect;
+        float ex = PrimitiveRenderer::pxToNDCx(UiLayout::isHovered(UiLayout::COLOR_SWATCH, i) ? 2 : 0, width);
+        PrimitiveRenderer::drawRect(swatch.x1 - ex, swatch.y1 - ex, swatch.x2 + ex, swatch.y2 + ex, colorArr[i].r, colorArr[i].g, colorArr[i].b);
+        PrimitiveRenderer::drawOutlineRect(swatch.x1 - ex, swatch.y1 - ex, swatch.x2 + ex, swatch.y2 + ex, 0, 0, 0, 1.0f);
     }
+
+    const UiLayout::Rect& v = UiLayout::get(UiLayout::SHADES_TOGGLE).rect;
+    bool hoverV = UiLayout::isHovered(UiLayout::SHADES_TOGGLE);
+    PrimitiveRenderer::drawRect(v.x1, v.y1, v.x2, v.y2, hoverV ? 0.6f : 0.25f, hoverV ? 0.6f : 0.25f, hoverV ? 0.6f : 0.25f);
+    PrimitiveRenderer::drawOutlineRect(v.x1, v.y1, v.x2, v.y2, 0, 0, 0, 1.0f);
+    PrimitiveRenderer::setTextColor(1,1,1);
+    PrimitiveRenderer::drawText("V", v.x1 + 0.005f, (v.y1 + v.y2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_12);
+
+    const UiLayout::Rect& shades = UiLayout::get(UiLayout::SHADES_LABEL).rect;
+    PrimitiveRenderer::drawRect(shades.x1, shades.y1, shades.x2, shades.y2, 0.3f, 0.3f, 0.3f);
+    PrimitiveRenderer::drawOutlineRect(shades.x1, shades.y1, shades.x2, shades.y2, 0, 0, 0, 1.0f);
+    PrimitiveRenderer::setTextColor(1,1,1);
+    PrimitiveRenderer::drawText("Shades", shades.x1 + 0.01f, (shades.y1 + shades.y2)*0.5f - 0.01f, GLUT_BITMAP_HELVETICA_12);
 }
 
-void Panels::drawShapesPanel(float panelX1, float panelY1, float panelWidth, float panelHeight,
-                            ApplicationState& state, int width, int height) {
-    int panelXPx = (int)((panelX1 + 1.0f) * 0.5f * width);
-    int panelYPx = (int)((1.0f - (panelY1 + panelHeight)) * 0.5f * height);
-    int panelWidthPx = (int)(panelWidth * 0.5f * width);
-    int panelHeightPx = (int)(panelHeight * 0.5f * height);
-
-    glEnable(GL_SCISSOR_TEST);
-    PrimitiveRenderer::setScissor(panelXPx, panelYPx, panelWidthPx, panelHeightPx, height);
-
-    PrimitiveRenderer::drawRect(panelX1, panelY1, panelX1 + panelWidth, panelY1 + panelHeight, 0.4f, 0.4f, 0.4f);
-    PrimitiveRenderer::drawOutlineRect(panelX1, panelY1, panelX1 + panelWidth, panelY1 + panelHeight, 0.0f, 0.0f, 0.0f, 2.0f);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Shapes", panelX1 + PrimitiveRenderer::pxToNDCx(10, width), panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(25, height), GLUT_BITMAP_HELVETICA_18);
-
-    float buttonWidth = (panelWidth - PrimitiveRenderer::pxToNDCx(40, width)) / 2.0f;
-    float buttonHeight = PrimitiveRenderer::pxToNDCy(75, height);
-    float buttonGap = PrimitiveRenderer::pxToNDCx(8, width);
-
-    float rowGap = PrimitiveRenderer::pxToNDCy(10, height);
-    float contentHeight = (buttonHeight * 3) + (rowGap * 2);
-    float maxScroll = std::max(0.0f, contentHeight - panelHeight);
-
-    float scrollOffset = std::max(0.0f, std::min(maxScroll, -state.leftPanelShapesScroll));
-
-    float row1Y = panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(50, height) + scrollOffset;
-
-    // Cube button
-    float cubeX1 = panelX1 + PrimitiveRenderer::pxToNDCx(10, width);
-    float cubeX2 = cubeX1 + buttonWidth;
-    bool hoverCube = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, cubeX1, row1Y - buttonHeight, cubeX2, row1Y);
-    bool isCubeSelected = (state.currentShape == ShapeType::CUBE);
-
-    PrimitiveRenderer::drawRect(cubeX1, row1Y - buttonHeight, cubeX2, row1Y,
-                              isCubeSelected ? 0.5f : (0.3f + (hoverCube ? 0.1f : 0.0f)),
-                              isCubeSelected ? 0.5f : (0.3f + (hoverCube ? 0.1f : 0.0f)),
-                              isCubeSelected ? 0.5f : (0.3f + (hoverCube ? 0.1f : 0.0f)));
-    PrimitiveRenderer::drawOutlineRect(cubeX1, row1Y - buttonHeight, cubeX2, row1Y, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    // Draw 3D cube symbol
-    float symbolSize = 0.03f;
-    float symbolX = cubeX1 + buttonWidth * 0.5f;
-    float symbolY = row1Y - buttonHeight * 0.5f;
-
-    glPushMatrix();
-    glTranslatef(symbolX, symbolY, 0.0f);
-    glScalef(symbolSize, symbolSize, symbolSize);
-
-    // Front face (light gray)
-    glColor3f(0.8f, 0.8f, 0.8f);
-    glBegin(GL_QUADS);
-    glVertex3f(-1.0f, -1.0f, 1.0f);
-    glVertex3f(1.0f, -1.0f, 1.0f);
-    glVertex3f(1.0f, 1.0f, 1.0f);
-    glVertex3f(-1.0f, 1.0f, 1.0f);
-    glEnd();
-
-    // Right face (medium gray)
-    glColor3f(0.6f, 0.6f, 0.6f);
-    glBegin(GL_QUADS);
-    glVertex3f(1.0f, -1.0f, 1.0f);
-    glVertex3f(1.0f, -1.0f, -1.0f);
-    glVertex3f(1.0f, 1.0f, -1.0f);
-    glVertex3f(1.0f, 1.0f, 1.0f);
-    glEnd();
-
-    // Top face (dark gray)
-    glColor3f(0.4f, 0.4f, 0.4f);
-    glBegin(GL_QUADS);
-    glVertex3f(-1.0f, 1.0f, 1.0f);
-    glVertex3f(1.0f, 1.0f, 1.0f);
-    glVertex3f(1.0f, 1.0f, -1.0f);
-    glVertex3f(-1.0f, 1.0f, -1.0f);
-    glEnd();
-
-    glPopMatrix();
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Cube", cubeX1 + PrimitiveRenderer::pxToNDCx(20, width), row1Y - PrimitiveRenderer::pxToNDCy(35, height), GLUT_BITMAP_HELVETICA_12);
-
-    // Sphere button
-    float sphereX1 = cubeX2 + buttonGap;
-    float sphereX2 = sphereX1 + buttonWidth;
-    bool hoverSphere = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, sphereX1, row1Y - buttonHeight, sphereX2, row1Y);
-    bool isSphereSelected = (state.currentShape == ShapeType::SPHERE);
-
-    PrimitiveRenderer::drawRect(sphereX1, row1Y - buttonHeight, sphereX2, row1Y,
-                              isSphereSelected ? 0.5f : (0.3f + (hoverSphere ? 0.1f : 0.0f)),
-                              isSphereSelected ? 0.5f : (0.3f + (hoverSphere ? 0.1f : 0.0f)),
-                              isSphereSelected ? 0.5f : (0.3f + (hoverSphere ? 0.1f : 0.0f)));
-    PrimitiveRenderer::drawOutlineRect(sphereX1, row1Y - buttonHeight, sphereX2, row1Y, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    // Draw 3D sphere symbol
-    symbolX = sphereX1 + buttonWidth * 0.5f;
-    symbolY = row1Y - buttonHeight * 0.5f;
-
-    glPushMatrix();
-    glTranslatef(symbolX, symbolY, 0.0f);
-    glScalef(symbolSize, symbolSize, symbolSize);
-
-    int slices = 8;
-    int stacks = 6;
-    for (int i = 0; i <= stacks; ++i) {
-        float phi = Constants::PI * i / stacks;
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= slices; ++j) {
-            float theta = 2.0f * Constants::PI * j / slices;
-            float x = sin(phi) * cos(theta);
-            float y = cos(phi);
-            float z = sin(phi) * sin(theta);
-
-            // Vary color based on position for 3D effect
-            float shade = 0.5f + y * 0.3f;
-            glColor3f(shade, shade, shade);
-            glVertex3f(x, y, z);
-
-            x = sin(phi + Constants::PI / stacks) * cos(theta);
-            y = cos(phi + Constants::PI / stacks);
-            z = sin(phi + Constants::PI / stacks) * sin(theta);
-
-            shade = 0.5f + y * 0.3f;
-            glColor3f(shade, shade, shade);
-            glVertex3f(x, y, z);
+void Panels::drawTransformPanel(int panel, ApplicationState& state, int width, int height) {
+    const UiLayout::Rect& box = UiLayout::get(UiLayout::TRANSFORM_PANEL, panel).rect;
+    const float* values = transformValues(state, panel);
+    PrimitiveRenderer::drawRect(box.x1, box.y1, box.x2, box.y2, 0.4f, 0.4f, 0.4f);
+    PrimitiveRenderer::drawOutlineRect(box.x1, box.y1, box.x2, box.y2, 0.0f, 0.0f, 0.0f, 2.0f);
+
+    PrimitiveRenderer::setTextColor(1.0f, 1.0f, 1.0f);
+    PrimitiveRenderer::drawText(TRANSFORM_TITLES[panel], box.x1 + PrimitiveRenderer::pxToNDCx(10, width), box.y2 - PrimitiveRenderer::pxToNDCy(25, height), GLUT_BITMAP_HELVETICA_18);
+    PrimitiveRenderer::drawText("Vector", box.x1 + PrimitiveRenderer::pxToNDCx(15, width), box.y2 - PrimitiveRenderer::pxToNDCy(45, height), GLUT_BITMAP_HELVETICA_12);
+
+    // X, Y and Z input boxes; the one being edited shows the text typed so far
+    for (int axis = 0; axis < 3; ++axis) {
+        const UiLayout::Rect& field = UiLayout::get(UiLayout::TRANSFORM_FIELD, panel * 3 + axis).rect;
+        bool isActive = (state.activeInputField.panelType == panel && state.activeInputField.axis == axis);
+        bool hover = UiLayout::isHovered(UiLayout::TRANSFORM_FIELD, panel * 3 + axis);
+
+        // Draw input box with different color if active or hovered
+        if (isActive) {
+            PrimitiveRenderer::drawRect(field.x1, field.y1, field.x2, field.y2, 0.7f, 0.7f, 0.9f);
+        } else if (hover) {
+            PrimitiveRenderer::drawRect(field.x1, field.y1, field.x2, field.y2, 0.6f, 0.6f, 0.6f);
+        } else {
+            PrimitiveRenderer::drawRect(field.x1, field.y1, field.x2, field.y2, 0.9f, 0.9f, 0.9f);
         }
-        glEnd();
-    }
-    glPopMatrix();
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Sphere", sphereX1 + PrimitiveRenderer::pxToNDCx(20, width), row1Y - PrimitiveRenderer::pxToNDCy(35, height), GLUT_BITMAP_HELVETICA_12);
-
-    float row2Y = row1Y - buttonHeight - rowGap;
-
-    // Cone button
-    float coneX1 = panelX1 + PrimitiveRenderer::pxToNDCx(10, width);
-    float coneX2 = coneX1 + buttonWidth;
-    bool hoverCone = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, coneX1, row2Y - buttonHeight, coneX2, row2Y);
-    bool isConeSelected = (state.currentShape == ShapeType::CONE);
-
-    PrimitiveRenderer::drawRect(coneX1, row2Y - buttonHeight, coneX2, row2Y,
-                              isConeSelected ? 0.5f : (0.3f + (hoverCone ? 0.1f : 0.0f)),
-                              isConeSelected ? 0.5f : (0.3f + (hoverCone ? 0.1f : 0.0f)),
-                              isConeSelected ? 0.5f : (0.3f + (hoverCone ? 0.1f : 0.0f)));
-    PrimitiveRenderer::drawOutlineRect(coneX1, row2Y - buttonHeight, coneX2, row2Y, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    // Draw 3D cone symbol
-    symbolX = coneX1 + buttonWidth * 0.5f;
-    symbolY = row2Y - buttonHeight * 0.5f;
-
-    glPushMatrix();
-    glTranslatef(symbolX, symbolY, 0.0f);
-    glScalef(symbolSize, symbolSize, symbolSize);
-
-    // Base (dark gray)
-    glColor3f(0.4f, 0.4f, 0.4f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0.0f, -1.0f, 0.0f);
-    for (int i = 0; i <= 16; ++i) {
-        float theta = 2.0f * Constants::PI * i / 16;
-        float x = cos(theta);
-        float z = sin(theta);
-        glVertex3f(x, -1.0f, z);
-    }
-    glEnd();
-
-    // Side (gradient from dark to light)
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    for (int i = 0; i <= 16; ++i) {
-        float theta = 2.0f * Constants::PI * i / 16;
-        float x = cos(theta);
-        float z = sin(theta);
-        float shade = 0.6f - fabs(sin(theta)) * 0.2f;
-        glColor3f(shade, shade, shade);
-        glVertex3f(x, -1.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Cone", coneX1 + PrimitiveRenderer::pxToNDCx(25, width), row2Y - PrimitiveRenderer::pxToNDCy(35, height), GLUT_BITMAP_HELVETICA_12);
-
-    // Cylinder button
-    float cylinderX1 = coneX2 + buttonGap;
-    float cylinderX2 = cylinderX1 + buttonWidth;
-    bool hoverCylinder = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, cylinderX1, row2Y - buttonHeight, cylinderX2, row2Y);
-    bool isCylinderSelected = (state.currentShape == ShapeType::CYLINDER);
-
-    PrimitiveRenderer::drawRect(cylinderX1, row2Y - buttonHeight, cylinderX2, row2Y,
-                              isCylinderSelected ? 0.5f : (0.3f + (hoverCylinder ? 0.1f : 0.0f)),
-                              isCylinderSelected ? 0.5f : (0.3f + (hoverCylinder ? 0.1f : 0.0f)),
-                              isCylinderSelected ? 0.5f : (0.3f + (hoverCylinder ? 0.1f : 0.0f)));
-    PrimitiveRenderer::drawOutlineRect(cylinderX1, row2Y - buttonHeight, cylinderX2, row2Y, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    // Draw 3D cylinder symbol
-    symbolX = cylinderX1 + buttonWidth * 0.5f;
-    symbolY = row2Y - buttonHeight * 0.5f;
-
-    glPushMatrix();
-    glTranslatef(symbolX, symbolY, 0.0f);
-    glScalef(symbolSize * 0.8f, symbolSize * 0.8f, symbolSize * 0.8f);
-
-    // Top (light gray)
-    glColor3f(0.8f, 0.8f, 0.8f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    for (int i = 0; i <= 16; ++i) {
-        float theta = 2.0f * Constants::PI * i / 16;
-        glVertex3f(cos(theta), 1.0f, sin(theta));
-    }
-    glEnd();
-
-    // Bottom (dark gray)
-    glColor3f(0.4f, 0.4f, 0.4f);
-    glBegin(GL_TRIANGLE_FAN);
-    glVertex3f(0.0f, -1.0f, 0.0f);
-    for (int i = 0; i <= 16; ++i) {
-        float theta = 2.0f * Constants::PI * i / 16;
-        glVertex3f(cos(theta), -1.0f, sin(theta));
-    }
-    glEnd();
-
-    // Side (medium gray)
-    glColor3f(0.6f, 0.6f, 0.6f);
-    glBegin(GL_QUAD_STRIP);
-    for (int i = 0; i <= 16; ++i) {
-        float theta = 2.0f * Constants::PI * i / 16;
-        float x = cos(theta);
-        float z = sin(theta);
-        glVertex3f(x, 1.0f, z);
-        glVertex3f(x, -1.0f, z);
-    }
-    glEnd();
-    glPopMatrix();
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Cylinder", cylinderX1 + PrimitiveRenderer::pxToNDCx(15, width), row2Y - PrimitiveRenderer::pxToNDCy(35, height), GLUT_BITMAP_HELVETICA_12);
-
-    float row3Y = row2Y - buttonHeight - rowGap;
-
-    // Torus button
-    float torusX1 = panelX1 + PrimitiveRenderer::pxToNDCx(10, width);
-    float torusX2 = torusX1 + buttonWidth;
-    bool hoverTorus = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, torusX1, row3Y - buttonHeight, torusX2, row3Y);
-    bool isTorusSelected = (state.currentShape == ShapeType::TORUS);
-
-    PrimitiveRenderer::drawRect(torusX1, row3Y - buttonHeight, torusX2, row3Y,
-                              isTorusSelected ? 0.5f : (0.3f + (hoverTorus ? 0.1f : 0.0f)),
-                              isTorusSelected ? 0.5f : (0.3f + (hoverTorus ? 0.1f : 0.0f)),
-                              isTorusSelected ? 0.5f : (0.3f + (hoverTorus ? 0.1f : 0.0f)));
-    PrimitiveRenderer::drawOutlineRect(torusX1, row3Y - buttonHeight, torusX2, row3Y, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    // Draw 3D torus symbol
-    symbolX = torusX1 + buttonWidth * 0.5f;
-    symbolY = row3Y - buttonHeight * 0.5f;
-
-    glPushMatrix();
-    glTranslatef(symbolX, symbolY, 0.0f);
-    glScalef(symbolSize, symbolSize, symbolSize);
-
-    float majorRadius = 1.0f;
-    float minorRadius = 0.3f;
-    int majorSlices = 12;
-    int minorSlices = 8;
-
-    for (int i = 0; i < majorSlices; ++i) {
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= minorSlices; ++j) {
-            for (int k = 0; k <= 1; ++k) {
-                float phi = 2.0f * Constants::PI * (i + k) / majorSlices;
-                float theta = 2.0f * Constants::PI * j / minorSlices;
-
-                float x = (majorRadius + minorRadius * cos(theta)) * cos(phi);
-                float y = minorRadius * sin(theta);
-                float z = (majorRadius + minorRadius * cos(theta)) * sin(phi);
-
-                // Vary color based on position
-                float shade = 0.5f + cos(theta) * 0.3f;
-                glColor3f(shade, shade, shade);
-                glVertex3f(x, y, z);
-            }
+        PrimitiveRenderer::drawOutlineRect(field.x1, field.y1, field.x2, field.y2, 0.0f, 0.0f, 0.0f, 1.0f);
+
+        PrimitiveRenderer::setTextColor(0.2f, 0.2f, 0.2f);
+        std::string text = std::string(1, AXIS_NAMES[axis]) + ": ";
+        if (isActive) {
+            text += state.activeInputField.text;
+        } else {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(3) << values[axis];
+            text += stream.str();
         }
-        glEnd();
-    }
-    glPopMatrix();
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Torus", torusX1 + PrimitiveRenderer::pxToNDCx(25, width), row3Y - PrimitiveRenderer::pxToNDCy(35, height), GLUT_BITMAP_HELVETICA_12);
-
-    // Pyramid button
-    float pyramidX1 = torusX2 + buttonGap;
-    float pyramidX2 = pyramidX1 + buttonWidth;
-    bool hoverPyramid = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, pyramidX1, row3Y - buttonHeight, pyramidX2, row3Y);
-    bool isPyramidSelected = (state.currentShape == ShapeType::PYRAMID);
-
-    PrimitiveRenderer::drawRect(pyramidX1, row3Y - buttonHeight, pyramidX2, row3Y,
-                              isPyramidSelected ? 0.5f : (0.3f + (hoverPyramid ? 0.1f : 0.0f)),
-                              isPyramidSelected ? 0.5f : (0.3f + (hoverPyramid ? 0.1f : 0.0f)),
-                              isPyramidSelected ? 0.5f : (0.3f + (hoverPyramid ? 0.1f : 0.0f)));
-    PrimitiveRenderer::drawOutlineRect(pyramidX1, row3Y - buttonHeight, pyramidX2, row3Y, 0.0f, 0.0f, 0.0f, 1.5f);
-
-    // Draw 3D pyramid symbol
-    symbolX = pyramidX1 + buttonWidth * 0.5f;
-    symbolY = row3Y - buttonHeight * 0.5f;
-
-    glPushMatrix();
-    glTranslatef(symbolX, symbolY, 0.0f);
-    glScalef(symbolSize, symbolSize, symbolSize);
-
-    // Base (dark gray)
-    glColor3f(0.4f, 0.4f, 0.4f);
-    glBegin(GL_QUADS);
-    glVertex3f(-1.0f, -1.0f, -1.0f);
-    glVertex3f(1.0f, -1.0f, -1.0f);
-    glVertex3f(1.0f, -1.0f, 1.0f);
-    glVertex3f(-1.0f, -1.0f, 1.0f);
-    glEnd();
-
-    // Front face (medium gray)
-    glColor3f(0.6f, 0.6f, 0.6f);
-    glBegin(GL_TRIANGLES);
-    glVertex3f(-1.0f, -1.0f, 1.0f);
-    glVertex3f(1.0f, -1.0f, 1.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glEnd();
-
-    // Right face (light gray)
-    glColor3f(0.7f, 0.7f, 0.7f);
-    glBegin(GL_TRIANGLES);
-    glVertex3f(1.0f, -1.0f, 1.0f);
-    glVertex3f(1.0f, -1.0f, -1.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glEnd();
-
-    // Back face (medium-dark gray)
-    glColor3f(0.5f, 0.5f, 0.5f);
-    glBegin(GL_TRIANGLES);
-    glVertex3f(1.0f, -1.0f, -1.0f);
-    glVertex3f(-1.0f, -1.0f, -1.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glEnd();
-
-    // Left face (medium-light gray)
-    glColor3f(0.65f, 0.65f, 0.65f);
-    glBegin(GL_TRIANGLES);
-    glVertex3f(-1.0f, -1.0f, -1.0f);
-    glVertex3f(-1.0f, -1.0f, 1.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glEnd();
-    glPopMatrix();
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Pyramid", pyramidX1 + PrimitiveRenderer::pxToNDCx(20, width), row3Y - PrimitiveRenderer::pxToNDCy(35, height), GLUT_BITMAP_HELVETICA_12);
-
-    glDisable(GL_SCISSOR_TEST);
-
-    if (maxScroll > 0) {
-        float scrollBarWidth = PrimitiveRenderer::pxToNDCx(8, width);
-        float scrollBarX = panelX1 + panelWidth - scrollBarWidth - PrimitiveRenderer::pxToNDCx(5, width);
-        float scrollBarHeight = panelHeight - PrimitiveRenderer::pxToNDCy(15, height);
-        float scrollThumbHeight = scrollBarHeight * (panelHeight / contentHeight);
-        float scrollProgress = state.leftPanelShapesScroll / maxScroll;
-        float scrollThumbY = panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(10, height) - scrollThumbHeight - (scrollProgress * (scrollBarHeight - scrollThumbHeight));
-
-        PrimitiveRenderer::drawRect(scrollBarX, panelY1 + PrimitiveRenderer::pxToNDCy(10, height), scrollBarX + scrollBarWidth, panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(10, height), 0.3f, 0.3f, 0.3f);
-        PrimitiveRenderer::drawRect(scrollBarX, scrollThumbY, scrollBarX + scrollBarWidth, scrollThumbY + scrollThumbHeight, 0.6f, 0.6f, 0.6f);
+        PrimitiveRenderer::drawText(text, field.x1 + PrimitiveRenderer::pxToNDCx(5, width), field.y2 - PrimitiveRenderer::pxToNDCy(15, height), GLUT_BITMAP_HELVETICA_12);
     }
-}
 
-void Panels::drawTexturesPanel(float panelX1, float panelY1, float panelWidth, float panelHeight,
-                              ApplicationState& state, int width, int height) {
-    // Enable scissor test for this panel
-    int panelXPx = (int)((panelX1 + 1.0f) * 0.5f * width);
-    int panelYPx = (int)((1.0f - (panelY1 + panelHeight)) * 0.5f * height);
-    int panelWidthPx = (int)(panelWidth * 0.5f * width);
-    int panelHeightPx = (int)(panelHeight * 0.5f * height);
+    const UiLayout::Rect& reset = UiLayout::get(UiLayout::RESET_BUTTON, panel).rect;
+    bool hoverReset = UiLayout::isHovered(UiLayout::RESET_BUTTON, panel);
+    PrimitiveRenderer::drawRect(reset.x1, reset.y1, reset.x2, reset.y2,
+                               0.32f + (hoverReset ? 0.08f : 0.0f), 0.32f + (hoverReset ? 0.08f : 0.0f), 0.32f + (hoverReset ? 0.08f : 0.0f));
+    PrimitiveRenderer::drawOutlineRect(reset.x1, reset.y1, reset.x2, reset.y2, 0,0,0,1.0f);
 
-    glEnable(GL_SCISSOR_TEST);
-    PrimitiveRenderer::setScissor(panelXPx, panelYPx, panelWidthPx, panelHeightPx, height);
+    PrimitiveRenderer::setTextColor(1,1,1);
+    PrimitiveRenderer::drawText("Reset", box.x1 + PrimitiveRenderer::pxToNDCx(25, width), reset.y2 - PrimitiveRenderer::pxToNDCy(15, height), GLUT_BITMAP_HELVETICA_12);
+}
 
-    PrimitiveRenderer::drawRect(panelX1, panelY1, panelX1 + panelWidth, panelY1 + panelHeight, 0.4f, 0.4f, 0.4f);
-    PrimitiveRenderer::drawOutlineRect(panelX1, panelY1, panelX1 + panelWidth, panelY1 + panelHeight, 0.0f, 0.0f, 0.0f, 2.0f);
+void Panels::drawShapesPanel(ApplicationState& state, int width, int height) {
+    const UiLayout::Widget& panel = UiLayout::get(UiLayout::SHAPES_PANEL);
+    const UiLayout::Rect& box = panel.rect;
+    clipToPanel(panel, width, height);
+
+    PrimitiveRenderer::drawRect(box.x1, box.y1, box.x2, box.y2, 0.4f, 0.4f, 0.4f);
+    PrimitiveRenderer::drawOutlineRect(box.x1, box.y1, box.x2, box.y2, 0.0f, 0.0f, 0.0f, 2.0f);
+
+    PrimitiveRenderer::setTextColor(1.0f, 1.0f, 1.0f);
+    PrimitiveRenderer::drawText("Shapes", box.x1 + PrimitiveRenderer::pxToNDCx(10, width), box.y2 - PrimitiveRenderer::pxToNDCy(25, height), GLUT_BITMAP_HELVETICA_18);
+
+    // Cube, Sphere, Cone, Cylinder, Torus and Pyramid, two to a row
+    for (int i = 0; i < 6; ++i) {
+        const UiLayout::Widget& button = UiLayout::get(UiLayout::SHAPE_BUTTON, i);
+        const UiLayout::Rect& rect = button.rect;
+        ShapeType shape = (ShapeType)((int)ShapeType::CUBE + i);
+        bool hover = UiLayout::isHovered(UiLayout::SHAPE_BUTTON, i);
+        bool isSelected = (state.currentShape == shape);
+
+        PrimitiveRenderer::drawRect(rect.x1, rect.y1, rect.x2, rect.y2,
+                                  isSelected ? 0.5f : (0.3f + (hover ? 0.1f : 0.0f)),
+                                  isSelected ? 0.5f : (0.3f + (hover ? 0.1f : 0.0f)),
+                                  isSelected ? 0.5f : (0.3f + (hover ? 0.1f : 0.0f)));
+        PrimitiveRenderer::drawOutlineRect(rect.x1, rect.y1, rect.x2, rect.y2, 0.0f, 0.0f, 0.0f, 1.5f);
+
+        // Draw the 3D shape symbol from the icon atlas
+        float symbolX = rect.x1 + button.width * 0.5f;
+        float symbolY = rect.y2 - button.height * 0.5f;
+        IconAtlas::draw(shape, symbolX, symbolY, width, height);
+
+        PrimitiveRenderer::setTextColor(1.0f, 1.0f, 1.0f);
+        PrimitiveRenderer::drawText(SHAPE_LABELS[i], rect.x1 + PrimitiveRenderer::pxToNDCx(SHAPE_LABEL_INSETS[i], width), rect.y2 - PrimitiveRenderer::pxToNDCy(35, height), GLUT_BITMAP_HELVETICA_12);
+    }
+
+    PrimitiveRenderer::clearScissor();
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-    PrimitiveRenderer::drawText("Textures", panelX1 + PrimitiveRenderer::pxToNDCx(10, width), panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(25, height), GLUT_BITMAP_HELVETICA_18);
+    drawScrollBar(1);
+}
 
-    // Use the same layout as shapes panel for consistency
-    float buttonWidth = (panelWidth - PrimitiveRenderer::pxToNDCx(40, width)) / 2.0f;
-    float buttonHeight = PrimitiveRenderer::pxToNDCy(75, height);
-    float buttonGap = PrimitiveRenderer::pxToNDCx(8, width);
-    float rowGap = PrimitiveRenderer::pxToNDCy(10, height);
+void Panels::drawTexturesPanel(ApplicationState& state, int width, int height) {
+    // Enable scissor test for this panel
+    const UiLayout::Widget& panel = UiLayout::get(UiLayout::TEXTURES_PANEL);
+    const UiLayout::Rect& box = panel.rect;
+    clipToPanel(panel, width, height);
 
-    float contentHeight = (buttonHeight * 3) + (rowGap * 2);
-    float maxScroll = std::max(0.0f, contentHeight - panelHeight);
-    float scrollOffset = std::max(0.0f, std::min(maxScroll, -state.leftPanelTexturesScroll));
+    PrimitiveRenderer::drawRect(box.x1, box.y1, box.x2, box.y2, 0.4f, 0.4f, 0.4f);
+    PrimitiveRenderer::drawOutlineRect(box.x1, box.y1, box.x2, box.y2, 0.0f, 0.0f, 0.0f, 2.0f);
 
-    float row1Y = panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(50, height) + scrollOffset;
+    PrimitiveRenderer::setTextColor(1.0f, 1.0f, 1.0f);
+    PrimitiveRenderer::drawText("Textures", box.x1 + PrimitiveRenderer::pxToNDCx(10, width), box.y2 - PrimitiveRenderer::pxToNDCy(25, height), GLUT_BITMAP_HELVETICA_18);
 
     // Texture buttons - 2 columns, 3 rows
     for (int i = 0; i < 6; i++) {
-        int row = i / 2;
-        int col = i % 2;
-
-        float buttonX1 = panelX1 + PrimitiveRenderer::pxToNDCx(10, width) + col * (buttonWidth + buttonGap);
-        float buttonX2 = buttonX1 + buttonWidth;
-        float buttonY1 = row1Y - buttonHeight - row * (buttonHeight + rowGap);
-        float buttonY2 = buttonY1 + buttonHeight;
+        const UiLayout::Rect& button = UiLayout::get(UiLayout::TEXTURE_BUTTON, i).rect;
+        float buttonX1 = button.x1;
+        float buttonX2 = button.x2;
+        float buttonY1 = button.y1;
+        float buttonY2 = button.y2;
 
-        bool hover = PrimitiveRenderer::isInsideNDC(state.mouseX, state.mouseY, width, height, buttonX1, buttonY1, buttonX2, buttonY2);
+        bool hover = UiLayout::isHovered(UiLayout::TEXTURE_BUTTON, i);
 
         // Draw button background
         PrimitiveRenderer::drawRect(buttonX1, buttonY1, buttonX2, buttonY2,
@@ -867,63 +303,265 @@ void Panels::drawTexturesPanel(float panelX1, float panelY1, float panelWidth, f
             float textureY1 = buttonY1 + textureMargin;
             float textureY2 = buttonY2 - textureMargin;
 
-            // Save current matrix state
-            glMatrixMode(GL_PROJECTION);
-            glPushMatrix();
-            glLoadIdentity();
-            glOrtho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-
-            glMatrixMode(GL_MODELVIEW);
-            glPushMatrix();
-            glLoadIdentity();
-
-            // Draw the textured rectangle
+            // The UI pass already draws in window NDC with identity matrices
             PrimitiveRenderer::drawTexturedRect(textureX1, textureY1, textureX2, textureY2, PrimitiveRenderer::textureIDs[i]);
-
-            // Restore matrix state
-            glPopMatrix();
-            glMatrixMode(GL_PROJECTION);
-            glPopMatrix();
-            glMatrixMode(GL_MODELVIEW);
         } else {
             // Draw placeholder if no texture
             PrimitiveRenderer::drawRect(buttonX1, buttonY1, buttonX2, buttonY2, 0.8f, 0.2f, 0.2f);
         }
 
-        // Handle texture selection AND application to current shape
-        if (hover && state.mouseClicked) {
-            state.selectedTexture = i;
-            std::cout << "Selected texture " << i << std::endl;
+        // Draw selection indicator
+        if (state.selectedTexture == i) {
+            PrimitiveRenderer::drawOutlineRect(buttonX1 - 0.005f, buttonY1 - 0.005f,
+                                             buttonX2 + 0.005f, buttonY2 + 0.005f,
+                                             1.0f, 1.0f, 0.0f, 2.0f);
+        }
+    }
 
-            // NEW: Apply texture to current shape if one is selected
+    PrimitiveRenderer::clearScissor();
+
+    // Scroll bar for textures panel
+    drawScrollBar(0);
+}
+
+bool Panels::handleClick(int widget, ApplicationState& state) {
+    if (widget < 0) {
+        return false;
+    }
+
+    const UiLayout::Widget& clicked = UiLayout::widget(widget);
+    int index = clicked.index;
+    switch (clicked.type) {
+        case UiLayout::COLOR_SWATCH:
+            handleColorButtonClick(index, state);
+            break;
+        case UiLayout::TEXTURE_BUTTON:
+            // Select the texture AND apply it to the current shape
+            state.selectedTexture = index;
+            std::cout << "Selected texture " << index << std::endl;
             if (state.currentShape != ShapeType::NONE) {
-                PrimitiveRenderer::applyTextureToShape(state.currentShape, i, state);
-                std::cout << "Applied texture " << i << " to current shape" << std::endl;
+                ShapeMaterial::applyTextureToShape(state.currentShape, index, state);
+                std::cout << "Applied texture " << index << " to current shape" << std::endl;
             } else {
                 std::cout << "No shape selected to apply texture to" << std::endl;
             }
+            break;
+        case UiLayout::SHAPE_BUTTON:
+            SceneEditor::addShape(state, (ShapeType)((int)ShapeType::CUBE + index));
+            std::cout << SHAPE_LABELS[index] << " generated!\n";
+            break;
+        case UiLayout::TRANSFORM_FIELD: {
+            int panel = index / 3;
+            int axis = index % 3;
+            if (!(state.activeInputField.panelType == panel && state.activeInputField.axis == axis)) {
+                state.activeInputField.panelType = panel;
+                state.activeInputField.axis = axis;
+                state.activeInputField.active = true;
+                state.activeInputField.text = ""; // Start with empty text
+                std::cout << "Editing " << TRANSFORM_TITLES[panel] << " " << AXIS_NAMES[axis] << " value\n";
+            }
+            break;
         }
+        case UiLayout::RESET_BUTTON:
+            if (index == 2) {
+                // Reset translation to origin - NO LIMITS
+                state.translate[0] = 0.0f;
+                state.translate[1] = 0.0f;
+                state.translate[2] = 0.0f;
+                std::cout << "Translation reset to origin\n";
+            } else if (index == 1) {
+                state.scale[0] = 1.0f;
+                state.scale[1] = 1.0f;
+                state.scale[2] = 1.0f;
+                std::cout << "Scaling reset to default values\n";
+            } else {
+                state.rotate[0] = 0.0f;
+                state.rotate[1] = 0.0f;
+                state.rotate[2] = 0.0f;
+                std::cout << "Rotation reset to default values\n";
+            }
+            break;
+        case UiLayout::AXIS_BUTTON:
+            // Toggle axis selection
+            state.axisSelected[index] = !state.axisSelected[index];
+            std::cout << AXIS_NAMES[index] << " axis " << (state.axisSelected[index] ? "selected" : "deselected") << "!\n";
+            break;
+        default:
+            break;
+    }
+    return true;
+}
 
-        // Draw selection indicator
-        if (state.selectedTexture == i) {
-            PrimitiveRenderer::drawOutlineRect(buttonX1 - 0.005f, buttonY1 - 0.005f,
-                                             buttonX2 + 0.005f, buttonY2 + 0.005f,
-                                             1.0f, 1.0f, 0.0f, 2.0f);
+void Panels::drawStatsOverlay(float canvasX1, float canvasY2, int width, int height, ApplicationState& appState) {
+    if (!appState.showStats) {
+        return;
+    }
+
+    std::vector<std::string> lines;
+    std::ostringstream line;
+
+    line << "Objects: " << appState.scene.size();
+    lines.push_back(line.str());
+    line.str("");
+
+    const FrameStats& frame = appState.frameStats;
+    line << std::fixed << std::setprecision(2) << "Frame: " << frame.frameMs << " ms  CPU: " << frame.cpuMs << " ms";
+    lines.push_back(line.str());
+    line.str("");
+    line << std::fixed << std::setprecision(1) << "Redraws: " << frame.redrawsPerSecond << "/s "
+         << (appState.continuousRedraw ? "continuous" : "on demand") << " (F1)";
+    if (!appState.windowFocused) {
+        line << ", capped while unfocused";
+    }
+    lines.push_back(line.str());
+    line.str("");
+    line << "Draw calls: " << frame.drawCalls << "  batches: " << frame.batches << "  instances: " << frame.instances;
+    lines.push_back(line.str());
+    line.str("");
+    line << "Instancing: " << (appState.useInstancing ? "on" : "off") << " (F6, F5 for benchmark scene)";
+    lines.push_back(line.str());
+    line.str("");
+    line << "Renderer: " << (appState.useCoreRenderer ? "core profile" : "legacy");
+    if (appState.useCoreRenderer) {
+        line << (ShaderRenderer::isPersistentlyMapped() ? ", persistent ring" : ", orphaned buffer");
+    }
+    line << " (F10)";
+    lines.push_back(line.str());
+    line.str("");
+    line << "State changes: " << frame.stateChanges;
+    if (!appState.useInstancing || appState.useCoreRenderer) {
+        line << " sorted, " << frame.unsortedStateChanges << " in scene order";
+    }
+    lines.push_back(line.str());
+    line.str("");
+    line << "GL state calls: " << frame.glCallsIssued << " issued, " << frame.glCallsElided << " elided";
+    lines.push_back(line.str());
+    line.str("");
+    line << std::fixed << std::setprecision(2) << "UI: " << frame.uiDrawCalls << " draw calls, "
+         << frame.uiPrimitives << " prims, " << frame.uiMs << " ms";
+    lines.push_back(line.str());
+    line.str("");
+    if (UiLayer::isCaching()) {
+        line << "UI layer: " << frame.uiRegionsDrawn << " regions redrawn, " << frame.uiRegionsCached << " cached";
+    } else {
+        line << "UI layer: off (no framebuffer objects), " << frame.uiRegionsDrawn << " regions drawn";
+    }
+    lines.push_back(line.str());
+    line.str("");
+    line << "UI layout: " << UiLayout::widgetCount() << " widgets, " << frame.uiHitTests << " hit tests over "
+         << frame.uiHitRectsTested << " rects";
+    if (frame.uiLayoutBuilds > 0) {
+        line << ", laid out again";
+    }
+    lines.push_back(line.str());
+    line.str("");
+    if (TextRenderer::isReady()) {
+        line << "Text: " << frame.uiGlyphs << " glyphs, " << frame.uiLayoutsBuilt << " laid out, "
+             << TextRenderer::getAtlas().cachedLayouts() << " cached";
+    } else {
+        line << "Text: " << frame.uiTextStrings << " GLUT bitmap strings (no font)";
+    }
+    lines.push_back(line.str());
+    line.str("");
+    line << std::fixed << std::setprecision(2) << "Transparent: " << frame.transparentObjects
+         << " back to front, " << frame.transparentSortMs << " ms";
+    if (frame.sortedTriangles > 0) {
+        line << ", " << frame.sortedTriangles << " tris sorted";
+    }
+    lines.push_back(line.str());
+    line.str("");
+    // Summed over the views shown
+    int viewCount = appState.quadView ? ApplicationState::VIEW_COUNT : 1;
+    SceneBvh::CullStats cull;
+    for (int v = 0; v < viewCount; ++v) {
+        cull.visible += appState.views[v].cullStats.visible;
+        cull.culled += appState.views[v].cullStats.culled;
+        cull.nodesVisited += appState.views[v].cullStats.nodesVisited;
+    }
+    line << "Culling" << (appState.frustumCulling ? "" : " off") << ": " << cull.visible << " visible, "
+         << cull.culled << " culled, " << cull.nodesVisited << " nodes (F7)";
+    lines.push_back(line.str());
+    line.str("");
+    line << "Views: " << viewCount << ", " << frame.viewsDrawn << " redrawn (F2 quad view)";
+    lines.push_back(line.str());
+    line.str("");
+    if (appState.occlusionCulling) {
+        const OcclusionCuller::Stats& occlusion = appState.occlusionCuller.getStats();
+        line << std::fixed << std::setprecision(2) << "Occlusion: " << occlusion.culled << "/" << occlusion.tested
+             << " culled, " << occlusion.occluders << " occluders, " << occlusion.triangles << " tris, "
+             << occlusion.rasterMs << " + " << occlusion.testMs << " ms (F8, F9 buffer)";
+    } else {
+        line << "Occlusion: off (F8)";
+    }
+    lines.push_back(line.str());
+    line.str("");
+    const PickResult& pick = appState.hoverPick;
+    if (pick.hit()) {
+        line << std::fixed << std::setprecision(2) << "Pick: face " << pick.face << " (" << pick.barycentric.x
+             << ", " << pick.barycentric.y << ", " << pick.barycentric.z << ") " << std::setprecision(1)
+             << appState.pickMicros << " us";
+    } else {
+        line << "Pick: none";
+    }
+    lines.push_back(line.str());
+    line.str("");
+
+    const MeshCache::Stats& meshStats = MeshCache::getStats();
+    line << "Mesh cache: " << meshStats.meshCount << " meshes, "
+         << std::fixed << std::setprecision(1) << (meshStats.bytesResident / 1024.0) << " KB resident";
+    lines.push_back(line.str());
+    line.str("");
+    line << "Mesh cache hits: " << meshStats.hits << "  misses: " << meshStats.misses;
+    lines.push_back(line.str());
+    if (LodSelector::usesLod(appState.currentShape) && appState.lodLevel >= 0) {
+        line.str("");
+        line << "LOD: level " << appState.lodLevel << " (" << LodSelector::LEVEL_SLICES[appState.lodLevel]
+             << " slices), radius " << std::setprecision(0) << appState.lodScreenRadius << " px";
+        lines.push_back(line.str());
+    }
+
+    PrimitiveParams params = PrimitiveParams::defaultsFor(appState.currentShape);
+    if (LodSelector::usesLod(appState.currentShape) && appState.lodLevel >= 0) {
+        params = LodSelector::paramsForLevel(params, appState.lodLevel);
+    }
+    if (const GpuMesh* mesh = MeshCache::find(params)) {
+        const MeshOptimizer::Report& report = mesh->optimization;
+        line.str("");
+        line << std::setprecision(2) << "ACMR " << report.before.acmr << " -> " << report.after.acmr
+             << "  ATVR " << report.before.atvr << " -> " << report.after.atvr;
+        lines.push_back(line.str());
+
+        if (mesh->format == VertexFormat::PACKED16) {
+            const QuantizationReport& packed = mesh->quantization;
+            line.str("");
+            line << "Packed: " << std::setprecision(1) << (packed.packedBytes / 1024.0) << " KB vs "
+                 << (packed.floatBytes / 1024.0) << " KB float (" << std::setprecision(2)
+                 << (double)packed.floatBytes / packed.packedBytes << "x)";
+            lines.push_back(line.str());
+            line.str("");
+            line << std::scientific << std::setprecision(1) << "Max error: pos " << packed.maxPositionError
+                 << "  uv " << packed.maxUvError << std::fixed << std::setprecision(3)
+                 << "  normal " << packed.maxNormalErrorDegrees << " deg";
+            lines.push_back(line.str());
+        } else {
+            line.str("");
+            line << "Vertex format: float (F4 for packed)";
+            lines.push_back(line.str());
         }
     }
 
-    glDisable(GL_SCISSOR_TEST);
+    float lineHeight = PrimitiveRenderer::pxToNDCy(16, height);
+    float x1 = canvasX1 + PrimitiveRenderer::pxToNDCx(8, width);
+    float x2 = x1 + PrimitiveRenderer::pxToNDCx(360, width);
+    float y2 = canvasY2 - PrimitiveRenderer::pxToNDCy(8, height);
+    float y1 = y2 - lineHeight * lines.size() - PrimitiveRenderer::pxToNDCy(8, height);
 
-    // Scroll bar for textures panel
-    if (maxScroll > 0) {
-        float scrollBarWidth = PrimitiveRenderer::pxToNDCx(8, width);
-        float scrollBarX = panelX1 + panelWidth - scrollBarWidth - PrimitiveRenderer::pxToNDCx(5, width);
-        float scrollBarHeight = panelHeight - PrimitiveRenderer::pxToNDCy(15, height);
-        float scrollThumbHeight = scrollBarHeight * (panelHeight / contentHeight);
-        float scrollProgress = state.leftPanelTexturesScroll / maxScroll;
-        float scrollThumbY = panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(10, height) - scrollThumbHeight - (scrollProgress * (scrollBarHeight - scrollThumbHeight));
-
-        PrimitiveRenderer::drawRect(scrollBarX, panelY1 + PrimitiveRenderer::pxToNDCy(10, height), scrollBarX + scrollBarWidth, panelY1 + panelHeight - PrimitiveRenderer::pxToNDCy(10, height), 0.3f, 0.3f, 0.3f);
-        PrimitiveRenderer::drawRect(scrollBarX, scrollThumbY, scrollBarX + scrollBarWidth, scrollThumbY + scrollThumbHeight, 0.6f, 0.6f, 0.6f);
+    PrimitiveRenderer::drawRect(x1, y1, x2, y2, 0.08f, 0.08f, 0.1f);
+    PrimitiveRenderer::drawOutlineRect(x1, y1, x2, y2, 0.3f, 0.3f, 0.3f, 1.0f);
+
+    PrimitiveRenderer::setTextColor(0.9f, 0.9f, 0.6f);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        PrimitiveRenderer::drawText(lines[i], x1 + PrimitiveRenderer::pxToNDCx(6, width),
+                                    y2 - lineHeight * (i + 1), GLUT_BITMAP_HELVETICA_12);
     }
-}
\ No newline at end of file
+}
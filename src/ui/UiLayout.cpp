@@ -0,0 +1,477 @@
+#include "../include/ui/UiLayout.hpp"
+#include "../include/rendering/PrimitiveRenderer.hpp"
+#include "../include/core/Constants.hpp"
+#include <algorithm>
+#include <cmath>
+
+std::vector<UiLayout::Widget> UiLayout::widgets;
+int UiLayout::slots[WIDGET_TYPE_COUNT][MAX_INDEX];
+std::vector<uint32_t> UiLayout::cellStart;
+std::vector<uint16_t> UiLayout::cellWidgets;
+int UiLayout::columns = 0;
+int UiLayout::rows = 0;
+int UiLayout::builtWidth = 0;
+int UiLayout::builtHeight = 0;
+float UiLayout::builtScrolls[3] = {0.0f, 0.0f, 0.0f};
+float UiLayout::maxScrolls[3] = {0.0f, 0.0f, 0.0f};
+int UiLayout::hovered = -1;
+UiLayout::Stats UiLayout::stats;
+
+namespace {
+    // The window size the widgets are being laid out for
+    int layoutWidth = 0;
+    int layoutHeight = 0;
+
+    float pxX(int px) {
+        return PrimitiveRenderer::pxToNDCx(px, layoutWidth);
+    }
+    float pxY(int px) {
+        return PrimitiveRenderer::pxToNDCy(px, layoutHeight);
+    }
+
+    // Bars are clipped to their UI layer region and the scrolled left panels
+    // to a scissor; the rest draw over their edges
+    bool clipsChildren(UiLayout::WidgetType type) {
+        return type == UiLayout::TOP_BAR || type == UiLayout::LEFT_BAR || type == UiLayout::RIGHT_BAR ||
+               type == UiLayout::AXIS_GROUP || type == UiLayout::TEXTURES_PANEL || type == UiLayout::SHAPES_PANEL;
+    }
+
+    // SCROLL_TRACK index of the containers that scroll, -1 for the rest
+    int scrollIndex(UiLayout::WidgetType type) {
+        switch (type) {
+            case UiLayout::TEXTURES_PANEL: return 0;
+            case UiLayout::SHAPES_PANEL: return 1;
+            case UiLayout::RIGHT_BAR: return 2;
+            default: return -1;
+        }
+    }
+
+    bool isInteractive(UiLayout::WidgetType type) {
+        switch (type) {
+            case UiLayout::SAVE_BUTTON:
+            case UiLayout::SAVE_AS_BUTTON:
+            case UiLayout::UNDO_BUTTON:
+            case UiLayout::REDO_BUTTON:
+            case UiLayout::NEW_PROJECT_BUTTON:
+            case UiLayout::CAMERA_BUTTON:
+            case UiLayout::COLOR_SWATCH:
+            case UiLayout::SHADES_TOGGLE:
+            case UiLayout::TEXTURE_BUTTON:
+            case UiLayout::SHAPE_BUTTON:
+            case UiLayout::TRANSFORM_FIELD:
+            case UiLayout::RESET_BUTTON:
+            case UiLayout::AXIS_BUTTON:
+                return true;
+            default:
+                return false;
+        }
+    }
+}
+
+bool UiLayout::update(int width, int height, const ApplicationState& state) {
+    if (!widgets.empty() && builtWidth == width && builtHeight == height &&
+        builtScrolls[0] == state.leftPanelTexturesScroll && builtScrolls[1] == state.leftPanelShapesScroll &&
+        builtScrolls[2] == state.rightPanelScroll) {
+        return false;
+    }
+    builtWidth = width;
+    builtHeight = height;
+    builtScrolls[0] = state.leftPanelTexturesScroll;
+    builtScrolls[1] = state.leftPanelShapesScroll;
+    builtScrolls[2] = state.rightPanelScroll;
+    build(state);
+    stats.builds++;
+
+    // The widget under a still cursor can change with the layout
+    setCursor(state.mouseX, state.mouseY);
+    return true;
+}
+
+int UiLayout::hitTest(double mouseX, double mouseY) {
+    stats.hitTests++;
+    if (widgets.empty()) {
+        return -1;
+    }
+    float x, y;
+    PrimitiveRenderer::mouseToNDC(mouseX, mouseY, builtWidth, builtHeight, x, y);
+    if (x < -1.0f || x > 1.0f || y < -1.0f || y > 1.0f) {
+        return -1;
+    }
+    int cell = cellRow(y) * columns + cellColumn(x);
+    for (uint32_t i = cellStart[cell + 1]; i > cellStart[cell]; --i) {
+        int id = cellWidgets[i - 1];
+        stats.rectsTested++;
+        if (widgets[id].hit.contains(x, y)) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+bool UiLayout::setCursor(double mouseX, double mouseY) {
+    int previous = hovered;
+    hovered = hitTest(mouseX, mouseY);
+    return hovered != previous;
+}
+
+bool UiLayout::isOverCanvas(double mouseX, double mouseY) {
+    if (widgets.empty()) {
+        return false;
+    }
+    float x, y;
+    PrimitiveRenderer::mouseToNDC(mouseX, mouseY, builtWidth, builtHeight, x, y);
+    return x > get(LEFT_BAR).rect.x2 && x < get(RIGHT_BAR).rect.x1 && y >= -1.0f && y < get(TOP_BAR).rect.y1;
+}
+
+int UiLayout::scrollAt(double mouseX, double mouseY) {
+    for (int id = hitTest(mouseX, mouseY); id >= 0; id = widgets[id].parent) {
+        int index = scrollIndex(widgets[id].type);
+        if (index >= 0) {
+            return index;
+        }
+    }
+
+    // Over a panel's background, where no interactive widget is
+    if (widgets.empty()) {
+        return -1;
+    }
+    float x, y;
+    PrimitiveRenderer::mouseToNDC(mouseX, mouseY, builtWidth, builtHeight, x, y);
+    for (WidgetType type : {TEXTURES_PANEL, SHAPES_PANEL, RIGHT_BAR}) {
+        if (get(type).hit.contains(x, y)) {
+            return scrollIndex(type);
+        }
+    }
+    return -1;
+}
+
+bool UiLayout::isHovered(WidgetType type, int index) {
+    return hovered >= 0 && widgets[hovered].type == type && widgets[hovered].index == index;
+}
+
+int UiLayout::hoveredIn(UiLayer::Region region) {
+    return hovered >= 0 && widgets[hovered].region == region ? hovered : -1;
+}
+
+int UiLayout::find(WidgetType type, int index) {
+    return slots[type][index];
+}
+
+void UiLayout::build(const ApplicationState& state) {
+    layoutWidth = builtWidth;
+    layoutHeight = builtHeight;
+    widgets.clear();
+    for (auto& typeSlots : slots) {
+        std::fill(typeSlots, typeSlots + MAX_INDEX, -1);
+    }
+
+    buildTopBar();
+    buildLeftBar(state);
+    buildRightBar(state);
+    buildAxisGroup();
+    buildGrid();
+}
+
+void UiLayout::buildTopBar() {
+    float topEdgeNDC = 1.0f - (2.0f * Constants::TOP_BAR_HEIGHT / layoutHeight);
+    int bar = add(TOP_BAR, 0, -1, -1.0f, topEdgeNDC, 1.0f, 1.0f);
+
+    float marginX = pxX(10);
+    float topBarY2 = 1.0f;
+
+    float blenderX1 = -1.0f + marginX;
+    float blenderX2 = blenderX1 + pxX(120);
+    float blenderY2 = topBarY2 - pxY(8);
+    float blenderY1 = blenderY2 - pxY(48);
+    add(LOGO, 0, bar, blenderX1, blenderY1, blenderX2, blenderY2);
+
+    // Save, Save as, then Undo and Redo side by side, stacked right of the logo
+    float groupX1 = blenderX2 + marginX;
+    float groupX2 = groupX1 + pxX(140);
+    float saveH = pxY(28);
+    float gapV = pxY(6);
+    float save1Y2 = blenderY2;
+    float save1Y1 = save1Y2 - saveH;
+    float save2Y2 = save1Y1 - gapV;
+    float save2Y1 = save2Y2 - saveH;
+    add(SAVE_BUTTON, 0, bar, groupX1, save1Y1, groupX2, save1Y2);
+    add(SAVE_AS_BUTTON, 0, bar, groupX1, save2Y1, groupX2, save2Y2);
+
+    float underY2 = save2Y1 - gapV;
+    float underY1 = underY2 - saveH;
+    float halfW = (groupX2 - groupX1 - marginX) * 0.5f;
+    float undoX2 = groupX1 + halfW - marginX * 0.5f;
+    float redoX1 = undoX2 + marginX * 0.5f;
+    add(UNDO_BUTTON, 0, bar, groupX1, underY1, undoX2, underY2);
+    add(REDO_BUTTON, 0, bar, redoX1, underY1, groupX2, underY2);
+
+    // Project name centered, New Project under it
+    float centerX1 = -pxX(150);
+    float centerX2 = pxX(150);
+    float pnameY2 = blenderY2;
+    float pnameY1 = pnameY2 - pxY(20) - pxY(6);
+    add(PROJECT_NAME, 0, bar, centerX1, pnameY1, centerX2, pnameY2);
+
+    float npY2 = pnameY1 - pxY(8);
+    float npY1 = npY2 - pxY(28);
+    add(NEW_PROJECT_BUTTON, 0, bar, -pxX(75), npY1, pxX(75), npY2);
+
+    float camSize = pxX(48);
+    float camX2 = 1.0f - pxX(50);
+    float camX1 = camX2 - camSize;
+    float camY2 = blenderY2;
+    float camHeight = pxY(48);
+    float camY1 = camY2 - camHeight;
+    add(CAMERA_BUTTON, 0, bar, camX1, camY1, camX2, camY2, camSize, camHeight);
+
+    // Colors right of the project name, pushed left to keep clear of the camera
+    float colorsPanelW = pxX(220);
+    float colorsX1 = centerX2 + pxX(10);
+    float colorsX2 = colorsX1 + colorsPanelW;
+    if (colorsX2 > camX1 - pxX(10)) {
+        colorsX2 = camX1 - pxX(10);
+        colorsX1 = colorsX2 - colorsPanelW;
+    }
+    float colorsY2 = topBarY2 - pxY(8);
+    float colorsY1 = colorsY2 - pxY(80);
+    int colors = add(COLORS_PANEL, 0, bar, colorsX1, colorsY1, colorsX2, colorsY2);
+
+    float swatchSize = pxX(20);
+    float swatchGap = pxX(5);
+    float startSwX = colorsX1 + pxX(10);
+    float swYTop = colorsY2 - pxY(30);
+    float swYBottom = swYTop - swatchSize;
+    for (int i = 0; i < 6; i++) {
+        float sx1 = startSwX + i * (swatchSize + swatchGap);
+        add(COLOR_SWATCH, i, colors, sx1, swYBottom, sx1 + swatchSize, swYTop);
+    }
+
+    float vX2 = startSwX + pxX(22);
+    float vY2 = swYBottom - pxY(5);
+    add(SHADES_TOGGLE, 0, colors, startSwX, vY2 - pxY(22), vX2, vY2);
+
+    float shadesX1 = vX2 + pxX(5);
+    add(SHADES_LABEL, 0, colors, shadesX1, vY2 - pxY(22), shadesX1 + pxX(80), vY2);
+}
+
+void UiLayout::buildLeftBar(const ApplicationState& state) {
+    float leftEdgeNDC = -1.0f + (2.0f * Constants::LEFT_BAR_WIDTH / layoutWidth);
+    float topEdgeNDC = widgets[find(TOP_BAR)].rect.y1;
+    int bar = add(LEFT_BAR, 0, -1, -1.0f, -1.0f, leftEdgeNDC, topEdgeNDC);
+
+    // The textures panel at the bottom, the shapes panel above it, each
+    // holding two columns of three buttons that scroll inside the panel
+    float panelX1 = -1.0f + pxX(5);
+    float panelWidth = pxX((int)(Constants::LEFT_BAR_WIDTH * 0.85f));
+    float panelHeight = pxY(310);
+    float texturesPanelY = -1.0f + state.leftPanelTexturesScroll + pxY(5);
+    float shapesPanelY = texturesPanelY + panelHeight + pxY(20) + state.leftPanelShapesScroll;
+
+    float buttonWidth = (panelWidth - pxX(40)) / 2.0f;
+    float buttonHeight = pxY(75);
+    float buttonGap = pxX(8);
+    float rowGap = pxY(10);
+    float contentHeight = (buttonHeight * 3) + (rowGap * 2);
+    float maxScroll = std::max(0.0f, contentHeight - panelHeight);
+    maxScrolls[0] = maxScroll;
+    maxScrolls[1] = maxScroll;
+
+    // Track and thumb inside a panel's right edge, when its buttons overflow it
+    auto addScrollBar = [&](int index, int panel, float panelY1, float scroll) {
+        if (maxScroll <= 0) {
+            return;
+        }
+        float scrollBarWidth = pxX(8);
+        float scrollBarX = panelX1 + panelWidth - scrollBarWidth - pxX(5);
+        float scrollBarHeight = panelHeight - pxY(15);
+        float scrollThumbHeight = scrollBarHeight * (panelHeight / contentHeight);
+        float scrollProgress = scroll / maxScroll;
+        float scrollThumbY = panelY1 + panelHeight - pxY(10) - scrollThumbHeight - (scrollProgress * (scrollBarHeight - scrollThumbHeight));
+        add(SCROLL_TRACK, index, panel, scrollBarX, panelY1 + pxY(10), scrollBarX + scrollBarWidth, panelY1 + panelHeight - pxY(10));
+        add(SCROLL_THUMB, index, panel, scrollBarX, scrollThumbY, scrollBarX + scrollBarWidth, scrollThumbY + scrollThumbHeight);
+    };
+
+    int textures = add(TEXTURES_PANEL, 0, bar, panelX1, texturesPanelY, panelX1 + panelWidth, texturesPanelY + panelHeight,
+                       panelWidth, panelHeight);
+    float scrollOffset = std::max(0.0f, std::min(maxScroll, -state.leftPanelTexturesScroll));
+    float row1Y = texturesPanelY + panelHeight - pxY(50) + scrollOffset;
+    for (int i = 0; i < 6; i++) {
+        int row = i / 2;
+        int col = i % 2;
+        float buttonX1 = panelX1 + pxX(10) + col * (buttonWidth + buttonGap);
+        float buttonY1 = row1Y - buttonHeight - row * (buttonHeight + rowGap);
+        add(TEXTURE_BUTTON, i, textures, buttonX1, buttonY1, buttonX1 + buttonWidth, buttonY1 + buttonHeight,
+            buttonWidth, buttonHeight);
+    }
+    addScrollBar(0, textures, texturesPanelY, state.leftPanelTexturesScroll);
+
+    int shapes = add(SHAPES_PANEL, 0, bar, panelX1, shapesPanelY, panelX1 + panelWidth, shapesPanelY + panelHeight,
+                     panelWidth, panelHeight);
+    scrollOffset = std::max(0.0f, std::min(maxScroll, -state.leftPanelShapesScroll));
+    float rowY = shapesPanelY + panelHeight - pxY(50) + scrollOffset;
+    for (int row = 0; row < 3; ++row) {
+        float leftX1 = panelX1 + pxX(10);
+        float leftX2 = leftX1 + buttonWidth;
+        float rightX1 = leftX2 + buttonGap;
+        add(SHAPE_BUTTON, row * 2, shapes, leftX1, rowY - buttonHeight, leftX2, rowY, buttonWidth, buttonHeight);
+        add(SHAPE_BUTTON, row * 2 + 1, shapes, rightX1, rowY - buttonHeight, rightX1 + buttonWidth, rowY,
+            buttonWidth, buttonHeight);
+        rowY = rowY - buttonHeight - rowGap;
+    }
+    addScrollBar(1, shapes, shapesPanelY, state.leftPanelShapesScroll);
+}
+
+void UiLayout::buildRightBar(const ApplicationState& state) {
+    float rightEdgeNDC = 1.0f - (2.0f * Constants::RIGHT_BAR_WIDTH / layoutWidth);
+    float topEdgeNDC = widgets[find(TOP_BAR)].rect.y1;
+    int bar = add(RIGHT_BAR, 0, -1, rightEdgeNDC, -1.0f, 1.0f, topEdgeNDC);
+
+    // Rotation, Scaling and Translate stacked from the bottom, scrolled together
+    float panelX1 = rightEdgeNDC + pxX(5);
+    float panelWidth = pxX((int)(Constants::RIGHT_BAR_WIDTH * 0.85f));
+    float panelHeight = pxY(180);
+    float panelGap = pxY(15);
+    float totalPanelsHeight = (panelHeight * 3) + (panelGap * 2);
+    float rightVerticalOffset = pxY(50);
+    float panelY1s[3] = {
+        -1.0f + state.rightPanelScroll + rightVerticalOffset,
+        -1.0f + panelHeight + panelGap + state.rightPanelScroll + rightVerticalOffset,
+        -1.0f + (panelHeight * 2) + (panelGap * 2) + state.rightPanelScroll + rightVerticalOffset};
+
+    float inputBoxHeight = pxY(25);
+    float inputBoxWidth = panelWidth - pxX(30);
+    for (int panel = 0; panel < 3; ++panel) {
+        float panelY1 = panelY1s[panel];
+        int transform = add(TRANSFORM_PANEL, panel, bar, panelX1, panelY1, panelX1 + panelWidth, panelY1 + panelHeight,
+                            panelWidth, panelHeight);
+
+        // X, Y and Z fields one under the other, then the Reset button
+        float inputY = panelY1 + panelHeight - pxY(70);
+        float boxX1 = panelX1 + pxX(15);
+        for (int axis = 0; axis < 3; ++axis) {
+            if (axis > 0) {
+                inputY -= inputBoxHeight + pxY(2);
+            }
+            add(TRANSFORM_FIELD, panel * 3 + axis, transform, boxX1, inputY - inputBoxHeight, boxX1 + inputBoxWidth, inputY,
+                inputBoxWidth, inputBoxHeight);
+        }
+
+        float resetBtnY = inputY - inputBoxHeight - pxY(10);
+        float resetBtnHeight = pxY(25);
+        add(RESET_BUTTON, panel, transform, boxX1, resetBtnY - resetBtnHeight, boxX1 + pxX(60), resetBtnY);
+    }
+
+    // Scroll bar along the window's right edge
+    float scrollBarWidth = pxX(8);
+    float scrollBarX = 1.0f - scrollBarWidth;
+    float scrollBarHeight = topEdgeNDC - (-1.0f);
+    float scrollThumbHeight = scrollBarHeight * 0.3f;
+    float maxScroll = totalPanelsHeight - (topEdgeNDC - (-1.0f));
+    if (maxScroll < 0) maxScroll = 0;
+    maxScrolls[2] = maxScroll;
+    float scrollProgress = 0.0f;
+    if (maxScroll > 0) {
+        scrollProgress = std::max(0.0f, std::min(1.0f, -state.rightPanelScroll / maxScroll));
+    }
+    float scrollThumbY = -1.0f + (1.0f - scrollProgress) * scrollBarHeight;
+    add(SCROLL_TRACK, 2, bar, scrollBarX, -1.0f, scrollBarX + scrollBarWidth, topEdgeNDC);
+    add(SCROLL_THUMB, 2, bar, scrollBarX, scrollThumbY - scrollThumbHeight, scrollBarX + scrollBarWidth, scrollThumbY);
+}
+
+void UiLayout::buildAxisGroup() {
+    // Attached to the left sidebar's right edge over the canvas's bottom-left
+    // corner; the group also covers the arrows and labels drawn above the buttons
+    float leftEdgeNDC = widgets[find(LEFT_BAR)].rect.x2;
+    float canvasY1 = -1.0f;
+    int group = add(AXIS_GROUP, 0, -1, leftEdgeNDC, canvasY1, leftEdgeNDC + 0.15f, canvasY1 + 0.15f);
+
+    float buttonSize = 0.035f;
+    float buttonGap = 0.002f;
+    float startY = canvasY1 + 0.03f;
+    float x1 = leftEdgeNDC;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (axis > 0) {
+            x1 = widgets.back().rect.x2 + buttonGap;
+        }
+        add(AXIS_BUTTON, axis, group, x1, startY, x1 + buttonSize, startY + buttonSize, buttonSize, buttonSize);
+    }
+}
+
+void UiLayout::buildGrid() {
+    columns = std::max(1, (builtWidth + CELL_SIZE - 1) / CELL_SIZE);
+    rows = std::max(1, (builtHeight + CELL_SIZE - 1) / CELL_SIZE);
+    cellStart.assign((size_t)columns * rows + 1, 0);
+
+    // Count each cell's widgets, turn the counts into offsets, then fill the
+    // cells in widget order so each lists its widgets ascending
+    auto forEachCell = [&](const Widget& widget, auto&& visit) {
+        if (!widget.interactive || widget.hit.isEmpty() || widget.hit.x2 < -1.0f || widget.hit.x1 > 1.0f ||
+            widget.hit.y2 < -1.0f || widget.hit.y1 > 1.0f) {
+            return;
+        }
+        int column1 = cellColumn(widget.hit.x1), column2 = cellColumn(widget.hit.x2);
+        int row1 = cellRow(widget.hit.y1), row2 = cellRow(widget.hit.y2);
+        for (int row = row1; row <= row2; ++row) {
+            for (int column = column1; column <= column2; ++column) {
+                visit(row * columns + column);
+            }
+        }
+    };
+    for (const Widget& widget : widgets) {
+        forEachCell(widget, [&](int cell) { cellStart[cell + 1]++; });
+    }
+    for (size_t cell = 1; cell < cellStart.size(); ++cell) {
+        cellStart[cell] += cellStart[cell - 1];
+    }
+    cellWidgets.resize(cellStart.back());
+    std::vector<uint32_t> next(cellStart.begin(), cellStart.end() - 1);
+    for (size_t id = 0; id < widgets.size(); ++id) {
+        forEachCell(widgets[id], [&](int cell) { cellWidgets[next[cell]++] = (uint16_t)id; });
+    }
+}
+
+int UiLayout::add(WidgetType type, int index, int parent, float x1, float y1, float x2, float y2) {
+    return add(type, index, parent, x1, y1, x2, y2, x2 - x1, y2 - y1);
+}
+
+int UiLayout::add(WidgetType type, int index, int parent, float x1, float y1, float x2, float y2,
+                  float width, float height) {
+    Widget widget;
+    widget.type = type;
+    widget.index = index;
+    widget.parent = parent;
+    widget.interactive = isInteractive(type);
+    widget.rect = {x1, y1, x2, y2};
+    widget.width = width;
+    widget.height = height;
+    widget.hit = widget.rect;
+    if (parent < 0) {
+        widget.region = type == TOP_BAR ? UiLayer::TOP_BAR : type == LEFT_BAR ? UiLayer::LEFT_BAR :
+                        type == RIGHT_BAR ? UiLayer::RIGHT_BAR : UiLayer::AXIS_BUTTONS;
+    } else {
+        // Whatever a widget draws outside its clipping parents is clipped away,
+        // so it can't be hit there either
+        const Widget& outer = widgets[parent];
+        widget.region = outer.region;
+        widget.hit.x1 = std::max(widget.hit.x1, outer.clip.x1);
+        widget.hit.y1 = std::max(widget.hit.y1, outer.clip.y1);
+        widget.hit.x2 = std::min(widget.hit.x2, outer.clip.x2);
+        widget.hit.y2 = std::min(widget.hit.y2, outer.clip.y2);
+    }
+    widget.clip = parent < 0 || clipsChildren(type) ? widget.hit : widgets[parent].clip;
+
+    int id = (int)widgets.size();
+    widgets.push_back(widget);
+    slots[type][index] = id;
+    return id;
+}
+
+int UiLayout::cellColumn(float x) {
+    int column = (int)std::floor((x + 1.0f) * 0.5f * builtWidth / CELL_SIZE);
+    return std::max(0, std::min(columns - 1, column));
+}
+
+int UiLayout::cellRow(float y) {
+    int row = (int)std::floor((y + 1.0f) * 0.5f * builtHeight / CELL_SIZE);
+    return std::max(0, std::min(rows - 1, row));
+}